@@ -20,6 +20,7 @@
 #include <map>
 #include <unordered_map>
 #include <memory>
+#include <vector>
 
 // #include <FairLogger.h>
 
@@ -81,6 +82,15 @@ class CCDBManagerInstance
     return getForTimeStamp<T>(path, mTimestamp);
   }
 
+  /// download concurrently the objects at the given paths for the timestamp, to be served by the following get calls
+  size_t prefetch(std::vector<std::string> const& paths, long timestamp) { return mCCDBAccessor.prefetch(paths, mMetaData, timestamp); }
+
+  /// download concurrently the objects at the given paths; will use the timestamp member
+  size_t prefetch(std::vector<std::string> const& paths) { return prefetch(paths, mTimestamp); }
+
+  /// keep the retrieved objects in a cache on the local disk, shared by the processes using the same directory
+  void setDiskCacheDir(std::string const& dir) { mCCDBAccessor.setDiskCacheDir(dir); }
+
   bool isHostReachable() const { return mCCDBAccessor.isHostReachable(); }
 
   /// clear all entries in the cache
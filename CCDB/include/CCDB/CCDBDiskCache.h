@@ -0,0 +1,76 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   CCDBDiskCache.h
+/// \brief  Cache of CCDB objects on the local disk, shared by the processes of a node
+///
+
+#ifndef O2_CCDB_DISKCACHE_H
+#define O2_CCDB_DISKCACHE_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace o2
+{
+namespace ccdb
+{
+
+/// Image of a CCDB object together with the headers it was served with
+struct CCDBBlob {
+  std::vector<char> data;
+  std::map<std::string, std::string> headers;
+
+  std::string getETag() const { return getHeader("ETag"); }
+  /// start and end of validity from the headers, -1 if absent
+  long getValidFrom() const;
+  long getValidUntil() const;
+  bool isValid(long timestamp) const { return getValidFrom() <= timestamp && timestamp < getValidUntil(); }
+
+ private:
+  std::string getHeader(std::string const& key) const;
+};
+
+/// Content addressed cache of CCDB objects on the local disk.
+///
+/// An object is stored as <dir>/<path>/<metadata key>/<valid from>_<valid until>_<ETag hash>, so that
+/// the objects are identified by the query and by the version served by the server. Files are written
+/// under a temporary name and renamed, therefore the cache directory can be shared by concurrent processes:
+/// they see either a complete object or none. Objects are never modified once stored.
+class CCDBDiskCache
+{
+ public:
+  explicit CCDBDiskCache(std::string const& dir) : mDir(dir) {}
+
+  std::string const& getDirectory() const { return mDir; }
+
+  /// look for an object at path, for the metadata, valid for the timestamp. If there are several, the
+  /// most recently stored one is returned.
+  bool find(std::string const& path, std::map<std::string, std::string> const& metadata, long timestamp, CCDBBlob& blob) const;
+
+  /// store an object; its headers must provide the ETag and the validity
+  bool store(std::string const& path, std::map<std::string, std::string> const& metadata, CCDBBlob const& blob) const;
+
+  /// key identifying a set of metadata in the cache
+  static std::string getMetadataKey(std::map<std::string, std::string> const& metadata);
+
+ private:
+  std::string getEntryDirectory(std::string const& path, std::map<std::string, std::string> const& metadata) const;
+  static bool read(std::string const& fileName, CCDBBlob& blob);
+
+  std::string mDir;
+};
+
+} // namespace ccdb
+} // namespace o2
+
+#endif // O2_CCDB_DISKCACHE_H
@@ -19,10 +19,14 @@
 #include <string>
 #include <memory>
 #include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 #include <curl/curl.h>
 #include <TObject.h>
 #include <TMessage.h>
 #include "CCDB/CcdbObjectInfo.h"
+#include "CCDB/CCDBDiskCache.h"
 
 class TFile;
 class TGrid;
@@ -147,6 +151,31 @@ class CcdbApi //: public DatabaseInterface
                           long timestamp = -1, std::map<std::string, std::string>* headers = nullptr, std::string const& etag = "",
                           const std::string& createdNotAfter = "", const std::string& createdNotBefore = "") const;
 
+  /**
+   * Download concurrently the objects at the given paths valid for the given timestamp.
+   * The objects are kept to serve the next retrieveFromTFile call for the same path and metadata, at
+   * any timestamp within their validity, and are stored in the disk cache, if any. The objects which
+   * cannot be prefetched are retrieved as usual.
+   *
+   * @param paths The paths of the objects.
+   * @param metadata Key-values representing the metadata to filter out objects.
+   * @param timestamp Timestamp of the objects to retrieve. If omitted, current timestamp is used.
+   * @param maxParallel Maximum number of concurrent transfers.
+   * @return The number of prefetched objects.
+   */
+  size_t prefetch(std::vector<std::string> const& paths, std::map<std::string, std::string> const& metadata,
+                  long timestamp = -1, int maxParallel = 16) const;
+
+  /**
+   * Keep the retrieved objects in a cache on the local disk, which can be shared by the processes of a node.
+   * An object found in the cache is validated with the server by its ETag and downloaded only if it
+   * changed. The cache is set at initialization from the ALICEO2_CCDB_DISKCACHE environment variable.
+   *
+   * @param dir The cache directory, an empty string disables the cache.
+   */
+  void setDiskCacheDir(std::string const& dir);
+  std::string getDiskCacheDir() const { return mDiskCache ? mDiskCache->getDirectory() : ""; }
+
   /**
    * Delete all versions of the object at this path.
    *
@@ -364,7 +393,12 @@ class CcdbApi //: public DatabaseInterface
 
   /// Queries the CCDB server and navigates through possible redirects until binary content is found; Retrieves content as instance
   /// given by tinfo if that is possible. Returns nullptr if something fails...
-  void* navigateURLsAndRetrieveContent(CURL*, std::string const& url, std::type_info const& tinfo, std::map<std::string, std::string>* headers) const;
+  /// If rawContent is given, it is filled with the image of the object as downloaded.
+  void* navigateURLsAndRetrieveContent(CURL*, std::string const& url, std::type_info const& tinfo, std::map<std::string, std::string>* headers,
+                                       std::vector<char>* rawContent = nullptr) const;
+
+  /// Extract the object of a prefetched blob for path and metadata valid at timestamp, if any
+  bool takePrefetched(std::string const& path, std::map<std::string, std::string> const& metadata, long timestamp, CCDBBlob& blob) const;
 
   // helper that interprets a content chunk as TMemFile and extracts the object therefrom
   void* interpretAsTMemFileAndExtract(char* contentptr, size_t contentsize, std::type_info const& tinfo) const;
@@ -383,6 +417,12 @@ class CcdbApi //: public DatabaseInterface
   bool mInSnapshotMode = false;
   mutable TGrid* mAlienInstance = nullptr;                     // a cached connection to TGrid (needed for Alien locations)
   bool mHaveAlienToken = false;                                // stores if an alien token is available
+  std::shared_ptr<CCDBDiskCache> mDiskCache;                   //! node-wide cache of the objects on the local disk
+  struct PrefetchedObjects {
+    std::mutex mutex;
+    std::unordered_map<std::string, CCDBBlob> blobs; // by path and metadata
+  };
+  std::shared_ptr<PrefetchedObjects> mPrefetched = std::make_shared<PrefetchedObjects>(); //! objects downloaded by prefetch
 
   ClassDefNV(CcdbApi, 1);
 };
@@ -0,0 +1,216 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   CCDBDiskCache.cxx
+/// \brief  Cache of CCDB objects on the local disk, shared by the processes of a node
+///
+
+#include "CCDB/CCDBDiskCache.h"
+#include <FairLogger.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace o2
+{
+namespace ccdb
+{
+
+namespace
+{
+// layout of a cached file: magic | number of headers | (key size, key, value size, value)... | data size | data
+constexpr char CacheFileMagic[8] = {'O', '2', 'C', 'C', 'D', 'B', 'C', '1'};
+
+uint64_t hashString(std::string const& s, uint64_t h = 0xcbf29ce484222325ULL)
+{
+  // FNV-1a
+  for (unsigned char c : s) {
+    h ^= c;
+    h *= 0x100000001b3ULL;
+  }
+  return h;
+}
+
+std::string toHex(uint64_t v)
+{
+  char buf[17];
+  snprintf(buf, sizeof(buf), "%016" PRIx64, v);
+  return buf;
+}
+
+void writeString(std::ofstream& out, std::string const& s)
+{
+  uint32_t size = s.size();
+  out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+  out.write(s.data(), size);
+}
+
+bool readString(std::ifstream& in, std::string& s, size_t maxSize)
+{
+  uint32_t size = 0;
+  if (!in.read(reinterpret_cast<char*>(&size), sizeof(size)) || size > maxSize) {
+    return false;
+  }
+  s.resize(size);
+  return bool(in.read(s.data(), size));
+}
+} // namespace
+
+std::string CCDBBlob::getHeader(std::string const& key) const
+{
+  auto it = headers.find(key);
+  return it == headers.end() ? std::string{} : it->second;
+}
+
+long CCDBBlob::getValidFrom() const
+{
+  auto v = getHeader("Valid-From");
+  return v.empty() ? -1 : std::strtol(v.c_str(), nullptr, 10);
+}
+
+long CCDBBlob::getValidUntil() const
+{
+  auto v = getHeader("Valid-Until");
+  return v.empty() ? -1 : std::strtol(v.c_str(), nullptr, 10);
+}
+
+std::string CCDBDiskCache::getMetadataKey(std::map<std::string, std::string> const& metadata)
+{
+  if (metadata.empty()) {
+    return "default";
+  }
+  uint64_t h = hashString("");
+  for (auto const& [key, value] : metadata) {
+    h = hashString(key + '=' + value + '/', h);
+  }
+  return toHex(h);
+}
+
+std::string CCDBDiskCache::getEntryDirectory(std::string const& path, std::map<std::string, std::string> const& metadata) const
+{
+  return mDir + '/' + path + '/' + getMetadataKey(metadata);
+}
+
+bool CCDBDiskCache::find(std::string const& path, std::map<std::string, std::string> const& metadata, long timestamp, CCDBBlob& blob) const
+{
+  namespace fs = std::filesystem;
+  std::error_code ec;
+  fs::directory_iterator dir(getEntryDirectory(path, metadata), ec);
+  if (ec) {
+    return false;
+  }
+  std::vector<std::pair<fs::file_time_type, fs::path>> candidates;
+  for (auto const& entry : dir) {
+    long from = 0, until = 0;
+    char hash[17];
+    auto name = entry.path().filename().string();
+    if (name.find('.') != std::string::npos || sscanf(name.c_str(), "%ld_%ld_%16[0-9a-f]", &from, &until, hash) != 3) {
+      continue; // temporary file or something we did not write
+    }
+    if (from <= timestamp && timestamp < until) {
+      candidates.emplace_back(entry.last_write_time(ec), entry.path());
+    }
+  }
+  std::sort(candidates.begin(), candidates.end(), [](auto const& a, auto const& b) { return a.first > b.first; });
+  for (auto const& candidate : candidates) {
+    if (read(candidate.second.string(), blob)) {
+      return true;
+    }
+    LOG(WARNING) << "Ignoring corrupted CCDB cache file " << candidate.second;
+  }
+  return false;
+}
+
+bool CCDBDiskCache::store(std::string const& path, std::map<std::string, std::string> const& metadata, CCDBBlob const& blob) const
+{
+  static std::atomic<uint32_t> counter{0};
+  auto etag = blob.getETag();
+  long from = blob.getValidFrom(), until = blob.getValidUntil();
+  if (etag.empty() || from < 0 || until < 0 || path.find("..") != std::string::npos) {
+    LOG(DEBUG) << "Not caching CCDB object " << path << " w/o ETag or validity";
+    return false;
+  }
+  auto dir = getEntryDirectory(path, metadata);
+  std::error_code ec;
+  std::filesystem::create_directories(dir, ec); // might be created concurrently by another process
+  auto fileName = dir + '/' + std::to_string(from) + '_' + std::to_string(until) + '_' + toHex(hashString(etag));
+  // unique name of the file being written, renamed once complete
+  auto tmpName = fileName + ".tmp" + std::to_string(getpid()) + '_' + std::to_string(counter++);
+  {
+    std::ofstream out(tmpName, std::ios::binary | std::ios::trunc);
+    uint32_t nHeaders = blob.headers.size();
+    uint64_t dataSize = blob.data.size();
+    out.write(CacheFileMagic, sizeof(CacheFileMagic));
+    out.write(reinterpret_cast<const char*>(&nHeaders), sizeof(nHeaders));
+    for (auto const& [key, value] : blob.headers) {
+      writeString(out, key);
+      writeString(out, value);
+    }
+    out.write(reinterpret_cast<const char*>(&dataSize), sizeof(dataSize));
+    out.write(blob.data.data(), dataSize);
+    out.close();
+    if (out.fail()) {
+      LOG(WARNING) << "Failed to write CCDB cache file " << tmpName;
+      std::remove(tmpName.c_str());
+      return false;
+    }
+  }
+  if (std::rename(tmpName.c_str(), fileName.c_str()) != 0) {
+    LOG(WARNING) << "Failed to move CCDB cache file to " << fileName;
+    std::remove(tmpName.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool CCDBDiskCache::read(std::string const& fileName, CCDBBlob& blob)
+{
+  std::ifstream in(fileName, std::ios::binary | std::ios::ate);
+  if (!in) {
+    return false;
+  }
+  const size_t fileSize = in.tellg();
+  in.seekg(0);
+  char magic[sizeof(CacheFileMagic)];
+  uint32_t nHeaders = 0;
+  if (!in.read(magic, sizeof(magic)) || memcmp(magic, CacheFileMagic, sizeof(magic)) != 0 ||
+      !in.read(reinterpret_cast<char*>(&nHeaders), sizeof(nHeaders))) {
+    return false;
+  }
+  CCDBBlob result;
+  for (uint32_t i = 0; i < nHeaders; i++) {
+    std::string key, value;
+    if (!readString(in, key, fileSize) || !readString(in, value, fileSize)) {
+      return false;
+    }
+    result.headers[key] = value;
+  }
+  uint64_t dataSize = 0;
+  if (!in.read(reinterpret_cast<char*>(&dataSize), sizeof(dataSize)) || size_t(in.tellg()) + dataSize != fileSize) {
+    return false;
+  }
+  result.data.resize(dataSize);
+  if (!in.read(result.data.data(), dataSize)) {
+    return false;
+  }
+  blob = std::move(result);
+  return true;
+}
+
+} // namespace ccdb
+} // namespace o2
@@ -35,6 +35,7 @@
 #include <boost/algorithm/string.hpp>
 #include <iostream>
 #include <mutex>
+#include <unordered_map>
 
 namespace o2
 {
@@ -69,6 +70,13 @@ void CcdbApi::init(std::string const& host)
     initInSnapshotMode(path);
   } else {
     curlInit();
+    if (auto cacheDir = getenv("ALICEO2_CCDB_DISKCACHE")) {
+      setDiskCacheDir(cacheDir);
+    }
+  }
+  {
+    std::lock_guard<std::mutex> guard(mPrefetched->mutex);
+    mPrefetched->blobs.clear(); // were served by the previous host
   }
 
   // find out if we can can in principle connect to Alien
@@ -536,7 +544,8 @@ void* CcdbApi::interpretAsTMemFileAndExtract(char* contentptr, size_t contentsiz
 }
 
 // navigate sequence of URLs until TFile content is found; object is extracted and returned
-void* CcdbApi::navigateURLsAndRetrieveContent(CURL* curl_handle, std::string const& url, std::type_info const& tinfo, std::map<string, string>* headers) const
+void* CcdbApi::navigateURLsAndRetrieveContent(CURL* curl_handle, std::string const& url, std::type_info const& tinfo, std::map<string, string>* headers,
+                                               std::vector<char>* rawContent) const
 {
   // a global internal data structure that can be filled with HTTP header information
   // static --> to avoid frequent alloc/dealloc as optimization
@@ -582,6 +591,9 @@ void* CcdbApi::navigateURLsAndRetrieveContent(CURL* curl_handle, std::string con
     if (200 <= response_code && response_code < 300) {
       // good response and the content is directly provided and should have been dumped into "chunk"
       content = interpretAsTMemFileAndExtract(chunk.memory, chunk.size, tinfo);
+      if (content && rawContent) {
+        rawContent->assign(chunk.memory, chunk.memory + chunk.size);
+      }
     } else if (response_code == 304) {
       // this means the object exist but I am not serving
       // it since it's already in your possession
@@ -622,7 +634,7 @@ void* CcdbApi::navigateURLsAndRetrieveContent(CURL* curl_handle, std::string con
       for (auto& l : locs) {
         if (l.size() > 0) {
           LOG(DEBUG) << "Trying content location " << l;
-          content = navigateURLsAndRetrieveContent(curl_handle, l, tinfo, nullptr);
+          content = navigateURLsAndRetrieveContent(curl_handle, l, tinfo, nullptr, rawContent);
           if (content /* or other success marker in future */) {
             break;
           }
@@ -660,11 +672,34 @@ void* CcdbApi::retrieveFromTFile(std::type_info const& tinfo, std::string const&
   string fullUrl = getFullUrlForRetrieval(curl_handle, path, metadata, timestamp);
   // if we are in snapshot mode we can simply open the file; extract the object and return
   if (mInSnapshotMode) {
+    curl_easy_cleanup(curl_handle);
     return extractFromLocalFile(fullUrl, tinfo);
   }
 
+  // the prefetched objects and the disk cache are not used for TimeMachine queries
+  const bool useCaches = createdNotAfter.empty() && createdNotBefore.empty();
+  const long validAt = timestamp < 0 ? getCurrentTimestamp() : timestamp;
+  CCDBBlob cached;
+  if (useCaches && takePrefetched(path, metadata, validAt, cached)) {
+    curl_easy_cleanup(curl_handle);
+    if (headers) {
+      for (auto& p : cached.headers) {
+        (*headers)[p.first] = p.second;
+      }
+    }
+    if (!etag.empty() && cached.getETag() == etag) {
+      return nullptr; // as for a 304 reply: the caller has the object already
+    }
+    return interpretAsTMemFileAndExtract(cached.data.data(), cached.data.size(), tinfo);
+  }
+  // an object in the disk cache is validated with the server by its ETag
+  const bool haveCached = useCaches && mDiskCache && etag.empty() && mDiskCache->find(path, metadata, validAt, cached);
+
   // add some global options to the curl query
   struct curl_slist* list = nullptr;
+  if (haveCached) {
+    list = curl_slist_append(list, ("If-None-Match: " + cached.getETag()).c_str());
+  }
   if (!etag.empty()) {
     list = curl_slist_append(list, ("If-None-Match: " + etag).c_str());
   }
@@ -679,11 +714,150 @@ void* CcdbApi::retrieveFromTFile(std::type_info const& tinfo, std::string const&
   }
   curl_easy_setopt(curl_handle, CURLOPT_HTTPHEADER, list);
 
-  auto content = navigateURLsAndRetrieveContent(curl_handle, fullUrl, tinfo, headers);
+  if (!useCaches || !mDiskCache) {
+    auto content = navigateURLsAndRetrieveContent(curl_handle, fullUrl, tinfo, headers);
+    curl_easy_cleanup(curl_handle);
+    curl_slist_free_all(list);
+    return content;
+  }
+
+  CCDBBlob downloaded;
+  auto content = navigateURLsAndRetrieveContent(curl_handle, fullUrl, tinfo, &downloaded.headers, &downloaded.data);
+  long responseCode = -1;
+  curl_easy_getinfo(curl_handle, CURLINFO_RESPONSE_CODE, &responseCode);
   curl_easy_cleanup(curl_handle);
+  curl_slist_free_all(list);
+  if (!content && haveCached && responseCode == 304) {
+    LOG(DEBUG) << "Serving " << path << " from the disk cache " << mDiskCache->getDirectory();
+    content = interpretAsTMemFileAndExtract(cached.data.data(), cached.data.size(), tinfo);
+    downloaded.headers = std::move(cached.headers);
+  } else if (content && !downloaded.data.empty()) {
+    mDiskCache->store(path, metadata, downloaded);
+  }
+  if (headers) {
+    for (auto& p : downloaded.headers) {
+      (*headers)[p.first] = p.second;
+    }
+  }
   return content;
 }
 
+void CcdbApi::setDiskCacheDir(std::string const& dir)
+{
+  if (dir.empty()) {
+    mDiskCache.reset();
+    return;
+  }
+  LOG(INFO) << "Using CCDB disk cache in " << dir;
+  mDiskCache = std::make_shared<CCDBDiskCache>(dir);
+}
+
+bool CcdbApi::takePrefetched(std::string const& path, std::map<std::string, std::string> const& metadata, long timestamp, CCDBBlob& blob) const
+{
+  std::lock_guard<std::mutex> guard(mPrefetched->mutex);
+  auto it = mPrefetched->blobs.find(path + '/' + CCDBDiskCache::getMetadataKey(metadata));
+  if (it == mPrefetched->blobs.end() || !it->second.isValid(timestamp)) {
+    return false;
+  }
+  blob = std::move(it->second);
+  mPrefetched->blobs.erase(it);
+  return true;
+}
+
+size_t CcdbApi::prefetch(std::vector<std::string> const& paths, std::map<std::string, std::string> const& metadata,
+                         long timestamp, int maxParallel) const
+{
+  if (mInSnapshotMode) {
+    return 0; // the objects are local already
+  }
+  struct Transfer {
+    CURL* handle = nullptr;
+    struct curl_slist* list = nullptr;
+    MemoryStruct chunk{nullptr, 0};
+    std::map<std::string, std::string> headers;
+    CURLcode result = CURLE_FAILED_INIT;
+    CCDBBlob cached;
+    bool haveCached = false;
+  };
+  const long validAt = timestamp < 0 ? getCurrentTimestamp() : timestamp;
+  CURLM* multi_handle = curl_multi_init();
+  curl_multi_setopt(multi_handle, CURLMOPT_MAX_TOTAL_CONNECTIONS, long(maxParallel));
+  std::vector<Transfer> transfers(paths.size()); // not resized anymore, curl keeps pointers to the elements
+  for (size_t i = 0; i < paths.size(); i++) {
+    auto& transfer = transfers[i];
+    transfer.handle = curl_easy_init();
+    string fullUrl = getFullUrlForRetrieval(transfer.handle, paths[i], metadata, validAt);
+    if (mDiskCache && mDiskCache->find(paths[i], metadata, validAt, transfer.cached)) {
+      transfer.haveCached = true;
+      transfer.list = curl_slist_append(transfer.list, ("If-None-Match: " + transfer.cached.getETag()).c_str());
+      curl_easy_setopt(transfer.handle, CURLOPT_HTTPHEADER, transfer.list);
+    }
+    transfer.chunk.memory = (char*)malloc(1);
+    curl_easy_setopt(transfer.handle, CURLOPT_URL, fullUrl.c_str());
+    curl_easy_setopt(transfer.handle, CURLOPT_USERAGENT, "libcurl-agent/1.0");
+    // the redirections to the actual content are followed by curl, the headers of the
+    // CCDB reply come first and are the ones kept by the callback
+    curl_easy_setopt(transfer.handle, CURLOPT_FOLLOWLOCATION, 1L);
+    curl_easy_setopt(transfer.handle, CURLOPT_HEADERFUNCTION, header_map_callback<decltype(transfer.headers)>);
+    curl_easy_setopt(transfer.handle, CURLOPT_HEADERDATA, (void*)&transfer.headers);
+    curl_easy_setopt(transfer.handle, CURLOPT_WRITEFUNCTION, WriteMemoryCallback);
+    curl_easy_setopt(transfer.handle, CURLOPT_WRITEDATA, (void*)&transfer.chunk);
+    curl_easy_setopt(transfer.handle, CURLOPT_PRIVATE, (void*)&transfer);
+    curl_multi_add_handle(multi_handle, transfer.handle);
+  }
+
+  int running = 0;
+  do {
+    if (curl_multi_perform(multi_handle, &running) != CURLM_OK) {
+      break;
+    }
+    if (running) {
+      curl_multi_wait(multi_handle, nullptr, 0, 1000, nullptr);
+    }
+  } while (running);
+  int nMessages = 0;
+  while (CURLMsg* msg = curl_multi_info_read(multi_handle, &nMessages)) {
+    if (msg->msg == CURLMSG_DONE) {
+      Transfer* transfer = nullptr;
+      curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, (char**)&transfer);
+      transfer->result = msg->data.result;
+    }
+  }
+
+  size_t nPrefetched = 0;
+  for (size_t i = 0; i < paths.size(); i++) {
+    auto& transfer = transfers[i];
+    long responseCode = -1;
+    if (transfer.result == CURLE_OK) {
+      curl_easy_getinfo(transfer.handle, CURLINFO_RESPONSE_CODE, &responseCode);
+    }
+    CCDBBlob blob;
+    if (200 <= responseCode && responseCode < 300) {
+      blob.data.assign(transfer.chunk.memory, transfer.chunk.memory + transfer.chunk.size);
+      blob.headers = std::move(transfer.headers);
+      if (mDiskCache) {
+        mDiskCache->store(paths[i], metadata, blob);
+      }
+    } else if (responseCode == 304 && transfer.haveCached) {
+      blob = std::move(transfer.cached);
+    } else {
+      LOG(DEBUG) << "Could not prefetch " << paths[i] << ", response code " << responseCode << ": " << curl_easy_strerror(transfer.result);
+    }
+    if (!blob.data.empty()) {
+      std::lock_guard<std::mutex> guard(mPrefetched->mutex);
+      mPrefetched->blobs[paths[i] + '/' + CCDBDiskCache::getMetadataKey(metadata)] = std::move(blob);
+      nPrefetched++;
+    }
+    curl_multi_remove_handle(multi_handle, transfer.handle);
+    curl_easy_cleanup(transfer.handle);
+    curl_slist_free_all(transfer.list);
+    free(transfer.chunk.memory);
+  }
+  curl_multi_cleanup(multi_handle);
+  LOG(INFO) << "Prefetched " << nPrefetched << " out of " << paths.size() << " CCDB objects";
+  return nPrefetched;
+}
+
 size_t CurlWrite_CallbackFunc_StdString2(void* contents, size_t size, size_t nmemb, std::string* s)
 {
   size_t newLength = size * nmemb;
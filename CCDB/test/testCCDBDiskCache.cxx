@@ -0,0 +1,281 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testCCDBDiskCache.cxx
+/// \brief  Test the prefetching and the disk cache of the CcdbApi against a local HTTP server
+///
+
+#define BOOST_TEST_MODULE CCDB
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include "CCDB/CcdbApi.h"
+#include "CCDB/CCDBDiskCache.h"
+#include <boost/test/unit_test.hpp>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+using namespace o2::ccdb;
+namespace fs = std::filesystem;
+
+/// Minimal HTTP server standing in for the CCDB. It serves an image of a std::string for each
+/// path and validity interval with the headers of the CCDB and honours If-None-Match.
+class LocalCCDBServer
+{
+ public:
+  LocalCCDBServer()
+  {
+    mSocket = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    socklen_t len = sizeof(addr);
+    if (bind(mSocket, (sockaddr*)&addr, len) != 0 || listen(mSocket, 64) != 0 || getsockname(mSocket, (sockaddr*)&addr, &len) != 0) {
+      throw std::runtime_error("cannot start local HTTP server");
+    }
+    mPort = ntohs(addr.sin_port);
+    mThread = std::thread([this]() { loop(); });
+  }
+
+  ~LocalCCDBServer()
+  {
+    mStop = true;
+    shutdown(mSocket, SHUT_RDWR);
+    mThread.join();
+    close(mSocket);
+  }
+
+  std::string getURL() const { return "http://127.0.0.1:" + std::to_string(mPort); }
+
+  void setObject(std::string const& path, std::string const& value, std::string const& etag, long from, long until)
+  {
+    auto image = CcdbApi::createObjectImage(&value);
+    std::lock_guard<std::mutex> lock(mMutex);
+    mObjects[path] = Object{std::string(image->begin(), image->end()), '"' + etag + '"', from, until};
+  }
+
+  int getNRequests() const { return mNRequests; }
+  int getNDownloads() const { return mNDownloads; }
+
+ private:
+  struct Object {
+    std::string image;
+    std::string etag;
+    long from = 0;
+    long until = 0;
+  };
+
+  void loop()
+  {
+    while (!mStop) {
+      int fd = accept(mSocket, nullptr, nullptr);
+      if (fd < 0) {
+        continue;
+      }
+      handle(fd);
+      close(fd);
+    }
+  }
+
+  void handle(int fd)
+  {
+    std::string request;
+    char buffer[4096];
+    while (request.find("\r\n\r\n") == std::string::npos) {
+      auto n = recv(fd, buffer, sizeof(buffer), 0);
+      if (n <= 0) {
+        return;
+      }
+      request.append(buffer, n);
+    }
+    mNRequests++;
+    // GET /<path>/<timestamp>/ HTTP/1.1
+    auto url = request.substr(4, request.find(' ', 4) - 4);
+    std::string ifNoneMatch;
+    auto pos = request.find("If-None-Match: ");
+    if (pos != std::string::npos) {
+      pos += strlen("If-None-Match: ");
+      ifNoneMatch = request.substr(pos, request.find("\r\n", pos) - pos);
+    }
+    std::string reply = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (auto const& [path, object] : mObjects) {
+      auto prefix = '/' + path + '/';
+      if (url.find(prefix) != 0) {
+        continue;
+      }
+      auto timestamp = std::stol(url.substr(prefix.size()));
+      if (timestamp < object.from || timestamp >= object.until) {
+        continue;
+      }
+      std::string headers = "ETag: " + object.etag + "\r\nValid-From: " + std::to_string(object.from) +
+                            "\r\nValid-Until: " + std::to_string(object.until) + "\r\nConnection: close\r\n";
+      if (ifNoneMatch == object.etag) {
+        reply = "HTTP/1.1 304 Not Modified\r\n" + headers + "\r\n";
+      } else {
+        mNDownloads++;
+        reply = "HTTP/1.1 200 OK\r\n" + headers + "Content-Length: " + std::to_string(object.image.size()) + "\r\n\r\n" + object.image;
+      }
+    }
+    send(fd, reply.data(), reply.size(), MSG_NOSIGNAL);
+  }
+
+  int mSocket = -1;
+  int mPort = 0;
+  std::atomic<bool> mStop{false};
+  std::atomic<int> mNRequests{0};
+  std::atomic<int> mNDownloads{0};
+  std::thread mThread;
+  std::mutex mMutex;
+  std::map<std::string, Object> mObjects;
+};
+
+struct CacheDirectory {
+  fs::path path = fs::temp_directory_path() / ("testCCDBDiskCache_" + std::to_string(getpid()));
+  CacheDirectory() { fs::remove_all(path); }
+  ~CacheDirectory() { fs::remove_all(path); }
+};
+
+BOOST_AUTO_TEST_CASE(TestDiskCache)
+{
+  CacheDirectory dir;
+  CCDBDiskCache cache(dir.path.string());
+  std::map<std::string, std::string> md, otherMD{{"key", "value"}};
+  CCDBBlob blob{{'a', 'b', 'c'}, {{"ETag", "\"1\""}, {"Valid-From", "1000"}, {"Valid-Until", "2000"}}};
+  BOOST_CHECK(cache.store("Test/A", md, blob));
+
+  CCDBBlob found;
+  BOOST_CHECK(cache.find("Test/A", md, 1500, found));
+  BOOST_CHECK(found.data == blob.data);
+  BOOST_CHECK(found.getETag() == "\"1\"");
+  BOOST_CHECK(!cache.find("Test/A", md, 2000, found));
+  BOOST_CHECK(!cache.find("Test/A", otherMD, 1500, found));
+  BOOST_CHECK(!cache.find("Test/B", md, 1500, found));
+
+  // no validity, no caching
+  BOOST_CHECK(!cache.store("Test/B", md, CCDBBlob{{'a'}, {{"ETag", "\"2\""}}}));
+
+  // concurrent writers of the same object, as processes sharing the cache would do
+  std::vector<std::thread> writers;
+  std::atomic<int> nBadReads{0};
+  CCDBBlob blobC{std::vector<char>(1 << 20, 'c'), {{"ETag", "\"3\""}, {"Valid-From", "0"}, {"Valid-Until", "5000"}}};
+  for (int i = 0; i < 8; i++) {
+    writers.emplace_back([&]() {
+      CCDBBlob read;
+      for (int j = 0; j < 10; j++) {
+        cache.store("Test/C", md, blobC);
+        // a reader sees either nothing or the complete object
+        if (cache.find("Test/C", md, 100, read) && read.data != blobC.data) {
+          nBadReads++;
+        }
+      }
+    });
+  }
+  for (auto& w : writers) {
+    w.join();
+  }
+  BOOST_CHECK_EQUAL(nBadReads.load(), 0);
+  int nFiles = 0;
+  for (auto& entry : fs::recursive_directory_iterator(dir.path / "Test/C")) {
+    nFiles += entry.is_regular_file();
+  }
+  BOOST_CHECK_EQUAL(nFiles, 1); // no leftover of the temporary files
+
+  // a corrupted file is ignored
+  for (auto& entry : fs::recursive_directory_iterator(dir.path / "Test/A")) {
+    if (entry.is_regular_file()) {
+      fs::resize_file(entry.path(), 10);
+    }
+  }
+  BOOST_CHECK(!cache.find("Test/A", md, 1500, found));
+}
+
+BOOST_AUTO_TEST_CASE(TestPrefetch)
+{
+  LocalCCDBServer server;
+  server.setObject("Test/A", "objectA", "a1", 1000, 2000);
+  server.setObject("Test/B", "objectB", "b1", 1000, 2000);
+  server.setObject("Test/C", "objectC", "c1", 1000, 2000);
+
+  CcdbApi api;
+  api.init(server.getURL());
+  std::map<std::string, std::string> md;
+  BOOST_CHECK_EQUAL(api.prefetch({"Test/A", "Test/B", "Test/C", "Test/Missing"}, md, 1500), 3);
+  BOOST_CHECK_EQUAL(server.getNRequests(), 4);
+
+  // served w/o querying the server, at any timestamp within the validity
+  std::map<std::string, std::string> headers;
+  auto* objA = api.retrieveFromTFileAny<std::string>("Test/A", md, 1999, &headers);
+  auto* objB = api.retrieveFromTFileAny<std::string>("Test/B", md, 1000);
+  BOOST_REQUIRE(objA && objB);
+  BOOST_CHECK(*objA == "objectA");
+  BOOST_CHECK(*objB == "objectB");
+  BOOST_CHECK(headers["ETag"] == "\"a1\"");
+  BOOST_CHECK_EQUAL(server.getNRequests(), 4);
+
+  // a prefetched object which is not valid anymore is retrieved from the server
+  auto* objC = api.retrieveFromTFileAny<std::string>("Test/C", md, 2500);
+  BOOST_CHECK(objC == nullptr);
+  BOOST_CHECK_EQUAL(server.getNRequests(), 5);
+  delete objA;
+  delete objB;
+}
+
+BOOST_AUTO_TEST_CASE(TestRetrieveWithDiskCache)
+{
+  CacheDirectory dir;
+  LocalCCDBServer server;
+  server.setObject("Test/A", "objectA", "a1", 1000, 2000);
+  std::map<std::string, std::string> md;
+
+  CcdbApi api1;
+  api1.init(server.getURL());
+  api1.setDiskCacheDir(dir.path.string());
+  std::unique_ptr<std::string> obj(api1.retrieveFromTFileAny<std::string>("Test/A", md, 1500));
+  BOOST_REQUIRE(obj);
+  BOOST_CHECK(*obj == "objectA");
+  BOOST_CHECK_EQUAL(server.getNDownloads(), 1);
+
+  // another process sharing the cache only validates the object with the server
+  CcdbApi api2;
+  api2.init(server.getURL());
+  api2.setDiskCacheDir(dir.path.string());
+  std::map<std::string, std::string> headers;
+  obj.reset(api2.retrieveFromTFileAny<std::string>("Test/A", md, 1600, &headers));
+  BOOST_REQUIRE(obj);
+  BOOST_CHECK(*obj == "objectA");
+  BOOST_CHECK(headers["Valid-Until"] == "2000");
+  BOOST_CHECK_EQUAL(server.getNRequests(), 2);
+  BOOST_CHECK_EQUAL(server.getNDownloads(), 1);
+
+  // so does the prefetching
+  BOOST_CHECK_EQUAL(api2.prefetch({"Test/A"}, md, 1700), 1);
+  BOOST_CHECK_EQUAL(server.getNDownloads(), 1);
+
+  // a new version of the object is downloaded
+  server.setObject("Test/A", "objectA2", "a2", 1000, 2000);
+  obj.reset(api2.retrieveFromTFileAny<std::string>("Test/A", md, 1500)); // the prefetched version is served once
+  BOOST_REQUIRE(obj);
+  BOOST_CHECK(*obj == "objectA");
+  obj.reset(api2.retrieveFromTFileAny<std::string>("Test/A", md, 1500));
+  BOOST_REQUIRE(obj);
+  BOOST_CHECK(*obj == "objectA2");
+  BOOST_CHECK_EQUAL(server.getNDownloads(), 2);
+}
@@ -0,0 +1,130 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file CTFFlatFile.h
+/// \brief Flat container of CTFs which can be memory-mapped and used in place
+
+///  Layout of the file: Header | TF_0 data | ... | TF_n-1 data | index of n TFEntry records.
+///  The data of a TF are the flat EncodedBlocks images of its detectors, each aligned to o2::ctf::Alignment,
+///  as they were received by the writer. A reader maps the file and passes the images to the decoders, which
+///  relocate them with EncodedBlocks::getImage, w/o any deserialization or copy.
+
+#ifndef ALICEO2_CTF_FLAT_FILE_H
+#define ALICEO2_CTF_FLAT_FILE_H
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "DetectorsCommonDataFormats/DetID.h"
+#include "DetectorsCommonDataFormats/CTFHeader.h"
+
+namespace o2
+{
+namespace ctf
+{
+
+struct CTFFlatFileHeader {
+  static constexpr uint64_t MagicWord = 0x4c46465443324fULL; // "O2CTFFL"
+  static constexpr uint32_t CurrentVersion = 1;
+
+  uint64_t magic = MagicWord;
+  uint32_t version = CurrentVersion;
+  uint32_t nTFs = 0;        // number of TFs in the index
+  uint64_t indexOffset = 0; // position of the TF index, 0 if the file was not closed properly
+};
+
+struct CTFFlatTFEntry {
+  uint64_t run = 0;
+  uint32_t firstTForbit = 0;
+  uint32_t detectors = 0;                                        // mask of represented detectors
+  std::array<uint64_t, o2::detectors::DetID::nDetectors> offset{}; // position of the detector EncodedBlocks image
+  std::array<uint64_t, o2::detectors::DetID::nDetectors> size{};   // its size in bytes
+
+  CTFHeader getCTFHeader() const { return CTFHeader{run, firstTForbit, o2::detectors::DetID::mask_t(detectors)}; }
+};
+
+class CTFFlatFileWriter
+{
+ public:
+  CTFFlatFileWriter() = default;
+  ~CTFFlatFileWriter();
+
+  void open(const std::string& fileName);
+  /// write the index and close the file
+  void close();
+  bool isOpen() const { return mFile.is_open(); }
+  const std::string& getFileName() const { return mFileName; }
+
+  /// add flat EncodedBlocks image of the detector to the current TF, returns number of bytes written
+  size_t addDetector(o2::detectors::DetID det, const void* data, size_t size);
+  /// close current TF, returns the size of its index record
+  size_t endTF(const CTFHeader& header);
+
+  uint32_t getNTFs() const { return mIndex.size(); }
+  size_t getFileSize() const { return mPosition; }
+
+ private:
+  size_t write(const void* data, size_t size);
+  size_t pad();
+
+  std::string mFileName{};
+  std::ofstream mFile;
+  size_t mPosition = 0;
+  CTFFlatTFEntry mCurrentTF{};
+  std::vector<CTFFlatTFEntry> mIndex;
+};
+
+class CTFFlatFileReader
+{
+ public:
+  /// read-only mapping of the whole file, unmapped when the last owner is gone
+  struct Mapping {
+    const char* data = nullptr;
+    size_t size = 0;
+    Mapping(const char* d, size_t s) : data(d), size(s) {}
+    Mapping(const Mapping&) = delete;
+    Mapping& operator=(const Mapping&) = delete;
+    ~Mapping();
+  };
+  using MappingPtr = std::shared_ptr<const Mapping>;
+
+  /// check if the file starts with the flat CTF file magic word
+  static bool isFlatFile(const std::string& fileName);
+
+  void open(const std::string& fileName);
+  void close();
+  bool isOpen() const { return bool(mMapping); }
+  const std::string& getFileName() const { return mFileName; }
+
+  uint32_t getNTFs() const { return mHeader.nTFs; }
+  CTFHeader getCTFHeader(uint32_t tf) const { return getTFEntry(tf).getCTFHeader(); }
+  const CTFFlatTFEntry& getTFEntry(uint32_t tf) const;
+
+  /// pointer on the EncodedBlocks image of the detector in the mapped file and its size in bytes
+  std::pair<const char*, size_t> getDetectorBuffer(uint32_t tf, o2::detectors::DetID det) const;
+
+  /// mapping to be held by the users of the detector buffers which may outlive the reader
+  const MappingPtr& getMapping() const { return mMapping; }
+
+ private:
+  std::string mFileName{};
+  MappingPtr mMapping;
+  CTFFlatFileHeader mHeader{};
+  const CTFFlatTFEntry* mIndex = nullptr;
+};
+
+} // namespace ctf
+} // namespace o2
+
+#endif
@@ -0,0 +1,188 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file CoderCache.h
+/// \brief Cache of entropy encoders/decoders built from the dictionaries met in the data
+
+///  Building the rANS coder tables costs O(alphabet range + 2^probabilityBits), which dominates the
+///  encoding/decoding of small TFs. Blocks with identical statistics (e.g. constant or sparse columns)
+///  are very frequent, so the coders are cached by their dictionary and reused across TFs.
+
+#ifndef ALICEO2_CTF_CODER_CACHE_H
+#define ALICEO2_CTF_CODER_CACHE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+#include "Framework/Logger.h"
+
+namespace o2
+{
+namespace ctf
+{
+
+class CoderCache
+{
+ public:
+  static constexpr size_t DefaultCapacity = 64;
+
+  CoderCache(size_t capacity = DefaultCapacity) : mCapacity(capacity) {}
+
+  /// get coder of type C for the dictionary (frequencies of symbols min...max) and precision, create it with builder() if absent
+  template <typename C, typename W, typename B>
+  std::shared_ptr<const C> getCoder(const W* dict, size_t nDict, int32_t min, int32_t max, uint8_t probabilityBits, B&& builder);
+
+  /// max number of cached coders, 0 disables the cache
+  void setCapacity(size_t n);
+  size_t getCapacity() const { return mCapacity; }
+
+  size_t size() const
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mEntries.size();
+  }
+
+  size_t getNHits() const { return mNHits; }
+  size_t getNMisses() const { return mNMisses; }
+  void resetStat() { mNHits = mNMisses = 0; }
+
+  void clear()
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mEntries.clear();
+    mLookup.clear();
+  }
+
+  void print(const std::string& prefix = "") const
+  {
+    LOG(INFO) << prefix << "coder cache of capacity " << mCapacity << " holds " << size() << " coders, hits: " << mNHits << " misses: " << mNMisses;
+  }
+
+ private:
+  struct Entry {
+    size_t hash = 0;
+    size_t coderType = 0;
+    int32_t min = 0;
+    int32_t max = 0;
+    uint8_t probabilityBits = 0;
+    std::vector<uint32_t> dict;
+    std::shared_ptr<const void> coder;
+
+    template <typename W>
+    bool matches(size_t _hash, size_t _coderType, const W* _dict, size_t _nDict, int32_t _min, int32_t _max, uint8_t _probabilityBits) const
+    {
+      return hash == _hash && coderType == _coderType && min == _min && max == _max && probabilityBits == _probabilityBits &&
+             dict.size() == _nDict && std::equal(dict.begin(), dict.end(), _dict);
+    }
+  };
+  using EntryList = std::list<Entry>; // in order of last usage, most recent first
+
+  /// drop least recently used coders exceeding the capacity, to be called with locked mutex
+  void shrink();
+
+  template <typename W>
+  static size_t hashDictionary(const W* dict, size_t nDict, int32_t min, int32_t max, uint8_t probabilityBits, size_t coderType);
+
+  std::atomic<size_t> mCapacity{DefaultCapacity};
+  std::atomic<size_t> mNHits{0};
+  std::atomic<size_t> mNMisses{0};
+  mutable std::mutex mMutex;
+  EntryList mEntries;
+  std::unordered_multimap<size_t, EntryList::iterator> mLookup;
+};
+
+///_____________________________________________________________________________
+template <typename W>
+inline size_t CoderCache::hashDictionary(const W* dict, size_t nDict, int32_t min, int32_t max, uint8_t probabilityBits, size_t coderType)
+{
+  // FNV-1a over the dictionary words followed by the metadata
+  uint64_t h = 0xcbf29ce484222325ULL;
+  auto add = [&h](uint64_t v) {
+    h ^= v;
+    h *= 0x100000001b3ULL;
+  };
+  for (size_t i = 0; i < nDict; i++) {
+    add(dict[i]);
+  }
+  add(uint32_t(min));
+  add(uint32_t(max));
+  add(probabilityBits);
+  add(coderType);
+  return h;
+}
+
+///_____________________________________________________________________________
+template <typename C, typename W, typename B>
+std::shared_ptr<const C> CoderCache::getCoder(const W* dict, size_t nDict, int32_t min, int32_t max, uint8_t probabilityBits, B&& builder)
+{
+  static_assert(sizeof(W) <= sizeof(uint32_t), "dictionary words must fit to 32 bits");
+  if (!mCapacity) {
+    mNMisses++;
+    return std::shared_ptr<const C>(builder());
+  }
+  const size_t coderType = typeid(C).hash_code();
+  const size_t hash = hashDictionary(dict, nDict, min, max, probabilityBits, coderType);
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto range = mLookup.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second->matches(hash, coderType, dict, nDict, min, max, probabilityBits)) {
+        mEntries.splice(mEntries.begin(), mEntries, it->second);
+        mNHits++;
+        return std::static_pointer_cast<const C>(it->second->coder);
+      }
+    }
+  }
+  // build outside of the lock, other threads may build different coders meanwhile
+  mNMisses++;
+  std::shared_ptr<const C> coder(builder());
+  std::lock_guard<std::mutex> lock(mMutex);
+  mEntries.push_front(Entry{hash, coderType, min, max, probabilityBits, std::vector<uint32_t>(dict, dict + nDict), coder});
+  mLookup.emplace(hash, mEntries.begin());
+  shrink();
+  return coder;
+}
+
+///_____________________________________________________________________________
+inline void CoderCache::setCapacity(size_t n)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mCapacity = n;
+  shrink();
+}
+
+///_____________________________________________________________________________
+inline void CoderCache::shrink()
+{
+  while (mEntries.size() > mCapacity) { // evict the least recently used coders
+    auto last = std::prev(mEntries.end());
+    auto range = mLookup.equal_range(last->hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second == last) {
+        mLookup.erase(it);
+        break;
+      }
+    }
+    mEntries.erase(last);
+  }
+}
+
+} // namespace ctf
+} // namespace o2
+
+#endif
@@ -17,12 +17,16 @@
 #define ALICEO2_ENCODED_BLOCKS_H
 
 #include <type_traits>
+#include <algorithm>
+#include <functional>
+#include <exception>
 #include <Rtypes.h>
 #include "rANS/rans.h"
 #include "rANS/utils.h"
 #include "TTree.h"
 #include "CommonUtils/StringUtils.h"
 #include "Framework/Logger.h"
+#include "DetectorsCommonDataFormats/CoderCache.h"
 
 namespace o2
 {
@@ -53,6 +57,15 @@ constexpr size_t Alignment = 16;
 constexpr int WrappersSplitLevel = 99;
 constexpr int WrappersCompressionLevel = 1;
 
+/// number of interleaved rANS states used by default, this is the layout of the classic 2-way interleaved coder
+constexpr uint8_t DefaultNStreams = 2;
+
+/// check if the number of interleaved rANS states is supported by the entropy coder
+inline constexpr bool isSupportedNStreams(int nStreams)
+{
+  return nStreams == 2 || nStreams == 4 || nStreams == 8 || nStreams == 16;
+}
+
 /// This is the type of the vector to be used for the EncodedBlocks buffer allocation
 using BufferType = uint8_t; // to avoid every detector using different types, we better define it here
 
@@ -63,6 +76,13 @@ inline size_t alignSize(size_t sizeBytes)
   return res ? sizeBytes + (Alignment - res) : sizeBytes;
 }
 
+/// execute n independent tasks f(i), concurrently on nThreads threads if the library is compiled with OpenMP.
+/// The 1st exception thrown by any of the tasks is rethrown once all of them are finished
+void forEachConcurrently(size_t n, const std::function<void(size_t)>& f, int nThreads = 1);
+
+/// true if forEachConcurrently can run the tasks concurrently, i.e. the library is compiled with OpenMP
+bool isConcurrencyEnabled();
+
 /// relocate pointer by the difference of addresses
 template <class T>
 inline T* relocatePointer(const char* oldBase, char* newBase, const T* ptr)
@@ -98,6 +118,7 @@ struct Metadata {
   int nDictWords = 0;
   int nDataWords = 0;
   int nLiteralWords = 0;
+  uint8_t nStreams = DefaultNStreams; // number of interleaved rANS states used for entropy encoding
 
   void clear()
   {
@@ -110,8 +131,9 @@ struct Metadata {
     nDictWords = 0;
     nDataWords = 0;
     nLiteralWords = 0;
+    nStreams = DefaultNStreams;
   }
-  ClassDefNV(Metadata, 1);
+  ClassDefNV(Metadata, 2);
 };
 
 /// registry struct for the buffer start and offsets of writable space
@@ -291,6 +313,29 @@ struct Block {
     realignBlock();
   }
 
+  /// store dictionary and data provided as a single contiguous array followed by the literals. The dictionary+data array
+  /// may overlap with the destination, which is the case when compactifying blocks encoded directly in the flat buffer
+  void storeMoved(int _ndict, int _ndata, int _nliterals, const W* _dictData, const W* _literals)
+  {
+    size_t sz = estimateSize(_ndict + _ndata + _nliterals);
+    assert(registry); // this method is valid only for flat version, which has a registry
+    assert(sz <= registry->getFreeSize());
+    setNDict(_ndict);
+    setNData(_ndata);
+    setNLiterals(_nliterals);
+    getCreatePayload(); // do this even for empty block!!!
+    if (getNStored()) {
+      payload = reinterpret_cast<W*>(registry->getFreeBlockStart());
+      if (getNDict() + getNData()) {
+        memmove(payload, _dictData, (_ndict + _ndata) * sizeof(W));
+      }
+      if (getNLiterals()) {
+        memcpy(getCreateLiterals(), _literals, _nliterals * sizeof(W));
+      }
+    }
+    realignBlock();
+  }
+
   /// relocate to different head position
   void relocate(const char* oldHead, char* newHeadData, char* newHeadRegistry)
   {
@@ -301,6 +346,19 @@ struct Block {
   ClassDefNV(Block, 1);
 }; // namespace ctf
 
+/// deferred encoding of a single slot, allows to encode all slots of the container concurrently (see EncodedBlocks::encodeSlots)
+template <typename W = uint32_t>
+struct SlotEncoding {
+  int slot = -1;
+  Metadata md;             // metadata of the encoded block, set by encodeTo
+  int nDict = 0;           // number of dictionary words written by encodeTo
+  int nData = 0;           // number of data words written by encodeTo
+  std::vector<W> literals; // incompressible symbols repacked to W words, set by encodeTo
+
+  std::function<size_t()> prepare;                 // build statistics and encoder, return upper bound on the number of dict + data words
+  std::function<void(SlotEncoding&, W*)> encodeTo; // write dictionary followed by the encoded data to provided memory
+};
+
 ///<<======================== Auxiliary classes =======================<<
 
 template <typename H, int N, typename W = uint32_t>
@@ -308,6 +366,7 @@ class EncodedBlocks
 {
  public:
   typedef EncodedBlocks<H, N, W> base;
+  typedef SlotEncoding<W> slotEncoding;
 
   void setHeader(const H& h) { mHeader = h; }
   const H& getHeader() const { return mHeader; }
@@ -392,24 +451,35 @@ class EncodedBlocks
   template <typename VD>
   static void readFromTree(VD& vec, TTree& tree, const std::string& name, int ev = 0);
 
-  /// encode vector src to bloc at provided slot
+  /// encode vector src to bloc at provided slot, using nStreams interleaved rANS states.
+  /// If no external encoder is provided, the encoder for the message statistics is taken from the cache (if any)
   template <typename VE, typename VB>
-  inline void encode(const VE& src, int slot, uint8_t probabilityBits, Metadata::OptStore opt, VB* buffer = nullptr, const void* encoderExt = nullptr)
+  inline void encode(const VE& src, int slot, uint8_t probabilityBits, Metadata::OptStore opt, VB* buffer = nullptr, const void* encoderExt = nullptr, uint8_t nStreams = DefaultNStreams, CoderCache* cache = nullptr)
   {
-    encode(std::begin(src), std::end(src), slot, probabilityBits, opt, buffer, encoderExt);
+    encode(std::begin(src), std::end(src), slot, probabilityBits, opt, buffer, encoderExt, nStreams, cache);
   }
 
-  /// encode vector src to bloc at provided slot
+  /// encode vector src to bloc at provided slot, using nStreams interleaved rANS states
   template <typename S_IT, typename VB>
-  void encode(const S_IT srcBegin, const S_IT srcEnd, int slot, uint8_t probabilityBits, Metadata::OptStore opt, VB* buffer = nullptr, const void* encoderExt = nullptr);
+  void encode(const S_IT srcBegin, const S_IT srcEnd, int slot, uint8_t probabilityBits, Metadata::OptStore opt, VB* buffer = nullptr, const void* encoderExt = nullptr, uint8_t nStreams = DefaultNStreams, CoderCache* cache = nullptr);
+
+  /// create deferred encoding of the src message for the provided slot, to be executed by encodeSlots
+  template <typename S_IT>
+  static SlotEncoding<W> makeSlotEncoding(const S_IT srcBegin, const S_IT srcEnd, int slot, uint8_t probabilityBits, Metadata::OptStore opt, const void* encoderExt = nullptr, uint8_t nStreams = DefaultNStreams, CoderCache* cache = nullptr);
 
-  /// decode block at provided slot to destination vector (will be resized as needed)
+  /// encode the slots (must be consecutive, starting from the 1st unfilled one) concurrently on nThreads threads.
+  /// The blocks are encoded directly at pre-computed offsets of the buffer, which is expanded at most twice
+  template <typename VB>
+  static void encodeSlots(VB& buffer, std::vector<SlotEncoding<W>>& slots, int nThreads = 1);
+
+  /// decode block at provided slot to destination vector (will be resized as needed).
+  /// The decoder for the dictionary stored in the block is taken from the cache (if any)
   template <class container_T, class container_IT = typename container_T::iterator>
-  void decode(container_T& dest, int slot, const void* decoderExt = nullptr) const;
+  void decode(container_T& dest, int slot, const void* decoderExt = nullptr, CoderCache* cache = nullptr) const;
 
   /// decode block at provided slot to destination pointer, the needed space assumed to be available
   template <typename D_IT, std::enable_if_t<detail::is_iterator_v<D_IT>, bool> = true>
-  void decode(D_IT dest, int slot, const void* decoderExt = nullptr) const;
+  void decode(D_IT dest, int slot, const void* decoderExt = nullptr, CoderCache* cache = nullptr) const;
 
   /// create a special EncodedBlocks containing only dictionaries made from provided vector of frequency tables
   static std::vector<char> createDictionaryBlocks(const std::vector<o2::rans::FrequencyTable>& vfreq, const std::vector<Metadata>& prbits);
@@ -445,6 +515,10 @@ class EncodedBlocks
   /// Create its own flat copy in the destination empty flat object
   void fillFlatCopy(EncodedBlocks& dest) const;
 
+  /// create encoder for the frequency table or get it from the cache (if any)
+  template <typename STYP>
+  static std::shared_ptr<const o2::rans::LiteralEncoder64<STYP>> createEncoder(const o2::rans::FrequencyTable& frequencies, uint8_t probabilityBits, CoderCache* cache);
+
   /// add and fill single branch
   template <typename D>
   static size_t fillTreeBranch(TTree& tree, const std::string& brname, D& dt, int compLevel, int splitLevel = 99);
@@ -526,6 +600,19 @@ inline size_t EncodedBlocks<H, N, W>::fillTreeBranch(TTree& tree, const std::str
   return br->Fill();
 }
 
+///_____________________________________________________________________________
+/// create encoder for the frequency table or get it from the cache (if any)
+template <typename H, int N, typename W>
+template <typename STYP>
+std::shared_ptr<const o2::rans::LiteralEncoder64<STYP>> EncodedBlocks<H, N, W>::createEncoder(const o2::rans::FrequencyTable& frequencies, uint8_t probabilityBits, CoderCache* cache)
+{
+  auto buildEncoder = [&frequencies, probabilityBits]() { return new o2::rans::LiteralEncoder64<STYP>(frequencies, probabilityBits); };
+  if (cache) {
+    return cache->getCoder<o2::rans::LiteralEncoder64<STYP>>(frequencies.data(), frequencies.size(), frequencies.getMinSymbol(), frequencies.getMaxSymbol(), probabilityBits, buildEncoder);
+  }
+  return std::shared_ptr<const o2::rans::LiteralEncoder64<STYP>>(buildEncoder());
+}
+
 ///_____________________________________________________________________________
 /// Create its own flat copy in the destination empty flat object
 template <typename H, int N, typename W>
@@ -685,27 +772,29 @@ void EncodedBlocks<H, N, W>::print(const std::string& prefix) const
   for (int i = 0; i < N; i++) {
     LOG(INFO) << "Block " << i << " for " << mMetadata[i].messageLength << " message words |"
               << " NDictWords: " << mBlocks[i].getNDict() << " NDataWords: " << mBlocks[i].getNData()
-              << " NLiteralWords: " << mBlocks[i].getNLiterals();
+              << " NLiteralWords: " << mBlocks[i].getNLiterals() << " NStreams: " << int(mMetadata[i].nStreams);
   }
 }
 
 ///_____________________________________________________________________________
 template <typename H, int N, typename W>
 template <class container_T, class container_IT>
-inline void EncodedBlocks<H, N, W>::decode(container_T& dest,            // destination container
-                                           int slot,                     // slot of the block to decode
-                                           const void* decoderExt) const // optional externally provided decoder
+inline void EncodedBlocks<H, N, W>::decode(container_T& dest,       // destination container
+                                           int slot,                // slot of the block to decode
+                                           const void* decoderExt,  // optional externally provided decoder
+                                           CoderCache* cache) const // optional cache of decoders
 {
   dest.resize(mMetadata[slot].messageLength); // allocate output buffer
-  decode(std::begin(dest), slot, decoderExt);
+  decode(std::begin(dest), slot, decoderExt, cache);
 }
 
 ///_____________________________________________________________________________
 template <typename H, int N, typename W>
 template <typename D_IT, std::enable_if_t<detail::is_iterator_v<D_IT>, bool>>
-void EncodedBlocks<H, N, W>::decode(D_IT dest,                    // iterator to destination
-                                    int slot,                     // slot of the block to decode
-                                    const void* decoderExt) const // optional externally provided decoder
+void EncodedBlocks<H, N, W>::decode(D_IT dest,                // iterator to destination
+                                    int slot,                // slot of the block to decode
+                                    const void* decoderExt,  // optional externally provided decoder
+                                    CoderCache* cache) const // optional cache of decoders
 {
   // get references to the right data
   const auto& block = mBlocks[slot];
@@ -721,11 +810,18 @@ void EncodedBlocks<H, N, W>::decode(D_IT dest,                    // iterator to
         throw std::runtime_error("Dictionary is not saved and no external decoder provided");
       }
       const o2::rans::LiteralDecoder64<dest_t>* decoder = reinterpret_cast<const o2::rans::LiteralDecoder64<dest_t>*>(decoderExt);
-      std::unique_ptr<o2::rans::LiteralDecoder64<dest_t>> decoderLoc;
+      std::shared_ptr<const o2::rans::LiteralDecoder64<dest_t>> decoderLoc;
       if (block.getNDict()) { // if dictionaty is saved, prefer it
-        o2::rans::FrequencyTable frequencies;
-        frequencies.addFrequencies(block.getDict(), block.getDict() + block.getNDict(), md.min, md.max);
-        decoderLoc = std::make_unique<o2::rans::LiteralDecoder64<dest_t>>(frequencies, md.probabilityBits);
+        auto buildDecoder = [&block, &md]() {
+          o2::rans::FrequencyTable frequencies;
+          frequencies.addFrequencies(block.getDict(), block.getDict() + block.getNDict(), md.min, md.max);
+          return new o2::rans::LiteralDecoder64<dest_t>(frequencies, md.probabilityBits);
+        };
+        if (cache) {
+          decoderLoc = cache->getCoder<o2::rans::LiteralDecoder64<dest_t>>(block.getDict(), block.getNDict(), md.min, md.max, md.probabilityBits, buildDecoder);
+        } else {
+          decoderLoc.reset(buildDecoder());
+        }
         decoder = decoderLoc.get();
       } else { // verify that decoded corresponds to stored metadata
         if (md.min != decoder->getMinSymbol() || md.max != decoder->getMaxSymbol()) {
@@ -742,11 +838,28 @@ void EncodedBlocks<H, N, W>::decode(D_IT dest,                    // iterator to
         // to D-word array
         literals = std::vector<dest_t>{reinterpret_cast<const dest_t*>(block.getLiterals()), reinterpret_cast<const dest_t*>(block.getLiterals()) + md.nLiterals};
       }
-      decoder->process(block.getData() + block.getNData(), dest, md.messageLength, literals);
+      const auto* dataEnd = block.getData() + block.getNData();
+      switch (md.nStreams) {
+        case 2:
+          decoder->template process<2>(dataEnd, dest, md.messageLength, literals);
+          break;
+        case 4:
+          decoder->template process<4>(dataEnd, dest, md.messageLength, literals);
+          break;
+        case 8:
+          decoder->template process<8>(dataEnd, dest, md.messageLength, literals);
+          break;
+        case 16:
+          decoder->template process<16>(dataEnd, dest, md.messageLength, literals);
+          break;
+        default:
+          LOG(ERROR) << "Unsupported number " << int(md.nStreams) << " of interleaved rANS streams for slot " << slot;
+          throw std::runtime_error("Unsupported number of interleaved rANS streams");
+      }
     } else { // data was stored as is
       using destPtr_t = typename std::iterator_traits<D_IT>::pointer;
       destPtr_t srcBegin = reinterpret_cast<destPtr_t>(block.payload);
-      destPtr_t srcEnd = srcBegin + md.messageLength * sizeof(dest_t);
+      destPtr_t srcEnd = srcBegin + md.messageLength;
       std::copy(srcBegin, srcEnd, dest);
       //std::memcpy(dest, block.payload, md.messageLength * sizeof(dest_t));
     }
@@ -762,7 +875,9 @@ void EncodedBlocks<H, N, W>::encode(const S_IT srcBegin,     // iterator begin o
                                     uint8_t probabilityBits, // encoding into
                                     Metadata::OptStore opt,  // option for data compression
                                     VB* buffer,              // optional buffer (vector) providing memory for encoded blocks
-                                    const void* encoderExt)  // optional external encoder
+                                    const void* encoderExt,  // optional external encoder
+                                    uint8_t nStreams,        // number of interleaved rANS states
+                                    CoderCache* cache)       // optional cache of encoders
 {
   // fill a new block
   assert(slot == mRegistry.nFilledBlocks);
@@ -794,7 +909,7 @@ void EncodedBlocks<H, N, W>::encode(const S_IT srcBegin,     // iterator begin o
     if (szNeed >= bl->registry->getFreeSize()) {
       LOG(INFO) << "Slot " << slot << ": free size: " << bl->registry->getFreeSize() << ", need " << szNeed << " for " << nElems << " words";
       if (buffer) {
-        eeb->expand(*buffer, size() + (szNeed - getFreeSize()));
+        eeb->expand(*buffer, eeb->size() + (szNeed - eeb->getFreeSize()));
         meta = &(get(buffer->data())->mMetadata[slot]);
         bl = &(get(buffer->data())->mBlocks[slot]); // in case of resizing this and any this.xxx becomes invalid
       } else {
@@ -805,17 +920,21 @@ void EncodedBlocks<H, N, W>::encode(const S_IT srcBegin,     // iterator begin o
 
   // case 3: message where entropy coding should be applied
   if (opt == Metadata::OptStore::EENCODE) {
+    if (!isSupportedNStreams(nStreams)) {
+      LOG(ERROR) << "Unsupported number " << int(nStreams) << " of interleaved rANS streams requested for slot " << slot;
+      throw std::runtime_error("Unsupported number of interleaved rANS streams");
+    }
     // build symbol statistics
     constexpr size_t SizeEstMarginAbs = 10 * 1024;
     constexpr float SizeEstMarginRel = 1.05;
     const o2::rans::LiteralEncoder64<STYP>* encoder = reinterpret_cast<const o2::rans::LiteralEncoder64<STYP>*>(encoderExt);
-    std::unique_ptr<o2::rans::LiteralEncoder64<STYP>> encoderLoc;
+    std::shared_ptr<const o2::rans::LiteralEncoder64<STYP>> encoderLoc;
     std::unique_ptr<o2::rans::FrequencyTable> frequencies = nullptr;
     int dictSize = 0;
     if (!encoder) { // no external encoder provide, create one on spot
       frequencies = std::make_unique<o2::rans::FrequencyTable>();
       frequencies->addSamples(srcBegin, srcEnd);
-      encoderLoc = std::make_unique<o2::rans::LiteralEncoder64<STYP>>(*frequencies, probabilityBits);
+      encoderLoc = createEncoder<STYP>(*frequencies, probabilityBits, cache);
       encoder = encoderLoc.get();
       dictSize = frequencies->size();
     }
@@ -834,7 +953,21 @@ void EncodedBlocks<H, N, W>::encode(const S_IT srcBegin,     // iterator begin o
     // directly encode source message into block buffer.
     auto blIn = bl->getCreateData();
     auto frSize = bl->registry->getFreeSize(); // note: "this" might be not valid after expandStorage call!!!
-    const auto encodedMessageEnd = encoder->process(srcBegin, srcEnd, blIn, literals);
+    auto encodedMessageEnd = blIn;
+    switch (nStreams) {
+      case 2:
+        encodedMessageEnd = encoder->template process<2>(srcBegin, srcEnd, blIn, literals);
+        break;
+      case 4:
+        encodedMessageEnd = encoder->template process<4>(srcBegin, srcEnd, blIn, literals);
+        break;
+      case 8:
+        encodedMessageEnd = encoder->template process<8>(srcBegin, srcEnd, blIn, literals);
+        break;
+      case 16:
+        encodedMessageEnd = encoder->template process<16>(srcBegin, srcEnd, blIn, literals);
+        break;
+    }
     rans::utils::checkBounds(encodedMessageEnd, blIn + frSize);
     dataSize = encodedMessageEnd - bl->getData();
     bl->setNData(dataSize);
@@ -849,7 +982,7 @@ void EncodedBlocks<H, N, W>::encode(const S_IT srcBegin,     // iterator begin o
       bl->storeLiterals(literalSize, reinterpret_cast<const stream_t*>(literals.data()));
     }
     *meta = Metadata{messageLength, literals.size(), sizeof(uint64_t), sizeof(stream_t), static_cast<uint8_t>(encoder->getSymbolTablePrecision()), opt,
-                     encoder->getMinSymbol(), encoder->getMaxSymbol(), dictSize, dataSize, literalSize};
+                     encoder->getMinSymbol(), encoder->getMaxSymbol(), dictSize, dataSize, literalSize, nStreams};
 
   } else { // store original data w/o EEncoding
     const size_t szb = messageLength * sizeof(STYP);
@@ -865,6 +998,179 @@ void EncodedBlocks<H, N, W>::encode(const S_IT srcBegin,     // iterator begin o
   // resize block if necessary
 }
 
+///_____________________________________________________________________________
+template <typename H, int N, typename W>
+template <typename S_IT>
+SlotEncoding<W> EncodedBlocks<H, N, W>::makeSlotEncoding(const S_IT srcBegin,     // iterator begin of source message
+                                                         const S_IT srcEnd,       // iterator end of source message
+                                                         int slot,                // slot in encoded data to fill
+                                                         uint8_t probabilityBits, // encoding into
+                                                         Metadata::OptStore opt,  // option for data compression
+                                                         const void* encoderExt,  // optional external encoder
+                                                         uint8_t nStreams,        // number of interleaved rANS states
+                                                         CoderCache* cache)       // optional cache of encoders
+{
+  using STYP = typename std::iterator_traits<S_IT>::value_type;
+  using stream_t = typename o2::rans::Encoder64<STYP>::stream_t;
+  static_assert(std::is_same<W, stream_t>());
+
+  if (opt == Metadata::OptStore::EENCODE && !isSupportedNStreams(nStreams)) {
+    LOG(ERROR) << "Unsupported number " << int(nStreams) << " of interleaved rANS streams requested for slot " << slot;
+    throw std::runtime_error("Unsupported number of interleaved rANS streams");
+  }
+
+  // encoder and statistics are shared between the preparation and encoding steps
+  struct EncodingState {
+    const o2::rans::LiteralEncoder64<STYP>* encoder = nullptr;
+    std::shared_ptr<const o2::rans::LiteralEncoder64<STYP>> encoderLoc;
+    std::unique_ptr<o2::rans::FrequencyTable> frequencies;
+    int dictSize = 0;
+    int dataSize = 0; // upper bound, in words
+  };
+  auto state = std::make_shared<EncodingState>();
+  state->encoder = reinterpret_cast<const o2::rans::LiteralEncoder64<STYP>*>(encoderExt);
+  const size_t messageLength = std::distance(srcBegin, srcEnd);
+
+  SlotEncoding<W> enc;
+  enc.slot = slot;
+
+  enc.prepare = [=]() -> size_t {
+    if (messageLength == 0) {
+      return 0;
+    }
+    if (opt == Metadata::OptStore::EENCODE) {
+      constexpr size_t SizeEstMarginAbs = 10 * 1024;
+      constexpr float SizeEstMarginRel = 1.05;
+      if (!state->encoder) { // no external encoder provide, create one on spot
+        state->frequencies = std::make_unique<o2::rans::FrequencyTable>();
+        state->frequencies->addSamples(srcBegin, srcEnd);
+        state->encoderLoc = createEncoder<STYP>(*state->frequencies, probabilityBits, cache);
+        state->encoder = state->encoderLoc.get();
+        state->dictSize = state->frequencies->size();
+      }
+      int dataSize = rans::calculateMaxBufferSize(messageLength, state->encoder->getAlphabetRangeBits(), sizeof(STYP)); // size in bytes
+      state->dataSize = SizeEstMarginAbs + int(SizeEstMarginRel * (dataSize / sizeof(W))) + (sizeof(STYP) < sizeof(W));
+    } else {
+      state->dataSize = (messageLength * sizeof(STYP)) / sizeof(stream_t) + (sizeof(STYP) < sizeof(stream_t));
+    }
+    return state->dictSize + state->dataSize;
+  };
+
+  enc.encodeTo = [=](SlotEncoding<W>& res, W* dest) {
+    // case 1: empty source message
+    if (messageLength == 0) {
+      res.md = Metadata{0, 0, sizeof(uint64_t), sizeof(stream_t), probabilityBits, Metadata::OptStore::NODATA, 0, 0, 0, 0, 0};
+      return;
+    }
+    // case 3: message where entropy coding should be applied
+    if (opt == Metadata::OptStore::EENCODE) {
+      const auto* encoder = state->encoder;
+      if (state->dictSize) {
+        memcpy(dest, state->frequencies->data(), state->dictSize * sizeof(W));
+      }
+      std::vector<STYP> literals;
+      W* blIn = dest + state->dictSize;
+      W* encodedMessageEnd = blIn;
+      switch (nStreams) {
+        case 2:
+          encodedMessageEnd = encoder->template process<2>(srcBegin, srcEnd, blIn, literals);
+          break;
+        case 4:
+          encodedMessageEnd = encoder->template process<4>(srcBegin, srcEnd, blIn, literals);
+          break;
+        case 8:
+          encodedMessageEnd = encoder->template process<8>(srcBegin, srcEnd, blIn, literals);
+          break;
+        case 16:
+          encodedMessageEnd = encoder->template process<16>(srcBegin, srcEnd, blIn, literals);
+          break;
+      }
+      rans::utils::checkBounds(encodedMessageEnd, blIn + state->dataSize);
+      int literalSize = 0;
+      if (literals.size()) {
+        literalSize = (literals.size() * sizeof(STYP)) / sizeof(stream_t) + (sizeof(STYP) < sizeof(stream_t));
+        res.literals.resize(literalSize);
+        memcpy(res.literals.data(), literals.data(), literals.size() * sizeof(STYP));
+      }
+      res.nDict = state->dictSize;
+      res.nData = encodedMessageEnd - blIn;
+      res.md = Metadata{messageLength, literals.size(), sizeof(uint64_t), sizeof(stream_t), static_cast<uint8_t>(encoder->getSymbolTablePrecision()), opt,
+                        encoder->getMinSymbol(), encoder->getMaxSymbol(), res.nDict, res.nData, literalSize, nStreams};
+    } else { // store original data w/o EEncoding
+      dest[state->dataSize - 1] = 0; // the last word may be filled only partially
+      std::copy(srcBegin, srcEnd, reinterpret_cast<STYP*>(dest));
+      res.nData = state->dataSize;
+      res.md = Metadata{messageLength, 0, sizeof(uint64_t), sizeof(stream_t), probabilityBits, opt, 0, 0, 0, res.nData, 0};
+    }
+  };
+  return enc;
+}
+
+///_____________________________________________________________________________
+template <typename H, int N, typename W>
+template <typename VB>
+void EncodedBlocks<H, N, W>::encodeSlots(VB& buffer,                          // buffer (vector) providing memory for encoded blocks
+                                         std::vector<SlotEncoding<W>>& slots, // slots to encode, in increasing order
+                                         int nThreads)                        // number of threads to use
+{
+  const size_t nSlots = slots.size();
+  std::vector<size_t> offsets(nSlots); // offsets (wrt head, in bytes) of the region reserved for every block
+
+  // build statistics and estimate upper bound of every block size
+  std::vector<size_t> bounds(nSlots);
+  auto prepareSlot = [&slots, &bounds](size_t i) { bounds[i] = slots[i].prepare(); };
+  forEachConcurrently(nSlots, prepareSlot, nThreads);
+
+  // reserve space for all blocks at once, so that they can be encoded directly to the buffer
+  auto eeb = get(buffer.data());
+  size_t offs = eeb->mRegistry.offsFreeStart;
+  for (size_t i = 0; i < nSlots; i++) {
+    offsets[i] = offs;
+    offs += alignSize(bounds[i] * sizeof(W));
+  }
+  if (offs > eeb->size()) {
+    eeb = expand(buffer, offs);
+  }
+
+  // encode dictionaries and data, literals are kept aside until the final sizes are known
+  char* head = eeb->mRegistry.head;
+  auto encodeSlot = [&slots, &offsets, head](size_t i) { slots[i].encodeTo(slots[i], reinterpret_cast<W*>(head + offsets[i])); };
+  forEachConcurrently(nSlots, encodeSlot, nThreads);
+
+  // compactify: blocks are moved towards the head and the literals are appended to them
+  size_t sizeFinal = eeb->mRegistry.offsFreeStart;
+  for (const auto& s : slots) {
+    sizeFinal += alignSize((s.nDict + s.nData + s.literals.size()) * sizeof(W));
+  }
+  if (sizeFinal > eeb->size()) {
+    eeb = expand(buffer, sizeFinal);
+    head = eeb->mRegistry.head;
+  }
+  std::vector<std::vector<W>> stash(nSlots); // copies of the blocks whose region would be overwritten before they are moved
+  size_t nextToCheck = 0; // 1st block which was neither moved nor stashed
+  for (size_t i = 0; i < nSlots; i++) {
+    auto& s = slots[i];
+    if (s.slot != eeb->mRegistry.nFilledBlocks) {
+      LOG(ERROR) << "Slot " << s.slot << " is encoded while the next unfilled slot is " << eeb->mRegistry.nFilledBlocks;
+      throw std::runtime_error("slots must be encoded consecutively");
+    }
+    eeb->mRegistry.nFilledBlocks++;
+    eeb->mMetadata[s.slot] = s.md;
+    if (s.md.opt == Metadata::OptStore::NODATA) {
+      continue;
+    }
+    // the literals might overwrite not yet moved blocks
+    size_t blockEnd = eeb->mRegistry.offsFreeStart + alignSize((s.nDict + s.nData + s.literals.size()) * sizeof(W));
+    nextToCheck = std::max(nextToCheck, i + 1);
+    for (; nextToCheck < nSlots && offsets[nextToCheck] < blockEnd; nextToCheck++) {
+      const W* src = reinterpret_cast<const W*>(head + offsets[nextToCheck]);
+      stash[nextToCheck].assign(src, src + slots[nextToCheck].nDict + slots[nextToCheck].nData);
+    }
+    const W* dictData = stash[i].empty() ? reinterpret_cast<const W*>(head + offsets[i]) : stash[i].data();
+    eeb->mBlocks[s.slot].storeMoved(s.nDict, s.nData, s.literals.size(), dictData, s.literals.data());
+  }
+}
+
 /// create a special EncodedBlocks containing only dictionaries made from provided vector of frequency tables
 template <typename H, int N, typename W>
 std::vector<char> EncodedBlocks<H, N, W>::createDictionaryBlocks(const std::vector<o2::rans::FrequencyTable>& vfreq, const std::vector<Metadata>& vmd)
@@ -0,0 +1,208 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "DetectorsCommonDataFormats/CTFFlatFile.h"
+#include "DetectorsCommonDataFormats/EncodedBlocks.h"
+#include "Framework/Logger.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+using namespace o2::ctf;
+using DetID = o2::detectors::DetID;
+
+///_____________________________________________________________________________
+CTFFlatFileWriter::~CTFFlatFileWriter()
+{
+  try {
+    close();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << "Failed to close flat CTF file: " << e.what();
+  }
+}
+
+///_____________________________________________________________________________
+void CTFFlatFileWriter::open(const std::string& fileName)
+{
+  close();
+  mFile.open(fileName, std::ios::binary | std::ios::trunc);
+  if (!mFile.is_open()) {
+    LOG(ERROR) << "Failed to open flat CTF file " << fileName << " for writing";
+    throw std::runtime_error("failed to open flat CTF file");
+  }
+  mFileName = fileName;
+  mPosition = 0;
+  mIndex.clear();
+  mCurrentTF = CTFFlatTFEntry{};
+  CTFFlatFileHeader header{}; // index offset is filled on closing
+  write(&header, sizeof(header));
+  pad();
+}
+
+///_____________________________________________________________________________
+void CTFFlatFileWriter::close()
+{
+  if (!mFile.is_open()) {
+    return;
+  }
+  pad();
+  CTFFlatFileHeader header{};
+  header.nTFs = mIndex.size();
+  header.indexOffset = mPosition;
+  write(mIndex.data(), mIndex.size() * sizeof(CTFFlatTFEntry));
+  mFile.seekp(0);
+  mFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  mFile.close();
+  if (mFile.fail()) {
+    LOG(ERROR) << "Failed to finalize flat CTF file " << mFileName;
+    throw std::runtime_error("failed to finalize flat CTF file");
+  }
+  mIndex.clear();
+}
+
+///_____________________________________________________________________________
+size_t CTFFlatFileWriter::addDetector(DetID det, const void* data, size_t size)
+{
+  if (mCurrentTF.size[det]) {
+    LOG(ERROR) << "Data of " << det.getName() << " were already added to current TF";
+    throw std::runtime_error("detector data added twice to flat CTF");
+  }
+  size_t sz = pad();
+  mCurrentTF.offset[det] = mPosition;
+  mCurrentTF.size[det] = size;
+  mCurrentTF.detectors |= det.getMask().to_ulong();
+  return sz + write(data, size);
+}
+
+///_____________________________________________________________________________
+size_t CTFFlatFileWriter::endTF(const CTFHeader& header)
+{
+  mCurrentTF.run = header.run;
+  mCurrentTF.firstTForbit = header.firstTForbit;
+  mIndex.push_back(mCurrentTF);
+  mCurrentTF = CTFFlatTFEntry{};
+  mFile.flush();
+  return sizeof(CTFFlatTFEntry);
+}
+
+///_____________________________________________________________________________
+size_t CTFFlatFileWriter::write(const void* data, size_t size)
+{
+  mFile.write(reinterpret_cast<const char*>(data), size);
+  if (mFile.fail()) {
+    LOG(ERROR) << "Failed to write " << size << " bytes to flat CTF file " << mFileName;
+    throw std::runtime_error("failed to write flat CTF file");
+  }
+  mPosition += size;
+  return size;
+}
+
+///_____________________________________________________________________________
+size_t CTFFlatFileWriter::pad()
+{
+  static const char zeros[Alignment] = {0};
+  return write(zeros, alignSize(mPosition) - mPosition);
+}
+
+///_____________________________________________________________________________
+CTFFlatFileReader::Mapping::~Mapping()
+{
+  if (data) {
+    munmap(const_cast<char*>(data), size);
+  }
+}
+
+///_____________________________________________________________________________
+bool CTFFlatFileReader::isFlatFile(const std::string& fileName)
+{
+  std::ifstream inp(fileName, std::ios::binary);
+  uint64_t magic = 0;
+  return inp.read(reinterpret_cast<char*>(&magic), sizeof(magic)) && magic == CTFFlatFileHeader::MagicWord;
+}
+
+///_____________________________________________________________________________
+void CTFFlatFileReader::open(const std::string& fileName)
+{
+  close();
+  int fd = ::open(fileName.c_str(), O_RDONLY);
+  struct stat st;
+  if (fd < 0 || fstat(fd, &st) != 0) {
+    if (fd >= 0) {
+      ::close(fd);
+    }
+    LOG(ERROR) << "Failed to open flat CTF file " << fileName << ": " << strerror(errno);
+    throw std::runtime_error("failed to open flat CTF file");
+  }
+  size_t fileSize = st.st_size;
+  void* addr = fileSize >= sizeof(CTFFlatFileHeader) ? mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+  ::close(fd); // the mapping stays valid
+  if (addr == MAP_FAILED) {
+    LOG(ERROR) << "Failed to map flat CTF file " << fileName << " of size " << fileSize;
+    throw std::runtime_error("failed to map flat CTF file");
+  }
+  madvise(addr, fileSize, MADV_SEQUENTIAL);
+  mMapping = std::make_shared<const Mapping>(reinterpret_cast<const char*>(addr), fileSize);
+
+  std::memcpy(&mHeader, mMapping->data, sizeof(mHeader));
+  if (mHeader.magic != CTFFlatFileHeader::MagicWord || mHeader.version != CTFFlatFileHeader::CurrentVersion) {
+    close();
+    LOG(ERROR) << "File " << fileName << " is not a flat CTF file of version " << CTFFlatFileHeader::CurrentVersion;
+    throw std::runtime_error("wrong flat CTF file format");
+  }
+  if (!mHeader.indexOffset || mHeader.indexOffset % Alignment || mHeader.indexOffset + mHeader.nTFs * sizeof(CTFFlatTFEntry) > fileSize) {
+    close();
+    LOG(ERROR) << "Flat CTF file " << fileName << " has no valid TF index, was it closed properly?";
+    throw std::runtime_error("corrupted flat CTF file");
+  }
+  mIndex = reinterpret_cast<const CTFFlatTFEntry*>(mMapping->data + mHeader.indexOffset);
+  for (uint32_t tf = 0; tf < mHeader.nTFs; tf++) {
+    for (int id = DetID::First; id <= DetID::Last; id++) {
+      const auto& entry = mIndex[tf];
+      if (entry.offset[id] % Alignment || entry.offset[id] + entry.size[id] > mHeader.indexOffset) {
+        close();
+        LOG(ERROR) << "Corrupted index of flat CTF file " << fileName << " for TF " << tf << " detector " << DetID::getName(id);
+        throw std::runtime_error("corrupted flat CTF file");
+      }
+    }
+  }
+  mFileName = fileName;
+}
+
+///_____________________________________________________________________________
+void CTFFlatFileReader::close()
+{
+  mMapping.reset(); // buffers shipped to the users keep the file mapped
+  mIndex = nullptr;
+  mHeader = CTFFlatFileHeader{};
+  mFileName.clear();
+}
+
+///_____________________________________________________________________________
+const CTFFlatTFEntry& CTFFlatFileReader::getTFEntry(uint32_t tf) const
+{
+  if (tf >= getNTFs()) {
+    throw std::runtime_error(fmt::format("TF {} requested from flat CTF file {} with {} TFs", tf, mFileName, getNTFs()));
+  }
+  return mIndex[tf];
+}
+
+///_____________________________________________________________________________
+std::pair<const char*, size_t> CTFFlatFileReader::getDetectorBuffer(uint32_t tf, DetID det) const
+{
+  const auto& entry = getTFEntry(tf);
+  if (!entry.size[det]) {
+    return {nullptr, 0};
+  }
+  return {mMapping->data + entry.offset[det], entry.size[det]};
+}
@@ -9,5 +9,37 @@
 // or submit itself to any jurisdiction.
 
 #include "DetectorsCommonDataFormats/EncodedBlocks.h"
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 
 using namespace o2::ctf;
+
+void o2::ctf::forEachConcurrently(size_t n, const std::function<void(size_t)>& f, int nThreads)
+{
+  std::vector<std::exception_ptr> errors(n);
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nThreads)
+#endif
+  for (size_t i = 0; i < n; i++) {
+    try {
+      f(i);
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+  }
+  for (auto& err : errors) {
+    if (err) {
+      std::rethrow_exception(err);
+    }
+  }
+}
+
+bool o2::ctf::isConcurrencyEnabled()
+{
+#ifdef WITH_OPENMP
+  return true;
+#else
+  return false;
+#endif
+}
@@ -0,0 +1,90 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test CTFFlatFile
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <vector>
+#include "DetectorsCommonDataFormats/EncodedBlocks.h"
+#include "DetectorsCommonDataFormats/CTFFlatFile.h"
+
+using namespace o2::ctf;
+using DetID = o2::detectors::DetID;
+
+struct TestHeader {
+  int dummy = 0;
+};
+using TestBlocks = EncodedBlocks<TestHeader, 2, uint32_t>;
+
+BOOST_AUTO_TEST_CASE(CTFFlatFile_roundtrip)
+{
+  const std::string fileName = "testCTFFlatFile.ctf";
+  std::vector<uint16_t> src0(1000), src1(333);
+  for (size_t i = 0; i < src0.size(); i++) {
+    src0[i] = i % 7;
+  }
+  for (size_t i = 0; i < src1.size(); i++) {
+    src1[i] = i * 31;
+  }
+  std::vector<BufferType> buffTPC, buffITS;
+  TestBlocks::create(buffTPC);
+  TestBlocks::get(buffTPC.data())->encode(src0, 0, 0, Metadata::OptStore::EENCODE, &buffTPC);
+  TestBlocks::get(buffTPC.data())->encode(src1, 1, 0, Metadata::OptStore::EENCODE, &buffTPC);
+  TestBlocks::create(buffITS);
+  TestBlocks::get(buffITS.data())->encode(src1, 0, 0, Metadata::OptStore::EENCODE, &buffITS);
+  TestBlocks::get(buffITS.data())->encode(src0, 1, 0, Metadata::OptStore::EENCODE, &buffITS);
+
+  {
+    CTFFlatFileWriter writer;
+    writer.open(fileName);
+    writer.addDetector(DetID::TPC, buffTPC.data(), buffTPC.size());
+    writer.endTF(CTFHeader{1234, 100, DetID::getMask(DetID::TPC)});
+    writer.addDetector(DetID::ITS, buffITS.data(), buffITS.size() - 1); // unaligned size, next images must be padded
+    writer.addDetector(DetID::TPC, buffTPC.data(), buffTPC.size());
+    writer.endTF(CTFHeader{1234, 356, DetID::getMask(DetID::ITS) | DetID::getMask(DetID::TPC)});
+    BOOST_CHECK(writer.getNTFs() == 2);
+  }
+
+  BOOST_CHECK(CTFFlatFileReader::isFlatFile(fileName));
+  CTFFlatFileReader::MappingPtr mapping;
+  {
+    CTFFlatFileReader reader;
+    reader.open(fileName);
+    BOOST_CHECK(reader.getNTFs() == 2);
+    BOOST_CHECK(reader.getCTFHeader(1).firstTForbit == 356);
+    BOOST_CHECK(reader.getCTFHeader(1).detectors == (DetID::getMask(DetID::ITS) | DetID::getMask(DetID::TPC)));
+    BOOST_CHECK(reader.getDetectorBuffer(0, DetID::ITS).second == 0);
+    BOOST_CHECK_THROW(reader.getTFEntry(2), std::runtime_error);
+    mapping = reader.getMapping(); // buffers must stay valid after closing the reader
+  }
+  BOOST_CHECK(reinterpret_cast<const CTFFlatFileHeader*>(mapping->data)->nTFs == 2);
+  mapping.reset();
+
+  CTFFlatFileReader reader;
+  reader.open(fileName);
+  for (uint32_t tf = 0; tf < reader.getNTFs(); tf++) {
+    auto [buff, size] = reader.getDetectorBuffer(tf, DetID::TPC);
+    BOOST_CHECK(size == buffTPC.size());
+    BOOST_CHECK(reinterpret_cast<uintptr_t>(buff) % Alignment == 0);
+    // the image is used in place
+    const auto image = TestBlocks::getImage(buff);
+    std::vector<uint16_t> dest0, dest1;
+    image.decode(dest0, 0);
+    image.decode(dest1, 1);
+    BOOST_CHECK(dest0 == src0);
+    BOOST_CHECK(dest1 == src1);
+  }
+  auto [buffI, sizeI] = reader.getDetectorBuffer(1, DetID::ITS);
+  BOOST_CHECK(sizeI == buffITS.size() - 1);
+  BOOST_CHECK(std::equal(buffITS.begin(), buffITS.end() - 1, reinterpret_cast<const BufferType*>(buffI)));
+  std::remove(fileName.c_str());
+}
@@ -0,0 +1,71 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test CoderCache
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <vector>
+#include "DetectorsCommonDataFormats/EncodedBlocks.h"
+#include "DetectorsCommonDataFormats/CoderCache.h"
+
+using namespace o2::ctf;
+
+struct TestHeader {
+  int dummy = 0;
+};
+using TestBlocks = EncodedBlocks<TestHeader, 2, uint32_t>;
+
+BOOST_AUTO_TEST_CASE(CoderCache_reuse)
+{
+  std::vector<uint16_t> src0(1000), src1(1000);
+  for (size_t i = 0; i < src0.size(); i++) {
+    src0[i] = i % 7;
+    src1[i] = i % 11;
+  }
+  CoderCache cache;
+  std::vector<BufferType> buffRef, buffCached;
+  for (int tf = 0; tf < 3; tf++) {
+    buffRef.clear();
+    buffCached.clear();
+    TestBlocks::create(buffRef);
+    TestBlocks::create(buffCached);
+    TestBlocks::get(buffRef.data())->encode(src0, 0, 0, Metadata::OptStore::EENCODE, &buffRef);
+    TestBlocks::get(buffRef.data())->encode(src1, 1, 0, Metadata::OptStore::EENCODE, &buffRef);
+    TestBlocks::get(buffCached.data())->encode(src0, 0, 0, Metadata::OptStore::EENCODE, &buffCached, nullptr, DefaultNStreams, &cache);
+    TestBlocks::get(buffCached.data())->encode(src1, 1, 0, Metadata::OptStore::EENCODE, &buffCached, nullptr, DefaultNStreams, &cache);
+    // cached encoders must produce the same output as the freshly built ones
+    BOOST_CHECK(TestBlocks::get(buffRef.data())->compactify() == TestBlocks::get(buffCached.data())->compactify());
+    BOOST_CHECK(std::equal(buffRef.begin() + TestBlocks::getMinAlignedSize(), buffRef.begin() + TestBlocks::get(buffRef.data())->size(),
+                           buffCached.begin() + TestBlocks::getMinAlignedSize()));
+  }
+  BOOST_CHECK(cache.getNMisses() == 2);
+  BOOST_CHECK(cache.getNHits() == 4);
+
+  // decoders are cached separately from the encoders
+  const auto image = TestBlocks::getImage(buffCached.data());
+  for (int tf = 0; tf < 2; tf++) {
+    std::vector<uint16_t> dest0, dest1;
+    image.decode(dest0, 0, nullptr, &cache);
+    image.decode(dest1, 1, nullptr, &cache);
+    BOOST_CHECK(dest0 == src0);
+    BOOST_CHECK(dest1 == src1);
+  }
+  BOOST_CHECK(cache.getNMisses() == 4);
+  BOOST_CHECK(cache.getNHits() == 6);
+  BOOST_CHECK(cache.size() == 4);
+
+  // least recently used coders are evicted
+  cache.setCapacity(1);
+  BOOST_CHECK(cache.size() == 1);
+  std::vector<uint16_t> dest1;
+  image.decode(dest1, 1, nullptr, &cache);
+  BOOST_CHECK(cache.getNHits() == 7);
+}
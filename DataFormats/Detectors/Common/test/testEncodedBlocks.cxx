@@ -0,0 +1,64 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test EncodedBlocks
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "DetectorsCommonDataFormats/EncodedBlocks.h"
+
+using namespace o2::ctf;
+
+// with several threads the tasks must really overlap: each task waits until another one has started
+BOOST_AUTO_TEST_CASE(ForEachConcurrently_overlap)
+{
+  if (!isConcurrencyEnabled()) {
+    BOOST_TEST_MESSAGE("DetectorsCommonDataFormats is built without OpenMP, the tasks run sequentially");
+    return;
+  }
+  constexpr size_t NTasks = 4;
+  std::atomic<int> started{0};
+  std::vector<char> overlapped(NTasks, 0);
+  forEachConcurrently(
+    NTasks, [&](size_t i) {
+      started++;
+      auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+      while (started < 2 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+      }
+      overlapped[i] = started >= 2;
+    },
+    NTasks);
+  for (auto ok : overlapped) {
+    BOOST_CHECK(ok);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ForEachConcurrently_exception)
+{
+  std::vector<char> done(8, 0);
+  BOOST_CHECK_THROW(forEachConcurrently(
+                      done.size(), [&](size_t i) {
+                        if (i == 3) {
+                          throw std::runtime_error("task failed");
+                        }
+                        done[i] = 1;
+                      },
+                      4),
+                    std::runtime_error);
+  for (size_t i = 0; i < done.size(); i++) {
+    BOOST_CHECK_EQUAL(done[i], i != 3);
+  }
+}
@@ -25,6 +25,8 @@
 /// Rare topologies, i.e. with a frequency below a threshold defined a priori, have not their own entries
 /// in the dictionaries, but are grouped together with topologies with similar dimensions.
 /// For the groups of rare topollogies a dummy bitmask is used.
+/// The quantities needed to compute the cluster positions are also kept in a flat table indexed by the pattern ID,
+/// which is used by the bulk conversion of the compact clusters to 3D clusters.
 
 #ifndef ALICEO2_ITSMFT_TOPOLOGYDICTIONARY_H
 #define ALICEO2_ITSMFT_TOPOLOGYDICTIONARY_H
@@ -36,7 +38,9 @@
 #include <vector>
 #include "MathUtils/Cartesian.h"
 #include "DataFormatsITSMFT/CompCluster.h"
+#include "ReconstructionDataFormats/BaseCluster.h"
 #include "TH1F.h"
+#include <gsl/gsl>
 
 namespace o2
 {
@@ -63,6 +67,16 @@ struct GroupStruct {
   ClassDefNV(GroupStruct, 3);
 };
 
+/// Compact entry of the flat table of the dictionary, with what is needed to compute the position of a cluster
+struct TopologyEntry {
+  float mXCOG;      ///< x position of the COG wrt the bottom left corner of the bounding box
+  float mZCOG;      ///< z position of the COG wrt the bottom left corner of the bounding box
+  float mErr2X;     ///< Squared error associated to the hit point in the x direction
+  float mErr2Z;     ///< Squared error associated to the hit point in the z direction
+  bool mIsGroup;    ///< true: group of rare topologies
+  bool mHasPattern; ///< true: the pattern of the cluster is stored in the pattern stream (groups and invalid IDs)
+};
+
 class TopologyDictionary
 {
  public:
@@ -158,6 +172,18 @@ class TopologyDictionary
   math_utils::Point3D<float> getClusterCoordinates(const CompCluster& cl) const;
   ///Returns the local position of a compact cluster
   static math_utils::Point3D<float> getClusterCoordinates(const CompCluster& cl, const ClusterPattern& patt, bool isGroup = true);
+  /// Returns the entry of the flat table for a pattern ID, InvalidPatternID included
+  const TopologyEntry& getEntry(int n) const
+  {
+    assert(n >= 0 && n < (int)mFlatTable.size());
+    return mFlatTable[n];
+  }
+  /// Appends to output the local positions and errors of the compact clusters, with their sensor IDs.
+  /// The patterns of the groups of rare topologies and of the clusters with an invalid ID are read from pattIt.
+  void convertCompactClusters(gsl::span<const CompClusterExt> clusters, gsl::span<const unsigned char>::iterator& pattIt,
+                              std::vector<o2::BaseCluster<float>>& output) const;
+  /// Fills the flat table from the vector of topologies, also called by a read rule after ROOT streaming
+  void buildFlatTable();
 
   friend BuildTopologyDictionary;
   friend LookUp;
@@ -168,6 +194,7 @@ class TopologyDictionary
   std::unordered_map<int, int> mGroupMap;            ///< Map of pair <groudID, position in mVectorOfIDs>
   int mSmallTopologiesLUT[8 * 255 + 1];              ///< Look-Up Table for the topologies with 1-byte linearised matrix
   std::vector<GroupStruct> mVectorOfIDs;             ///< Vector of topologies and groups
+  std::vector<TopologyEntry> mFlatTable;             //! Flat table indexed by pattern ID, including InvalidPatternID
 
   ClassDefNV(TopologyDictionary, 4);
 }; // namespace itsmft
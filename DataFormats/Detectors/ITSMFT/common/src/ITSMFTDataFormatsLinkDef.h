@@ -35,6 +35,7 @@
 #pragma link C++ class std::map < int, o2::itsmft::ClusterPattern> + ;
 #pragma link C++ class o2::itsmft::ClusterTopology + ;
 #pragma link C++ class o2::itsmft::TopologyDictionary + ;
+#pragma read sourceClass = "o2::itsmft::TopologyDictionary" targetClass = "o2::itsmft::TopologyDictionary" source = "" version = "[1-]" target = "mFlatTable" code = "{ newObj->buildFlatTable(); }"
 #pragma link C++ class o2::itsmft::GroupStruct + ;
 
 #pragma link C++ class o2::itsmft::CTFHeader + ;
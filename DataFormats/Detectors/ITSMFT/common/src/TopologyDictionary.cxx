@@ -15,6 +15,7 @@
 
 #include "DataFormatsITSMFT/TopologyDictionary.h"
 #include "DataFormatsITSMFT/ClusterTopology.h"
+#include <algorithm>
 #include <iostream>
 #include "ITSMFTBase/SegmentationAlpide.h"
 
@@ -31,7 +32,10 @@ namespace o2
 namespace itsmft
 {
 
-TopologyDictionary::TopologyDictionary() : mSmallTopologiesLUT{-1} {}
+TopologyDictionary::TopologyDictionary() : mSmallTopologiesLUT{-1}
+{
+  buildFlatTable();
+}
 
 TopologyDictionary::TopologyDictionary(std::string fileName)
 {
@@ -108,6 +112,7 @@ int TopologyDictionary::readBinaryFile(string fname)
     }
   }
   in.close();
+  buildFlatTable();
   return 0;
 }
 
@@ -126,6 +131,51 @@ void TopologyDictionary::getTopologyDistribution(const TopologyDictionary& dict,
   }
 }
 
+void TopologyDictionary::buildFlatTable()
+{
+  // the IDs without a topology in the dictionary are decoded from their pattern, with dummy errors of half a pixel
+  constexpr float DefErrX = SegmentationAlpide::PitchRow * 0.5;
+  constexpr float DefErrZ = SegmentationAlpide::PitchCol * 0.5;
+  mFlatTable.assign(CompCluster::InvalidPatternID + 1, TopologyEntry{0.f, 0.f, DefErrX * DefErrX, DefErrZ * DefErrZ, false, true});
+  int nIDs = std::min(getSize(), (int)CompCluster::InvalidPatternID);
+  for (int iID = 0; iID < nIDs; iID++) {
+    const auto& gr = mVectorOfIDs[iID];
+    mFlatTable[iID] = TopologyEntry{gr.mXCOG, gr.mZCOG, gr.mErr2X, gr.mErr2Z, gr.mIsGroup, gr.mIsGroup};
+  }
+}
+
+void TopologyDictionary::convertCompactClusters(gsl::span<const CompClusterExt> clusters, gsl::span<const unsigned char>::iterator& pattIt,
+                                                std::vector<o2::BaseCluster<float>>& output) const
+{
+  // first pass without branches over all the clusters, using the COG of their topology
+  size_t first = output.size();
+  output.resize(first + clusters.size());
+  auto* out = output.data() + first;
+  bool anyPattern = false;
+  for (size_t iCl = 0; iCl < clusters.size(); iCl++) {
+    const auto& c = clusters[iCl];
+    const auto& entry = mFlatTable[c.getPatternID()];
+    float x = SegmentationAlpide::getFirstRowCoordinate() - float(c.getRow()) * SegmentationAlpide::PitchRow;
+    float z = float(c.getCol()) * SegmentationAlpide::PitchCol + SegmentationAlpide::getFirstColCoordinate();
+    out[iCl].setSensorID(c.getSensorID());
+    out[iCl].setXYZ(x + entry.mXCOG, 0.f, z + entry.mZCOG);
+    out[iCl].setErrors(entry.mErr2X, entry.mErr2Z, 0.f);
+    anyPattern |= entry.mHasPattern;
+  }
+  if (!anyPattern) {
+    return;
+  }
+  // second pass for the rare clusters with a pattern, whose patterns are stored in the order of the clusters
+  for (size_t iCl = 0; iCl < clusters.size(); iCl++) {
+    const auto& c = clusters[iCl];
+    const auto& entry = mFlatTable[c.getPatternID()];
+    if (entry.mHasPattern) {
+      ClusterPattern patt(pattIt);
+      out[iCl].setPos(getClusterCoordinates(c, patt, entry.mIsGroup));
+    }
+  }
+}
+
 math_utils::Point3D<float> TopologyDictionary::getClusterCoordinates(const CompCluster& cl) const
 {
   math_utils::Point3D<float> locCl;
@@ -0,0 +1,142 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test DataFormatsITSMFT TopologyDictionary
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+#include "DataFormatsITSMFT/TopologyDictionary.h"
+#include "ITSMFTBase/SegmentationAlpide.h"
+#include <TFile.h>
+#include <memory>
+
+namespace o2::itsmft
+{
+
+namespace
+{
+// writes a dictionary entry in the format of TopologyDictionary::writeBinaryFile
+void writeEntry(std::ofstream& out, unsigned long hash, float errX, float errZ, float xCOG, float zCOG, bool isGroup)
+{
+  float err2X = errX * errX, err2Z = errZ * errZ;
+  int nPixels = 2;
+  double frequency = 0.1;
+  unsigned char bitmap[ClusterPattern::kExtendedPatternBytes] = {1, 2, 0xc0};
+  out.write(reinterpret_cast<char*>(&hash), sizeof(unsigned long));
+  out.write(reinterpret_cast<char*>(&errX), sizeof(float));
+  out.write(reinterpret_cast<char*>(&errZ), sizeof(float));
+  out.write(reinterpret_cast<char*>(&err2X), sizeof(float));
+  out.write(reinterpret_cast<char*>(&err2Z), sizeof(float));
+  out.write(reinterpret_cast<char*>(&xCOG), sizeof(float));
+  out.write(reinterpret_cast<char*>(&zCOG), sizeof(float));
+  out.write(reinterpret_cast<char*>(&nPixels), sizeof(int));
+  out.write(reinterpret_cast<char*>(&frequency), sizeof(double));
+  out.write(reinterpret_cast<char*>(&isGroup), sizeof(bool));
+  out.write(reinterpret_cast<char*>(bitmap), sizeof(bitmap));
+}
+} // namespace
+
+// the bulk conversion must give the same positions and errors as the per-cluster decoding
+BOOST_AUTO_TEST_CASE(TopologyDictionary_convertCompactClusters)
+{
+  const std::string fileName = "test_TopologyDictionary.bin";
+  {
+    std::ofstream out(fileName, std::ios::out | std::ios::binary);
+    writeEntry(out, 1, 1.e-4, 2.e-4, 1.3e-3, -1.4e-3, false);
+    writeEntry(out, 2, 3.e-4, 4.e-4, 0.f, 0.f, true);
+  }
+  TopologyDictionary dict;
+  dict.readBinaryFile(fileName);
+  std::remove(fileName.c_str());
+  BOOST_CHECK_EQUAL(dict.getSize(), 2);
+  BOOST_CHECK(!dict.getEntry(0).mHasPattern);
+  BOOST_CHECK(dict.getEntry(1).mIsGroup && dict.getEntry(1).mHasPattern);
+  BOOST_CHECK(dict.getEntry(CompCluster::InvalidPatternID).mHasPattern);
+
+  // common topology, group, invalid ID, common topology
+  std::vector<CompClusterExt> clusters{{10, 20, 0, 3}, {100, 200, 1, 4}, {300, 400, CompCluster::InvalidPatternID, 5}, {500, 1000, 0, 6}};
+  std::vector<unsigned char> patterns{2, 1, 0xc0, 1, 3, 0xe0};
+
+  gsl::span<const unsigned char> pattSpan(patterns);
+  auto pattIt = pattSpan.begin();
+  std::vector<o2::BaseCluster<float>> output;
+  dict.convertCompactClusters(clusters, pattIt, output);
+  BOOST_CHECK(pattIt == pattSpan.end());
+  BOOST_REQUIRE_EQUAL(output.size(), clusters.size());
+
+  auto refIt = pattSpan.begin();
+  const float defErr = SegmentationAlpide::PitchRow * 0.5;
+  for (size_t iCl = 0; iCl < clusters.size(); iCl++) {
+    const auto& c = clusters[iCl];
+    auto pattID = c.getPatternID();
+    math_utils::Point3D<float> locXYZ;
+    float sigmaY2 = defErr * defErr;
+    if (pattID != CompCluster::InvalidPatternID) {
+      sigmaY2 = dict.getErr2X(pattID);
+      if (!dict.isGroup(pattID)) {
+        locXYZ = dict.getClusterCoordinates(c);
+      } else {
+        ClusterPattern patt(refIt);
+        locXYZ = dict.getClusterCoordinates(c, patt);
+      }
+    } else {
+      ClusterPattern patt(refIt);
+      locXYZ = dict.getClusterCoordinates(c, patt, false);
+    }
+    BOOST_CHECK_EQUAL(output[iCl].getSensorID(), c.getSensorID());
+    BOOST_CHECK_EQUAL(output[iCl].getX(), locXYZ.X());
+    BOOST_CHECK_EQUAL(output[iCl].getY(), locXYZ.Y());
+    BOOST_CHECK_EQUAL(output[iCl].getZ(), locXYZ.Z());
+    BOOST_CHECK_EQUAL(output[iCl].getSigmaY2(), sigmaY2);
+  }
+}
+
+// the flat table is transient, it must be rebuilt when the dictionary is read back with ROOT
+BOOST_AUTO_TEST_CASE(TopologyDictionary_streaming)
+{
+  const std::string binFileName = "test_TopologyDictionary_streaming.bin";
+  {
+    std::ofstream out(binFileName, std::ios::out | std::ios::binary);
+    writeEntry(out, 1, 1.e-4, 2.e-4, 1.3e-3, -1.4e-3, false);
+    writeEntry(out, 2, 3.e-4, 4.e-4, 0.f, 0.f, true);
+  }
+  TopologyDictionary dict;
+  dict.readBinaryFile(binFileName);
+  std::remove(binFileName.c_str());
+
+  const std::string rootFileName = "test_TopologyDictionary_streaming.root";
+  {
+    TFile out(rootFileName.c_str(), "recreate");
+    out.WriteObjectAny(&dict, "o2::itsmft::TopologyDictionary", "dict");
+  }
+  std::unique_ptr<TopologyDictionary> read;
+  {
+    TFile in(rootFileName.c_str());
+    read.reset(in.Get<TopologyDictionary>("dict"));
+  }
+  std::remove(rootFileName.c_str());
+  BOOST_REQUIRE(read);
+  BOOST_REQUIRE_EQUAL(read->getSize(), dict.getSize());
+  for (int iID = 0; iID <= CompCluster::InvalidPatternID; iID++) {
+    const auto& entry = read->getEntry(iID);
+    const auto& ref = dict.getEntry(iID);
+    BOOST_CHECK_EQUAL(entry.mXCOG, ref.mXCOG);
+    BOOST_CHECK_EQUAL(entry.mZCOG, ref.mZCOG);
+    BOOST_CHECK_EQUAL(entry.mErr2X, ref.mErr2X);
+    BOOST_CHECK_EQUAL(entry.mErr2Z, ref.mErr2Z);
+    BOOST_CHECK_EQUAL(entry.mIsGroup, ref.mIsGroup);
+    BOOST_CHECK_EQUAL(entry.mHasPattern, ref.mHasPattern);
+  }
+}
+
+} // namespace o2::itsmft
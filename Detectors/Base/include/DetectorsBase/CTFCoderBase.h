@@ -20,6 +20,7 @@
 #include <TTree.h>
 #include "DetectorsCommonDataFormats/DetID.h"
 #include "DetectorsCommonDataFormats/NameConf.h"
+#include "DetectorsCommonDataFormats/CoderCache.h"
 #include "rANS/rans.h"
 
 namespace o2
@@ -73,6 +74,21 @@ class CTFCoderBase
     }
   }
 
+  /// number of threads used to encode/decode the blocks concurrently (if supported by the detector coder)
+  int getNThreads() const { return mNThreads; }
+  void setNThreads(int n) { mNThreads = n > 0 ? n : 1; }
+
+  /// cache of the coders built for the dictionaries stored in the data, reused across TFs (nullptr if disabled)
+  CoderCache* getCoderCache() { return mCoderCache.get(); }
+  void setCoderCacheCapacity(size_t n)
+  {
+    if (n) {
+      mCoderCache = std::make_unique<CoderCache>(n);
+    } else {
+      mCoderCache.reset();
+    }
+  }
+
   void clear()
   {
     for (auto c : mCoders) {
@@ -85,6 +101,8 @@ class CTFCoderBase
 
   std::vector<std::shared_ptr<void>> mCoders; // encoders/decoders
   DetID mDet;
+  int mNThreads = 1; // number of threads for concurrent encoding/decoding of the blocks
+  std::unique_ptr<CoderCache> mCoderCache; //! coders for the dictionaries stored in the data
 
   ClassDefNV(CTFCoderBase, 1);
 };
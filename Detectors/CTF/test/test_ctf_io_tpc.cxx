@@ -12,6 +12,7 @@
 #define BOOST_TEST_MAIN
 #define BOOST_TEST_DYN_LINK
 #include <boost/test/unit_test.hpp>
+#include <boost/test/data/test_case.hpp>
 #include "DataFormatsTPC/CompressedClusters.h"
 #include "DataFormatsTPC/CTF.h"
 #include "DetectorsCommonDataFormats/NameConf.h"
@@ -24,7 +25,7 @@
 
 using namespace o2::tpc;
 
-BOOST_AUTO_TEST_CASE(CTFTest)
+BOOST_DATA_TEST_CASE(CTFTest, boost::unit_test::data::make({2, 8}) * boost::unit_test::data::make({1, 4}), nStreams, nThreads)
 {
   CompressedClusters c;
   c.nAttachedClusters = 99;
@@ -87,6 +88,8 @@ BOOST_AUTO_TEST_CASE(CTFTest)
   {
     CTFCoder coder;
     coder.setCombineColumns(true);
+    coder.setNStreams(nStreams);
+    coder.setNThreads(nThreads);
     coder.encode(vecIO, c); // compress
   }
   sw.Stop();
@@ -123,6 +126,7 @@ BOOST_AUTO_TEST_CASE(CTFTest)
   {
     CTFCoder coder;
     coder.setCombineColumns(true);
+    coder.setNThreads(nThreads);
     coder.decode(ctfImage, vecIn); // decompress
   }
   sw.Stop();
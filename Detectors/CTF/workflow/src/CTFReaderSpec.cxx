@@ -23,6 +23,7 @@
 #include "DetectorsCommonDataFormats/EncodedBlocks.h"
 #include "DetectorsCommonDataFormats/NameConf.h"
 #include "DetectorsCommonDataFormats/CTFHeader.h"
+#include "DetectorsCommonDataFormats/CTFFlatFile.h"
 #include "DataFormatsITSMFT/CTF.h"
 #include "DataFormatsTPC/CTF.h"
 #include "DataFormatsTRD/CTF.h"
@@ -63,6 +64,12 @@ bool readFromTree(TTree& tree, const std::string brname, T& dest, int ev = 0)
 
 using DetID = o2::detectors::DetID;
 
+// release the reference on the mapped flat CTF file held by the shipped message
+static void releaseFlatCTFMapping(void* /*data*/, void* hint)
+{
+  delete static_cast<CTFFlatFileReader::MappingPtr*>(hint);
+}
+
 class CTFReaderSpec : public o2::framework::Task
 {
  public:
@@ -73,11 +80,17 @@ class CTFReaderSpec : public o2::framework::Task
 
  private:
   void openCTFFile(const std::string& flname);
+  void closeCTFFile();
+  int getNEntries() const { return mFlatFile.isOpen() ? int(mFlatFile.getNTFs()) : mCTFTree->GetEntries(); }
+  template <typename C>
+  void processDet(o2::framework::ProcessingContext& pc, DetID det, const CTFHeader& ctfHeader);
+  void setFirstTFOrbit(o2::framework::ProcessingContext& pc, const std::string& label, const CTFHeader& ctfHeader) const;
 
   DetID::mask_t mDets;             // detectors
   std::vector<std::string> mInput; // input files
   std::unique_ptr<TFile> mCTFFile;
   std::unique_ptr<TTree> mCTFTree;
+  CTFFlatFileReader mFlatFile; // used instead of mCTFFile/mCTFTree for the flat CTF files
   uint32_t mCTFCounter = 0;
   size_t mNextToProcess = 0;
   int mCurrEntry = 0;
@@ -105,6 +118,11 @@ void CTFReaderSpec::init(InitContext& ic)
 ///_______________________________________
 void CTFReaderSpec::openCTFFile(const std::string& flname)
 {
+  mCurrEntry = 0;
+  if (CTFFlatFileReader::isFlatFile(flname)) {
+    mFlatFile.open(flname);
+    return;
+  }
   mCTFFile.reset(TFile::Open(flname.c_str()));
   if (!mCTFFile->IsOpen() || mCTFFile->IsZombie()) {
     LOG(ERROR) << "Failed to open file " << flname;
@@ -114,7 +132,52 @@ void CTFReaderSpec::openCTFFile(const std::string& flname)
   if (!mCTFTree) {
     throw std::runtime_error("failed to load CTF tree");
   }
-  mCurrEntry = 0;
+}
+
+///_______________________________________
+void CTFReaderSpec::closeCTFFile()
+{
+  if (mFlatFile.isOpen()) {
+    mFlatFile.close();
+    return;
+  }
+  mCTFTree.reset();
+  mCTFFile->Close();
+  mCTFFile.reset();
+}
+
+///_______________________________________
+void CTFReaderSpec::setFirstTFOrbit(ProcessingContext& pc, const std::string& label, const CTFHeader& ctfHeader) const
+{
+  auto* hd = pc.outputs().findMessageHeader({label});
+  if (!hd) {
+    throw std::runtime_error(o2::utils::Str::concat_string("failed to find output message header for ", label));
+  }
+  hd->firstTForbit = ctfHeader.firstTForbit;
+  hd->tfCounter = mCTFCounter;
+}
+
+///_______________________________________
+template <typename C>
+void CTFReaderSpec::processDet(ProcessingContext& pc, DetID det, const CTFHeader& ctfHeader)
+{
+  if (!(mDets & ctfHeader.detectors)[det]) {
+    return;
+  }
+  if (mFlatFile.isOpen()) {
+    auto [buff, size] = mFlatFile.getDetectorBuffer(mCurrEntry, det);
+    if (size < sizeof(C)) {
+      throw std::runtime_error(fmt::format("{} CTF buffer of {} bytes in {} is too small", det.getName(), size, mFlatFile.getFileName()));
+    }
+    // ship the view on the mapped file instead of copying it, the message keeps the mapping alive until it is released.
+    // The EncodedBlocks image is relocated in place by the decoder, the buffer is never modified.
+    pc.outputs().adoptChunk(Output{det.getDataOrigin(), "CTFDATA", 0, Lifetime::Timeframe}, const_cast<char*>(buff), size,
+                            &releaseFlatCTFMapping, new CTFFlatFileReader::MappingPtr(mFlatFile.getMapping()));
+  } else {
+    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(C));
+    C::readFromTree(bufVec, *(mCTFTree.get()), det.getName(), mCurrEntry);
+  }
+  setFirstTFOrbit(pc, det.getName(), ctfHeader);
 }
 
 ///_______________________________________
@@ -130,146 +193,45 @@ void CTFReaderSpec::run(ProcessingContext& pc)
   auto cput = mTimer.CpuTime();
   mTimer.Start(false);
 
-  if (!mCTFTree) { // there is still a tree open with multiple entries
+  if (!mCTFTree && !mFlatFile.isOpen()) { // there is still a file open with multiple entries
     std::string inputFile = o2::utils::Str::concat_string(mCTFDir, mInput[mNextToProcess]);
     LOG(INFO) << "Reading CTF input " << mNextToProcess << ' ' << inputFile;
     openCTFFile(inputFile);
   }
   CTFHeader ctfHeader;
-  if (!readFromTree(*(mCTFTree.get()), "CTFHeader", ctfHeader, mCurrEntry)) {
+  if (mFlatFile.isOpen()) {
+    ctfHeader = mFlatFile.getCTFHeader(mCurrEntry);
+  } else if (!readFromTree(*(mCTFTree.get()), "CTFHeader", ctfHeader, mCurrEntry)) {
     throw std::runtime_error("did not find CTFHeader");
   }
   LOG(INFO) << ctfHeader;
 
-  auto setFirstTFOrbit = [&pc, &ctfHeader, this](const std::string& label) {
-    auto* hd = pc.outputs().findMessageHeader({label});
-    if (!hd) {
-      throw std::runtime_error(o2::utils::Str::concat_string("failed to find output message header for ", label));
-    }
-    hd->firstTForbit = ctfHeader.firstTForbit;
-    hd->tfCounter = this->mCTFCounter;
-  };
-
   // send CTF Header
   pc.outputs().snapshot({"header"}, ctfHeader);
-  setFirstTFOrbit("header");
-
-  DetID::mask_t detsTF = mDets & ctfHeader.detectors;
-  DetID det;
-
-  det = DetID::ITS;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::itsmft::CTF));
-    o2::itsmft::CTF::readFromTree(bufVec, *(mCTFTree.get()), det.getName(), mCurrEntry);
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::MFT;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::itsmft::CTF));
-    o2::itsmft::CTF::readFromTree(bufVec, *(mCTFTree.get()), det.getName(), mCurrEntry);
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::TPC;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::tpc::CTF));
-    o2::tpc::CTF::readFromTree(bufVec, *(mCTFTree.get()), det.getName(), mCurrEntry);
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::TRD;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::trd::CTF));
-    o2::trd::CTF::readFromTree(bufVec, *(mCTFTree.get()), det.getName(), mCurrEntry);
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::FT0;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::ft0::CTF));
-    o2::ft0::CTF::readFromTree(bufVec, *(mCTFTree.get()), det.getName(), mCurrEntry);
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::FV0;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::fv0::CTF));
-    o2::fv0::CTF::readFromTree(bufVec, *(mCTFTree.get()), det.getName(), mCurrEntry);
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::FDD;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::fdd::CTF));
-    o2::fdd::CTF::readFromTree(bufVec, *(mCTFTree.get()), det.getName(), mCurrEntry);
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::TOF;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::tof::CTF));
-    o2::tof::CTF::readFromTree(bufVec, *(mCTFTree.get()), det.getName(), mCurrEntry);
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::MID;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::mid::CTF));
-    o2::mid::CTF::readFromTree(bufVec, *(mCTFTree.get()), det.getName(), mCurrEntry);
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::MCH;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::mch::CTF));
-    o2::mch::CTF::readFromTree(bufVec, *(mCTFTree.get()), det.getName(), mCurrEntry);
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::EMC;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::emcal::CTF));
-    o2::emcal::CTF::readFromTree(bufVec, *(mCTFTree.get()), det.getName(), mCurrEntry);
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::PHS;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::phos::CTF));
-    o2::phos::CTF::readFromTree(bufVec, *(mCTFTree.get()), det.getName(), mCurrEntry);
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::CPV;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::cpv::CTF));
-    o2::cpv::CTF::readFromTree(bufVec, *(mCTFTree.get()), det.getName(), mCurrEntry);
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::ZDC;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::zdc::CTF));
-    o2::zdc::CTF::readFromTree(bufVec, *(mCTFTree.get()), det.getName(), mCurrEntry);
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::HMP;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::hmpid::CTF));
-    o2::hmpid::CTF::readFromTree(bufVec, *(mCTFTree.get()), det.getName(), mCurrEntry);
-    setFirstTFOrbit(det.getName());
-  }
+  setFirstTFOrbit(pc, "header", ctfHeader);
+
+  processDet<o2::itsmft::CTF>(pc, DetID::ITS, ctfHeader);
+  processDet<o2::itsmft::CTF>(pc, DetID::MFT, ctfHeader);
+  processDet<o2::tpc::CTF>(pc, DetID::TPC, ctfHeader);
+  processDet<o2::trd::CTF>(pc, DetID::TRD, ctfHeader);
+  processDet<o2::ft0::CTF>(pc, DetID::FT0, ctfHeader);
+  processDet<o2::fv0::CTF>(pc, DetID::FV0, ctfHeader);
+  processDet<o2::fdd::CTF>(pc, DetID::FDD, ctfHeader);
+  processDet<o2::tof::CTF>(pc, DetID::TOF, ctfHeader);
+  processDet<o2::mid::CTF>(pc, DetID::MID, ctfHeader);
+  processDet<o2::mch::CTF>(pc, DetID::MCH, ctfHeader);
+  processDet<o2::emcal::CTF>(pc, DetID::EMC, ctfHeader);
+  processDet<o2::phos::CTF>(pc, DetID::PHS, ctfHeader);
+  processDet<o2::cpv::CTF>(pc, DetID::CPV, ctfHeader);
+  processDet<o2::zdc::CTF>(pc, DetID::ZDC, ctfHeader);
+  processDet<o2::hmpid::CTF>(pc, DetID::HMP, ctfHeader);
 
   mTimer.Stop();
-  LOGP(INFO, "Read CTF#{} ({} of {} in {}) in {:.3f} s", mCTFCounter, mCurrEntry, mCTFTree->GetEntries(), mCTFFile->GetName(), mTimer.CpuTime() - cput);
+  LOGP(INFO, "Read CTF#{} ({} of {} in {}) in {:.3f} s", mCTFCounter, mCurrEntry, getNEntries(), mFlatFile.isOpen() ? mFlatFile.getFileName() : mCTFFile->GetName(), mTimer.CpuTime() - cput);
 
-  bool moreToProcess = (++mCurrEntry < mCTFTree->GetEntries());
+  bool moreToProcess = (++mCurrEntry < getNEntries());
   if (!moreToProcess) { // this file is done, check if there are other files
-    mCTFTree.reset();
-    mCTFFile->Close();
-    mCTFFile.reset();
+    closeCTFFile();
     moreToProcess = true;
     if (++mNextToProcess >= mInput.size()) {
       if (++mLoopsCounter >= mLoops) {
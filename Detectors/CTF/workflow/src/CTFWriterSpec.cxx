@@ -17,6 +17,7 @@
 #include "CTFWorkflow/CTFWriterSpec.h"
 
 #include "DetectorsCommonDataFormats/CTFHeader.h"
+#include "DetectorsCommonDataFormats/CTFFlatFile.h"
 #include "DetectorsCommonDataFormats/NameConf.h"
 #include "DetectorsCommonDataFormats/EncodedBlocks.h"
 #include "CommonUtils/StringUtils.h"
@@ -95,12 +96,14 @@ class CTFWriterSpec : public o2::framework::Task
   std::string dictionaryFileName(const std::string& detName = "");
   void closeTFTreeAndFile();
   void prepareTFTreeAndFile(const o2::header::DataHeader* dh);
+  bool isTFFileOpen() const { return mCTFTreeOut || mFlatFileOut.isOpen(); }
   size_t estimateCTFSize(ProcessingContext& pc);
 
   DetID::mask_t mDets; // detectors
   bool mWriteCTF = false;
   bool mCreateDict = false;
   bool mDictPerDetector = false;
+  bool mFlatFormat = false; // write CTFs to memory-mappable flat file instead of the tree
   int mSaveDictAfter = -1; // if positive and mWriteCTF==true, save dictionary after each mSaveDictAfter TFs processed
   uint64_t mRun = 0;
   size_t mMinSize = 0;     // if > 0, accumulate CTFs in the same tree until the total size exceeds this minimum
@@ -116,6 +119,7 @@ class CTFWriterSpec : public o2::framework::Task
 
   std::unique_ptr<TFile> mCTFFileOut;
   std::unique_ptr<TTree> mCTFTreeOut;
+  CTFFlatFileWriter mFlatFileOut;
 
   std::unique_ptr<TFile> mDictFileOut; // file to store dictionary
   std::unique_ptr<TTree> mDictTreeOut; // tree to store dictionary
@@ -144,7 +148,11 @@ size_t CTFWriterSpec::processDet(o2::framework::ProcessingContext& pc, DetID det
   const auto ctfImage = C::getImage(ctfBuffer.data());
   ctfImage.print(o2::utils::Str::concat_string(det.getName(), ": "));
   if (mWriteCTF) {
-    sz += ctfImage.appendToTree(*tree, det.getName());
+    if (mFlatFormat) {
+      sz += mFlatFileOut.addDetector(det, ctfBuffer.data(), ctfBuffer.size() * sizeof(o2::ctf::BufferType));
+    } else {
+      sz += ctfImage.appendToTree(*tree, det.getName());
+    }
     header.detectors.set(det);
   }
   if (mCreateDict) {
@@ -224,6 +232,12 @@ void CTFWriterSpec::init(InitContext& ic)
   mSaveDictAfter = ic.options().get<int>("save-dict-after");
   mDictDir = o2::utils::Str::rectifyDirectory(ic.options().get<std::string>("ctf-dict-dir"));
   mCTFDir = o2::utils::Str::rectifyDirectory(ic.options().get<std::string>("output-dir"));
+  auto format = ic.options().get<std::string>("ctf-format");
+  if (format == "flat") {
+    mFlatFormat = true;
+  } else if (format != "root") {
+    throw std::invalid_argument(o2::utils::Str::concat_string("Invalid ctf-format ", format, ", allowed: root or flat"));
+  }
   if (mWriteCTF) {
     if (mMinSize > 0) {
       LOG(INFO) << "Multiple CTFs will be accumulated in the tree/file until its size exceeds " << mMinSize << " bytes";
@@ -282,10 +296,18 @@ void CTFWriterSpec::run(ProcessingContext& pc)
   mTimer.Stop();
 
   if (mWriteCTF) {
-    szCTF += appendToTree(*mCTFTreeOut.get(), "CTFHeader", header);
+    std::string fileName;
+    if (mFlatFormat) {
+      szCTF += mFlatFileOut.endTF(header);
+      ++mNAccCTF;
+      fileName = mFlatFileOut.getFileName();
+    } else {
+      szCTF += appendToTree(*mCTFTreeOut.get(), "CTFHeader", header);
+      mCTFTreeOut->SetEntries(++mNAccCTF);
+      fileName = mCTFFileOut->GetName();
+    }
     mAccCTFSize += szCTF;
-    mCTFTreeOut->SetEntries(++mNAccCTF);
-    LOG(INFO) << "TF#" << mNCTF << ": wrote CTF{" << header << "} of size " << szCTF << " to " << mCTFFileOut->GetName() << " in " << mTimer.CpuTime() - cput << " s";
+    LOG(INFO) << "TF#" << mNCTF << ": wrote CTF{" << header << "} of size " << szCTF << " to " << fileName << " in " << mTimer.CpuTime() - cput << " s";
     if (mNAccCTF > 1) {
       LOG(INFO) << "Current CTF tree has " << mNAccCTF << " entries with total size of " << mAccCTFSize << " bytes";
     }
@@ -324,7 +346,7 @@ void CTFWriterSpec::prepareTFTreeAndFile(const o2::header::DataHeader* dh)
     return;
   }
   bool needToOpen = false;
-  if (!mCTFTreeOut) {
+  if (!isTFFileOpen()) {
     needToOpen = true;
   } else {
     if ((mAccCTFSize >= mMinSize) ||                                                         // min size exceeded, may close the file
@@ -336,8 +358,12 @@ void CTFWriterSpec::prepareTFTreeAndFile(const o2::header::DataHeader* dh)
   }
   if (needToOpen) {
     closeTFTreeAndFile();
-    mCTFFileOut.reset(TFile::Open(o2::utils::Str::concat_string(mCTFDir, o2::base::NameConf::getCTFFileName(dh->runNumber, dh->firstTForbit, dh->tfCounter)).c_str(), "recreate"));
-    mCTFTreeOut = std::make_unique<TTree>(std::string(o2::base::NameConf::CTFTREENAME).c_str(), "O2 CTF tree");
+    if (mFlatFormat) {
+      mFlatFileOut.open(o2::utils::Str::concat_string(mCTFDir, o2::base::NameConf::getCTFFileName(dh->runNumber, dh->firstTForbit, dh->tfCounter, "o2_ctf", o2::base::NameConf::CTFFLATEXT)));
+    } else {
+      mCTFFileOut.reset(TFile::Open(o2::utils::Str::concat_string(mCTFDir, o2::base::NameConf::getCTFFileName(dh->runNumber, dh->firstTForbit, dh->tfCounter)).c_str(), "recreate"));
+      mCTFTreeOut = std::make_unique<TTree>(std::string(o2::base::NameConf::CTFTREENAME).c_str(), "O2 CTF tree");
+    }
     mNCTFFiles++;
   }
 }
@@ -352,6 +378,10 @@ void CTFWriterSpec::closeTFTreeAndFile()
     mCTFFileOut.reset();
     mNAccCTF = 0;
   }
+  if (mFlatFileOut.isOpen()) {
+    mFlatFileOut.close();
+    mNAccCTF = 0;
+  }
   mAccCTFSize = 0;
 }
 
@@ -442,7 +472,8 @@ DataProcessorSpec getCTFWriterSpec(DetID::mask_t dets, uint64_t run, bool doCTF,
     AlgorithmSpec{adaptFromTask<CTFWriterSpec>(dets, run, doCTF, doDict, dictPerDet, szmn, szmx)},
     Options{{"save-dict-after", VariantType::Int, -1, {"In dictionary generation mode save it dictionary after certain number of TFs processed"}},
             {"ctf-dict-dir", VariantType::String, "none", {"CTF dictionary directory"}},
-            {"output-dir", VariantType::String, "none", {"CTF output directory"}}}};
+            {"output-dir", VariantType::String, "none", {"CTF output directory"}},
+            {"ctf-format", VariantType::String, "root", {"CTF file format: root (tree) or flat (memory-mappable, read w/o copy)"}}}};
 }
 
 } // namespace ctf
@@ -500,32 +500,18 @@ void CookedTracker::process(gsl::span<const o2::itsmft::CompClusterExt> const& c
 
   mClusterCache.reserve(rof.getNEntries());
   auto clusters_in_frame = rof.getROFData(clusters);
-  for (const auto& comp : clusters_in_frame) {
-
-    auto pattID = comp.getPatternID();
-    o2::math_utils::Point3D<float> locXYZ;
-    float sigmaY2 = 0.0015 * 0.0015, sigmaZ2 = sigmaY2, sigmaYZ = 0; //Dummy COG errors (about half pixel size)
-    if (pattID != itsmft::CompCluster::InvalidPatternID) {
-      sigmaY2 = dict.getErr2X(pattID);
-      sigmaZ2 = dict.getErr2Z(pattID);
-      if (!dict.isGroup(pattID)) {
-        locXYZ = dict.getClusterCoordinates(comp);
-      } else {
-        o2::itsmft::ClusterPattern patt(pattIt);
-        locXYZ = dict.getClusterCoordinates(comp, patt);
-      }
-    } else {
-      o2::itsmft::ClusterPattern patt(pattIt);
-      locXYZ = dict.getClusterCoordinates(comp, patt, false);
-    }
-    auto sensorID = comp.getSensorID();
+  std::vector<o2::BaseCluster<float>> localClusters;
+  localClusters.reserve(clusters_in_frame.size());
+  dict.convertCompactClusters(clusters_in_frame, pattIt, localClusters);
+  for (const auto& locCl : localClusters) {
+    auto sensorID = locCl.getSensorID();
     // Inverse transformation to the local --> tracking
-    auto trkXYZ = mGeom->getMatrixT2L(sensorID) ^ locXYZ;
+    auto trkXYZ = mGeom->getMatrixT2L(sensorID) ^ locCl.getXYZ();
 
     Cluster c;
     c.setSensorID(sensorID);
     c.setPos(trkXYZ);
-    c.setErrors(sigmaY2, sigmaZ2, 0.f);
+    c.setErrors(locCl.getSigmaY2(), locCl.getSigmaZ2(), 0.f);
     mClusterCache.push_back(c);
   }
 
@@ -0,0 +1,74 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file ClusterLayerSoA.h
+/// \brief Structure of arrays of the clusters of a layer, for the vectorised loops of the CPU tracker
+///
+
+#ifndef TRACKINGITSU_INCLUDE_CLUSTERLAYERSOA_H_
+#define TRACKINGITSU_INCLUDE_CLUSTERLAYERSOA_H_
+
+#include <vector>
+
+#include "ITStracking/Cluster.h"
+
+namespace o2
+{
+namespace its
+{
+
+/// The coordinates of the clusters of a layer as separate arrays, in the order of the clusters of the
+/// PrimaryVertexContext, i.e. sorted by index table bin, so that the clusters of consecutive bins are contiguous in
+/// memory and can be checked several at a time.
+struct ClusterLayerSoA {
+  std::vector<float> xCoordinates;
+  std::vector<float> yCoordinates;
+  std::vector<float> zCoordinates;
+  std::vector<float> phiCoordinates;
+  std::vector<float> rCoordinates;
+  std::vector<unsigned char> used; // 1 for the clusters already attached to a track
+
+  int size() const { return static_cast<int>(zCoordinates.size()); }
+
+  void fill(const std::vector<Cluster>& clusters);
+  void fillUsed(const std::vector<Cluster>& clusters, const std::vector<bool>& usedClusters);
+};
+
+inline void ClusterLayerSoA::fill(const std::vector<Cluster>& clusters)
+{
+  const size_t clustersNum{clusters.size()};
+  xCoordinates.resize(clustersNum);
+  yCoordinates.resize(clustersNum);
+  zCoordinates.resize(clustersNum);
+  phiCoordinates.resize(clustersNum);
+  rCoordinates.resize(clustersNum);
+  for (size_t iCluster{0}; iCluster < clustersNum; ++iCluster) {
+    const Cluster& cluster{clusters[iCluster]};
+    xCoordinates[iCluster] = cluster.xCoordinate;
+    yCoordinates[iCluster] = cluster.yCoordinate;
+    zCoordinates[iCluster] = cluster.zCoordinate;
+    phiCoordinates[iCluster] = cluster.phiCoordinate;
+    rCoordinates[iCluster] = cluster.rCoordinate;
+  }
+}
+
+/// The used flags are indexed by cluster id, they are gathered in the order of the clusters
+inline void ClusterLayerSoA::fillUsed(const std::vector<Cluster>& clusters, const std::vector<bool>& usedClusters)
+{
+  used.resize(clusters.size());
+  for (size_t iCluster{0}; iCluster < clusters.size(); ++iCluster) {
+    used[iCluster] = usedClusters[clusters[iCluster].clusterId];
+  }
+}
+
+} // namespace its
+} // namespace o2
+
+#endif /* TRACKINGITSU_INCLUDE_CLUSTERLAYERSOA_H_ */
@@ -105,6 +105,7 @@ struct VertexingParameters {
   int clusterContributorsCut = 16;
   int phiSpan = -1;
   int zSpan = -1;
+  float lineClusteringZWindow = 0.f; // > 0 to pair only the lines closer than this in z at the beam axis
 };
 
 struct VertexerHistogramsConfiguration {
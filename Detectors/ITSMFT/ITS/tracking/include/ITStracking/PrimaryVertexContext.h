@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "ITStracking/Cell.h"
+#include "ITStracking/ClusterLayerSoA.h"
 #include "ITStracking/Configuration.h"
 #include "ITStracking/Constants.h"
 #include "ITStracking/Definitions.h"
@@ -47,6 +48,7 @@ class PrimaryVertexContext
                           const std::vector<std::vector<Cluster>>& cl, const std::array<float, 3>& pv, const int iteration);
   const float3& getPrimaryVertex() const { return mPrimaryVertex; }
   auto& getClusters() { return mClusters; }
+  const auto& getClustersSoA() const { return mClustersSoA; }
   auto& getCells() { return mCells; }
   auto& getCellsLookupTable() { return mCellsLookupTable; }
   auto& getCellsNeighbours() { return mCellsNeighbours; }
@@ -74,6 +76,7 @@ class PrimaryVertexContext
   std::vector<float> mMinR;
   std::vector<float> mMaxR;
   std::vector<std::vector<Cluster>> mClusters;
+  std::vector<ClusterLayerSoA> mClustersSoA; // same clusters as mClusters, for the vectorised selections
   std::vector<std::vector<bool>> mUsedClusters;
   std::vector<std::vector<Cell>> mCells;
   std::vector<std::vector<int>> mCellsLookupTable;
@@ -0,0 +1,91 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file ThreadUtils.h
+/// \brief Helpers to run the loops of the CPU tracker on several threads
+///
+
+#ifndef TRACKINGITSU_INCLUDE_THREADUTILS_H_
+#define TRACKINGITSU_INCLUDE_THREADUTILS_H_
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#include "ITStracking/Constants.h"
+
+namespace o2
+{
+namespace its
+{
+
+namespace thread_utils
+{
+
+/// Number of chunks per thread, to balance the load when the items take different times
+constexpr int ChunksPerThread{4};
+
+/// Calls process(iItem, output) for the items [0, nItems), which appends the results of each item to output.
+/// With more than one thread the items are split in contiguous chunks, processed concurrently into separate buffers
+/// which are then appended to output in the order of the items, so that the output does not depend on the number of
+/// threads. If firstIndices is given, the entry of each item which produced results and which is still UnusedIndex is
+/// set to the position of its first result in output.
+/// process must be safe to call concurrently for different items, the threads are used only in the translation units
+/// compiled with OpenMP.
+template <typename T, typename F>
+void processInChunks(const int nItems, const int nThreads, std::vector<T>& output, std::vector<int>* firstIndices, F&& process)
+{
+  const int nChunks{std::min(nItems, nThreads * ChunksPerThread)};
+  if (nThreads < 2 || nChunks < 2) {
+    for (int iItem{0}; iItem < nItems; ++iItem) {
+      const size_t first{output.size()};
+      process(iItem, output);
+      if (firstIndices != nullptr && output.size() > first && (*firstIndices)[iItem] == constants::its::UnusedIndex) {
+        (*firstIndices)[iItem] = static_cast<int>(first);
+      }
+    }
+    return;
+  }
+
+  auto chunkBegin = [nItems, nChunks](const int iChunk) { return static_cast<int>(static_cast<long>(nItems) * iChunk / nChunks); };
+  std::vector<std::vector<T>> chunkOutputs(nChunks);
+  std::vector<int> localFirstIndices(firstIndices != nullptr ? nItems : 0, constants::its::UnusedIndex);
+#ifdef WITH_OPENMP
+#pragma omp parallel for num_threads(nThreads) schedule(dynamic)
+#endif
+  for (int iChunk = 0; iChunk < nChunks; ++iChunk) {
+    auto& chunkOutput = chunkOutputs[iChunk];
+    for (int iItem{chunkBegin(iChunk)}; iItem < chunkBegin(iChunk + 1); ++iItem) {
+      const size_t first{chunkOutput.size()};
+      process(iItem, chunkOutput);
+      if (firstIndices != nullptr && chunkOutput.size() > first) {
+        localFirstIndices[iItem] = static_cast<int>(first);
+      }
+    }
+  }
+
+  for (int iChunk{0}; iChunk < nChunks; ++iChunk) {
+    const int offset{static_cast<int>(output.size())};
+    if (firstIndices != nullptr) {
+      for (int iItem{chunkBegin(iChunk)}; iItem < chunkBegin(iChunk + 1); ++iItem) {
+        if (localFirstIndices[iItem] != constants::its::UnusedIndex && (*firstIndices)[iItem] == constants::its::UnusedIndex) {
+          (*firstIndices)[iItem] = offset + localFirstIndices[iItem];
+        }
+      }
+    }
+    output.insert(output.end(), std::make_move_iterator(chunkOutputs[iChunk].begin()), std::make_move_iterator(chunkOutputs[iChunk].end()));
+  }
+}
+
+} // namespace thread_utils
+} // namespace its
+} // namespace o2
+
+#endif /* TRACKINGITSU_INCLUDE_THREADUTILS_H_ */
@@ -79,7 +79,11 @@ class Tracker
   void setCorrType(const o2::base::PropagatorImpl<float>::MatCorrType& type) { mCorrType = type; }
   void setParameters(const std::vector<MemoryParameters>&, const std::vector<TrackingParameters>&);
   void getGlobalConfiguration();
+  /// Number of threads used within a ROF, for the tracklet, cell and road finding and for the track fitting
+  void setNThreads(int nThreads);
+  int getNThreads() const { return mNThreads; }
   bool isMatLUT() const { return o2::base::Propagator::Instance()->getMatLUT() && (mCorrType == o2::base::PropagatorImpl<float>::MatCorrType::USEMatCorrLUT); }
+  bool canFitConcurrently() const { return isMatLUT() || mCorrType == o2::base::PropagatorImpl<float>::MatCorrType::USEMatCorrNONE; }
 
  private:
   track::TrackParCov buildTrackSeed(const Cluster& cluster1, const Cluster& cluster2, const Cluster& cluster3,
@@ -92,7 +96,7 @@ class Tracker
   void findRoads(int& iteration);
   void findTracks(const ROframe& ev);
   bool fitTrack(const ROframe& event, TrackITSExt& track, int start, int end, int step, const float chi2cut = o2::constants::math::VeryBig);
-  void traverseCellsTree(const int, const int);
+  void traverseCellsTree(const int, const int, std::vector<Road>&);
   void computeRoadsMClabels(const ROframe&);
   void computeTracksMClabels(const ROframe&);
   void rectifyClusterIndices(const ROframe& event);
@@ -110,6 +114,7 @@ class Tracker
   o2::base::PropagatorImpl<float>::MatCorrType mCorrType = o2::base::PropagatorImpl<float>::MatCorrType::USEMatCorrLUT;
   float mBz = 5.f;
   std::uint32_t mROFrame = 0;
+  int mNThreads = 1;
   std::vector<TrackITSExt> mTracks;
   std::vector<MCCompLabel> mTrackLabels;
   o2::gpu::GPUChainITS* mRecoChain = nullptr;
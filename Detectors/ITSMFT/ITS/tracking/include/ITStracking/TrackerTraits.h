@@ -64,9 +64,14 @@ class TrackerTraits
   void UpdateTrackingParameters(const TrackingParameters& trkPar);
   PrimaryVertexContext* getPrimaryVertexContext() { return mPrimaryVertexContext; }
 
+  /// Number of threads used by the CPU implementation for the tracklet and cell finding
+  void setNThreads(int nThreads) { mNThreads = nThreads > 0 ? nThreads : 1; }
+  int getNThreads() const { return mNThreads; }
+
  protected:
   PrimaryVertexContext* mPrimaryVertexContext;
   TrackingParameters mTrkParams;
+  int mNThreads = 1;
 
   o2::gpu::GPUChainITS* mChain = nullptr;
   FuncRunITSTrackFit_t mChainRunITSTrackFit;
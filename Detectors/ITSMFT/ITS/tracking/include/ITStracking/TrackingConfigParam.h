@@ -31,6 +31,10 @@ struct VertexerParamConfig : public o2::conf::ConfigurableParamHelper<VertexerPa
   int clusterContributorsCut = 16;
   int phiSpan = -1;
   int zSpan = -1;
+  // z window (cm) of the binned line clustering, which pairs only the lines close in z at the beam axis, 0 to pair all
+  float lineClusteringZWindow = 0.f;
+  // ROFs vertexed concurrently, each by its own vertexer traits
+  int nThreads = 1;
 
   O2ParamDef(VertexerParamConfig, "ITSVertexerParam");
 };
@@ -39,6 +43,10 @@ struct TrackerParamConfig : public o2::conf::ConfigurableParamHelper<TrackerPara
 
   // Use TGeo for mat. budget
   bool useMatCorrTGeo = false;
+  // Threads of the CPU tracker within a ROF (tracklets, cells, roads and fits), the fits stay serial without material LUT
+  int nThreads = 1;
+  // ROFs tracked concurrently by the workflow, each with its own tracker
+  int nROFsInParallel = 1;
 
   O2ParamDef(TrackerParamConfig, "ITSCATrackerParam");
 };
@@ -20,6 +20,10 @@
 #include <iomanip>
 #include <array>
 #include <iosfwd>
+#include <memory>
+#include <vector>
+
+#include <gsl/span>
 
 #include "ITStracking/ROframe.h"
 #include "ITStracking/Constants.h"
@@ -60,6 +64,8 @@ class Vertexer
   VertexerTraits* getTraits() const { return mTraits; };
 
   float clustersToVertices(ROframe&, const bool useMc = false, std::ostream& = std::cout);
+  /// Finds the vertices of each of the events, several events concurrently with more than one thread
+  void clustersToVertices(gsl::span<ROframe> events, std::vector<std::vector<Vertex>>& vertices);
   void filterMCTracklets();
   void validateTracklets();
 
@@ -70,6 +76,10 @@ class Vertexer
   void findVertices();
   void findHistVertices();
 
+  /// Number of events vertexed concurrently, the additional threads use their own CPU vertexer traits
+  void setNThreads(int nThreads);
+  int getNThreads() const { return mNThreads; }
+
   template <typename... T>
   void initialiseVertexer(T&&... args);
 
@@ -87,8 +97,13 @@ class Vertexer
   // \debug
 
  private:
+  static std::vector<Vertex> makeVertices(const VertexerTraits& traits);
+  static void logVertices(const std::vector<Vertex>& vertices);
+
   std::uint32_t mROframe = 0;
   VertexerTraits* mTraits = nullptr;
+  int mNThreads = 1;
+  std::vector<std::unique_ptr<VertexerTraits>> mThreadTraits; // traits of the threads other than the first one
 };
 
 #ifdef _ALLOW_DEBUG_TREES_ITS_
@@ -123,6 +138,9 @@ inline VertexingParameters Vertexer::getVertParameters() const
 inline void Vertexer::setParameters(const VertexingParameters& verPar)
 {
   mTraits->updateVertexingParameters(verPar);
+  for (auto& traits : mThreadTraits) {
+    traits->updateVertexingParameters(verPar);
+  }
 }
 
 inline void Vertexer::dumpTraits()
@@ -136,18 +154,31 @@ inline void Vertexer::validateTracklets()
 }
 
 inline std::vector<Vertex> Vertexer::exportVertices()
+{
+  std::vector<Vertex> vertices{makeVertices(*mTraits)};
+  logVertices(vertices);
+  return vertices;
+}
+
+inline std::vector<Vertex> Vertexer::makeVertices(const VertexerTraits& traits)
 {
   std::vector<Vertex> vertices;
-  for (auto& vertex : mTraits->getVertices()) {
-    if (fair::Logger::Logging(fair::Severity::info)) {
-      std::cout << "\t\tFound vertex with: " << std::setw(6) << vertex.mContributors << " contributors" << std::endl;
-    }
+  for (auto& vertex : traits.getVertices()) {
     vertices.emplace_back(o2::math_utils::Point3D<float>(vertex.mX, vertex.mY, vertex.mZ), vertex.mRMS2, vertex.mContributors, vertex.mAvgDistance2);
     vertices.back().setTimeStamp(vertex.mTimeStamp);
   }
   return vertices;
 }
 
+inline void Vertexer::logVertices(const std::vector<Vertex>& vertices)
+{
+  if (fair::Logger::Logging(fair::Severity::info)) {
+    for (auto& vertex : vertices) {
+      std::cout << "\t\tFound vertex with: " << std::setw(6) << vertex.getNContributors() << " contributors" << std::endl;
+    }
+  }
+}
+
 template <typename... T>
 float Vertexer::evaluateTask(void (Vertexer::*task)(T...), const char* taskName, std::ostream& ostream,
                              T&&... args)
@@ -143,6 +143,10 @@ class VertexerTraits
   unsigned int getDebugFlags() const { return static_cast<unsigned int>(mDBGFlags); }
 
  protected:
+  // grouping of the lines in clusters around the vertex candidates, over all pairs of lines or only the close ones in z
+  void clusterLines();
+  void clusterLinesBinned();
+
   unsigned char mIsGPU;
 
   std::vector<Line> mTracklets;
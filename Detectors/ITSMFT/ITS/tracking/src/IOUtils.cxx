@@ -55,25 +55,11 @@ void ioutils::convertCompactClusters(gsl::span<const itsmft::CompClusterExt> clu
                                      const itsmft::TopologyDictionary& dict)
 {
   GeometryTGeo* geom = GeometryTGeo::Instance();
-  for (auto& c : clusters) {
-    auto pattID = c.getPatternID();
-    o2::math_utils::Point3D<float> locXYZ;
-    float sigmaY2 = ioutils::DefClusError2Row, sigmaZ2 = ioutils::DefClusError2Col, sigmaYZ = 0; //Dummy COG errors (about half pixel size)
-    if (pattID != itsmft::CompCluster::InvalidPatternID) {
-      sigmaY2 = dict.getErr2X(pattID);
-      sigmaZ2 = dict.getErr2Z(pattID);
-      if (!dict.isGroup(pattID)) {
-        locXYZ = dict.getClusterCoordinates(c);
-      } else {
-        o2::itsmft::ClusterPattern patt(pattIt);
-        locXYZ = dict.getClusterCoordinates(c, patt);
-      }
-    } else {
-      o2::itsmft::ClusterPattern patt(pattIt);
-      locXYZ = dict.getClusterCoordinates(c, patt, false);
-    }
-    auto& cl3d = output.emplace_back(c.getSensorID(), geom->getMatrixT2L(c.getSensorID()) ^ locXYZ); // local --> tracking
-    cl3d.setErrors(sigmaY2, sigmaZ2, sigmaYZ);
+  size_t first = output.size();
+  dict.convertCompactClusters(clusters, pattIt, output);
+  for (size_t iCl = first; iCl < output.size(); iCl++) {
+    auto& cl3d = output[iCl];
+    cl3d.setPos(geom->getMatrixT2L(cl3d.getSensorID()) ^ cl3d.getXYZ()); // local --> tracking
   }
 }
 
@@ -139,26 +125,16 @@ void ioutils::loadEventData(ROframe& event, gsl::span<const itsmft::CompClusterE
   GeometryTGeo* geom = GeometryTGeo::Instance();
   geom->fillMatrixCache(o2::math_utils::bit2Mask(o2::math_utils::TransformType::T2L, o2::math_utils::TransformType::L2G));
   int clusterId{0};
+  std::vector<o2::BaseCluster<float>> localClusters;
+  localClusters.reserve(clusters.size());
+  dict.convertCompactClusters(clusters, pattIt, localClusters);
 
   for (auto& c : clusters) {
     int layer = geom->getLayer(c.getSensorID());
 
-    auto pattID = c.getPatternID();
-    o2::math_utils::Point3D<float> locXYZ;
-    float sigmaY2 = ioutils::DefClusError2Row, sigmaZ2 = ioutils::DefClusError2Col, sigmaYZ = 0; //Dummy COG errors (about half pixel size)
-    if (pattID != itsmft::CompCluster::InvalidPatternID) {
-      sigmaY2 = dict.getErr2X(pattID);
-      sigmaZ2 = dict.getErr2Z(pattID);
-      if (!dict.isGroup(pattID)) {
-        locXYZ = dict.getClusterCoordinates(c);
-      } else {
-        o2::itsmft::ClusterPattern patt(pattIt);
-        locXYZ = dict.getClusterCoordinates(c, patt);
-      }
-    } else {
-      o2::itsmft::ClusterPattern patt(pattIt);
-      locXYZ = dict.getClusterCoordinates(c, patt, false);
-    }
+    const auto& cl3d = localClusters[clusterId];
+    auto locXYZ = cl3d.getXYZ();
+    float sigmaY2 = cl3d.getSigmaY2(), sigmaZ2 = cl3d.getSigmaZ2(), sigmaYZ = 0;
     auto sensorID = c.getSensorID();
     // Inverse transformation to the local --> tracking
     auto trkXYZ = geom->getMatrixT2L(sensorID) ^ locXYZ;
@@ -189,25 +165,15 @@ int ioutils::loadROFrameData(const o2::itsmft::ROFRecord& rof, ROframe& event, g
 
   auto first = rof.getFirstEntry();
   auto clusters_in_frame = rof.getROFData(clusters);
+  std::vector<o2::BaseCluster<float>> localClusters;
+  localClusters.reserve(clusters_in_frame.size());
+  dict.convertCompactClusters(clusters_in_frame, pattIt, localClusters);
   for (auto& c : clusters_in_frame) {
     int layer = geom->getLayer(c.getSensorID());
 
-    auto pattID = c.getPatternID();
-    o2::math_utils::Point3D<float> locXYZ;
-    float sigmaY2 = ioutils::DefClusError2Row, sigmaZ2 = ioutils::DefClusError2Col, sigmaYZ = 0; //Dummy COG errors (about half pixel size)
-    if (pattID != itsmft::CompCluster::InvalidPatternID) {
-      sigmaY2 = dict.getErr2X(pattID);
-      sigmaZ2 = dict.getErr2Z(pattID);
-      if (!dict.isGroup(pattID)) {
-        locXYZ = dict.getClusterCoordinates(c);
-      } else {
-        o2::itsmft::ClusterPattern patt(pattIt);
-        locXYZ = dict.getClusterCoordinates(c, patt);
-      }
-    } else {
-      o2::itsmft::ClusterPattern patt(pattIt);
-      locXYZ = dict.getClusterCoordinates(c, patt, false);
-    }
+    const auto& cl3d = localClusters[clusterId];
+    auto locXYZ = cl3d.getXYZ();
+    float sigmaY2 = cl3d.getSigmaY2(), sigmaZ2 = cl3d.getSigmaZ2(), sigmaYZ = 0;
     auto sensorID = c.getSensorID();
     // Inverse transformation to the local --> tracking
     auto trkXYZ = geom->getMatrixT2L(sensorID) ^ locXYZ;
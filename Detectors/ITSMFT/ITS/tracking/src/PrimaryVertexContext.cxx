@@ -41,6 +41,7 @@ void PrimaryVertexContext::initialise(const MemoryParameters& memParam, const Tr
     mMinR.resize(trkParam.NLayers, 10000.);
     mMaxR.resize(trkParam.NLayers, -1.);
     mClusters.resize(trkParam.NLayers);
+    mClustersSoA.resize(trkParam.NLayers);
     mUsedClusters.resize(trkParam.NLayers);
     mCells.resize(trkParam.CellsPerRoad());
     mCellsLookupTable.resize(trkParam.CellsPerRoad() - 1);
@@ -100,6 +101,7 @@ void PrimaryVertexContext::initialise(const MemoryParameters& memParam, const Tr
         c.rCoordinate = h.r;
         c.indexTableBinIndex = h.bin;
       }
+      mClustersSoA[iLayer].fill(mClusters[iLayer]);
 
       if (iLayer > 0) {
         for (unsigned int iB{0}; iB < clsPerBin.size(); ++iB) {
@@ -114,6 +116,11 @@ void PrimaryVertexContext::initialise(const MemoryParameters& memParam, const Tr
 
   mRoads.clear();
 
+  // the clusters used by the tracks of the previous passes are skipped
+  for (unsigned int iLayer{0}; iLayer < mClusters.size(); ++iLayer) {
+    mClustersSoA[iLayer].fillUsed(mClusters[iLayer], mUsedClusters[iLayer]);
+  }
+
   for (unsigned int iLayer{0}; iLayer < mClusters.size(); ++iLayer) {
     if (iLayer < mCells.size()) {
       mCells[iLayer].clear();
@@ -17,6 +17,7 @@
 #include "ITStracking/Cell.h"
 #include "ITStracking/Constants.h"
 #include "ITStracking/IndexTableUtils.h"
+#include "ITStracking/ThreadUtils.h"
 #include "ITStracking/Tracklet.h"
 #include "ITStracking/TrackerTraits.h"
 #include "ITStracking/TrackerTraitsCPU.h"
@@ -176,20 +177,20 @@ void Tracker::findRoads(int& iteration)
 
       const int levelCellsNum{static_cast<int>(mPrimaryVertexContext->getCells()[iLayer].size())};
 
-      for (int iCell{0}; iCell < levelCellsNum; ++iCell) {
+      auto findCellRoads = [&](const int iCell, std::vector<Road>& roads) {
 
-        Cell& currentCell{mPrimaryVertexContext->getCells()[iLayer][iCell]};
+        const Cell& currentCell{mPrimaryVertexContext->getCells()[iLayer][iCell]};
 
         if (currentCell.getLevel() != iLevel) {
-          continue;
+          return;
         }
 
-        mPrimaryVertexContext->getRoads().emplace_back(iLayer, iCell);
+        roads.emplace_back(iLayer, iCell);
 
         /// For 3 clusters roads (useful for cascades and hypertriton) we just store the single cell
         /// and we do not do the candidate tree traversal
         if (iLevel == 1) {
-          continue;
+          return;
         }
 
         const int cellNeighboursNum{static_cast<int>(
@@ -211,15 +212,17 @@ void Tracker::findRoads(int& iteration)
 
           } else {
 
-            mPrimaryVertexContext->getRoads().emplace_back(iLayer, iCell);
+            roads.emplace_back(iLayer, iCell);
           }
 
-          traverseCellsTree(neighbourCellId, iLayer - 1);
+          traverseCellsTree(neighbourCellId, iLayer - 1, roads);
         }
 
         // TODO: crosscheck for short track iterations
         // currentCell.setLevel(0);
-      }
+      };
+      // the roads of the cells are appended in the order of the cells, whatever the number of threads
+      thread_utils::processInChunks(levelCellsNum, mNThreads, mPrimaryVertexContext->getRoads(), nullptr, findCellRoads);
     }
 #ifdef CA_DEBUG
     nRoads += mPrimaryVertexContext->getRoads().size();
@@ -233,6 +236,14 @@ void Tracker::findTracks(const ROframe& event)
   mTracks.reserve(mTracks.capacity() + mPrimaryVertexContext->getRoads().size());
   std::vector<TrackITSExt> tracks;
   tracks.reserve(mPrimaryVertexContext->getRoads().size());
+  const int roadsNum{static_cast<int>(mPrimaryVertexContext->getRoads().size())};
+#ifdef CA_DEBUG
+  // the debug counters and the debugger output are not thread safe
+  const int nThreads{1};
+#else
+  // TGeo, used for the material budget when the lookup table is not, is not thread safe
+  const int nThreads{canFitConcurrently() ? mNThreads : 1};
+#endif
 
 #ifdef CA_DEBUG
   std::vector<int> roadCounters(mTrkParams[0].NLayers - 3, 0);
@@ -242,7 +253,8 @@ void Tracker::findTracks(const ROframe& event)
   std::vector<int> nonsharingCounters(mTrkParams[0].NLayers - 3, 0);
 #endif
 
-  for (auto& road : mPrimaryVertexContext->getRoads()) {
+  auto fitRoad = [&](const int iRoad, std::vector<TrackITSExt>& fittedTracks) {
+    Road& road{mPrimaryVertexContext->getRoads()[iRoad]};
     std::vector<int> clusters(mTrkParams[0].NLayers, constants::its::UnusedIndex);
     int lastCellLevel = constants::its::UnusedIndex;
     CA_DEBUGGER(int nClusters = 2);
@@ -267,7 +279,7 @@ void Tracker::findTracks(const ROframe& event)
     CA_DEBUGGER(roadCounters[nClusters - 4]++);
 
     if (lastCellLevel == constants::its::UnusedIndex) {
-      continue;
+      return;
     }
 
     /// From primary vertex context index to event index (== the one used as input of the tracking code)
@@ -291,13 +303,13 @@ void Tracker::findTracks(const ROframe& event)
     }
     bool fitSuccess = fitTrack(event, temporaryTrack, mTrkParams[0].NLayers - 4, -1, -1);
     if (!fitSuccess) {
-      continue;
+      return;
     }
     CA_DEBUGGER(fitCounters[nClusters - 4]++);
     temporaryTrack.resetCovariance();
     fitSuccess = fitTrack(event, temporaryTrack, 0, mTrkParams[0].NLayers, 1, mTrkParams[0].FitIterationMaxChi2[0]);
     if (!fitSuccess) {
-      continue;
+      return;
     }
     CA_DEBUGGER(backpropagatedCounters[nClusters - 4]++);
     temporaryTrack.getParamOut() = temporaryTrack;
@@ -307,12 +319,14 @@ void Tracker::findTracks(const ROframe& event)
     mDebugger->dumpTrackToBranchWithInfo("testBranch", temporaryTrack, event, mPrimaryVertexContext, true);
 #endif
     if (!fitSuccess) {
-      continue;
+      return;
     }
     CA_DEBUGGER(refitCounters[nClusters - 4]++);
-    tracks.emplace_back(temporaryTrack);
+    fittedTracks.emplace_back(temporaryTrack);
     CA_DEBUGGER(assert(nClusters == temporaryTrack.getNumberOfClusters()));
-  }
+  };
+  // the fitted tracks are stored in the order of the roads, the selection below does not depend on the number of threads
+  thread_utils::processInChunks(roadsNum, nThreads, tracks, nullptr, fitRoad);
   //mTraits->refitTracks(event.getTrackingFrameInfo(), tracks);
 
   std::sort(tracks.begin(), tracks.end(),
@@ -439,12 +453,12 @@ bool Tracker::fitTrack(const ROframe& event, TrackITSExt& track, int start, int
   return true;
 }
 
-void Tracker::traverseCellsTree(const int currentCellId, const int currentLayerId)
+void Tracker::traverseCellsTree(const int currentCellId, const int currentLayerId, std::vector<Road>& roads)
 {
-  Cell& currentCell{mPrimaryVertexContext->getCells()[currentLayerId][currentCellId]};
+  const Cell& currentCell{mPrimaryVertexContext->getCells()[currentLayerId][currentCellId]};
   const int currentCellLevel = currentCell.getLevel();
 
-  mPrimaryVertexContext->getRoads().back().addCell(currentLayerId, currentCellId);
+  roads.back().addCell(currentLayerId, currentCellId);
 
   if (currentLayerId > 0 && currentCellLevel > 1) {
     const int cellNeighboursNum{static_cast<int>(
@@ -464,10 +478,10 @@ void Tracker::traverseCellsTree(const int currentCellId, const int currentLayerI
       if (isFirstValidNeighbour) {
         isFirstValidNeighbour = false;
       } else {
-        mPrimaryVertexContext->getRoads().push_back(mPrimaryVertexContext->getRoads().back());
+        roads.push_back(roads.back());
       }
 
-      traverseCellsTree(neighbourCellId, currentLayerId - 1);
+      traverseCellsTree(neighbourCellId, currentLayerId - 1, roads);
     }
   }
 
@@ -644,12 +658,19 @@ track::TrackParCov Tracker::buildTrackSeed(const Cluster& cluster1, const Cluste
                              s2 * fy * cy, 0.f, s2 * cy * cy});
 }
 
+void Tracker::setNThreads(int nThreads)
+{
+  mNThreads = nThreads > 0 ? nThreads : 1;
+  mTraits->setNThreads(mNThreads);
+}
+
 void Tracker::getGlobalConfiguration()
 {
   auto& tc = o2::its::TrackerParamConfig::Instance();
   if (tc.useMatCorrTGeo) {
     setCorrType(o2::base::PropagatorImpl<float>::MatCorrType::USEMatCorrTGeo);
   }
+  setNThreads(tc.nThreads);
 }
 
 } // namespace its
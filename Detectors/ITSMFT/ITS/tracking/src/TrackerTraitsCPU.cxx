@@ -16,12 +16,16 @@
 
 #include "CommonConstants/MathConstants.h"
 #include "ITStracking/Cell.h"
+#include "ITStracking/ClusterLayerSoA.h"
 #include "ITStracking/Constants.h"
 #include "ITStracking/IndexTableUtils.h"
+#include "ITStracking/ThreadUtils.h"
 #include "ITStracking/Tracklet.h"
 #include <fmt/format.h>
 #include "ReconstructionDataFormats/Track.h"
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <iostream>
 
 #include "GPUCommonMath.h"
@@ -31,6 +35,82 @@ namespace o2
 namespace its
 {
 
+namespace
+{
+/// Number of candidates checked at once by the vectorised selections
+constexpr int SelectionBlockSize{64};
+
+/// Structure of arrays of the tracklets of a layer, for the selection of the cells
+struct TrackletLayerSoA {
+  explicit TrackletLayerSoA(const std::vector<Tracklet>& tracklets)
+  {
+    tanLambdas.reserve(tracklets.size());
+    phiCoordinates.reserve(tracklets.size());
+    firstClusterIndices.reserve(tracklets.size());
+    for (const auto& tracklet : tracklets) {
+      tanLambdas.push_back(tracklet.tanLambda);
+      phiCoordinates.push_back(tracklet.phiCoordinate);
+      firstClusterIndices.push_back(tracklet.firstClusterIndex);
+    }
+  }
+
+  std::vector<float> tanLambdas;
+  std::vector<float> phiCoordinates;
+  std::vector<int> firstClusterIndices;
+};
+
+/// Flags the clusters [first, first + n) of the next layer which are not used and are compatible in z and phi with the
+/// line from the primary vertex through the current cluster. The loop has no branches so that it is vectorised.
+inline void selectTrackletCandidates(const ClusterLayerSoA& nextLayer, const int first, const int n, const float tanLambda,
+                                     const Cluster& currentCluster, const float maxDeltaZ, const float maxDeltaPhi,
+                                     unsigned char* selected)
+{
+  const float* rCoordinates{nextLayer.rCoordinates.data() + first};
+  const float* zCoordinates{nextLayer.zCoordinates.data() + first};
+  const float* phiCoordinates{nextLayer.phiCoordinates.data() + first};
+  const unsigned char* used{nextLayer.used.data() + first};
+  const float rCoordinate{currentCluster.rCoordinate};
+  const float zCoordinate{currentCluster.zCoordinate};
+  const float phiCoordinate{currentCluster.phiCoordinate};
+#ifdef WITH_OPENMP
+#pragma omp simd
+#endif
+  for (int iCandidate = 0; iCandidate < n; ++iCandidate) {
+    const float deltaZ{std::abs(tanLambda * (rCoordinates[iCandidate] - rCoordinate) + zCoordinate - zCoordinates[iCandidate])};
+    const float deltaPhi{std::abs(phiCoordinate - phiCoordinates[iCandidate])};
+    selected[iCandidate] = (used[iCandidate] == 0) & (deltaZ < maxDeltaZ) &
+                           ((deltaPhi < maxDeltaPhi) | (std::abs(deltaPhi - constants::math::TwoPi) < maxDeltaPhi));
+  }
+}
+
+/// Flags the tracklets [first, first + n) of the next layer compatible in tanLambda and phi with the current tracklet,
+/// and whose average direction points to the primary vertex in z. The loop has no branches so that it is vectorised.
+inline void selectCellCandidates(const TrackletLayerSoA& nextLayer, const int first, const int n, const Tracklet& currentTracklet,
+                                 const Cluster& firstCellCluster, const float primaryVertexZ, const float maxDeltaTanLambda,
+                                 const float maxDeltaPhi, const float maxDeltaZ, unsigned char* selected)
+{
+  const float* tanLambdas{nextLayer.tanLambdas.data() + first};
+  const float* phiCoordinates{nextLayer.phiCoordinates.data() + first};
+  const float tanLambda{currentTracklet.tanLambda};
+  const float phiCoordinate{currentTracklet.phiCoordinate};
+  const float rCoordinate{firstCellCluster.rCoordinate};
+  const float zCoordinate{firstCellCluster.zCoordinate};
+#ifdef WITH_OPENMP
+#pragma omp simd
+#endif
+  for (int iCandidate = 0; iCandidate < n; ++iCandidate) {
+    const float deltaTanLambda{std::abs(tanLambda - tanLambdas[iCandidate])};
+    const float deltaPhi{std::abs(phiCoordinate - phiCoordinates[iCandidate])};
+    const float averageTanLambda{0.5f * (tanLambda + tanLambdas[iCandidate])};
+    const float directionZIntersection{-averageTanLambda * rCoordinate + zCoordinate};
+    const float deltaZ{std::abs(directionZIntersection - primaryVertexZ)};
+    selected[iCandidate] = (deltaTanLambda < maxDeltaTanLambda) &
+                           ((deltaPhi < maxDeltaPhi) | (std::abs(deltaPhi - constants::math::TwoPi) < maxDeltaPhi)) &
+                           (deltaZ < maxDeltaZ);
+  }
+}
+} // namespace
+
 void TrackerTraitsCPU::computeLayerTracklets()
 {
   PrimaryVertexContext* primaryVertexContext = mPrimaryVertexContext;
@@ -41,12 +121,13 @@ void TrackerTraitsCPU::computeLayerTracklets()
 
     const float3& primaryVertex = primaryVertexContext->getPrimaryVertex();
     const int currentLayerClustersNum{static_cast<int>(primaryVertexContext->getClusters()[iLayer].size())};
+    const ClusterLayerSoA& nextLayerClusters{primaryVertexContext->getClustersSoA()[iLayer + 1]};
 
-    for (int iCluster{0}; iCluster < currentLayerClustersNum; ++iCluster) {
+    auto findClusterTracklets = [&](const int iCluster, std::vector<Tracklet>& tracklets) {
       const Cluster& currentCluster{primaryVertexContext->getClusters()[iLayer][iCluster]};
 
       if (primaryVertexContext->isClusterUsed(iLayer, currentCluster.clusterId)) {
-        continue;
+        return;
       }
 
       const float tanLambda{(currentCluster.zCoordinate - primaryVertex.z) / currentCluster.rCoordinate};
@@ -61,7 +142,7 @@ void TrackerTraitsCPU::computeLayerTracklets()
                                               mTrkParams.TrackletMaxDeltaZ[iLayer], mTrkParams.TrackletMaxDeltaPhi)};
 
       if (selectedBinsRect.x == 0 && selectedBinsRect.y == 0 && selectedBinsRect.z == 0 && selectedBinsRect.w == 0) {
-        continue;
+        return;
       }
 
       int phiBinsNum{selectedBinsRect.w - selectedBinsRect.y + 1};
@@ -77,40 +158,29 @@ void TrackerTraitsCPU::computeLayerTracklets()
         const int firstRowClusterIndex = primaryVertexContext->getIndexTables()[iLayer][firstBinIndex];
         const int maxRowClusterIndex = primaryVertexContext->getIndexTables()[iLayer][maxBinIndex];
 
-        for (int iNextLayerCluster{firstRowClusterIndex}; iNextLayerCluster < maxRowClusterIndex;
-             ++iNextLayerCluster) {
-
-          if (iNextLayerCluster >= (int)primaryVertexContext->getClusters()[iLayer + 1].size()) {
-            break;
-          }
+        const int lastRowClusterIndex{std::min(maxRowClusterIndex, nextLayerClusters.size())};
 
-          const Cluster& nextCluster{primaryVertexContext->getClusters()[iLayer + 1][iNextLayerCluster]};
+        for (int iBlockStart{firstRowClusterIndex}; iBlockStart < lastRowClusterIndex; iBlockStart += SelectionBlockSize) {
+          const int blockSize{std::min(SelectionBlockSize, lastRowClusterIndex - iBlockStart)};
+          unsigned char selected[SelectionBlockSize];
+          selectTrackletCandidates(nextLayerClusters, iBlockStart, blockSize, tanLambda, currentCluster,
+                                   mTrkParams.TrackletMaxDeltaZ[iLayer], mTrkParams.TrackletMaxDeltaPhi, selected);
 
-          if (primaryVertexContext->isClusterUsed(iLayer + 1, nextCluster.clusterId)) {
-            continue;
-          }
-
-          const float deltaZ{o2::gpu::GPUCommonMath::Abs(tanLambda * (nextCluster.rCoordinate - currentCluster.rCoordinate) +
-                                                         currentCluster.zCoordinate - nextCluster.zCoordinate)};
-          const float deltaPhi{o2::gpu::GPUCommonMath::Abs(currentCluster.phiCoordinate - nextCluster.phiCoordinate)};
-
-          if (deltaZ < mTrkParams.TrackletMaxDeltaZ[iLayer] &&
-              (deltaPhi < mTrkParams.TrackletMaxDeltaPhi ||
-               o2::gpu::GPUCommonMath::Abs(deltaPhi - constants::math::TwoPi) < mTrkParams.TrackletMaxDeltaPhi)) {
-
-            if (iLayer > 0 &&
-                primaryVertexContext->getTrackletsLookupTable()[iLayer - 1][iCluster] == constants::its::UnusedIndex) {
-
-              primaryVertexContext->getTrackletsLookupTable()[iLayer - 1][iCluster] =
-                primaryVertexContext->getTracklets()[iLayer].size();
+          for (int iCandidate{0}; iCandidate < blockSize; ++iCandidate) {
+            if (selected[iCandidate]) {
+              const int iNextLayerCluster{iBlockStart + iCandidate};
+              tracklets.emplace_back(iCluster, iNextLayerCluster, currentCluster,
+                                     primaryVertexContext->getClusters()[iLayer + 1][iNextLayerCluster]);
             }
-
-            primaryVertexContext->getTracklets()[iLayer].emplace_back(iCluster, iNextLayerCluster, currentCluster,
-                                                                      nextCluster);
           }
         }
       }
-    }
+    };
+    // the lookup table points to the first tracklet of each cluster, set in the order of the clusters
+    thread_utils::processInChunks(currentLayerClustersNum, mNThreads, primaryVertexContext->getTracklets()[iLayer],
+                                  iLayer > 0 ? &primaryVertexContext->getTrackletsLookupTable()[iLayer - 1] : nullptr,
+                                  findClusterTracklets);
+
     if (iLayer > 0 && iLayer < mTrkParams.TrackletsPerRoad() - 1 &&
         primaryVertexContext->getTracklets()[iLayer].size() > primaryVertexContext->getCellsLookupTable()[iLayer - 1].size()) {
       throw std::runtime_error(fmt::format("not enough memory in the CellsLookupTable, increase the tracklet memory coefficients: {} tracklets on L{}, lookup table size {} on L{}",
@@ -139,8 +209,9 @@ void TrackerTraitsCPU::computeLayerCells()
 
     const float3& primaryVertex = primaryVertexContext->getPrimaryVertex();
     const int currentLayerTrackletsNum{static_cast<int>(primaryVertexContext->getTracklets()[iLayer].size())};
+    const TrackletLayerSoA nextLayerTracklets{primaryVertexContext->getTracklets()[iLayer + 1]};
 
-    for (int iTracklet{0}; iTracklet < currentLayerTrackletsNum; ++iTracklet) {
+    auto findTrackletCells = [&](const int iTracklet, std::vector<Cell>& cells) {
 
       const Tracklet& currentTracklet{primaryVertexContext->getTracklets()[iLayer][iTracklet]};
       const int nextLayerClusterIndex{currentTracklet.secondClusterIndex};
@@ -149,7 +220,7 @@ void TrackerTraitsCPU::computeLayerCells()
 
       if (nextLayerFirstTrackletIndex == constants::its::UnusedIndex) {
 
-        continue;
+        return;
       }
 
       const Cluster& firstCellCluster{primaryVertexContext->getClusters()[iLayer][currentTracklet.firstClusterIndex]};
@@ -163,27 +234,22 @@ void TrackerTraitsCPU::computeLayerCells()
                                     secondCellClusterQuadraticRCoordinate - firstCellClusterQuadraticRCoordinate};
       const int nextLayerTrackletsNum{static_cast<int>(primaryVertexContext->getTracklets()[iLayer + 1].size())};
 
-      for (int iNextLayerTracklet{nextLayerFirstTrackletIndex};
-           iNextLayerTracklet < nextLayerTrackletsNum &&
-           primaryVertexContext->getTracklets()[iLayer + 1][iNextLayerTracklet].firstClusterIndex ==
-             nextLayerClusterIndex;
-           ++iNextLayerTracklet) {
-
-        const Tracklet& nextTracklet{primaryVertexContext->getTracklets()[iLayer + 1][iNextLayerTracklet]};
-        const float deltaTanLambda{std::abs(currentTracklet.tanLambda - nextTracklet.tanLambda)};
-        const float deltaPhi{std::abs(currentTracklet.phiCoordinate - nextTracklet.phiCoordinate)};
-
-        if (deltaTanLambda < mTrkParams.CellMaxDeltaTanLambda &&
-            (deltaPhi < mTrkParams.CellMaxDeltaPhi ||
-             std::abs(deltaPhi - constants::math::TwoPi) < mTrkParams.CellMaxDeltaPhi)) {
-
-          const float averageTanLambda{0.5f * (currentTracklet.tanLambda + nextTracklet.tanLambda)};
-          const float directionZIntersection{-averageTanLambda * firstCellCluster.rCoordinate +
-                                             firstCellCluster.zCoordinate};
-          const float deltaZ{std::abs(directionZIntersection - primaryVertex.z)};
+      int nextLayerLastTrackletIndex{nextLayerFirstTrackletIndex};
+      while (nextLayerLastTrackletIndex < nextLayerTrackletsNum &&
+             nextLayerTracklets.firstClusterIndices[nextLayerLastTrackletIndex] == nextLayerClusterIndex) {
+        ++nextLayerLastTrackletIndex;
+      }
 
-          if (deltaZ < mTrkParams.CellMaxDeltaZ[iLayer]) {
+      for (int iBlockStart{nextLayerFirstTrackletIndex}; iBlockStart < nextLayerLastTrackletIndex; iBlockStart += SelectionBlockSize) {
+        const int blockSize{std::min(SelectionBlockSize, nextLayerLastTrackletIndex - iBlockStart)};
+        unsigned char selected[SelectionBlockSize];
+        selectCellCandidates(nextLayerTracklets, iBlockStart, blockSize, currentTracklet, firstCellCluster, primaryVertex.z,
+                             mTrkParams.CellMaxDeltaTanLambda, mTrkParams.CellMaxDeltaPhi, mTrkParams.CellMaxDeltaZ[iLayer], selected);
 
+        for (int iCandidate{0}; iCandidate < blockSize; ++iCandidate) {
+          if (selected[iCandidate]) {
+            const int iNextLayerTracklet{iBlockStart + iCandidate};
+            const Tracklet& nextTracklet{primaryVertexContext->getTracklets()[iLayer + 1][iNextLayerTracklet]};
             const Cluster& thirdCellCluster{
               primaryVertexContext->getClusters()[iLayer + 2][nextTracklet.secondClusterIndex]};
 
@@ -230,20 +296,16 @@ void TrackerTraitsCPU::computeLayerCells()
             }
 
             const float cellTrajectoryCurvature{1.0f / cellTrajectoryRadius};
-            if (iLayer > 0 &&
-                primaryVertexContext->getCellsLookupTable()[iLayer - 1][iTracklet] == constants::its::UnusedIndex) {
-
-              primaryVertexContext->getCellsLookupTable()[iLayer - 1][iTracklet] =
-                primaryVertexContext->getCells()[iLayer].size();
-            }
-
-            primaryVertexContext->getCells()[iLayer].emplace_back(
-              currentTracklet.firstClusterIndex, nextTracklet.firstClusterIndex, nextTracklet.secondClusterIndex,
-              iTracklet, iNextLayerTracklet, normalizedPlaneVector, cellTrajectoryCurvature);
+            cells.emplace_back(currentTracklet.firstClusterIndex, nextTracklet.firstClusterIndex, nextTracklet.secondClusterIndex,
+                               iTracklet, iNextLayerTracklet, normalizedPlaneVector, cellTrajectoryCurvature);
           }
         }
       }
-    }
+    };
+    // the lookup table points to the first cell of each tracklet, set in the order of the tracklets
+    thread_utils::processInChunks(currentLayerTrackletsNum, mNThreads, primaryVertexContext->getCells()[iLayer],
+                                  iLayer > 0 ? &primaryVertexContext->getCellsLookupTable()[iLayer - 1] : nullptr,
+                                  findTrackletCells);
   }
 #ifdef CA_DEBUG
   std::cout << "+++ Number of cells per layer: ";
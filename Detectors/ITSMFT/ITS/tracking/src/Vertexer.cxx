@@ -20,7 +20,13 @@
 #include "ITStracking/VertexerTraits.h"
 #include "ITStracking/TrackingConfigParam.h"
 
+#include <algorithm>
 #include <array>
+#include <exception>
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 
 namespace o2
 {
@@ -49,6 +55,58 @@ float Vertexer::clustersToVertices(ROframe& event, const bool useMc, std::ostrea
   return total;
 }
 
+void Vertexer::clustersToVertices(gsl::span<ROframe> events, std::vector<std::vector<Vertex>>& vertices)
+{
+  vertices.clear();
+  vertices.resize(events.size());
+  std::vector<std::exception_ptr> errors(events.size());
+  const int nThreads{std::min(mNThreads, std::max(static_cast<int>(events.size()), 1))};
+#ifdef WITH_OPENMP
+#pragma omp parallel for num_threads(nThreads) schedule(dynamic)
+#endif
+  for (int iEvent = 0; iEvent < static_cast<int>(events.size()); ++iEvent) {
+#ifdef WITH_OPENMP
+    const int iThread{omp_get_thread_num()};
+#else
+    const int iThread{0};
+#endif
+    VertexerTraits& traits = iThread == 0 ? *mTraits : *mThreadTraits[iThread - 1];
+    try {
+      traits.initialise(&events[iEvent]);
+      traits.computeTracklets();
+      traits.computeTrackletMatching();
+      traits.computeVertices();
+      vertices[iEvent] = makeVertices(traits);
+    } catch (...) {
+      errors[iEvent] = std::current_exception();
+    }
+  }
+  for (auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+  for (auto& eventVertices : vertices) {
+    logVertices(eventVertices);
+  }
+}
+
+void Vertexer::setNThreads(int nThreads)
+{
+#ifdef _ALLOW_DEBUG_TREES_ITS_
+  mNThreads = 1; // the debug trees are written by a single traits
+#else
+  mNThreads = std::max(nThreads, 1);
+#endif
+  mThreadTraits.resize(mNThreads - 1);
+  for (auto& traits : mThreadTraits) {
+    if (!traits) {
+      traits = std::make_unique<VertexerTraits>();
+    }
+    traits->updateVertexingParameters(mTraits->getVertexingParameters());
+  }
+}
+
 void Vertexer::findVertices()
 {
   mTraits->computeVertices();
@@ -72,8 +130,10 @@ void Vertexer::getGlobalConfiguration()
   verPar.tanLambdaCut = vc.tanLambdaCut;
   verPar.clusterContributorsCut = vc.clusterContributorsCut;
   verPar.phiSpan = vc.phiSpan;
+  verPar.lineClusteringZWindow = vc.lineClusteringZWindow;
 
-  mTraits->updateVertexingParameters(verPar);
+  setParameters(verPar);
+  setNThreads(vc.nThreads);
 }
 } // namespace its
 } // namespace o2
@@ -12,7 +12,10 @@
 /// \brief
 /// \author matteo.concas@cern.ch
 
+#include <algorithm>
 #include <cassert>
+#include <limits>
+#include <numeric>
 #include <ostream>
 #include <boost/histogram.hpp>
 #include <boost/format.hpp>
@@ -390,39 +393,10 @@ void VertexerTraits::computeMCFiltering()
 
 void VertexerTraits::computeVertices()
 {
-  const int numTracklets{static_cast<int>(mTracklets.size())};
-  std::vector<bool> usedTracklets{};
-  usedTracklets.resize(mTracklets.size(), false);
-  for (int tracklet1{0}; tracklet1 < numTracklets; ++tracklet1) {
-    if (usedTracklets[tracklet1]) {
-      continue;
-    }
-    for (int tracklet2{tracklet1 + 1}; tracklet2 < numTracklets; ++tracklet2) {
-      if (usedTracklets[tracklet2]) {
-        continue;
-      }
-      if (Line::getDCA(mTracklets[tracklet1], mTracklets[tracklet2]) <= mVrtParams.pairCut) {
-        mTrackletClusters.emplace_back(tracklet1, mTracklets[tracklet1], tracklet2, mTracklets[tracklet2]);
-        std::array<float, 3> tmpVertex{mTrackletClusters.back().getVertex()};
-        if (tmpVertex[0] * tmpVertex[0] + tmpVertex[1] * tmpVertex[1] > 4.f) {
-          mTrackletClusters.pop_back();
-          break;
-        }
-        usedTracklets[tracklet1] = true;
-        usedTracklets[tracklet2] = true;
-        for (int tracklet3{0}; tracklet3 < numTracklets; ++tracklet3) {
-          if (usedTracklets[tracklet3]) {
-            continue;
-          }
-          if (Line::getDistanceFromPoint(mTracklets[tracklet3], tmpVertex) < mVrtParams.pairCut) {
-            mTrackletClusters.back().add(tracklet3, mTracklets[tracklet3]);
-            usedTracklets[tracklet3] = true;
-            tmpVertex = mTrackletClusters.back().getVertex();
-          }
-        }
-        break;
-      }
-    }
+  if (mVrtParams.lineClusteringZWindow > 0.f) {
+    clusterLinesBinned();
+  } else {
+    clusterLines();
   }
 #ifdef _ALLOW_DEBUG_TREES_ITS_
   if (isDebugFlag(VertexerDebug::LineSummaryAll)) {
@@ -486,6 +460,130 @@ void VertexerTraits::computeVertices()
 #endif
 }
 
+void VertexerTraits::clusterLines()
+{
+  const int numTracklets{static_cast<int>(mTracklets.size())};
+  std::vector<bool> usedTracklets{};
+  usedTracklets.resize(mTracklets.size(), false);
+  for (int tracklet1{0}; tracklet1 < numTracklets; ++tracklet1) {
+    if (usedTracklets[tracklet1]) {
+      continue;
+    }
+    for (int tracklet2{tracklet1 + 1}; tracklet2 < numTracklets; ++tracklet2) {
+      if (usedTracklets[tracklet2]) {
+        continue;
+      }
+      if (Line::getDCA(mTracklets[tracklet1], mTracklets[tracklet2]) <= mVrtParams.pairCut) {
+        mTrackletClusters.emplace_back(tracklet1, mTracklets[tracklet1], tracklet2, mTracklets[tracklet2]);
+        std::array<float, 3> tmpVertex{mTrackletClusters.back().getVertex()};
+        if (tmpVertex[0] * tmpVertex[0] + tmpVertex[1] * tmpVertex[1] > 4.f) {
+          mTrackletClusters.pop_back();
+          break;
+        }
+        usedTracklets[tracklet1] = true;
+        usedTracklets[tracklet2] = true;
+        for (int tracklet3{0}; tracklet3 < numTracklets; ++tracklet3) {
+          if (usedTracklets[tracklet3]) {
+            continue;
+          }
+          if (Line::getDistanceFromPoint(mTracklets[tracklet3], tmpVertex) < mVrtParams.pairCut) {
+            mTrackletClusters.back().add(tracklet3, mTracklets[tracklet3]);
+            usedTracklets[tracklet3] = true;
+            tmpVertex = mTrackletClusters.back().getVertex();
+          }
+        }
+        break;
+      }
+    }
+  }
+}
+
+void VertexerTraits::clusterLinesBinned()
+{
+  // same greedy clustering as clusterLines, but the partners of a line are only looked for among the lines which are
+  // close in z at their closest approach to the beam axis, found in a table of z bins at least as wide as the window
+  const int numTracklets{static_cast<int>(mTracklets.size())};
+  if (numTracklets == 0) {
+    return;
+  }
+  const float zWindow{mVrtParams.lineClusteringZWindow};
+  std::vector<float> linesZ(numTracklets);
+  float minZ{std::numeric_limits<float>::max()}, maxZ{std::numeric_limits<float>::lowest()};
+  for (int iTracklet{0}; iTracklet < numTracklets; ++iTracklet) {
+    const Line& line{mTracklets[iTracklet]};
+    const float transverseNorm2{line.cosinesDirector[0] * line.cosinesDirector[0] + line.cosinesDirector[1] * line.cosinesDirector[1]};
+    const float step{transverseNorm2 > constants::math::FloatMinThreshold ? -(line.originPoint[0] * line.cosinesDirector[0] + line.originPoint[1] * line.cosinesDirector[1]) / transverseNorm2 : 0.f};
+    linesZ[iTracklet] = line.originPoint[2] + line.cosinesDirector[2] * step;
+    minZ = std::min(minZ, linesZ[iTracklet]);
+    maxZ = std::max(maxZ, linesZ[iTracklet]);
+  }
+  // clamped in float, a narrow window can give more bins than an int holds
+  const int nBins{1 + static_cast<int>(std::min((maxZ - minZ) / zWindow, static_cast<float>(numTracklets - 1)))};
+  const float inverseBinSize{nBins / std::max(maxZ - minZ, nBins * zWindow)};
+  auto getBin = [&](const float z) {
+    return std::max(0, std::min(nBins - 1, static_cast<int>((z - minZ) * inverseBinSize)));
+  };
+
+  // counting sort of the lines by bin, keeping the order of the lines within a bin
+  std::vector<int> binOffsets(nBins + 1, 0);
+  for (int iTracklet{0}; iTracklet < numTracklets; ++iTracklet) {
+    ++binOffsets[getBin(linesZ[iTracklet]) + 1];
+  }
+  std::partial_sum(binOffsets.begin(), binOffsets.end(), binOffsets.begin());
+  std::vector<int> sortedLines(numTracklets);
+  std::vector<int> binFill(binOffsets.begin(), binOffsets.end() - 1);
+  for (int iTracklet{0}; iTracklet < numTracklets; ++iTracklet) {
+    sortedLines[binFill[getBin(linesZ[iTracklet])]++] = iTracklet;
+  }
+
+  std::vector<bool> usedTracklets(numTracklets, false);
+  // unused lines from firstTracklet on within the z window around z, in the order of the lines
+  std::vector<int> candidates;
+  auto findCandidates = [&](const float z, const int firstTracklet) {
+    candidates.clear();
+    const int bin{getBin(z)};
+    for (int iBin{std::max(0, bin - 1)}; iBin <= std::min(nBins - 1, bin + 1); ++iBin) {
+      for (int iEntry{binOffsets[iBin]}; iEntry < binOffsets[iBin + 1]; ++iEntry) {
+        const int iTracklet{sortedLines[iEntry]};
+        if (iTracklet >= firstTracklet && !usedTracklets[iTracklet] && std::abs(linesZ[iTracklet] - z) < zWindow) {
+          candidates.push_back(iTracklet);
+        }
+      }
+    }
+    std::sort(candidates.begin(), candidates.end());
+  };
+
+  std::vector<int> pairCandidates;
+  for (int tracklet1{0}; tracklet1 < numTracklets; ++tracklet1) {
+    if (usedTracklets[tracklet1]) {
+      continue;
+    }
+    findCandidates(linesZ[tracklet1], tracklet1 + 1);
+    pairCandidates.swap(candidates);
+    for (int tracklet2 : pairCandidates) {
+      if (Line::getDCA(mTracklets[tracklet1], mTracklets[tracklet2]) <= mVrtParams.pairCut) {
+        mTrackletClusters.emplace_back(tracklet1, mTracklets[tracklet1], tracklet2, mTracklets[tracklet2]);
+        std::array<float, 3> tmpVertex{mTrackletClusters.back().getVertex()};
+        if (tmpVertex[0] * tmpVertex[0] + tmpVertex[1] * tmpVertex[1] > 4.f) {
+          mTrackletClusters.pop_back();
+          break;
+        }
+        usedTracklets[tracklet1] = true;
+        usedTracklets[tracklet2] = true;
+        findCandidates(tmpVertex[2], 0);
+        for (int tracklet3 : candidates) {
+          if (Line::getDistanceFromPoint(mTracklets[tracklet3], tmpVertex) < mVrtParams.pairCut) {
+            mTrackletClusters.back().add(tracklet3, mTracklets[tracklet3]);
+            usedTracklets[tracklet3] = true;
+            tmpVertex = mTrackletClusters.back().getVertex();
+          }
+        }
+        break;
+      }
+    }
+  }
+}
+
 void VertexerTraits::computeHistVertices()
 {
   o2::its::VertexerHistogramsConfiguration histConf;
@@ -0,0 +1,84 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file bench_Vertexer.cxx
+/// \brief Benchmark of the ITS vertexer on recorded clusters
+///
+/// Usage: o2-bench-its-vertexer [benchmark options] --clusters o2clus_its.root [--dictionary dictionary.bin]
+/// The ROFs of the first entry of the cluster tree are vertexed with 1 to 8 threads, with the pairing of all the lines
+/// and with the binned pairing of the lines.
+
+#include <memory>
+#include <vector>
+
+#include <gsl/gsl>
+
+#include "ClustersBenchmarkHelper.h"
+#include "ITStracking/IOUtils.h"
+#include "ITStracking/ROframe.h"
+#include "ITStracking/Vertexer.h"
+#include "ITStracking/VertexerTraits.h"
+
+namespace
+{
+std::vector<o2::its::ROframe> gEvents;
+
+bool loadEvents(const std::map<std::string, std::string>& options)
+{
+  o2::itsmft::benchmark_helper::ClustersInput input;
+  if (!o2::itsmft::benchmark_helper::readClusters("ITS", options, input)) {
+    return false;
+  }
+  gsl::span<const unsigned char> patterns(input.patterns);
+  auto pattIt = patterns.begin();
+  for (size_t iROF{0}; iROF < input.rofs.size(); ++iROF) {
+    auto& event = gEvents.emplace_back(iROF, 7);
+    if (!o2::its::ioutils::loadROFrameData(input.rofs[iROF], event, input.clusters, pattIt, input.dict)) {
+      gEvents.pop_back();
+    }
+  }
+  std::cout << "Loaded " << gEvents.size() << " ROFs with clusters" << std::endl;
+  return !gEvents.empty();
+}
+} // namespace
+
+static void BM_Vertexer(benchmark::State& state)
+{
+  auto traits = std::make_unique<o2::its::VertexerTraits>();
+  o2::its::Vertexer vertexer(traits.get());
+  o2::its::VertexingParameters parameters;
+  parameters.lineClusteringZWindow = state.range(1) ? 0.5f : 0.f;
+  vertexer.setParameters(parameters);
+  vertexer.setNThreads(state.range(0));
+
+  std::vector<std::vector<o2::its::Vertex>> vertices;
+  o2::itsmft::benchmark_helper::runOnEvents(state, gEvents, [&](auto& events) { vertexer.clustersToVertices(events, vertices); });
+  size_t nVertices{0};
+  for (auto& eventVertices : vertices) {
+    nVertices += eventVertices.size();
+  }
+  state.counters["vertices"] = nVertices;
+}
+
+static void CustomArguments(benchmark::internal::Benchmark* bench)
+{
+  for (int binned{0}; binned < 2; ++binned) {
+    for (int nThreads{1}; nThreads <= 8; nThreads *= 2) {
+      bench->Args({nThreads, binned});
+    }
+  }
+}
+
+BENCHMARK(BM_Vertexer)->Apply(CustomArguments)->ArgNames({"threads", "binned"})->Unit(benchmark::kMillisecond)->UseRealTime();
+
+int main(int argc, char** argv)
+{
+  return o2::itsmft::benchmark_helper::runBenchmarks(argc, argv, "--clusters <o2clus_its.root> [--dictionary <file>]", loadEvents);
+}
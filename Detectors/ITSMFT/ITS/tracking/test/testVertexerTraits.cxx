@@ -0,0 +1,85 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test ITS VertexerTraits
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "ITStracking/ClusterLines.h"
+#include "ITStracking/VertexerTraits.h"
+
+using namespace o2::its;
+
+namespace
+{
+// gives access to the clustering of the lines
+class LinesClusterer : public VertexerTraits
+{
+ public:
+  std::vector<std::vector<int>> cluster(const std::vector<Line>& lines, float zWindow)
+  {
+    mTracklets = lines;
+    mTrackletClusters.clear();
+    mVrtParams.lineClusteringZWindow = zWindow;
+    if (zWindow > 0.f) {
+      clusterLinesBinned();
+    } else {
+      clusterLines();
+    }
+    std::vector<std::vector<int>> labels;
+    for (auto& cluster : mTrackletClusters) {
+      labels.push_back(cluster.getLabels());
+    }
+    return labels;
+  }
+};
+
+// lines from a few vertices along the beam axis, in the order of the random directions, and some random lines
+std::vector<Line> makeLines()
+{
+  std::mt19937 generator(1234);
+  std::uniform_real_distribution<float> angle(0.f, 2.f * M_PI), slope(-1.f, 1.f), noise(-0.005f, 0.005f), z(-10.f, 10.f);
+  const std::array<float, 4> vertexZ{-6.f, -0.5f, 0.5f, 7.f};
+  std::vector<Line> lines;
+  for (int iLine{0}; iLine < 200; ++iLine) {
+    const bool fake{iLine % 10 == 0};
+    const float phi{angle(generator)};
+    std::array<float, 3> origin{noise(generator), noise(generator), fake ? z(generator) : vertexZ[iLine % vertexZ.size()] + noise(generator)};
+    std::array<float, 3> outer{origin[0] + 3.f * std::cos(phi), origin[1] + 3.f * std::sin(phi), origin[2] + 3.f * slope(generator)};
+    if (fake) {
+      outer[2] += z(generator);
+    }
+    lines.emplace_back(origin, outer);
+  }
+  return lines;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(VertexerTraits_clusterLinesBinned)
+{
+  // with a window wider than the z range of the lines, the binned clustering must give the clusters of the pairing of all the lines
+  const auto lines{makeLines()};
+  LinesClusterer clusterer;
+  const auto reference{clusterer.cluster(lines, 0.f)};
+  BOOST_CHECK(!reference.empty());
+  const auto binned{clusterer.cluster(lines, 1000.f)};
+  BOOST_REQUIRE_EQUAL(binned.size(), reference.size());
+  for (size_t iCluster{0}; iCluster < reference.size(); ++iCluster) {
+    BOOST_CHECK_EQUAL_COLLECTIONS(binned[iCluster].begin(), binned[iCluster].end(), reference[iCluster].begin(), reference[iCluster].end());
+  }
+
+  // a window so narrow that the number of bins overflows an int is clamped to one bin per line
+  const auto narrow{clusterer.cluster(lines, 1.e-30f)};
+  BOOST_CHECK(narrow.size() <= lines.size() / 2);
+}
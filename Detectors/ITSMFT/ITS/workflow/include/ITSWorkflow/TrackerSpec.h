@@ -52,6 +52,8 @@ class TrackerDPL : public framework::Task
   std::unique_ptr<o2::gpu::GPUReconstruction> mRecChain = nullptr;
   std::unique_ptr<parameters::GRPObject> mGRP = nullptr;
   std::unique_ptr<Tracker> mTracker = nullptr;
+  std::vector<std::unique_ptr<TrackerTraits>> mROFTrackerTraits; // traits of the additional trackers
+  std::vector<std::unique_ptr<Tracker>> mROFTrackers;             // additional trackers processing ROFs concurrently
   std::unique_ptr<Vertexer> mVertexer = nullptr;
   TStopwatch mTimer;
 };
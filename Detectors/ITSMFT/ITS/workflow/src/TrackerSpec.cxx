@@ -37,6 +37,11 @@
 #include "ITSReconstruction/FastMultEstConfig.h"
 #include "ITSReconstruction/FastMultEst.h"
 #include <fmt/format.h>
+#include <exception>
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 
 namespace o2
 {
@@ -45,6 +50,9 @@ namespace its
 {
 using Vertex = o2::dataformats::Vertex<o2::dataformats::TimeStamp<int>>;
 
+// number of ROFs loaded per thread for each batch of ROFs vertexed and tracked concurrently
+constexpr size_t ROFsPerThread = 4;
+
 TrackerDPL::TrackerDPL(bool isMC, const std::string& trModeS, o2::gpu::GPUDataTypes::DeviceType dType) : mIsMC{isMC}, mMode{trModeS}, mRecChain{o2::gpu::GPUReconstruction::CreateInstance(dType, true)}
 {
   std::transform(mMode.begin(), mMode.end(), mMode.begin(), [](unsigned char c) { return std::tolower(c); });
@@ -126,11 +134,37 @@ void TrackerDPL::init(InitContext& ic)
     mTracker->setParameters(memParams, trackParams);
 
     mVertexer->getGlobalConfiguration();
+    if (mVertexer->getNThreads() > 1 && mRecChain->IsGPU()) {
+      LOG(WARNING) << "ROFs are vertexed concurrently only on the CPU, processing them one by one";
+      mVertexer->setNThreads(1);
+    }
     mTracker->getGlobalConfiguration();
     LOG(INFO) << Form("Using %s for material budget approximation", (mTracker->isMatLUT() ? "lookup table" : "TGeometry"));
 
     double origD[3] = {0., 0., 0.};
     mTracker->setBz(field->getBz(origD));
+
+    // additional CPU trackers to process several ROFs concurrently
+    mROFTrackers.clear();
+    mROFTrackerTraits.clear();
+    int nROFsInParallel = std::max(1, TrackerParamConfig::Instance().nROFsInParallel);
+    if (nROFsInParallel > 1 && mRecChain->IsGPU()) {
+      LOG(WARNING) << "ROFs are tracked concurrently only on the CPU, processing them one by one";
+      nROFsInParallel = 1;
+    }
+    if (nROFsInParallel > 1 && !mTracker->canFitConcurrently()) {
+      LOG(WARNING) << "Tracks cannot be fitted concurrently with the material budget from TGeo, processing the ROFs one by one";
+      nROFsInParallel = 1;
+    }
+    for (int iTracker = 1; iTracker < nROFsInParallel; ++iTracker) {
+      auto& traits = mROFTrackerTraits.emplace_back(std::make_unique<TrackerTraitsCPU>());
+      auto& tracker = mROFTrackers.emplace_back(std::make_unique<Tracker>(traits.get()));
+      tracker->setParameters(memParams, trackParams);
+      tracker->getGlobalConfiguration();
+      tracker->setBz(mTracker->getBz());
+    }
+    LOG(INFO) << "Vertexing " << mVertexer->getNThreads() << " ROF(s) concurrently";
+    LOG(INFO) << "Tracking " << nROFsInParallel << " ROF(s) concurrently with " << mTracker->getNThreads() << " thread(s) each";
   } else {
     throw std::runtime_error(o2::utils::Str::concat_string("Cannot retrieve GRP from the ", filename));
   }
@@ -169,9 +203,7 @@ void TrackerDPL::run(ProcessingContext& pc)
     LOG(INFO) << labels->getIndexedSize() << " MC label objects , in " << mc2rofs.size() << " MC events";
   }
 
-  std::vector<o2::its::TrackITSExt> tracks;
   auto& allClusIdx = pc.outputs().make<std::vector<int>>(Output{"ITS", "TRACKCLSID", 0, Lifetime::Timeframe});
-  std::vector<o2::MCCompLabel> trackLabels;
   auto& allTracks = pc.outputs().make<std::vector<o2::its::TrackITS>>(Output{"ITS", "TRACKS", 0, Lifetime::Timeframe});
   std::vector<o2::MCCompLabel> allTrackLabels;
 
@@ -181,7 +213,6 @@ void TrackerDPL::run(ProcessingContext& pc)
   auto& irFrames = pc.outputs().make<std::vector<o2::dataformats::IRFrame>>(Output{"ITS", "IRFRAMES", 0, Lifetime::Timeframe});
 
   std::uint32_t roFrame = 0;
-  ROframe event(0, 7);
 
   bool continuous = mGRP->isDetContinuousReadOut("ITS");
   LOG(INFO) << "ITSTracker RO: continuous=" << continuous;
@@ -212,35 +243,75 @@ void TrackerDPL::run(ProcessingContext& pc)
     }
   };
 
-  gsl::span<const unsigned char>::iterator pattIt = patterns.begin();
-  for (auto& rof : rofs) {
-    int nclUsed = ioutils::loadROFrameData(rof, event, compClusters, pattIt, mDict, labels);
-    // prepare in advance output ROFRecords, even if this ROF to be rejected
-    int first = allTracks.size();
+  // the ROFs are loaded serially in batches; the vertices of the ROFs of a batch are found, possibly concurrently, and
+  // selected in the order of the ROFs, then the selected ones are tracked, possibly concurrently by several trackers,
+  // and their tracks are stored in the order of the ROFs; the events are reused from one batch to the next
+  constexpr int UntouchedROF{-1}, RejectedROF{-2};
+  const size_t nThreads{std::max(mROFTrackers.size() + 1, static_cast<size_t>(mVertexer->getNThreads()))};
+  const size_t batchSize{nThreads > 1 ? nThreads * ROFsPerThread : 1};
+  std::vector<ROframe> events(std::min(batchSize, std::max(rofs.size(), size_t(1))), ROframe(0, 7));
+  std::vector<int> rofEvents;     // index of the event loaded for each ROF of the batch
+  std::vector<int> rofVertexROFs; // index of the vertices ROFRecord of each ROF of the batch with clusters
+  std::vector<std::vector<Vertex>> eventVertices;
+  std::vector<int> trackedEvents;
+  std::vector<std::uint32_t> eventROFrames;
+  std::vector<std::vector<TrackITSExt>> eventTracks(events.size());
+  std::vector<std::vector<MCCompLabel>> eventTrackLabels(events.size());
+  std::vector<std::exception_ptr> eventErrors(events.size());
 
-    if (nclUsed) {
-      LOG(INFO) << "ROframe: " << roFrame << ", clusters loaded : " << nclUsed;
+  gsl::span<const unsigned char>::iterator pattIt = patterns.begin();
+  for (size_t batchBegin{0}; batchBegin < rofs.size(); batchBegin += rofEvents.size()) {
+    rofEvents.clear();
+    rofVertexROFs.clear();
+    int nEvents{0};
+    for (size_t iROF{batchBegin}; iROF < rofs.size() && nEvents < static_cast<int>(events.size()); ++iROF) {
+      auto& rof = rofs[iROF];
+      auto& rofEvent = rofEvents.emplace_back(UntouchedROF);
+      auto& rofVertexROF = rofVertexROFs.emplace_back(-1);
+      int nclUsed = ioutils::loadROFrameData(rof, events[nEvents], compClusters, pattIt, mDict, labels);
+      if (nclUsed == 0) {
+        continue;
+      }
+      LOG(INFO) << "ROF: " << iROF << ", clusters loaded : " << nclUsed;
 
-      // for vertices output
-      auto& vtxROF = vertROFvec.emplace_back(rof); // register entry and number of vertices in the
-      vtxROF.setFirstEntry(vertices.size());       // dedicated ROFRecord
-      vtxROF.setNEntries(0);
+      // for vertices output, the entries are set once the vertices are selected
+      rofVertexROF = vertROFvec.size();
+      vertROFvec.emplace_back(rof).setNEntries(0);
 
       if (multEstConf.cutMultClusLow > 0 || multEstConf.cutMultClusHigh > 0) { // cut was requested
         auto mult = multEst.process(rof.getROFData(compClusters));
         if (mult < multEstConf.cutMultClusLow || mult > multEstConf.cutMultClusHigh) {
           LOG(INFO) << "Estimated cluster mult. " << mult << " is outside of requested range "
                     << multEstConf.cutMultClusLow << " : " << multEstConf.cutMultClusHigh << " | ROF " << rof.getBCData();
-          rof.setFirstEntry(first);
-          rof.setNEntries(0);
+          rofEvent = RejectedROF;
           continue;
         }
       }
+      rofEvent = nEvents++;
+    }
+
+    if (mRunVertexer) {
+      mVertexer->clustersToVertices(gsl::span<ROframe>(events.data(), nEvents), eventVertices);
+    }
+
+    trackedEvents.clear();
+    eventROFrames.clear();
+    for (size_t iBatch{0}; iBatch < rofEvents.size(); ++iBatch) {
+      if (rofVertexROFs[iBatch] < 0) { // no clusters
+        roFrame++;
+        continue;
+      }
+      auto& rof = rofs[batchBegin + iBatch];
+      auto& vtxROF = vertROFvec[rofVertexROFs[iBatch]]; // register entry and number of vertices in the
+      vtxROF.setFirstEntry(vertices.size());            // dedicated ROFRecord
+      if (rofEvents[iBatch] == RejectedROF) {
+        continue;
+      }
+      auto& event = events[rofEvents[iBatch]];
 
       std::vector<Vertex> vtxVecLoc;
       if (mRunVertexer) {
-        mVertexer->clustersToVertices(event);
-        vtxVecLoc = mVertexer->exportVertices();
+        vtxVecLoc.swap(eventVertices[rofEvents[iBatch]]);
       }
 
       if (mRunVertexer && (multEstConf.cutMultVtxLow > 0 || multEstConf.cutMultVtxHigh > 0)) { // cut was requested
@@ -255,8 +326,7 @@ void TrackerDPL::run(ProcessingContext& pc)
           vtxVecLoc.push_back(vtx);
         }
         if (vtxVecLoc.empty()) { // reject ROF
-          rof.setFirstEntry(first);
-          rof.setNEntries(0);
+          rofEvents[iBatch] = RejectedROF;
           continue;
         }
       }
@@ -266,27 +336,69 @@ void TrackerDPL::run(ProcessingContext& pc)
       } else {
         event.addPrimaryVertex(0.f, 0.f, 0.f);
       }
-      mTracker->setROFrame(roFrame);
-      mTracker->clustersToTracks(event);
-      tracks.swap(mTracker->getTracks());
+      vtxROF.setNEntries(vtxVecLoc.size());
+      for (const auto& vtx : vtxVecLoc) {
+        vertices.push_back(vtx);
+      }
+      trackedEvents.push_back(rofEvents[iBatch]);
+      eventROFrames.push_back(roFrame);
+      roFrame++;
+    }
+
+    // the events are tracked independently, each thread using its own tracker
+    const int nTrackers{static_cast<int>(std::min(mROFTrackers.size() + 1, std::max(trackedEvents.size(), size_t(1))))};
+#ifdef WITH_OPENMP
+#pragma omp parallel for num_threads(nTrackers) schedule(dynamic)
+#endif
+    for (int iTracked = 0; iTracked < static_cast<int>(trackedEvents.size()); ++iTracked) {
+      const int iEvent{trackedEvents[iTracked]};
+#ifdef WITH_OPENMP
+      const int iTracker{omp_get_thread_num()};
+#else
+      const int iTracker{0};
+#endif
+      Tracker& tracker = iTracker == 0 ? *mTracker : *mROFTrackers[iTracker - 1];
+      try {
+        tracker.setROFrame(eventROFrames[iTracked]);
+        tracker.clustersToTracks(events[iEvent]);
+        eventTracks[iEvent].swap(tracker.getTracks());
+        eventTrackLabels[iEvent].swap(tracker.getTrackLabels());
+      } catch (...) {
+        eventErrors[iEvent] = std::current_exception();
+      }
+    }
+    for (auto& error : eventErrors) {
+      if (error) {
+        std::rethrow_exception(error);
+      }
+    }
+
+    for (size_t iBatch{0}; iBatch < rofEvents.size(); ++iBatch) {
+      auto& rof = rofs[batchBegin + iBatch];
+      int first = allTracks.size();
+      if (rofEvents[iBatch] == RejectedROF) {
+        rof.setFirstEntry(first);
+        rof.setNEntries(0);
+        continue;
+      }
+      if (rofEvents[iBatch] == UntouchedROF) {
+        continue;
+      }
+      auto& tracks = eventTracks[rofEvents[iBatch]];
+      auto& trackLabels = eventTrackLabels[rofEvents[iBatch]];
       LOG(INFO) << "Found tracks: " << tracks.size();
       int number = tracks.size();
-      trackLabels.swap(mTracker->getTrackLabels()); /// FIXME: assignment ctor is not optimal.
-      int shiftIdx = -rof.getFirstEntry();          // cluster entry!!!
+      int shiftIdx = -rof.getFirstEntry(); // cluster entry!!!
       rof.setFirstEntry(first);
       rof.setNEntries(number);
       copyTracks(tracks, allTracks, allClusIdx, shiftIdx);
       std::copy(trackLabels.begin(), trackLabels.end(), std::back_inserter(allTrackLabels));
+      tracks.clear();
       trackLabels.clear();
-      vtxROF.setNEntries(vtxVecLoc.size());
-      for (const auto& vtx : vtxVecLoc) {
-        vertices.push_back(vtx);
-      }
       if (number) {
         irFrames.emplace_back(rof.getBCData(), rof.getBCData() + nBCPerTF - 1);
       }
     }
-    roFrame++;
   }
 
   LOG(INFO) << "ITSTracker pushed " << allTracks.size() << " tracks";
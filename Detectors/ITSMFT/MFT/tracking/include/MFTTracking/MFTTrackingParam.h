@@ -56,6 +56,8 @@ struct MFTTrackingParam : public o2::conf::ConfigurableParamHelper<MFTTrackingPa
   Int_t LTFseed2BinWin = 3;
   /// RPhi search window bin width for the intermediate points
   Int_t LTFinterBinWin = 3;
+  /// number of threads tracking ROFs concurrently
+  Int_t nThreads = 1;
 
   O2ParamDef(MFTTrackingParam, "MFTTracking");
 };
@@ -15,6 +15,8 @@
 #ifndef O2_MFT_TRACKER_H_
 #define O2_MFT_TRACKER_H_
 
+#include <algorithm>
+
 #include "MFTTracking/ROframe.h"
 #include "MFTTracking/TrackFitter.h"
 #include "MFTTracking/Cluster.h"
@@ -52,6 +54,12 @@ class Tracker : public TrackerConfig
   auto& getTrackLabels() { return mTrackLabels; }
 
   void clustersToTracks(ROframe&, std::ostream& = std::cout);
+  /// Finds and fits the tracks of each of the events, which are stored in the events as with clustersToTracks.
+  /// With more than one thread several events are processed concurrently, the tracks do not depend on the number of threads.
+  void clustersToTracks(gsl::span<ROframe> events);
+
+  void setNThreads(int nThreads) { mNThreads = std::max(nThreads, 1); }
+  int getNThreads() const { return mNThreads; }
 
   template <class T>
   void computeTracksMClabels(const T&);
@@ -63,23 +71,24 @@ class Tracker : public TrackerConfig
   void initConfig(const MFTTrackingParam& trkParam, bool printConfig = false);
 
  private:
-  void findTracks(ROframe&);
-  void findTracksLTF(ROframe&);
-  void findTracksCA(ROframe&);
-  void computeCellsInRoad(ROframe&);
-  void runForwardInRoad();
-  void runBackwardInRoad(ROframe&);
-  void updateCellStatusInRoad();
+  // the track finding keeps its state in the event and in the road, so that several events can be processed concurrently
+  void findTracks(ROframe&, Road&) const;
+  void findTracksLTF(ROframe&) const;
+  void findTracksCA(ROframe&, Road&) const;
+  void computeCellsInRoad(ROframe&, Road&) const;
+  Int_t runForwardInRoad(Road&) const;
+  void runBackwardInRoad(ROframe&, Road&, const Int_t maxCellLevel) const;
+  Int_t updateCellStatusInRoad(Road&) const;
 
-  bool fitTracks(ROframe&);
+  bool fitTracks(ROframe&) const;
 
   const Int_t isDiskFace(Int_t layer) const { return (layer % 2); }
   const Float_t getDistanceToSeed(const Cluster&, const Cluster&, const Cluster&) const;
   void getBinClusterRange(const ROframe&, const Int_t, const Int_t, Int_t&, Int_t&) const;
   const Float_t getCellDeviation(const Cell&, const Cell&) const;
   const Bool_t getCellsConnect(const Cell&, const Cell&) const;
-  void addCellToCurrentTrackCA(const Int_t, const Int_t, ROframe&);
-  void addCellToCurrentRoad(ROframe&, const Int_t, const Int_t, const Int_t, const Int_t, Int_t&);
+  void addCellToCurrentTrackCA(const Int_t, const Int_t, ROframe&, Road&) const;
+  void addCellToCurrentRoad(ROframe&, Road&, const Int_t, const Int_t, const Int_t, const Int_t, Int_t&) const;
 
   Float_t mBz = 5.f;
   std::uint32_t mROFrame = 0;
@@ -89,9 +98,8 @@ class Tracker : public TrackerConfig
   std::vector<MCCompLabel> mTrackLabels;
   std::unique_ptr<o2::mft::TrackFitter> mTrackFitter = nullptr;
 
-  Int_t mMaxCellLevel = 0;
-
   bool mUseMC = false;
+  int mNThreads = 1;
 
   std::array<std::array<std::array<std::vector<Int_t>, constants::index_table::MaxRPhiBins>, (constants::mft::LayersNumber - 1)>, (constants::mft::LayersNumber - 1)> mBinsS;
   std::array<std::array<std::array<std::vector<Int_t>, constants::index_table::MaxRPhiBins>, (constants::mft::LayersNumber - 1)>, (constants::mft::LayersNumber - 1)> mBins;
@@ -108,7 +116,7 @@ class Tracker : public TrackerConfig
     Int_t idInLayer;
   };
 
-  /// current road for CA algorithm
+  /// road of the CA algorithm of clustersToTracks for a single event
   Road mRoad;
 };
 
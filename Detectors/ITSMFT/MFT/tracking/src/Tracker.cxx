@@ -20,6 +20,12 @@
 
 #include "Framework/Logger.h"
 
+#include <exception>
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 namespace o2
 {
 namespace mft
@@ -47,6 +53,7 @@ void Tracker::initConfig(const MFTTrackingParam& trkParam, bool printConfig)
   mTrackFitter->setMFTRadLength(trkParam.MFTRadLength);
   mTrackFitter->setVerbosity(trkParam.verbose);
   mTrackFitter->setTrackModel(trkParam.trackmodel);
+  setNThreads(trkParam.nThreads);
 
   mMinTrackPointsLTF = trkParam.MinTrackPointsLTF;
   mMinTrackPointsCA = trkParam.MinTrackPointsCA;
@@ -84,6 +91,7 @@ void Tracker::initConfig(const MFTTrackingParam& trkParam, bool printConfig)
     LOG(INFO) << "PhiBins             = " << mPhiBins;
     LOG(INFO) << "LTFseed2BinWin      = " << mLTFseed2BinWin;
     LOG(INFO) << "LTFinterBinWin      = " << mLTFinterBinWin;
+    LOG(INFO) << "nThreads            = " << mNThreads;
   }
 }
 
@@ -187,19 +195,51 @@ void Tracker::clustersToTracks(ROframe& event, std::ostream& timeBenchmarkOutput
 {
   mTracks.clear();
   mTrackLabels.clear();
-  findTracks(event);
+  findTracks(event, mRoad);
   fitTracks(event);
 }
 
 //_________________________________________________________________________________________________
-void Tracker::findTracks(ROframe& event)
+void Tracker::clustersToTracks(gsl::span<ROframe> events)
+{
+  const int nThreads{std::min(mNThreads, std::max(static_cast<int>(events.size()), 1))};
+  std::vector<Road> roads(nThreads);
+  for (auto& road : roads) {
+    road.initialize();
+  }
+  std::vector<std::exception_ptr> errors(events.size());
+#ifdef WITH_OPENMP
+#pragma omp parallel for num_threads(nThreads) schedule(dynamic)
+#endif
+  for (int iEvent = 0; iEvent < static_cast<int>(events.size()); ++iEvent) {
+#ifdef WITH_OPENMP
+    const int iThread{omp_get_thread_num()};
+#else
+    const int iThread{0};
+#endif
+    try {
+      findTracks(events[iEvent], roads[iThread]);
+      fitTracks(events[iEvent]);
+    } catch (...) {
+      errors[iEvent] = std::current_exception();
+    }
+  }
+  for (auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+//_________________________________________________________________________________________________
+void Tracker::findTracks(ROframe& event, Road& road) const
 {
   findTracksLTF(event);
-  findTracksCA(event);
+  findTracksCA(event, road);
 }
 
 //_________________________________________________________________________________________________
-void Tracker::findTracksLTF(ROframe& event)
+void Tracker::findTracksLTF(ROframe& event) const
 {
   // find (high momentum) tracks by the Linear Track Finder (LTF) method
 
@@ -342,7 +382,7 @@ void Tracker::findTracksLTF(ROframe& event)
 }
 
 //_________________________________________________________________________________________________
-void Tracker::findTracksCA(ROframe& event)
+void Tracker::findTracksCA(ROframe& event, Road& road) const
 {
   // layers: 0, 1, 2, ..., 9
   // rules for combining first/last plane in a road:
@@ -448,18 +488,18 @@ void Tracker::findTracksCA(ROframe& event)
               continue;
             }
 
-            mRoad.reset();
+            road.reset();
             for (Int_t point = 0; point < nPoints; ++point) {
               auto layer = roadPoints[point].layer;
               auto clsInLayer = roadPoints[point].idInLayer;
-              mRoad.setPoint(layer, clsInLayer);
+              road.setPoint(layer, clsInLayer);
             }
-            mRoad.setRoadId(roadId);
+            road.setRoadId(roadId);
             ++roadId;
 
-            computeCellsInRoad(event);
-            runForwardInRoad();
-            runBackwardInRoad(event);
+            computeCellsInRoad(event, road);
+            auto maxCellLevel = runForwardInRoad(road);
+            runBackwardInRoad(event, road, maxCellLevel);
 
           } // end clusters in layer2
         }   // end binRPhi
@@ -469,7 +509,7 @@ void Tracker::findTracksCA(ROframe& event)
 }
 
 //_________________________________________________________________________________________________
-void Tracker::computeCellsInRoad(ROframe& event)
+void Tracker::computeCellsInRoad(ROframe& event, Road& road) const
 {
   Int_t layer1, layer1min, layer1max, layer2, layer2min, layer2max;
   Int_t nPtsInLayer1, nPtsInLayer2;
@@ -477,7 +517,7 @@ void Tracker::computeCellsInRoad(ROframe& event)
   Int_t cellId;
   Bool_t noCell;
 
-  mRoad.getLength(layer1min, layer1max);
+  road.getLength(layer1min, layer1max);
   --layer1max;
 
   for (layer1 = layer1min; layer1 <= layer1max; ++layer1) {
@@ -487,30 +527,30 @@ void Tracker::computeCellsInRoad(ROframe& event)
     layer2min = layer1 + 1;
     layer2max = std::min(layer1 + (constants::mft::DisksNumber - isDiskFace(layer1)), constants::mft::LayersNumber - 1);
 
-    nPtsInLayer1 = mRoad.getNPointsInLayer(layer1);
+    nPtsInLayer1 = road.getNPointsInLayer(layer1);
 
     for (Int_t point1 = 0; point1 < nPtsInLayer1; ++point1) {
 
-      clsInLayer1 = mRoad.getClustersIdInLayer(layer1)[point1];
+      clsInLayer1 = road.getClustersIdInLayer(layer1)[point1];
 
       layer2 = layer2min;
 
       noCell = kTRUE;
       while (noCell && (layer2 <= layer2max)) {
 
-        nPtsInLayer2 = mRoad.getNPointsInLayer(layer2);
+        nPtsInLayer2 = road.getNPointsInLayer(layer2);
         /*
         if (nPtsInLayer2 > 1) {
-          LOG(INFO) << "BV===== more than one point in road " << mRoad.getRoadId() << " in layer " << layer2 << " : " << nPtsInLayer2 << "\n";
+          LOG(INFO) << "BV===== more than one point in road " << road.getRoadId() << " in layer " << layer2 << " : " << nPtsInLayer2 << "\n";
         }
   */
         for (Int_t point2 = 0; point2 < nPtsInLayer2; ++point2) {
 
-          clsInLayer2 = mRoad.getClustersIdInLayer(layer2)[point2];
+          clsInLayer2 = road.getClustersIdInLayer(layer2)[point2];
 
           noCell = kFALSE;
           // create a cell
-          addCellToCurrentRoad(event, layer1, layer2, clsInLayer1, clsInLayer2, cellId);
+          addCellToCurrentRoad(event, road, layer1, layer2, clsInLayer1, clsInLayer2, cellId);
         } // end points in layer2
         ++layer2;
 
@@ -520,10 +560,10 @@ void Tracker::computeCellsInRoad(ROframe& event)
 }
 
 //_________________________________________________________________________________________________
-void Tracker::runForwardInRoad()
+Int_t Tracker::runForwardInRoad(Road& road) const
 {
   Int_t layerR, layerL, icellR, icellL;
-  Int_t iter = 0;
+  Int_t iter = 0, maxCellLevel = 0;
   Bool_t levelChange = kTRUE;
 
   while (levelChange) {
@@ -534,9 +574,9 @@ void Tracker::runForwardInRoad()
     // R = right, L = left
     for (layerL = 0; layerL < (constants::mft::LayersNumber - 2); ++layerL) {
 
-      for (icellL = 0; icellL < mRoad.getCellsInLayer(layerL).size(); ++icellL) {
+      for (icellL = 0; icellL < road.getCellsInLayer(layerL).size(); ++icellL) {
 
-        Cell& cellL = mRoad.getCellsInLayer(layerL)[icellL];
+        Cell& cellL = road.getCellsInLayer(layerL)[icellL];
 
         layerR = cellL.getSecondLayerId();
 
@@ -544,16 +584,16 @@ void Tracker::runForwardInRoad()
           continue;
         }
 
-        for (icellR = 0; icellR < mRoad.getCellsInLayer(layerR).size(); ++icellR) {
+        for (icellR = 0; icellR < road.getCellsInLayer(layerR).size(); ++icellR) {
 
-          Cell& cellR = mRoad.getCellsInLayer(layerR)[icellR];
+          Cell& cellR = road.getCellsInLayer(layerR)[icellR];
 
           if ((cellL.getLevel() == cellR.getLevel()) && getCellsConnect(cellL, cellR)) {
             if (iter == 1) {
-              mRoad.addRightNeighbourToCell(layerL, icellL, layerR, icellR);
-              mRoad.addLeftNeighbourToCell(layerR, icellR, layerL, icellL);
+              road.addRightNeighbourToCell(layerL, icellL, layerR, icellR);
+              road.addLeftNeighbourToCell(layerR, icellR, layerL, icellL);
             }
-            mRoad.incrementCellLevel(layerR, icellR);
+            road.incrementCellLevel(layerR, icellR);
             levelChange = kTRUE;
 
           } // end matching cells
@@ -561,16 +601,18 @@ void Tracker::runForwardInRoad()
       }     // end loop cellL
     }       // end loop layer
 
-    updateCellStatusInRoad();
+    maxCellLevel = std::max(maxCellLevel, updateCellStatusInRoad(road));
 
   } // end while (levelChange)
+
+  return maxCellLevel;
 }
 
 //_________________________________________________________________________________________________
-void Tracker::runBackwardInRoad(ROframe& event)
+void Tracker::runBackwardInRoad(ROframe& event, Road& road, const Int_t maxCellLevel) const
 {
-  if (mMaxCellLevel == 1) {
-    return; // we have only isolated cells
+  if (maxCellLevel == 1 && mMinTrackPointsCA > 2) {
+    return; // we have only isolated cells, which are too short to start a track
   }
 
   Bool_t addCellToNewTrack, hasDisk[constants::mft::DisksNumber];
@@ -588,9 +630,9 @@ void Tracker::runBackwardInRoad(ROframe& event)
 
   for (Int_t layer = maxLayer; layer >= minLayer; --layer) {
 
-    for (cellId = 0; cellId < mRoad.getCellsInLayer(layer).size(); ++cellId) {
+    for (cellId = 0; cellId < road.getCellsInLayer(layer).size(); ++cellId) {
 
-      if (mRoad.isCellUsed(layer, cellId) || (mRoad.getCellLevel(layer, cellId) < (mMinTrackPointsCA - 1))) {
+      if (road.isCellUsed(layer, cellId) || (road.getCellLevel(layer, cellId) < (mMinTrackPointsCA - 1))) {
         continue;
       }
 
@@ -608,7 +650,7 @@ void Tracker::runBackwardInRoad(ROframe& event)
         layerRC = trackCells[nCells - 1].layer;
         cellIdRC = trackCells[nCells - 1].idInLayer;
 
-        const Cell& cellRC = mRoad.getCellsInLayer(layerRC)[cellIdRC];
+        const Cell& cellRC = road.getCellsInLayer(layerRC)[cellIdRC];
 
         addCellToNewTrack = kFALSE;
 
@@ -621,9 +663,9 @@ void Tracker::runBackwardInRoad(ROframe& event)
           layerL = leftNeighbour.first;
           cellIdL = leftNeighbour.second;
 
-          const Cell& cellL = mRoad.getCellsInLayer(layerL)[cellIdL];
+          const Cell& cellL = road.getCellsInLayer(layerL)[cellIdL];
 
-          if (mRoad.isCellUsed(layerL, cellIdL) || (mRoad.getCellLevel(layerL, cellIdL) != (mRoad.getCellLevel(layerRC, cellIdRC) - 1))) {
+          if (road.isCellUsed(layerL, cellIdL) || (road.getCellLevel(layerL, cellIdL) != (road.getCellLevel(layerRC, cellIdRC) - 1))) {
             continue;
           }
 
@@ -655,7 +697,7 @@ void Tracker::runBackwardInRoad(ROframe& event)
 
       layerC = trackCells[0].layer;
       cellIdC = trackCells[0].idInLayer;
-      const Cell& cellC = mRoad.getCellsInLayer(layerC)[cellIdC];
+      const Cell& cellC = road.getCellsInLayer(layerC)[cellIdC];
       hasDisk[cellC.getSecondLayerId() / 2] = kTRUE;
       for (icell = 0; icell < nCells; ++icell) {
         layerC = trackCells[icell].layer;
@@ -675,14 +717,14 @@ void Tracker::runBackwardInRoad(ROframe& event)
       }
 
       // add a new TrackCA
-      event.addTrackCA(mRoad.getRoadId());
+      event.addTrackCA(road.getRoadId());
       for (icell = 0; icell < nCells; ++icell) {
         layerC = trackCells[icell].layer;
         cellIdC = trackCells[icell].idInLayer;
-        addCellToCurrentTrackCA(layerC, cellIdC, event);
-        mRoad.setCellUsed(layerC, cellIdC, kTRUE);
+        addCellToCurrentTrackCA(layerC, cellIdC, event, road);
+        road.setCellUsed(layerC, cellIdC, kTRUE);
         // marked the used clusters
-        const Cell& cellC = mRoad.getCellsInLayer(layerC)[cellIdC];
+        const Cell& cellC = road.getCellsInLayer(layerC)[cellIdC];
         event.getClustersInLayer(cellC.getFirstLayerId())[cellC.getFirstClusterIndex()].setUsed(true);
         event.getClustersInLayer(cellC.getSecondLayerId())[cellC.getSecondClusterIndex()].setUsed(true);
       }
@@ -691,22 +733,23 @@ void Tracker::runBackwardInRoad(ROframe& event)
 }
 
 //_________________________________________________________________________________________________
-void Tracker::updateCellStatusInRoad()
+Int_t Tracker::updateCellStatusInRoad(Road& road) const
 {
-  Int_t layerMin, layerMax;
-  mRoad.getLength(layerMin, layerMax);
+  Int_t layerMin, layerMax, maxCellLevel = 0;
+  road.getLength(layerMin, layerMax);
   for (Int_t layer = layerMin; layer < layerMax; ++layer) {
-    for (Int_t icell = 0; icell < mRoad.getCellsInLayer(layer).size(); ++icell) {
-      mRoad.updateCellLevel(layer, icell);
-      mMaxCellLevel = std::max(mMaxCellLevel, mRoad.getCellLevel(layer, icell));
+    for (Int_t icell = 0; icell < road.getCellsInLayer(layer).size(); ++icell) {
+      road.updateCellLevel(layer, icell);
+      maxCellLevel = std::max(maxCellLevel, road.getCellLevel(layer, icell));
     }
   }
+  return maxCellLevel;
 }
 
 //_________________________________________________________________________________________________
-void Tracker::addCellToCurrentRoad(ROframe& event, const Int_t layer1, const Int_t layer2, const Int_t clsInLayer1, const Int_t clsInLayer2, Int_t& cellId)
+void Tracker::addCellToCurrentRoad(ROframe& event, Road& road, const Int_t layer1, const Int_t layer2, const Int_t clsInLayer1, const Int_t clsInLayer2, Int_t& cellId) const
 {
-  Cell& cell = mRoad.addCellInLayer(layer1, layer2, clsInLayer1, clsInLayer2, cellId);
+  Cell& cell = road.addCellInLayer(layer1, layer2, clsInLayer1, clsInLayer2, cellId);
 
   Cluster& cluster1 = event.getClustersInLayer(layer1)[clsInLayer1];
   Cluster& cluster2 = event.getClustersInLayer(layer2)[clsInLayer2];
@@ -724,10 +767,10 @@ void Tracker::addCellToCurrentRoad(ROframe& event, const Int_t layer1, const Int
 }
 
 //_________________________________________________________________________________________________
-void Tracker::addCellToCurrentTrackCA(const Int_t layer1, const Int_t cellId, ROframe& event)
+void Tracker::addCellToCurrentTrackCA(const Int_t layer1, const Int_t cellId, ROframe& event, Road& road) const
 {
   TrackCA& trackCA = event.getCurrentTrackCA();
-  const Cell& cell = mRoad.getCellsInLayer(layer1)[cellId];
+  const Cell& cell = road.getCellsInLayer(layer1)[cellId];
   const Int_t layer2 = cell.getSecondLayerId();
   const Int_t clsInLayer1 = cell.getFirstClusterIndex();
   const Int_t clsInLayer2 = cell.getSecondClusterIndex();
@@ -750,7 +793,7 @@ void Tracker::addCellToCurrentTrackCA(const Int_t layer1, const Int_t cellId, RO
 }
 
 //_________________________________________________________________________________________________
-bool Tracker::fitTracks(ROframe& event)
+bool Tracker::fitTracks(ROframe& event) const
 {
   for (auto& track : event.getTracksLTF()) {
     TrackLTF outParam = track;
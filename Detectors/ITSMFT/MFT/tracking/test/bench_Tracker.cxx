@@ -0,0 +1,112 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file bench_Tracker.cxx
+/// \brief Benchmark of the MFT tracker on recorded clusters
+///
+/// Usage: o2-bench-mft-tracker [benchmark options] --clusters mftclusters.root [--geometry o2sim_geometry.root]
+///                             [--dictionary dictionary.bin] [--bz 5] [--max-rofs N]
+/// The ROFs of the first entry of the cluster tree are tracked one by one as in the single-threaded workflow, and
+/// concurrently with 1 to 8 threads.
+
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include <gsl/gsl>
+
+#include "DetectorsBase/GeometryManager.h"
+#include "ClustersBenchmarkHelper.h"
+#include "MFTBase/GeometryTGeo.h"
+#include "MFTTracking/IOUtils.h"
+#include "MFTTracking/MFTTrackingParam.h"
+#include "MFTTracking/ROframe.h"
+#include "MFTTracking/Tracker.h"
+
+namespace
+{
+std::unique_ptr<o2::mft::Tracker> gTracker;
+std::vector<o2::mft::ROframe> gEvents;
+
+bool loadEvents(const std::map<std::string, std::string>& options)
+{
+  o2::itsmft::benchmark_helper::ClustersInput input;
+  if (!o2::itsmft::benchmark_helper::readClusters("MFT", options, input)) {
+    return false;
+  }
+  auto option = [&options](const std::string& name, const std::string& def) {
+    auto it = options.find(name);
+    return it == options.end() ? def : it->second;
+  };
+  const size_t maxROFs = std::atol(option("max-rofs", "0").c_str());
+
+  o2::base::GeometryManager::loadGeometry(option("geometry", ""));
+  o2::mft::GeometryTGeo::Instance();
+
+  gTracker = std::make_unique<o2::mft::Tracker>(false);
+  gTracker->setBz(std::atof(option("bz", "5").c_str()));
+  gTracker->initConfig(o2::mft::MFTTrackingParam::Instance());
+  gTracker->initialize();
+
+  gsl::span<const unsigned char> patterns(input.patterns);
+  auto pattIt = patterns.begin();
+  for (size_t iROF{0}; iROF < input.rofs.size() && (maxROFs == 0 || gEvents.size() < maxROFs); ++iROF) {
+    auto& event = gEvents.emplace_back(iROF);
+    if (!o2::mft::ioutils::loadROFrameData(input.rofs[iROF], event, input.clusters, pattIt, input.dict, nullptr, gTracker.get())) {
+      gEvents.pop_back();
+      continue;
+    }
+    event.initialize();
+  }
+  std::cout << "Loaded " << gEvents.size() << " ROFs with clusters" << std::endl;
+  return !gEvents.empty();
+}
+
+size_t countTracks(std::vector<o2::mft::ROframe>& events)
+{
+  size_t nTracks{0};
+  for (auto& event : events) {
+    nTracks += event.getTracksLTF().size() + event.getTracksCA().size();
+  }
+  return nTracks;
+}
+} // namespace
+
+static void BM_TrackerSerial(benchmark::State& state)
+{
+  size_t nTracks{0};
+  // the tracker marks the used clusters and stores the tracks in the events
+  o2::itsmft::benchmark_helper::runOnEvents(state, gEvents, [&](auto& events) {
+    for (auto& event : events) {
+      gTracker->clustersToTracks(event);
+    }
+    nTracks = countTracks(events);
+  });
+  state.counters["tracks"] = nTracks;
+}
+
+static void BM_TrackerThreads(benchmark::State& state)
+{
+  gTracker->setNThreads(state.range(0));
+  size_t nTracks{0};
+  o2::itsmft::benchmark_helper::runOnEvents(state, gEvents, [&](auto& events) {
+    gTracker->clustersToTracks(gsl::span<o2::mft::ROframe>(events));
+    nTracks = countTracks(events);
+  });
+  state.counters["tracks"] = nTracks;
+}
+
+BENCHMARK(BM_TrackerSerial)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_TrackerThreads)->RangeMultiplier(2)->Range(1, 8)->ArgName("threads")->Unit(benchmark::kMillisecond)->UseRealTime();
+
+int main(int argc, char** argv)
+{
+  return o2::itsmft::benchmark_helper::runBenchmarks(argc, argv, "--clusters <mftclusters.root> [--geometry <file>] [--dictionary <file>] [--bz <kG>] [--max-rofs <n>]", loadEvents);
+}
@@ -19,6 +19,7 @@
 #include "MFTTracking/TrackCA.h"
 #include "MFTBase/GeometryTGeo.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "TGeoGlobalMagField.h"
@@ -42,6 +43,9 @@ namespace o2
 namespace mft
 {
 
+// number of ROFs loaded per tracking thread for each batch of ROFs tracked concurrently
+constexpr size_t ROFsPerThread = 4;
+
 void TrackerDPL::init(InitContext& ic)
 {
   mTimer.Stop();
@@ -116,13 +120,12 @@ void TrackerDPL::run(ProcessingContext& pc)
   auto& allTracksMFT = pc.outputs().make<std::vector<o2::mft::TrackMFT>>(Output{"MFT", "TRACKS", 0, Lifetime::Timeframe});
 
   std::uint32_t roFrame = 0;
-  o2::mft::ROframe event(0);
 
   Bool_t continuous = mGRP->isDetContinuousReadOut("MFT");
   LOG(INFO) << "MFTTracker RO: continuous=" << continuous;
 
   // snippet to convert found tracks to final output tracks with separate cluster indices
-  auto copyTracks = [&event](auto& tracks, auto& allTracks, auto& allClusIdx) {
+  auto copyTracks = [](auto& tracks, auto& allTracks, auto& allClusIdx) {
     for (auto& trc : tracks) {
       trc.setExternalClusterIndexOffset(allClusIdx.size());
       int ncl = trc.getNumberOfPoints();
@@ -134,16 +137,38 @@ void TrackerDPL::run(ProcessingContext& pc)
     }
   };
 
+  // the ROFs are loaded serially in batches, the ROFs of a batch are tracked concurrently with several threads and
+  // their tracks are stored in the order of the ROFs; the events are reused since each holds large bin tables
+  const size_t batchSize = mTracker->getNThreads() > 1 ? mTracker->getNThreads() * ROFsPerThread : 1;
+  std::vector<o2::mft::ROframe> events(std::min(batchSize, std::max(rofs.size(), size_t(1))), o2::mft::ROframe(0));
+  std::vector<o2::itsmft::ROFRecord*> eventROFs;
+
   gsl::span<const unsigned char>::iterator pattIt = patterns.begin();
   if (continuous) {
-    for (auto& rof : rofs) {
-      int nclUsed = ioutils::loadROFrameData(rof, event, compClusters, pattIt, mDict, labels, mTracker.get());
-      if (nclUsed) {
-        event.setROFrameId(roFrame);
-        event.initialize();
-        LOG(INFO) << "ROframe: " << roFrame << ", clusters loaded : " << nclUsed;
-        mTracker->setROFrame(roFrame);
-        mTracker->clustersToTracks(event);
+    for (size_t iROF = 0; iROF < rofs.size();) {
+      eventROFs.clear();
+      for (; iROF < rofs.size() && eventROFs.size() < events.size(); ++iROF) {
+        auto& rof = rofs[iROF];
+        auto& event = events[eventROFs.size()];
+        int nclUsed = ioutils::loadROFrameData(rof, event, compClusters, pattIt, mDict, labels, mTracker.get());
+        if (nclUsed) {
+          event.setROFrameId(roFrame);
+          event.initialize();
+          LOG(INFO) << "ROframe: " << roFrame << ", clusters loaded : " << nclUsed;
+          eventROFs.push_back(&rof);
+        }
+        roFrame++;
+      }
+      if (eventROFs.empty()) {
+        continue;
+      }
+
+      mTracker->clustersToTracks(gsl::span<o2::mft::ROframe>(events.data(), eventROFs.size()));
+
+      for (size_t iEvent = 0; iEvent < eventROFs.size(); ++iEvent) {
+        auto& event = events[iEvent];
+        auto& rof = *eventROFs[iEvent];
+        mTracker->setROFrame(event.getROFrameId());
         tracksLTF.swap(event.getTracksLTF());
         tracksCA.swap(event.getTracksCA());
         nTracksLTF += tracksLTF.size();
@@ -166,7 +191,6 @@ void TrackerDPL::run(ProcessingContext& pc)
         copyTracks(tracksLTF, allTracksMFT, allClusIdx);
         copyTracks(tracksCA, allTracksMFT, allClusIdx);
       }
-      roFrame++;
     }
   }
 
@@ -240,6 +240,7 @@ void BuildTopologyDictionary::groupRareTopologies()
       mDictionary.mGroupMap.insert(std::make_pair((int)(gr.mHash >> 32) & 0x00000000ffffffff, iKey));
     }
   }
+  mDictionary.buildFlatTable();
   std::cout << "Dictionay finalised" << std::endl;
   std::cout << "Number of keys: " << mDictionary.getSize() << std::endl;
   std::cout << "Number of common topologies: " << mDictionary.mCommonMap.size() << std::endl;
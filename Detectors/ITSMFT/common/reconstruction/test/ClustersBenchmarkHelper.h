@@ -0,0 +1,129 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file ClustersBenchmarkHelper.h
+/// \brief Input of the ITS and MFT reconstruction benchmarks run on recorded compact clusters
+
+#ifndef ALICEO2_ITSMFT_CLUSTERSBENCHMARKHELPER_H
+#define ALICEO2_ITSMFT_CLUSTERSBENCHMARKHELPER_H
+
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <TFile.h>
+#include <TTree.h>
+
+#include "benchmark/benchmark.h"
+
+#include "DataFormatsITSMFT/CompCluster.h"
+#include "DataFormatsITSMFT/ROFRecord.h"
+#include "DataFormatsITSMFT/TopologyDictionary.h"
+
+namespace o2
+{
+namespace itsmft
+{
+namespace benchmark_helper
+{
+
+/// compact clusters, patterns and ROFs of the first entry of a cluster tree, with the topology dictionary
+struct ClustersInput {
+  std::vector<CompClusterExt> clusters;
+  std::vector<unsigned char> patterns;
+  std::vector<ROFRecord> rofs;
+  TopologyDictionary dict;
+};
+
+/// Parses the "--name value" options of the benchmark which are left by benchmark::Initialize
+inline std::map<std::string, std::string> parseOptions(int argc, char** argv)
+{
+  std::map<std::string, std::string> options;
+  for (int iArg{1}; iArg < argc - 1; ++iArg) {
+    if (!std::strncmp(argv[iArg], "--", 2)) {
+      options[argv[iArg] + 2] = argv[iArg + 1];
+      ++iArg;
+    }
+  }
+  return options;
+}
+
+/// Reads the clusters of the detector (ITS or MFT) from the "clusters" file and the dictionary from the "dictionary" file, if given
+inline bool readClusters(const std::string& detName, const std::map<std::string, std::string>& options, ClustersInput& input)
+{
+  auto clustersFile = options.find("clusters");
+  if (clustersFile == options.end()) {
+    return false;
+  }
+  std::unique_ptr<TFile> file{TFile::Open(clustersFile->second.c_str())};
+  if (!file || file->IsZombie()) {
+    std::cerr << "Cannot open the cluster file " << clustersFile->second << std::endl;
+    return false;
+  }
+  auto* tree = dynamic_cast<TTree*>(file->Get("o2sim"));
+  const std::string compBranch{detName + "ClusterComp"}, pattBranch{detName + "ClusterPatt"}, rofBranch{detName + "ClustersROF"};
+  if (!tree || !tree->GetBranch(compBranch.c_str()) || !tree->GetBranch(pattBranch.c_str()) || !tree->GetBranch(rofBranch.c_str())) {
+    std::cerr << "Did not find the " << detName << " cluster branches in " << clustersFile->second << std::endl;
+    return false;
+  }
+  auto* clusters = &input.clusters;
+  auto* patterns = &input.patterns;
+  auto* rofs = &input.rofs;
+  tree->SetBranchAddress(compBranch.c_str(), &clusters);
+  tree->SetBranchAddress(pattBranch.c_str(), &patterns);
+  tree->SetBranchAddress(rofBranch.c_str(), &rofs);
+  tree->GetEntry(0);
+  tree->ResetBranchAddresses();
+
+  auto dictionaryFile = options.find("dictionary");
+  if (dictionaryFile != options.end()) {
+    input.dict.readBinaryFile(dictionaryFile->second);
+  }
+  return true;
+}
+
+/// Initializes google benchmark, loads the events with the detector specific loadEvents(options) and runs the benchmarks
+template <typename F>
+int runBenchmarks(int argc, char** argv, const std::string& usage, F&& loadEvents)
+{
+  benchmark::Initialize(&argc, argv);
+  auto options = parseOptions(argc, argv);
+  if (options.find("clusters") == options.end()) {
+    std::cerr << "Usage: " << argv[0] << " [benchmark options] " << usage << std::endl;
+    return 1;
+  }
+  if (!loadEvents(options)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
+
+/// Times f on a copy of the events, which the reconstruction modifies, and reports the number of events processed
+template <typename Events, typename F>
+void runOnEvents(benchmark::State& state, const Events& events, F&& f)
+{
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto copy = events;
+    state.ResumeTiming();
+    f(copy);
+  }
+  state.SetItemsProcessed(state.iterations() * events.size());
+}
+
+} // namespace benchmark_helper
+} // namespace itsmft
+} // namespace o2
+
+#endif
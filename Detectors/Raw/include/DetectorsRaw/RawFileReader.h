@@ -49,6 +49,10 @@ struct ReaderInp {
   bool cache = false;
   bool autodetectTF0 = false;
   bool preferCalcTF = false;
+  int prefetchTFs = 0;    // number of TFs to read ahead asynchronously
+  int ioThreads = 1;      // number of threads reading the links of the TF concurrently
+  bool useIndex = false;  // load/store the preprocessing results from/to index files
+  std::string indexDir{}; // directory for index files, by default next to raw files
 };
 
 class RawFileReader
@@ -198,6 +202,7 @@ class RawFileReader
     size_t getNextTFSuperPagesStat(std::vector<PartStat>& parts) const;
     int getNHBFinTF() const;
 
+    // reading methods use position-independent file access, different links can be read concurrently
     size_t readNextHBF(char* buff);
     size_t readNextTF(char* buff);
     size_t readNextSuperPage(char* buff, const PartStat* pstat = nullptr);
@@ -263,6 +268,13 @@ class RawFileReader
   bool getCacheData() const { return mCacheData; }
   void setCacheData(bool v) { mCacheData = v; }
 
+  // use the index files of the preprocessing results instead of scanning the raw files, create them if absent or outdated
+  bool getUseIndex() const { return mUseIndex; }
+  void setUseIndex(bool v) { mUseIndex = v; }
+  const std::string& getIndexDir() const { return mIndexDir; }
+  void setIndexDir(const std::string& d) { mIndexDir = d; }
+  std::string getIndexFileName(int ifl) const;
+
   o2::header::DataOrigin getDefaultDataOrigin() const { return mDefDataOrigin; }
   o2::header::DataDescription getDefaultDataSpecification() const { return mDefDataDescription; }
   ReadoutCardType getDefaultReadoutCardType() const { return mDefCardType; }
@@ -281,8 +293,23 @@ class RawFileReader
   static std::string nochk_expl(ErrTypes e);
 
  private:
+  // state of the link before preprocessing of the file, the index of the file is valid only for the same state
+  struct LinkState {
+    size_t nBlocks = 0;
+    size_t nTFStarts = 0;
+    uint64_t nCRUPages = 0;
+    uint32_t nTimeFrames = 0;
+    uint32_t nHBFrames = 0;
+    uint32_t nSPages = 0;
+    int nErrors = 0;
+  };
+
   int getLinkLocalID(const RDHAny& rdh, int fileID);
   bool preprocessFile(int ifl);
+  uint64_t getIndexKey(int ifl) const;
+  bool loadIndex(int ifl, bool& hasData);
+  void storeIndex(int ifl, uint64_t key, const std::vector<LinkState>& statesBefore, FirstTFDetection tfDetectionBefore, bool hasData) const;
+  bool readFromFile(int fileID, size_t offset, size_t size, char* buff) const;
   static LinkSpec_t createSpec(o2::header::DataOrigin orig, LinkSubSpec_t ss) { return (LinkSpec_t(orig) << 32) | ss; }
 
   static constexpr o2::header::DataOrigin DEFDataOrigin = o2::header::gDataOriginFLP;
@@ -311,6 +338,8 @@ class RawFileReader
   long int mPosInFile = 0;                                          //! current position in the file
   bool mMultiLinkFile = false;                                      //! was > than 1 link seen in the file?
   bool mCacheData = false;                                          //! cache data to block after 1st scan (may require excessive memory, use with care)
+  bool mUseIndex = false;                                           //! use/create index files of preprocessing
+  std::string mIndexDir{};                                          //! directory of index files, by default the one of the raw file
   uint32_t mCheckErrors = 0;                                        //! mask for errors to check
   FirstTFDetection mFirstTFAutodetect = FirstTFDetection::Disabled; //!
   bool mPreferCalculatedTFStart = false;                            //! prefer TFstart calculated via HBFUtils
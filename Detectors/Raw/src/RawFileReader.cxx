@@ -29,6 +29,12 @@
 #include <Common/Configuration.h>
 #include <TStopwatch.h>
 #include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <type_traits>
 
 using namespace o2::raw;
 namespace o2h = o2::header;
@@ -133,8 +139,7 @@ size_t RawFileReader::LinkData::readNextHBF(char* buff)
     if (blc.dataCache) {
       memcpy(buff + sz, blc.dataCache.get(), blc.size);
     } else {
-      auto fl = reader->mFiles[blc.fileID];
-      if (fseek(fl, blc.offset, SEEK_SET) || fread(buff + sz, 1, blc.size, fl) != blc.size) {
+      if (!reader->readFromFile(blc.fileID, blc.offset, blc.size, buff + sz)) {
         LOGF(ERROR, "Failed to read for the %s a bloc:", describe());
         blc.print();
         error = true;
@@ -287,8 +292,7 @@ size_t RawFileReader::LinkData::readNextSuperPage(char* buff, const RawFileReade
     if (reader->mCacheData && blocks[nextBlock2Read].dataCache) {
       memcpy(buff, blocks[nextBlock2Read].dataCache.get(), sz);
     } else {
-      auto fl = reader->mFiles[blocks[nextBlock2Read].fileID];
-      if (fseek(fl, blocks[nextBlock2Read].offset, SEEK_SET) || fread(buff, 1, sz, fl) != sz) {
+      if (!reader->readFromFile(blocks[nextBlock2Read].fileID, blocks[nextBlock2Read].offset, sz, buff)) {
         LOGF(ERROR, "Failed to read for the %s a bloc:", describe());
         blocks[nextBlock2Read].print();
         error = true;
@@ -537,6 +541,27 @@ RawFileReader::RawFileReader(const std::string& config, int verbosity, size_t bu
   }
 }
 
+//_____________________________________________________________________
+bool RawFileReader::readFromFile(int fileID, size_t offset, size_t size, char* buff) const
+{
+  // read size bytes from given offset of the file. Does not use the file position, so that
+  // different links can be read concurrently
+  int fd = fileno(mFiles[fileID]);
+  while (size) {
+    auto nr = pread(fd, buff, size, offset);
+    if (nr <= 0) {
+      if (nr < 0 && errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    buff += nr;
+    offset += nr;
+    size -= nr;
+  }
+  return true;
+}
+
 //_____________________________________________________________________
 int RawFileReader::getLinkLocalID(const RDHAny& rdh, int fileID)
 {
@@ -620,6 +645,270 @@ bool RawFileReader::preprocessFile(int ifl)
   return nRDHread > 0;
 }
 
+//====================== index of preprocessed files ========================
+namespace
+{
+constexpr uint64_t IndexMagic = 0x5844495741523230ULL; // "02RAWIDX"
+constexpr uint32_t IndexVersion = 2;
+constexpr std::string_view IndexExt = ".rawidx";
+
+// The records are written as raw bytes: the padding is spelled out so that no indeterminate bytes end up in the file
+
+struct IndexHeader {
+  uint64_t magic = IndexMagic;
+  uint32_t version = IndexVersion;
+  uint32_t nLinks = 0;        // number of links having data in the file
+  uint64_t key = 0;           // fingerprint of the raw file and of the preprocessing settings
+  uint32_t imposedOrbit = 0;  // orbit of the 1st TF, if it was detected in this file
+  uint8_t firstTFImposed = 0; // was the 1st TF detected in this file
+  uint8_t hasData = 0;        // was any RDH found
+  uint8_t reserved[2] = {};
+};
+
+struct IndexLink {
+  uint64_t spec = 0;
+  o2::header::RDHAny rdhl{};
+  o2::header::DataDescription description{};
+  o2::header::DataOrigin origin{};
+  uint32_t subspec = 0;
+  uint64_t nCRUPagesBefore = 0; // state of the link before the file: the index is valid only if it is the same
+  uint32_t nBlocksBefore = 0;
+  uint32_t nTFStartsBefore = 0;
+  uint64_t nCRUPages = 0; // contribution of the file
+  uint32_t nTimeFrames = 0;
+  uint32_t nHBFrames = 0;
+  uint32_t nSPages = 0;
+  int32_t nErrors = 0;
+  uint32_t nBlocks = 0;
+  uint32_t nTFStarts = 0;
+  int32_t nHBFinTF = 0; // running state after the file
+  uint32_t orbitOfSOX = 0;
+  uint16_t bcOfSOX = 0;
+  uint8_t openHB = 0;
+  uint8_t continuousRO = 0;
+  uint8_t cruDetector = 0;
+  uint8_t reserved[11] = {};
+};
+
+struct IndexBlock {
+  uint64_t offset = 0;
+  uint32_t size = 0;
+  uint32_t tfID = 0;
+  uint32_t orbit = 0;
+  uint16_t bc = 0;
+  uint8_t flags = 0;
+  uint8_t reserved = 0;
+};
+
+struct IndexTFStart {
+  int32_t block = 0; // relative to the 1st block of the file
+  uint32_t tfID = 0;
+};
+
+template <typename T>
+void writeRecords(std::ofstream& out, const T* rec, size_t n = 1)
+{
+  static_assert(std::has_unique_object_representations_v<T>, "index records must have no padding");
+  out.write(reinterpret_cast<const char*>(rec), n * sizeof(T));
+}
+
+template <typename T>
+bool readRecords(std::ifstream& inp, T* rec, size_t n = 1)
+{
+  static_assert(std::has_unique_object_representations_v<T>, "index records must have no padding");
+  return bool(inp.read(reinterpret_cast<char*>(rec), n * sizeof(T)));
+}
+} // namespace
+
+//_____________________________________________________________________
+std::string RawFileReader::getIndexFileName(int ifl) const
+{
+  const auto& name = mFileNames[ifl];
+  if (mIndexDir.empty()) {
+    return name + std::string(IndexExt);
+  }
+  auto dir = mIndexDir.back() == '/' ? mIndexDir : mIndexDir + '/';
+  return dir + name.substr(name.find_last_of('/') + 1) + std::string(IndexExt);
+}
+
+//_____________________________________________________________________
+uint64_t RawFileReader::getIndexKey(int ifl) const
+{
+  // fingerprint of the file (size and modification time) and of the settings affecting its preprocessing
+  struct stat st;
+  if (fstat(fileno(mFiles[ifl]), &st)) {
+    return 0;
+  }
+  const auto& hbu = HBFUtils::Instance();
+  uint64_t h = 0xcbf29ce484222325ULL;
+  auto add = [&h](uint64_t v) {
+    h ^= v;
+    h *= 0x100000001b3ULL;
+  };
+  add(IndexVersion);
+  add(st.st_size);
+  add(st.st_mtim.tv_sec);
+  add(st.st_mtim.tv_nsec);
+  add(uint32_t(std::get<0>(mDataSpecs[ifl])));
+  add(std::get<1>(mDataSpecs[ifl]).itg[0]);
+  add(std::get<1>(mDataSpecs[ifl]).itg[1]);
+  add(std::get<2>(mDataSpecs[ifl]));
+  add(mCheckErrors);
+  add(mPreferCalculatedTFStart);
+  add(mMaxTFToRead);
+  add(int(mFirstTFAutodetect));
+  add(hbu.nHBFPerTF);
+  add(hbu.orbitFirst);
+  return h;
+}
+
+//_____________________________________________________________________
+bool RawFileReader::loadIndex(int ifl, bool& hasData)
+{
+  // try to load the preprocessing results of the file from its index
+  struct LinkIndex {
+    IndexLink link;
+    std::vector<IndexBlock> blocks;
+    std::vector<IndexTFStart> tfStarts;
+  };
+  auto indexName = getIndexFileName(ifl);
+  std::ifstream inp(indexName, std::ios::binary);
+  if (!inp.good()) {
+    return false;
+  }
+  IndexHeader header;
+  if (!readRecords(inp, &header) || header.magic != IndexMagic || header.version != IndexVersion || header.key != getIndexKey(ifl)) {
+    LOG(INFO) << "Index " << indexName << " is outdated, will rescan " << mFileNames[ifl];
+    return false;
+  }
+  std::vector<LinkIndex> links(header.nLinks);
+  for (auto& lnk : links) {
+    if (!readRecords(inp, &lnk.link)) {
+      return false;
+    }
+    lnk.blocks.resize(lnk.link.nBlocks);
+    lnk.tfStarts.resize(lnk.link.nTFStarts);
+    if (!readRecords(inp, lnk.blocks.data(), lnk.blocks.size()) || !readRecords(inp, lnk.tfStarts.data(), lnk.tfStarts.size())) {
+      LOG(WARNING) << "Index " << indexName << " is truncated, will rescan " << mFileNames[ifl];
+      return false;
+    }
+    // the links must be in the same state as when the file was preprocessed
+    auto entry = mLinkEntries.find(lnk.link.spec);
+    bool sameState = entry == mLinkEntries.end() ? (lnk.link.nBlocksBefore == 0 && lnk.link.nCRUPagesBefore == 0)
+                                                 : (mLinksData[entry->second].blocks.size() == lnk.link.nBlocksBefore &&
+                                                    mLinksData[entry->second].tfStartBlock.size() == lnk.link.nTFStartsBefore &&
+                                                    mLinksData[entry->second].nCRUPages == lnk.link.nCRUPagesBefore);
+    if (!sameState) {
+      LOG(INFO) << "Index " << indexName << " was created for different preceding files, will rescan " << mFileNames[ifl];
+      return false;
+    }
+  }
+
+  // apply
+  if (header.firstTFImposed) {
+    imposeFirstTF(header.imposedOrbit);
+  }
+  for (const auto& lnk : links) {
+    int lID = getLinkLocalID(lnk.link.rdhl, ifl);
+    auto& link = mLinksData[lID];
+    link.rdhl = lnk.link.rdhl;
+    link.irOfSOX = IR(lnk.link.bcOfSOX, lnk.link.orbitOfSOX);
+    link.continuousRO = lnk.link.continuousRO;
+    link.openHB = lnk.link.openHB;
+    link.nHBFinTF = lnk.link.nHBFinTF;
+    link.nCRUPages += lnk.link.nCRUPages;
+    link.nTimeFrames += lnk.link.nTimeFrames;
+    link.nHBFrames += lnk.link.nHBFrames;
+    link.nSPages += lnk.link.nSPages;
+    link.nErrors += lnk.link.nErrors;
+    int blockOffset = link.blocks.size();
+    for (const auto& ib : lnk.blocks) {
+      auto& bl = link.blocks.emplace_back(ifl, ib.offset);
+      bl.size = ib.size;
+      bl.tfID = ib.tfID;
+      bl.ir = IR(ib.bc, ib.orbit);
+      bl.flags = ib.flags;
+    }
+    for (const auto& tfs : lnk.tfStarts) {
+      link.tfStartBlock.emplace_back(tfs.block + blockOffset, tfs.tfID);
+    }
+  }
+  hasData = header.hasData;
+  LOGF(INFO, "File %3d : loaded index %s for %4d links from %s", ifl, indexName, int(links.size()), mFileNames[ifl]);
+  return true;
+}
+
+//_____________________________________________________________________
+void RawFileReader::storeIndex(int ifl, uint64_t key, const std::vector<LinkState>& statesBefore, FirstTFDetection tfDetectionBefore, bool hasData) const
+{
+  // store the contribution of the just preprocessed file to the links data
+  auto indexName = getIndexFileName(ifl);
+  std::ofstream out(indexName, std::ios::binary | std::ios::trunc);
+  if (!out.good()) {
+    LOG(WARNING) << "Failed to create index " << indexName;
+    return;
+  }
+  IndexHeader header;
+  header.key = key;
+  header.hasData = hasData;
+  if (tfDetectionBefore == FirstTFDetection::Pending && mFirstTFAutodetect == FirstTFDetection::Done) {
+    header.firstTFImposed = 1;
+    header.imposedOrbit = HBFUtils::Instance().orbitFirst;
+  }
+  std::vector<int> linksInFile;
+  for (int i = 0; i < int(mLinksData.size()); i++) {
+    const auto& link = mLinksData[i];
+    if (i >= int(statesBefore.size()) || link.nCRUPages != statesBefore[i].nCRUPages || link.blocks.size() != statesBefore[i].nBlocks) {
+      linksInFile.push_back(i); // new links are in the order of their registration
+    }
+  }
+  header.nLinks = linksInFile.size();
+  writeRecords(out, &header);
+  for (auto i : linksInFile) {
+    const auto& link = mLinksData[i];
+    LinkState before = i < int(statesBefore.size()) ? statesBefore[i] : LinkState{};
+    IndexLink il;
+    il.spec = link.spec;
+    il.subspec = link.subspec;
+    il.origin = link.origin;
+    il.description = link.description;
+    il.rdhl = link.rdhl;
+    il.orbitOfSOX = link.irOfSOX.orbit;
+    il.bcOfSOX = link.irOfSOX.bc;
+    il.nCRUPagesBefore = before.nCRUPages;
+    il.nBlocksBefore = before.nBlocks;
+    il.nTFStartsBefore = before.nTFStarts;
+    il.nCRUPages = link.nCRUPages - before.nCRUPages;
+    il.nTimeFrames = link.nTimeFrames - before.nTimeFrames;
+    il.nHBFrames = link.nHBFrames - before.nHBFrames;
+    il.nSPages = link.nSPages - before.nSPages;
+    il.nErrors = link.nErrors - before.nErrors;
+    il.nBlocks = link.blocks.size() - before.nBlocks;
+    il.nTFStarts = link.tfStartBlock.size() - before.nTFStarts;
+    il.nHBFinTF = link.nHBFinTF;
+    il.openHB = link.openHB;
+    il.continuousRO = link.continuousRO;
+    il.cruDetector = link.cruDetector;
+    writeRecords(out, &il);
+    for (size_t ib = before.nBlocks; ib < link.blocks.size(); ib++) {
+      const auto& bl = link.blocks[ib];
+      IndexBlock rec{bl.offset, bl.size, bl.tfID, bl.ir.orbit, bl.ir.bc, bl.flags};
+      writeRecords(out, &rec);
+    }
+    for (size_t it = before.nTFStarts; it < link.tfStartBlock.size(); it++) {
+      IndexTFStart rec{int32_t(link.tfStartBlock[it].first - before.nBlocks), link.tfStartBlock[it].second};
+      writeRecords(out, &rec);
+    }
+  }
+  if (!out.good()) {
+    LOG(WARNING) << "Failed to write index " << indexName;
+    out.close();
+    std::remove(indexName.c_str());
+    return;
+  }
+  LOG(INFO) << "Stored index " << indexName;
+}
+
 //_____________________________________________________________________
 void RawFileReader::printStat(bool verbose) const
 {
@@ -701,7 +990,20 @@ bool RawFileReader::init()
   int nf = mFiles.size();
   mEmpty = true;
   for (int i = 0; i < nf; i++) {
-    if (preprocessFile(i)) {
+    bool hasData = false;
+    if (!mUseIndex || !loadIndex(i, hasData)) {
+      auto key = mUseIndex ? getIndexKey(i) : 0; // settings may be modified by the preprocessing
+      auto tfDetection = mFirstTFAutodetect;
+      std::vector<LinkState> statesBefore;
+      for (const auto& link : mLinksData) {
+        statesBefore.push_back(LinkState{link.blocks.size(), link.tfStartBlock.size(), link.nCRUPages, link.nTimeFrames, link.nHBFrames, link.nSPages, link.nErrors});
+      }
+      hasData = preprocessFile(i);
+      if (mUseIndex) {
+        storeIndex(i, key, statesBefore, tfDetection, hasData);
+      }
+    }
+    if (hasData) {
       mEmpty = false;
     }
   }
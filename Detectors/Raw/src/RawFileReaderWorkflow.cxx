@@ -15,6 +15,7 @@
 #include "Framework/DataSpecUtils.h"
 #include "Framework/ConcreteDataMatcher.h"
 #include "Framework/ControlService.h"
+#include "Framework/CallbackService.h"
 #include "Framework/DataProcessingHeader.h"
 #include "Framework/Task.h"
 #include "Framework/Logger.h"
@@ -37,6 +38,11 @@
 #include <string>
 #include <climits>
 #include <regex>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <exception>
 
 using namespace o2::raw;
 
@@ -53,6 +59,7 @@ class RawReaderSpecs : public o2f::Task
     std::uint32_t mRunNumber = 0;
   };
   explicit RawReaderSpecs(const ReaderInp& rinp);
+  ~RawReaderSpecs() override { stopPrefetching(); }
   void init(o2f::InitContext& ic) final;
   void run(o2f::ProcessingContext& ctx) final;
 
@@ -65,7 +72,31 @@ class RawReaderSpecs : public o2f::Task
   }
 
  private:
+  // messages of a single TF ready to be sent
+  struct TFMessages {
+    uint32_t tfCounter = 0;
+    size_t size = 0;
+    size_t nParts = 0;
+    double ioTime = 0.;
+    bool last = false;        // no more TFs to send
+    std::exception_ptr error; // failure of the asynchronous reading
+    std::unordered_map<std::string, std::unique_ptr<FairMQParts>> messagesPerRoute;
+  };
+  // messages of a single link
+  struct LinkMessages {
+    std::string channel;
+    uint32_t firstOrbit = 0;
+    std::vector<FairMQMessagePtr> parts; // header and payload messages
+    double ioTime = 0.;                  // real time spent reading the data of the link
+  };
+
   void processDropTF(const std::string& drops);
+  std::string findOutputChannel(const o2h::DataHeader& h) const;
+  std::unique_ptr<TFMessages> readNextTF();
+  void readLink(int il, uint32_t tfID, uint32_t tfCounter, LinkMessages& lm);
+  void sendTF(TFMessages& tf);
+  void prefetch();
+  void stopPrefetching();
 
   int mLoop = 0;                  // once last TF reached, loop while mLoop>=0
   uint32_t mTFCounter = 0;        // TFId accumulator (accounts for looping)
@@ -76,20 +107,34 @@ class RawReaderSpecs : public o2f::Task
   size_t mSentSize = 0;
   size_t mSentMessages = 0;
   bool mPartPerSP = true;                                          // fill part per superpage
+  int mPrefetchDepth = 0;                                          // number of TFs to read ahead asynchronously
+  int mNIOThreads = 1;                                             // number of threads reading the links of the TF concurrently
   std::string mRawChannelName = "";                                // name of optional non-DPL channel
   std::unique_ptr<o2::raw::RawFileReader> mReader;                 // matching engine
   std::unordered_map<std::string, std::pair<int, int>> mDropTFMap; // allows to drop certain fraction of TFs
+  FairMQDevice* mDevice = nullptr;
+  std::vector<o2f::OutputRoute> mOutputRoutes;
+  size_t mHeaderStackSize = 0;
+
+  // read-ahead: the TFs are read by a dedicated thread into the messages of the output channels transport (i.e. shared memory),
+  // at most mPrefetchDepth TFs are kept in flight
+  std::thread mPrefetchThread;
+  std::deque<std::unique_ptr<TFMessages>> mPrefetched;
+  std::mutex mPrefetchMutex;
+  std::condition_variable mPrefetchCond;
+  bool mStopPrefetch = false;
+
   enum TimerIDs { TimerInit,
                   TimerTotal,
-                  TimerIO,
                   NTimers };
-  static constexpr std::string_view TimerName[] = {"Init", "Total", "IO"};
+  static constexpr std::string_view TimerName[] = {"Init", "Total"};
   TStopwatch mTimer[NTimers];
+  double mIOTime = 0.; // real time spent reading the data, summed over the links read concurrently
 };
 
 //___________________________________________________________
 RawReaderSpecs::RawReaderSpecs(const ReaderInp& rinp)
-  : mLoop(rinp.loop < 0 ? INT_MAX : (rinp.loop < 1 ? 1 : rinp.loop)), mDelayUSec(rinp.delay_us), mMinTFID(rinp.minTF), mMaxTFID(rinp.maxTF), mPartPerSP(rinp.partPerSP), mReader(std::make_unique<o2::raw::RawFileReader>(rinp.inifile, 0, rinp.bufferSize)), mRawChannelName(rinp.rawChannelConfig)
+  : mLoop(rinp.loop < 0 ? INT_MAX : (rinp.loop < 1 ? 1 : rinp.loop)), mDelayUSec(rinp.delay_us), mMinTFID(rinp.minTF), mMaxTFID(rinp.maxTF), mPartPerSP(rinp.partPerSP), mPrefetchDepth(rinp.prefetchTFs < 0 ? 0 : rinp.prefetchTFs), mNIOThreads(rinp.ioThreads < 1 ? 1 : rinp.ioThreads), mReader(std::make_unique<o2::raw::RawFileReader>(rinp.inifile, 0, rinp.bufferSize)), mRawChannelName(rinp.rawChannelConfig)
 {
   mReader->setCheckErrors(rinp.errMap);
   mReader->setMaxTFToRead(rinp.maxTF);
@@ -97,8 +142,19 @@ RawReaderSpecs::RawReaderSpecs(const ReaderInp& rinp)
   mReader->setCacheData(rinp.cache);
   mReader->setTFAutodetect(rinp.autodetectTF0 ? RawFileReader::FirstTFDetection::Pending : RawFileReader::FirstTFDetection::Disabled);
   mReader->setPreferCalculatedTFStart(rinp.preferCalcTF);
+  mReader->setUseIndex(rinp.useIndex);
+  mReader->setIndexDir(rinp.indexDir);
   LOG(INFO) << "Will preprocess files with buffer size of " << rinp.bufferSize << " bytes";
   LOG(INFO) << "Number of loops over whole data requested: " << mLoop;
+  if (mPrefetchDepth) {
+    LOG(INFO) << "Will read ahead up to " << mPrefetchDepth << " TFs";
+  }
+#ifndef WITH_OPENMP
+  if (mNIOThreads > 1) {
+    LOG(WARNING) << "OpenMP is not available, the links will be read by a single thread";
+    mNIOThreads = 1;
+  }
+#endif
   for (int i = NTimers; i--;) {
     mTimer[i].Stop();
     mTimer[i].Reset();
@@ -147,53 +203,86 @@ void RawReaderSpecs::init(o2f::InitContext& ic)
   if (mMaxTFID >= mReader->getNTimeFrames()) {
     mMaxTFID = mReader->getNTimeFrames() ? mReader->getNTimeFrames() - 1 : 0;
   }
+  // the messages read ahead must be released while the transport is still alive
+  ic.services().get<o2f::CallbackService>().set(o2f::CallbackService::Id::Stop, [this]() { stopPrefetching(); });
 }
 
 //___________________________________________________________
 void RawReaderSpecs::run(o2f::ProcessingContext& ctx)
 {
   assert(mReader);
-  auto tTotStart = mTimer[TimerTotal].CpuTime(), tIOStart = mTimer[TimerIO].CpuTime();
+  auto tTotStart = mTimer[TimerTotal].CpuTime();
   mTimer[TimerTotal].Start(false);
-  auto device = ctx.services().get<o2f::RawDeviceService>().device();
-  assert(device);
+  if (!mDevice) {
+    mDevice = ctx.services().get<o2f::RawDeviceService>().device();
+    assert(mDevice);
+    mOutputRoutes = ctx.services().get<o2f::RawDeviceService>().spec().outputs;
+    o2::header::Stack dummyStack{o2h::DataHeader{}, o2::framework::DataProcessingHeader{0}}; // dummy stack to just to get stack size
+    mHeaderStackSize = dummyStack.size();
+    if (mPrefetchDepth) {
+      mPrefetchThread = std::thread(&RawReaderSpecs::prefetch, this);
+    }
+  }
 
-  auto findOutputChannel = [&ctx, this](o2h::DataHeader& h) {
-    if (!this->mRawChannelName.empty()) {
-      return std::string{this->mRawChannelName};
-    } else {
-      auto outputRoutes = ctx.services().get<o2f::RawDeviceService>().spec().outputs;
-      for (auto& oroute : outputRoutes) {
-        LOG(DEBUG) << "comparing with matcher to route " << oroute.matcher << " TSlice:" << oroute.timeslice;
-        if (o2f::DataSpecUtils::match(oroute.matcher, h.dataOrigin, h.dataDescription, h.subSpecification) && ((h.tfCounter % oroute.maxTimeslices) == oroute.timeslice)) {
-          LOG(DEBUG) << "picking the route:" << o2f::DataSpecUtils::describe(oroute.matcher) << " channel " << oroute.channel;
-          return std::string{oroute.channel};
-        }
-      }
+  std::unique_ptr<TFMessages> tf;
+  if (mPrefetchDepth) {
+    std::unique_lock<std::mutex> lock(mPrefetchMutex);
+    mPrefetchCond.wait(lock, [this] { return !mPrefetched.empty(); });
+    tf = std::move(mPrefetched.front());
+    mPrefetched.pop_front();
+    lock.unlock();
+    mPrefetchCond.notify_all(); // there is a free slot for the next TF
+    if (tf->error) {
+      std::rethrow_exception(tf->error);
     }
-    LOGP(ERROR, "Failed to find output channel for {}/{}/{} @ timeslice {}", h.dataOrigin.str, h.dataDescription.str, h.subSpecification, h.tfCounter);
-    return std::string{};
-  };
+  } else {
+    tf = readNextTF();
+  }
 
-  size_t tfNParts = 0, tfSize = 0;
-  std::unordered_map<std::string, std::unique_ptr<FairMQParts>> messagesPerRoute;
+  if (tf->last) {
+    stopPrefetching();
+    mTimer[TimerTotal].Stop();
+    LOGF(INFO, "Finished: payload of %zu bytes in %zu messages sent for %d TFs", mSentSize, mSentMessages, mTFCounter);
+    for (int i = 0; i < NTimers; i++) {
+      LOGF(INFO, "Timing for %15s: Cpu: %.3e Real: %.3e s in %d slots", TimerName[i], mTimer[i].CpuTime(), mTimer[i].RealTime(), mTimer[i].Counter() - 1);
+    }
+    LOGF(INFO, "Timing for %15s: Real: %.3e s", "IO", mIOTime);
+    ctx.services().get<o2f::ControlService>().endOfStream();
+    ctx.services().get<o2f::ControlService>().readyToQuit(o2f::QuitRequest::Me);
+    return;
+  }
 
-  auto addPart = [&messagesPerRoute, &tfNParts, &tfSize](FairMQMessagePtr hd, FairMQMessagePtr pl, const std::string& fairMQChannel) {
-    FairMQParts* parts = nullptr;
-    parts = messagesPerRoute[fairMQChannel].get(); // FairMQParts*
-    if (!parts) {
-      messagesPerRoute[fairMQChannel] = std::make_unique<FairMQParts>();
-      parts = messagesPerRoute[fairMQChannel].get();
+  sendTF(*tf);
+  mTimer[TimerTotal].Stop();
+
+  LOGF(INFO, "Sent payload of %zu bytes in %zu parts in %zu messages for TF %d | Timing (total/IO): %.3e / %.3e", tf->size, tf->nParts,
+       tf->messagesPerRoute.size(), tf->tfCounter, mTimer[TimerTotal].CpuTime() - tTotStart, tf->ioTime);
+}
+
+//___________________________________________________________
+std::string RawReaderSpecs::findOutputChannel(const o2h::DataHeader& h) const
+{
+  if (!mRawChannelName.empty()) {
+    return std::string{mRawChannelName};
+  } else {
+    for (auto& oroute : mOutputRoutes) {
+      LOG(DEBUG) << "comparing with matcher to route " << oroute.matcher << " TSlice:" << oroute.timeslice;
+      if (o2f::DataSpecUtils::match(oroute.matcher, h.dataOrigin, h.dataDescription, h.subSpecification) && ((h.tfCounter % oroute.maxTimeslices) == oroute.timeslice)) {
+        LOG(DEBUG) << "picking the route:" << o2f::DataSpecUtils::describe(oroute.matcher) << " channel " << oroute.channel;
+        return std::string{oroute.channel};
+      }
     }
-    tfSize += pl->GetSize();
-    tfNParts++;
-    parts->AddPart(std::move(hd));
-    parts->AddPart(std::move(pl));
-  };
+  }
+  LOGP(ERROR, "Failed to find output channel for {}/{}/{} @ timeslice {}", h.dataOrigin.str, h.dataDescription.str, h.subSpecification, h.tfCounter);
+  return std::string{};
+}
 
-  // clean-up before reading next TF
+//___________________________________________________________
+std::unique_ptr<RawReaderSpecs::TFMessages> RawReaderSpecs::readNextTF()
+{
+  // read all links of the next TF into the messages to send, advance to the next TF
+  auto tf = std::make_unique<TFMessages>();
   auto tfID = mReader->getNextTFToRead();
-  int nlinks = mReader->getNLinks();
 
   if (tfID > mMaxTFID) {
     if (!mReader->isEmpty() && --mLoop) {
@@ -201,14 +290,8 @@ void RawReaderSpecs::run(o2f::ProcessingContext& ctx)
       tfID = 0;
       LOG(INFO) << "Starting new loop " << mLoopsDone << " from the beginning of data";
     } else {
-      mTimer[TimerTotal].Stop();
-      LOGF(INFO, "Finished: payload of %zu bytes in %zu messages sent for %d TFs", mSentSize, mSentMessages, mTFCounter);
-      for (int i = 0; i < NTimers; i++) {
-        LOGF(INFO, "Timing for %15s: Cpu: %.3e Real: %.3e s in %d slots", TimerName[i], mTimer[i].CpuTime(), mTimer[i].RealTime(), mTimer[i].Counter() - 1);
-      }
-      ctx.services().get<o2f::ControlService>().endOfStream();
-      ctx.services().get<o2f::ControlService>().readyToQuit(o2f::QuitRequest::Me);
-      return;
+      tf->last = true;
+      return tf;
     }
   }
 
@@ -216,69 +299,56 @@ void RawReaderSpecs::run(o2f::ProcessingContext& ctx)
     tfID = mMinTFID;
   }
   mReader->setNextTFToRead(tfID);
-  std::vector<RawFileReader::PartStat> partsSP;
-  const auto& hbfU = HBFUtils::Instance();
+  tf->tfCounter = mTFCounter;
 
   // read next time frame
   LOG(INFO) << "Reading TF#" << mTFCounter << " (" << tfID << " at iteration " << mLoopsDone << ')';
-  o2::header::Stack dummyStack{o2h::DataHeader{}, o2::framework::DataProcessingHeader{0}}; // dummy stack to just to get stack size
-  auto hstackSize = dummyStack.size();
-
-  uint32_t firstOrbit = 0;
+  int nlinks = mReader->getNLinks();
+  std::vector<LinkMessages> linksMessages(nlinks);
+  std::vector<std::exception_ptr> errors(nlinks);
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNIOThreads)
+#endif
   for (int il = 0; il < nlinks; il++) {
-    auto& link = mReader->getLink(il);
-
-    if (!mDropTFMap.empty()) { // some TFs should be dropped
-      auto res = mDropTFMap.find(link.origin.str);
-      if (res != mDropTFMap.end() && (mTFCounter % res->second.first) == res->second.second) {
-        LOG(INFO) << "Droppint " << mTFCounter << " for " << link.origin.str << "/" << link.description.str << "/" << link.subspec;
-        continue; // drop the data
-      }
+    try {
+      readLink(il, tfID, mTFCounter, linksMessages[il]);
+    } catch (...) {
+      errors[il] = std::current_exception();
     }
-    if (!link.rewindToTF(tfID)) {
-      continue; // this link has no data for wanted TF
+  }
+  for (auto& lm : linksMessages) {
+    tf->ioTime += lm.ioTime;
+  }
+  mIOTime += tf->ioTime;
+  for (auto& err : errors) {
+    if (err) {
+      std::rethrow_exception(err);
     }
+  }
 
-    o2h::DataHeader hdrTmpl(link.description, link.origin, link.subspec); // template with 0 size
-    int nParts = mPartPerSP ? link.getNextTFSuperPagesStat(partsSP) : link.getNHBFinTF();
-    hdrTmpl.payloadSerializationMethod = o2h::gSerializationMethodNone;
-    hdrTmpl.splitPayloadParts = nParts;
-    hdrTmpl.tfCounter = mTFCounter;
-
-    const auto fmqChannel = findOutputChannel(hdrTmpl);
-    if (fmqChannel.empty()) { // no output channel
+  // collect the messages per output channel keeping the links order
+  auto addPart = [&tf](FairMQMessagePtr hd, FairMQMessagePtr pl, const std::string& fairMQChannel) {
+    auto& parts = tf->messagesPerRoute[fairMQChannel];
+    if (!parts) {
+      parts = std::make_unique<FairMQParts>();
+    }
+    tf->size += pl->GetSize();
+    tf->nParts++;
+    parts->AddPart(std::move(hd));
+    parts->AddPart(std::move(pl));
+  };
+  uint32_t firstOrbit = 0;
+  for (auto& lm : linksMessages) {
+    if (lm.parts.empty()) {
       continue;
     }
-
-    auto fmqFactory = device->GetChannel(fmqChannel, 0).Transport();
-    while (hdrTmpl.splitPayloadIndex < hdrTmpl.splitPayloadParts) {
-      hdrTmpl.payloadSize = mPartPerSP ? partsSP[hdrTmpl.splitPayloadIndex].size : link.getNextHBFSize();
-      auto hdMessage = fmqFactory->CreateMessage(hstackSize, fair::mq::Alignment{64});
-      auto plMessage = fmqFactory->CreateMessage(hdrTmpl.payloadSize, fair::mq::Alignment{64});
-      mTimer[TimerIO].Start(false);
-      auto bread = mPartPerSP ? link.readNextSuperPage(reinterpret_cast<char*>(plMessage->GetData()), &partsSP[hdrTmpl.splitPayloadIndex]) : link.readNextHBF(reinterpret_cast<char*>(plMessage->GetData()));
-      if (bread != hdrTmpl.payloadSize) {
-        LOG(ERROR) << "Link " << il << " read " << bread << " bytes instead of " << hdrTmpl.payloadSize
-                   << " expected in TF=" << mTFCounter << " part=" << hdrTmpl.splitPayloadIndex;
-      }
-      mTimer[TimerIO].Stop();
-      // check if the RDH to send corresponds to expected orbit
-      if (hdrTmpl.splitPayloadIndex == 0) {
-        auto ir = o2::raw::RDHUtils::getHeartBeatIR(plMessage->GetData());
-        auto tfid = hbfU.getTF(ir);
-        firstOrbit = hdrTmpl.firstTForbit = hbfU.getIRTF(tfid).orbit; // will be picked for the following parts
-      }
-      o2::header::Stack headerStack{hdrTmpl, o2::framework::DataProcessingHeader{mTFCounter}};
-      memcpy(hdMessage->GetData(), headerStack.data(), headerStack.size());
-      hdrTmpl.splitPayloadIndex++; // prepare for next
-
-      addPart(std::move(hdMessage), std::move(plMessage), fmqChannel);
+    firstOrbit = lm.firstOrbit;
+    for (size_t ip = 0; ip < lm.parts.size(); ip += 2) {
+      addPart(std::move(lm.parts[ip]), std::move(lm.parts[ip + 1]), lm.channel);
     }
-    LOGF(DEBUG, "Added %d parts for TF#%d(%d in iteration %d) of %s/%s/0x%u", hdrTmpl.splitPayloadParts, mTFCounter, tfID,
-         mLoopsDone, link.origin.as<std::string>(), link.description.as<std::string>(), link.subspec);
   }
 
-  // send sTF acknowledge message
+  // add sTF acknowledge message
   {
     STFHeader stfHeader{mTFCounter, firstOrbit, 0};
     o2::header::DataHeader stfDistDataHeader(gDataDescSubTimeFrame, o2::header::gDataOriginFLP, 0, sizeof(STFHeader), 0, 1);
@@ -287,9 +357,9 @@ void RawReaderSpecs::run(o2f::ProcessingContext& ctx)
     stfDistDataHeader.tfCounter = mTFCounter;
     const auto fmqChannel = findOutputChannel(stfDistDataHeader);
     if (!fmqChannel.empty()) { // no output channel
-      auto fmqFactory = device->GetChannel(fmqChannel, 0).Transport();
+      auto fmqFactory = mDevice->GetChannel(fmqChannel, 0).Transport();
       o2::header::Stack headerStackSTF{stfDistDataHeader, o2::framework::DataProcessingHeader{mTFCounter}};
-      auto hdMessageSTF = fmqFactory->CreateMessage(hstackSize, fair::mq::Alignment{64});
+      auto hdMessageSTF = fmqFactory->CreateMessage(mHeaderStackSize, fair::mq::Alignment{64});
       auto plMessageSTF = fmqFactory->CreateMessage(stfDistDataHeader.payloadSize, fair::mq::Alignment{64});
       memcpy(hdMessageSTF->GetData(), headerStackSTF.data(), headerStackSTF.size());
       memcpy(plMessageSTF->GetData(), &stfHeader, sizeof(STFHeader));
@@ -297,23 +367,129 @@ void RawReaderSpecs::run(o2f::ProcessingContext& ctx)
     }
   }
 
-  if (mTFCounter) { // delay sending
+  mReader->setNextTFToRead(++tfID);
+  ++mTFCounter;
+  return tf;
+}
+
+//___________________________________________________________
+void RawReaderSpecs::readLink(int il, uint32_t tfID, uint32_t tfCounter, LinkMessages& lm)
+{
+  // read TF data of the link to the messages, can be called concurrently for different links
+  auto& link = mReader->getLink(il);
+
+  if (!mDropTFMap.empty()) { // some TFs should be dropped
+    auto res = mDropTFMap.find(link.origin.str);
+    if (res != mDropTFMap.end() && (tfCounter % res->second.first) == res->second.second) {
+      LOG(INFO) << "Droppint " << tfCounter << " for " << link.origin.str << "/" << link.description.str << "/" << link.subspec;
+      return; // drop the data
+    }
+  }
+  if (!link.rewindToTF(tfID)) {
+    return; // this link has no data for wanted TF
+  }
+
+  std::vector<RawFileReader::PartStat> partsSP;
+  const auto& hbfU = HBFUtils::Instance();
+  o2h::DataHeader hdrTmpl(link.description, link.origin, link.subspec); // template with 0 size
+  int nParts = mPartPerSP ? link.getNextTFSuperPagesStat(partsSP) : link.getNHBFinTF();
+  hdrTmpl.payloadSerializationMethod = o2h::gSerializationMethodNone;
+  hdrTmpl.splitPayloadParts = nParts;
+  hdrTmpl.tfCounter = tfCounter;
+
+  lm.channel = findOutputChannel(hdrTmpl);
+  if (lm.channel.empty()) { // no output channel
+    return;
+  }
+
+  auto fmqFactory = mDevice->GetChannel(lm.channel, 0).Transport();
+  TStopwatch ioTimer; // only the reading of the data is timed, not the allocation of the messages
+  ioTimer.Stop();
+  ioTimer.Reset();
+  while (hdrTmpl.splitPayloadIndex < hdrTmpl.splitPayloadParts) {
+    hdrTmpl.payloadSize = mPartPerSP ? partsSP[hdrTmpl.splitPayloadIndex].size : link.getNextHBFSize();
+    auto hdMessage = fmqFactory->CreateMessage(mHeaderStackSize, fair::mq::Alignment{64});
+    auto plMessage = fmqFactory->CreateMessage(hdrTmpl.payloadSize, fair::mq::Alignment{64});
+    ioTimer.Start(false);
+    auto bread = mPartPerSP ? link.readNextSuperPage(reinterpret_cast<char*>(plMessage->GetData()), &partsSP[hdrTmpl.splitPayloadIndex]) : link.readNextHBF(reinterpret_cast<char*>(plMessage->GetData()));
+    ioTimer.Stop();
+    if (bread != hdrTmpl.payloadSize) {
+      LOG(ERROR) << "Link " << il << " read " << bread << " bytes instead of " << hdrTmpl.payloadSize
+                 << " expected in TF=" << tfCounter << " part=" << hdrTmpl.splitPayloadIndex;
+    }
+    // check if the RDH to send corresponds to expected orbit
+    if (hdrTmpl.splitPayloadIndex == 0) {
+      auto ir = o2::raw::RDHUtils::getHeartBeatIR(plMessage->GetData());
+      auto tfid = hbfU.getTF(ir);
+      lm.firstOrbit = hdrTmpl.firstTForbit = hbfU.getIRTF(tfid).orbit; // will be picked for the following parts
+    }
+    o2::header::Stack headerStack{hdrTmpl, o2::framework::DataProcessingHeader{tfCounter}};
+    memcpy(hdMessage->GetData(), headerStack.data(), headerStack.size());
+    hdrTmpl.splitPayloadIndex++; // prepare for next
+
+    lm.parts.push_back(std::move(hdMessage));
+    lm.parts.push_back(std::move(plMessage));
+  }
+  lm.ioTime = ioTimer.RealTime();
+  LOGF(DEBUG, "Added %d parts for TF#%d(%d in iteration %d) of %s/%s/0x%u", hdrTmpl.splitPayloadParts, tfCounter, tfID,
+       mLoopsDone, link.origin.as<std::string>(), link.description.as<std::string>(), link.subspec);
+}
+
+//___________________________________________________________
+void RawReaderSpecs::sendTF(TFMessages& tf)
+{
+  if (tf.tfCounter) { // delay sending
     usleep(mDelayUSec);
   }
-  for (auto& msgIt : messagesPerRoute) {
+  for (auto& msgIt : tf.messagesPerRoute) {
     LOG(INFO) << "Sending " << msgIt.second->Size() / 2 << " parts to channel " << msgIt.first;
-    device->Send(*msgIt.second.get(), msgIt.first);
+    mDevice->Send(*msgIt.second.get(), msgIt.first);
   }
-  mTimer[TimerTotal].Stop();
-
-  LOGF(INFO, "Sent payload of %zu bytes in %zu parts in %zu messages for TF %d | Timing (total/IO): %.3e / %.3e", tfSize, tfNParts,
-       messagesPerRoute.size(), mTFCounter, mTimer[TimerTotal].CpuTime() - tTotStart, mTimer[TimerIO].CpuTime() - tIOStart);
+  mSentSize += tf.size;
+  mSentMessages += tf.nParts;
+}
 
-  mSentSize += tfSize;
-  mSentMessages += tfNParts;
+//___________________________________________________________
+void RawReaderSpecs::prefetch()
+{
+  // read ahead the TFs until the end of data, keeping at most mPrefetchDepth of them in the queue
+  while (true) {
+    std::unique_ptr<TFMessages> tf;
+    try {
+      tf = readNextTF();
+    } catch (...) {
+      tf = std::make_unique<TFMessages>();
+      tf->error = std::current_exception();
+      tf->last = true;
+    }
+    bool last = tf->last;
+    {
+      std::unique_lock<std::mutex> lock(mPrefetchMutex);
+      mPrefetchCond.wait(lock, [this] { return mStopPrefetch || int(mPrefetched.size()) < mPrefetchDepth; });
+      if (mStopPrefetch) {
+        return;
+      }
+      mPrefetched.push_back(std::move(tf));
+    }
+    mPrefetchCond.notify_all();
+    if (last) {
+      return;
+    }
+  }
+}
 
-  mReader->setNextTFToRead(++tfID);
-  ++mTFCounter;
+//___________________________________________________________
+void RawReaderSpecs::stopPrefetching()
+{
+  {
+    std::lock_guard<std::mutex> lock(mPrefetchMutex);
+    mStopPrefetch = true;
+  }
+  mPrefetchCond.notify_all();
+  if (mPrefetchThread.joinable()) {
+    mPrefetchThread.join();
+  }
+  mPrefetched.clear();
 }
 
 //_________________________________________________________
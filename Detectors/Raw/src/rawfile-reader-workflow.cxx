@@ -33,6 +33,10 @@ void customize(std::vector<o2::framework::ConfigParamSpec>& workflowOptions)
   options.push_back(ConfigParamSpec{"part-per-hbf", VariantType::Bool, false, {"FMQ parts per superpage (default) of HBF"}});
   options.push_back(ConfigParamSpec{"raw-channel-config", VariantType::String, "", {"optional raw FMQ channel for non-DPL output"}});
   options.push_back(ConfigParamSpec{"cache-data", VariantType::Bool, false, {"cache data at 1st reading, may require excessive memory!!!"}});
+  options.push_back(ConfigParamSpec{"prefetch-tf", VariantType::Int, 0, {"number of TFs to read ahead asynchronously (0: read on demand)"}});
+  options.push_back(ConfigParamSpec{"io-threads", VariantType::Int, 1, {"number of threads reading the links of the TF concurrently"}});
+  options.push_back(ConfigParamSpec{"use-index", VariantType::Bool, false, {"use index files to skip preprocessing of unchanged raw files"}});
+  options.push_back(ConfigParamSpec{"index-dir", VariantType::String, "", {"directory for index files (default: next to raw files)"}});
   options.push_back(ConfigParamSpec{"detect-tf0", VariantType::Bool, false, {"autodetect HBFUtils start Orbit/BC from 1st TF seen"}});
   options.push_back(ConfigParamSpec{"calculate-tf-start", VariantType::Bool, false, {"calculate TF start instead of using TType"}});
   options.push_back(ConfigParamSpec{"drop-tf", VariantType::String, "none", {"Drop each TFid%(1)==(2) of detector, e.g. ITS,2,4;TPC,4[,0];..."}});
@@ -61,6 +65,10 @@ WorkflowSpec defineDataProcessing(ConfigContext const& configcontext)
   rinp.spSize = uint64_t(configcontext.options().get<int64_t>("super-page-size"));
   rinp.partPerSP = !configcontext.options().get<bool>("part-per-hbf");
   rinp.cache = configcontext.options().get<bool>("cache-data");
+  rinp.prefetchTFs = configcontext.options().get<int>("prefetch-tf");
+  rinp.ioThreads = configcontext.options().get<int>("io-threads");
+  rinp.useIndex = configcontext.options().get<bool>("use-index");
+  rinp.indexDir = configcontext.options().get<std::string>("index-dir");
   rinp.autodetectTF0 = configcontext.options().get<bool>("detect-tf0");
   rinp.preferCalcTF = configcontext.options().get<bool>("calculate-tf-start");
   rinp.rawChannelConfig = configcontext.options().get<std::string>("raw-channel-config");
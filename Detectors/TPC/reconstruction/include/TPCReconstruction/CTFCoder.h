@@ -19,6 +19,7 @@
 #include <iterator>
 #include <string>
 #include <cassert>
+#include <functional>
 #include <tuple>
 #include <type_traits>
 #include <typeinfo>
@@ -138,6 +139,9 @@ class CTFCoder : public o2::ctf::CTFCoderBase
   bool getCombineColumns() const { return mCombineColumns; }
   void setCombineColumns(bool v) { mCombineColumns = v; }
 
+  int getNStreams() const { return mNStreams; }
+  void setNStreams(int n);
+
  private:
   void checkDataDictionaryConsistency(const CTFHeader& h);
 
@@ -147,7 +151,8 @@ class CTFCoder : public o2::ctf::CTFCoderBase
   template <typename source_T>
   void buildCoder(ctf::CTFCoderBase::OpType coderType, const CTF::container_t& ctf, CTF::Slots slot);
 
-  bool mCombineColumns = false; // combine correlated columns
+  bool mCombineColumns = false;             // combine correlated columns
+  int mNStreams = o2::ctf::DefaultNStreams; // number of interleaved rANS states used for encoding
 
   ClassDefNV(CTFCoder, 1);
 };
@@ -215,10 +220,12 @@ void CTFCoder::encode(VEC& buff, const CompressedClusters& ccl)
   ec->getANSHeader().majorVersion = 0;
   ec->getANSHeader().minorVersion = 1;
 
-  auto encodeTPC = [&buff, &optField, &coders = mCoders](auto begin, auto end, CTF::Slots slot, size_t probabilityBits) {
-    // at every encoding the buffer might be autoexpanded, so we don't work with fixed pointer ec
+  // the slots are only booked here and encoded all together (concurrently if mNThreads > 1) directly to the buffer
+  std::vector<CTF::slotEncoding> slotEncodings;
+  slotEncodings.reserve(CTF::getNBlocks());
+  auto encodeTPC = [&slotEncodings, &optField, &coders = mCoders, nStreams = mNStreams, cache = getCoderCache()](auto begin, auto end, CTF::Slots slot, size_t probabilityBits) {
     const auto slotVal = static_cast<int>(slot);
-    CTF::get(buff.data())->encode(begin, end, slotVal, probabilityBits, optField[slotVal], &buff, coders[slotVal].get());
+    slotEncodings.emplace_back(CTF::makeSlotEncoding(begin, end, slotVal, probabilityBits, optField[slotVal], coders[slotVal].get(), nStreams, cache));
   };
 
   if (mCombineColumns) {
@@ -283,6 +290,7 @@ void CTFCoder::encode(VEC& buff, const CompressedClusters& ccl)
 
   encodeTPC(ccl.nTrackClusters, ccl.nTrackClusters + ccl.nTracks, CTF::BLCnTrackClusters, 0);
   encodeTPC(ccl.nSliceRowClusters, ccl.nSliceRowClusters + ccl.nSliceRows, CTF::BLCnSliceRowClusters, 0);
+  CTF::encodeSlots(buff, slotEncodings, mNThreads);
   CTF::get(buff.data())->print(getPrefix());
 }
 
@@ -308,10 +316,11 @@ void CTFCoder::decode(const CTF::base& ec, VEC& buffVec)
   ccFlat->set(sz, cc); // set offsets
   ec.print(getPrefix());
 
-  // decode encoded data directly to destination buff
-  auto decodeTPC = [&ec, &coders = mCoders](auto begin, CTF::Slots slot) {
+  // decode encoded data directly to destination buff, the slots are booked and decoded concurrently at the end
+  std::vector<std::function<void()>> slotDecodings;
+  auto decodeTPC = [&ec, &coders = mCoders, &slotDecodings, cache = getCoderCache()](auto begin, CTF::Slots slot) {
     const auto slotVal = static_cast<int>(slot);
-    ec.decode(begin, slotVal, coders[slotVal].get());
+    slotDecodings.emplace_back([&ec, &coders, begin, slotVal, cache]() { ec.decode(begin, slotVal, coders[slotVal].get(), cache); });
   };
 
   if (mCombineColumns) {
@@ -366,6 +375,8 @@ void CTFCoder::decode(const CTF::base& ec, VEC& buffVec)
 
   decodeTPC(cc.nTrackClusters, CTF::BLCnTrackClusters);
   decodeTPC(cc.nSliceRowClusters, CTF::BLCnSliceRowClusters);
+  auto runDecoding = [&slotDecodings](size_t i) { slotDecodings[i](); };
+  o2::ctf::forEachConcurrently(slotDecodings.size(), runDecoding, mNThreads);
 }
 
 } // namespace tpc
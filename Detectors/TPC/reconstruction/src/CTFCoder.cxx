@@ -152,6 +152,15 @@ void CTFCoder::createCoders(const std::string& dictPath, o2::ctf::CTFCoderBase::
   buildCoder<std::remove_pointer_t<decltype(cc.nSliceRowClusters)>>(op, *ctf, CTF::BLCnSliceRowClusters);
 }
 
+///________________________________
+void CTFCoder::setNStreams(int n)
+{
+  if (!o2::ctf::isSupportedNStreams(n)) {
+    throw std::runtime_error(fmt::format("Unsupported number {:d} of interleaved rANS streams, use 2, 4, 8 or 16", n));
+  }
+  mNStreams = n;
+}
+
 /// make sure loaded dictionaries (if any) are consistent with data
 void CTFCoder::checkDataDictionaryConsistency(const CTFHeader& h)
 {
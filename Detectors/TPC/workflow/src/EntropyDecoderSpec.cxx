@@ -14,6 +14,7 @@
 
 #include "Framework/ControlService.h"
 #include "Framework/ConfigParamRegistry.h"
+#include "Framework/Monitoring.h"
 #include "DataFormatsTPC/CompressedClusters.h"
 #include "TPCWorkflow/EntropyDecoderSpec.h"
 
@@ -26,6 +27,8 @@ namespace tpc
 
 void EntropyDecoderSpec::init(o2::framework::InitContext& ic)
 {
+  mCTFCoder.setNThreads(ic.options().get<int>("ctf-threads"));
+  mCTFCoder.setCoderCacheCapacity(ic.options().get<int>("ctf-coder-cache"));
   std::string dictPath = ic.options().get<std::string>("ctf-dict");
   if (!dictPath.empty() && dictPath != "none") {
     mCTFCoder.createCoders(dictPath, o2::ctf::CTFCoderBase::OpType::Decoder);
@@ -42,6 +45,11 @@ void EntropyDecoderSpec::run(ProcessingContext& pc)
   auto& compclusters = pc.outputs().make<std::vector<char>>(OutputRef{"output"});
   const auto ctfImage = o2::tpc::CTF::getImage(buff.data());
   mCTFCoder.decode(ctfImage, compclusters);
+  if (auto cache = mCTFCoder.getCoderCache()) {
+    auto& monitoring = pc.services().get<o2::monitoring::Monitoring>();
+    monitoring.send({cache->getNHits(), "tpc_ctf_coder_cache_hits"});
+    monitoring.send({cache->getNMisses(), "tpc_ctf_coder_cache_misses"});
+  }
 
   mTimer.Stop();
   LOG(INFO) << "Decoded " << buff.size() * sizeof(o2::ctf::BufferType) << " encoded bytes to "
@@ -52,6 +60,9 @@ void EntropyDecoderSpec::endOfStream(EndOfStreamContext& ec)
 {
   LOGF(INFO, "TPC Entropy Decoding total timing: Cpu: %.3e Real: %.3e s in %d slots",
        mTimer.CpuTime(), mTimer.RealTime(), mTimer.Counter() - 1);
+  if (auto cache = mCTFCoder.getCoderCache()) {
+    cache->print("TPC Entropy Decoding ");
+  }
 }
 
 DataProcessorSpec getEntropyDecoderSpec()
@@ -61,7 +72,9 @@ DataProcessorSpec getEntropyDecoderSpec()
     Inputs{InputSpec{"ctf", "TPC", "CTFDATA", 0, Lifetime::Timeframe}},
     Outputs{OutputSpec{{"output"}, "TPC", "COMPCLUSTERSFLAT", 0, Lifetime::Timeframe}},
     AlgorithmSpec{adaptFromTask<EntropyDecoderSpec>()},
-    Options{{"ctf-dict", VariantType::String, o2::base::NameConf::getCTFDictFileName(), {"File of CTF decoding dictionary"}}}};
+    Options{{"ctf-dict", VariantType::String, o2::base::NameConf::getCTFDictFileName(), {"File of CTF decoding dictionary"}},
+            {"ctf-threads", VariantType::Int, 1, {"Number of threads to decode the CTF blocks concurrently"}},
+            {"ctf-coder-cache", VariantType::Int, int(o2::ctf::CoderCache::DefaultCapacity), {"Number of decoders built from the data dictionaries to reuse across TFs, 0 to disable"}}}};
 }
 
 } // namespace tpc
@@ -16,6 +16,7 @@
 #include "TPCWorkflow/EntropyEncoderSpec.h"
 #include "DataFormatsTPC/CompressedClusters.h"
 #include "Framework/ConfigParamRegistry.h"
+#include "Framework/Monitoring.h"
 #include "Headers/DataHeader.h"
 
 using namespace o2::framework;
@@ -29,6 +30,9 @@ namespace tpc
 void EntropyEncoderSpec::init(o2::framework::InitContext& ic)
 {
   mCTFCoder.setCombineColumns(!ic.options().get<bool>("no-ctf-columns-combining"));
+  mCTFCoder.setNStreams(ic.options().get<int>("ctf-rans-streams"));
+  mCTFCoder.setNThreads(ic.options().get<int>("ctf-threads"));
+  mCTFCoder.setCoderCacheCapacity(ic.options().get<int>("ctf-coder-cache"));
   std::string dictPath = ic.options().get<std::string>("ctf-dict");
   if (!dictPath.empty() && dictPath != "none") {
     mCTFCoder.createCoders(dictPath, o2::ctf::CTFCoderBase::OpType::Encoder);
@@ -59,6 +63,11 @@ void EntropyEncoderSpec::run(ProcessingContext& pc)
 
   auto& buffer = pc.outputs().make<std::vector<o2::ctf::BufferType>>(Output{"TPC", "CTFDATA", 0, Lifetime::Timeframe});
   mCTFCoder.encode(buffer, clusters);
+  if (auto cache = mCTFCoder.getCoderCache()) {
+    auto& monitoring = pc.services().get<o2::monitoring::Monitoring>();
+    monitoring.send({cache->getNHits(), "tpc_ctf_coder_cache_hits"});
+    monitoring.send({cache->getNMisses(), "tpc_ctf_coder_cache_misses"});
+  }
   auto encodedBlocks = CTF::get(buffer.data()); // cast to container pointer
   encodedBlocks->compactify();                  // eliminate unnecessary padding
   buffer.resize(encodedBlocks->size());         // shrink buffer to strictly necessary size
@@ -71,6 +80,9 @@ void EntropyEncoderSpec::endOfStream(EndOfStreamContext& ec)
 {
   LOGF(INFO, "TPC Entropy Encoding total timing: Cpu: %.3e Real: %.3e s in %d slots",
        mTimer.CpuTime(), mTimer.RealTime(), mTimer.Counter() - 1);
+  if (auto cache = mCTFCoder.getCoderCache()) {
+    cache->print("TPC Entropy Encoding ");
+  }
 }
 
 DataProcessorSpec getEntropyEncoderSpec(bool inputFromFile)
@@ -83,7 +95,10 @@ DataProcessorSpec getEntropyEncoderSpec(bool inputFromFile)
     Outputs{{"TPC", "CTFDATA", 0, Lifetime::Timeframe}},
     AlgorithmSpec{adaptFromTask<EntropyEncoderSpec>(inputFromFile)},
     Options{{"ctf-dict", VariantType::String, o2::base::NameConf::getCTFDictFileName(), {"File of CTF encoding dictionary"}},
-            {"no-ctf-columns-combining", VariantType::Bool, false, {"Do not combine correlated columns in CTF"}}}};
+            {"no-ctf-columns-combining", VariantType::Bool, false, {"Do not combine correlated columns in CTF"}},
+            {"ctf-rans-streams", VariantType::Int, int(o2::ctf::DefaultNStreams), {"Number of interleaved rANS states (2, 4, 8, 16) used for entropy encoding"}},
+            {"ctf-threads", VariantType::Int, 1, {"Number of threads to encode the CTF blocks concurrently"}},
+            {"ctf-coder-cache", VariantType::Int, int(o2::ctf::CoderCache::DefaultCapacity), {"Number of encoders built from the data dictionaries to reuse across TFs, 0 to disable"}}}};
 }
 
 } // namespace tpc
@@ -38,7 +38,9 @@
 #include <arrow/table.h>
 #include <arrow/util/key_value_metadata.h>
 
+#include <sstream>
 #include <thread>
+#include <unordered_map>
 
 using namespace o2;
 using namespace o2::aod;
@@ -86,19 +88,46 @@ struct RuntimeWatchdog {
   }
 };
 
-template <typename... C>
-static constexpr auto columnNamesTrait(framework::pack<C...>)
+using ColumnsPerTable = std::unordered_map<std::string, std::vector<std::string>>;
+
+/// parse the columns to read, given as "ORIGIN/DESCRIPTION:column,column,...;ORIGIN/DESCRIPTION:..."
+ColumnsPerTable parseColumnsToRead(std::string const& encoded)
 {
-  return std::vector<std::string>{C::columnLabel()...};
+  ColumnsPerTable columnsPerTable;
+  std::stringstream tables(encoded);
+  std::string table;
+  while (std::getline(tables, table, ';')) {
+    auto separator = table.find(':');
+    if (separator == std::string::npos) {
+      continue;
+    }
+    auto& columns = columnsPerTable[table.substr(0, separator)];
+    std::stringstream labels(table.substr(separator + 1));
+    std::string label;
+    while (std::getline(labels, label, ',')) {
+      columns.push_back(label);
+    }
+  }
+  return columnsPerTable;
 }
 
-std::vector<std::string> getColumnNames(header::DataHeader dh)
+std::vector<std::string> getColumnNames(ColumnsPerTable const& columnsPerTable, header::DataHeader dh)
 {
-  auto description = std::string(dh.dataDescription.str);
-  auto origin = std::string(dh.dataOrigin.str);
+  auto it = columnsPerTable.find(dh.dataOrigin.as<std::string>() + "/" + dh.dataDescription.as<std::string>());
 
-  // default: column names = {}
-  return std::vector<std::string>({});
+  // default: column names = {}, all columns are read
+  return it == columnsPerTable.end() ? std::vector<std::string>({}) : it->second;
+}
+
+size_t getColumnSize(arrow::ChunkedArray const& column)
+{
+  size_t size = 0;
+  for (auto& chunk : column.chunks()) {
+    for (auto& buffer : chunk->data()->buffers) {
+      size += buffer ? buffer->size() : 0;
+    }
+  }
+  return size;
 }
 
 using o2::monitoring::Metric;
@@ -176,6 +205,9 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
       }
     }
 
+    // only the columns used by the analysis tasks of the workflow are read, see WorkflowHelpers::computeAODColumnsToRead
+    auto columnsPerTable = parseColumnsToRead(options.isSet("aod-columns") ? options.get<std::string>("aod-columns") : "");
+
     // get the run time watchdog
     auto* watchdog = new RuntimeWatchdog(options.get<int64_t>("time-limit"));
 
@@ -200,6 +232,7 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
                            fileCounter,
                            numTF,
                            watchdog,
+                           columnsPerTable,
                            didir](Monitoring& monitoring, DataAllocator& outputs, ControlService& control, DeviceSpec const& device) {
       // Each parallel reader device.inputTimesliceId reads the files fileCounter*device.maxInputTimeslices+device.inputTimesliceId
       // the TF to read is numTF
@@ -218,6 +251,8 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
       bool first = true;
       static size_t totalSizeUncompressed = 0;
       static size_t totalSizeCompressed = 0;
+      static size_t totalSizeSkippedUncompressed = 0;
+      static size_t totalSizeSkippedCompressed = 0;
       static TFile* currentFile = nullptr;
       static int tfCurrentFile = -1;
       static auto currentFileStartedAt = uv_hrtime();
@@ -243,9 +278,18 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
         auto concrete = DataSpecUtils::asConcreteDataMatcher(route.matcher);
         auto dh = header::DataHeader(concrete.description, concrete.origin, concrete.subSpec);
 
-        // create a TreeToTable object
-        TTree* tr = didir->getDataTree(dh, fcnt, ntf);
-        if (!tr) {
+        // get the tree, or the table of an Arrow AOD which is sent as it is
+        TTree* tr = nullptr;
+        std::shared_ptr<arrow::Table> table;
+        auto getInput = [&]() {
+          if (didir->isArrowFile(dh, fcnt)) {
+            table = didir->getArrowTable(dh, fcnt, ntf);
+            return table != nullptr;
+          }
+          tr = didir->getDataTree(dh, fcnt, ntf);
+          return tr != nullptr;
+        };
+        if (!getInput()) {
           if (first) {
             // dump metrics of file which is done for reading
             dumpFileMetrics(monitoring, currentFile, currentFileStartedAt, currentFileIOTime, tfCurrentFile, ntf);
@@ -264,8 +308,7 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
             }
             // get first folder of next file
             ntf = 0;
-            tr = didir->getDataTree(dh, fcnt, ntf);
-            if (!tr) {
+            if (!getInput()) {
               LOGP(FATAL, "Can not retrieve tree for table {}: fileCounter {}, timeFrame {}", concrete.origin, fcnt, ntf);
               throw std::runtime_error("Processing is stopped!");
             }
@@ -283,25 +326,57 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
 
         // create table output
         auto o = Output(dh);
-        auto& t2t = outputs.make<TreeToTable>(o);
-
-        // add branches to read
-        // fill the table
-        auto colnames = getColumnNames(dh);
-        if (colnames.size() == 0) {
-          totalSizeCompressed += tr->GetZipBytes();
-          totalSizeUncompressed += tr->GetTotBytes();
-          t2t.addAllColumns(tr);
+        auto colnames = getColumnNames(columnsPerTable, dh);
+        if (table) {
+          if (colnames.size() != 0) {
+            // drop the columns which are not subscribed to, the others are not touched
+            std::vector<std::shared_ptr<arrow::Field>> fields;
+            std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
+            for (int i = 0; i < table->num_columns(); ++i) {
+              if (std::find(colnames.begin(), colnames.end(), table->field(i)->name()) != colnames.end()) {
+                fields.push_back(table->field(i));
+                columns.push_back(table->column(i));
+              } else {
+                totalSizeSkippedUncompressed += getColumnSize(*table->column(i));
+              }
+            }
+            table = arrow::Table::Make(std::make_shared<arrow::Schema>(fields), columns, table->num_rows());
+          }
+          for (auto& column : table->columns()) {
+            totalSizeUncompressed += getColumnSize(*column);
+          }
+          outputs.adopt(o, table);
         } else {
-          for (auto& colname : colnames) {
-            TBranch* branch = tr->GetBranch(colname.c_str());
-            totalSizeCompressed += branch->GetZipBytes("*");
-            totalSizeUncompressed += branch->GetTotBytes("*");
-            t2t.addColumn(colname.c_str());
+          auto& t2t = outputs.make<TreeToTable>(o);
+
+          // add branches to read
+          // fill the table
+          if (colnames.size() == 0) {
+            totalSizeCompressed += tr->GetZipBytes();
+            totalSizeUncompressed += tr->GetTotBytes();
+            t2t.addAllColumns(tr);
+          } else {
+            size_t zipBytes = 0;
+            size_t totBytes = 0;
+            for (auto& colname : colnames) {
+              TBranch* branch = tr->GetBranch(colname.c_str());
+              if (branch == nullptr) {
+                // let the table fail to bind when it is used
+                LOGP(WARNING, "Column {} not found in tree {}", colname, tr->GetName());
+                continue;
+              }
+              zipBytes += branch->GetZipBytes("*");
+              totBytes += branch->GetTotBytes("*");
+              t2t.addColumn(colname.c_str());
+            }
+            totalSizeCompressed += zipBytes;
+            totalSizeUncompressed += totBytes;
+            totalSizeSkippedCompressed += tr->GetZipBytes() - zipBytes;
+            totalSizeSkippedUncompressed += tr->GetTotBytes() - totBytes;
           }
+          t2t.fill(tr);
+          delete tr;
         }
-        t2t.fill(tr);
-        delete tr;
 
         // needed for metrics dumping (upon next file read, or terminate due to watchdog)
         if (currentFile == nullptr) {
@@ -314,6 +389,8 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
       monitoring.send(Metric{(uint64_t)ntf, "tf-sent"}.addTag(Key::Subsystem, monitoring::tags::Value::DPL));
       monitoring.send(Metric{(uint64_t)totalSizeUncompressed / 1000, "aod-bytes-read-uncompressed"}.addTag(Key::Subsystem, monitoring::tags::Value::DPL));
       monitoring.send(Metric{(uint64_t)totalSizeCompressed / 1000, "aod-bytes-read-compressed"}.addTag(Key::Subsystem, monitoring::tags::Value::DPL));
+      monitoring.send(Metric{(uint64_t)totalSizeSkippedUncompressed / 1000, "aod-bytes-skipped-uncompressed"}.addTag(Key::Subsystem, monitoring::tags::Value::DPL));
+      monitoring.send(Metric{(uint64_t)totalSizeSkippedCompressed / 1000, "aod-bytes-skipped-compressed"}.addTag(Key::Subsystem, monitoring::tags::Value::DPL));
 
       // save file number and time frame
       *fileCounter = (fcnt - device.inputTimesliceId) / device.maxInputTimeslices;
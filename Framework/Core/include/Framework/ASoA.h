@@ -19,6 +19,7 @@
 #include "Framework/Expressions.h"
 #include "Framework/ArrowTypes.h"
 #include "Framework/RuntimeError.h"
+#include "Framework/SelectionBitmap.h"
 #include <arrow/table.h>
 #include <arrow/array.h>
 #include <arrow/util/variant.h>
@@ -1723,9 +1724,16 @@ class FilteredPolicy : public T
     return mSelectedRows;
   }
 
+  /// selected rows as a bitmap, which is cheaper to combine with other selections
+  SelectionBitmap getSelectionBitmap() const
+  {
+    return SelectionBitmap{mSelectedRows, tableSize()};
+  }
+
   static inline SelectionVector copySelection(framework::expressions::Selection const& sel)
   {
     SelectionVector rows;
+    rows.reserve(sel->GetNumSlots());
     for (auto i = 0; i < sel->GetNumSlots(); ++i) {
       rows.push_back(sel->GetIndex(i));
     }
@@ -1761,21 +1769,49 @@ class FilteredPolicy : public T
  protected:
   void sumWithSelection(SelectionVector const& selection)
   {
-    SelectionVector rowsUnion;
-    std::set_union(mSelectedRows.begin(), mSelectedRows.end(), selection.begin(), selection.end(), std::back_inserter(rowsUnion));
-    mSelectedRows = rowsUnion;
+    if (useBitmaps(selection)) {
+      mSelectedRows = (getSelectionBitmap() | SelectionBitmap{selection, tableSize()}).toRows();
+    } else {
+      SelectionVector rowsUnion;
+      rowsUnion.reserve(mSelectedRows.size() + selection.size());
+      std::set_union(mSelectedRows.begin(), mSelectedRows.end(), selection.begin(), selection.end(), std::back_inserter(rowsUnion));
+      mSelectedRows = std::move(rowsUnion);
+    }
     resetRanges();
   }
 
   void intersectWithSelection(SelectionVector const& selection)
   {
-    SelectionVector intersection;
-    std::set_intersection(mSelectedRows.begin(), mSelectedRows.end(), selection.begin(), selection.end(), std::back_inserter(intersection));
-    mSelectedRows = intersection;
+    if (useBitmaps(selection)) {
+      mSelectedRows = (getSelectionBitmap() & SelectionBitmap{selection, tableSize()}).toRows();
+    } else {
+      SelectionVector intersection;
+      intersection.reserve(std::min(mSelectedRows.size(), selection.size()));
+      std::set_intersection(mSelectedRows.begin(), mSelectedRows.end(), selection.begin(), selection.end(), std::back_inserter(intersection));
+      mSelectedRows = std::move(intersection);
+    }
+    resetRanges();
+  }
+
+  void sumWithSelection(SelectionBitmap const& selection)
+  {
+    mSelectedRows = (getSelectionBitmap() | selection).toRows();
+    resetRanges();
+  }
+
+  void intersectWithSelection(SelectionBitmap const& selection)
+  {
+    mSelectedRows = (getSelectionBitmap() & selection).toRows();
     resetRanges();
   }
 
  private:
+  /// the bitmaps are a better choice when the selections hold more than one row in 64 of the table
+  bool useBitmaps(SelectionVector const& selection) const
+  {
+    return static_cast<int64_t>(mSelectedRows.size() + selection.size()) * 64 > tableSize();
+  }
+
   void resetRanges()
   {
     mFilteredEnd.reset(new RowViewSentinel{mSelectedRows.size()});
@@ -1849,6 +1885,18 @@ class Filtered : public FilteredPolicy<T>
   {
     return operator*=(other.getSelectedRows());
   }
+
+  Filtered<T> operator+=(SelectionBitmap const& selection)
+  {
+    this->sumWithSelection(selection);
+    return *this;
+  }
+
+  Filtered<T> operator*=(SelectionBitmap const& selection)
+  {
+    this->intersectWithSelection(selection);
+    return *this;
+  }
 };
 
 template <typename T>
@@ -1927,6 +1975,18 @@ class Filtered<Filtered<T>> : public FilteredPolicy<typename T::table_t>
     return operator*=(other.getSelectedRows());
   }
 
+  Filtered<Filtered<T>> operator+=(SelectionBitmap const& selection)
+  {
+    this->sumWithSelection(selection);
+    return *this;
+  }
+
+  Filtered<Filtered<T>> operator*=(SelectionBitmap const& selection)
+  {
+    this->intersectWithSelection(selection);
+    return *this;
+  }
+
  private:
   std::vector<std::shared_ptr<arrow::Table>> extractTablesFromFiltered(std::vector<Filtered<T>>&& tables)
   {
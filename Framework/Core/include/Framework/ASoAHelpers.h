@@ -14,6 +14,7 @@
 #include "Framework/ASoA.h"
 #include "Framework/Kernels.h"
 #include "Framework/RuntimeError.h"
+#include "Framework/GroupingIndex.h"
 #include <arrow/table.h>
 
 #include <iterator>
@@ -101,10 +102,9 @@ std::vector<std::pair<uint64_t, uint64_t>> doGroupTable(const std::shared_ptr<ar
   return groupedIndices;
 }
 
-template <typename T, typename T2>
-auto groupTable(const T& table, const std::string& categoryColumnName, int minCatSize, const T2& outsider)
+template <typename T2>
+std::vector<std::pair<uint64_t, uint64_t>> groupArrowTable(const std::shared_ptr<arrow::Table>& arrowTable, const std::string& categoryColumnName, int minCatSize, const T2& outsider)
 {
-  auto arrowTable = table.asArrowTable();
   auto columnIndex = arrowTable->schema()->GetFieldIndex(categoryColumnName);
   auto dataType = arrowTable->column(columnIndex)->type();
   if (dataType->id() == arrow::Type::UINT64) {
@@ -126,6 +126,22 @@ auto groupTable(const T& table, const std::string& categoryColumnName, int minCa
   throw o2::framework::runtime_error("Combinations: category column must be of integral type");
 }
 
+/// The grouping of a table is computed once per column, minimum category
+/// size and outsider value, and reused by all the combinations of the time frame.
+template <typename T, typename T2>
+auto groupTable(const T& table, const std::string& categoryColumnName, int minCatSize, const T2& outsider)
+{
+  auto arrowTable = table.asArrowTable();
+  auto column = arrowTable->GetColumnByName(categoryColumnName);
+  if (!column) {
+    throw o2::framework::runtime_error_f("Combinations: cannot find category column %s", categoryColumnName.c_str());
+  }
+  auto key = "categories/" + categoryColumnName + "/" + std::to_string(minCatSize) + "/" + std::to_string(outsider);
+  return *o2::framework::GroupingIndexCache::get<std::vector<std::pair<uint64_t, uint64_t>>>(column, key, [&]() {
+    return groupArrowTable(arrowTable, categoryColumnName, minCatSize, outsider);
+  });
+}
+
 // Synchronize categories so as groupedIndices contain elements only of categories common to all tables
 template <std::size_t K>
 void syncCategories(std::array<std::vector<std::pair<uint64_t, uint64_t>>, K>& groupedIndices)
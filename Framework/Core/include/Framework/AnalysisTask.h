@@ -27,6 +27,7 @@
 #include "Framework/VariantHelpers.h"
 #include "Framework/RuntimeError.h"
 #include "Framework/TypeIdHelpers.h"
+#include "Framework/GroupingIndex.h"
 
 #include <arrow/compute/kernel.h>
 #include <arrow/table.h>
@@ -34,6 +35,9 @@
 #include <type_traits>
 #include <utility>
 #include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <set>
 #include <sstream>
 #include <iomanip>
 namespace o2::framework
@@ -79,6 +83,60 @@ struct AnalysisDataProcessorBuilder {
     return getInputSpecs(typename T::sources_t{});
   }
 
+  template <typename T, typename = void>
+  struct is_extension_metadata : std::false_type {
+  };
+
+  template <typename T>
+  struct is_extension_metadata<T, std::void_t<typename T::expression_pack_t>> : std::true_type {
+  };
+
+  static std::string joinLabels(std::set<std::string> const& labels)
+  {
+    std::string result;
+    for (auto& label : labels) {
+      result += (result.empty() ? "" : ",") + label;
+    }
+    return result;
+  }
+
+  template <typename T, typename = void>
+  struct has_bindings : std::false_type {
+  };
+
+  template <typename T>
+  struct has_bindings<T, std::void_t<typename T::bindings_t>> : std::true_type {
+  };
+
+  template <typename C>
+  static void addColumnLabels(std::set<std::string>& labels)
+  {
+    if constexpr (C::persistent::value) {
+      labels.insert(C::columnLabel());
+    } else if constexpr (has_bindings<C>::value) {
+      labels.merge(getColumnLabels(typename C::bindings_t{}));
+    }
+  }
+
+  /// The persistent columns among @a C and the ones the dynamic columns among @a C are bound to
+  template <typename... C>
+  static std::set<std::string> getColumnLabels(framework::pack<C...>)
+  {
+    std::set<std::string> labels;
+    (addColumnLabels<C>(labels), ...);
+    return labels;
+  }
+
+  /// The columns of the base table the expression columns of an extended
+  /// table are computed from
+  template <typename... C>
+  static std::set<std::string> getExpressionInputLabels(framework::pack<C...>)
+  {
+    std::set<std::string> labels;
+    (labels.merge(expressions::getBoundColumnNames(expressions::createOperations(C::Projector()))), ...);
+    return labels;
+  }
+
   template <typename Arg>
   static void doAppendInputWithMetadata(std::vector<InputSpec>& inputs)
   {
@@ -92,7 +150,16 @@ struct AnalysisDataProcessorBuilder {
       inputSources.erase(last, inputSources.end());
       inputs.push_back(InputSpec{metadata::tableLabel(), metadata::origin(), metadata::description(), Lifetime::Timeframe, inputSources});
     } else {
-      inputs.push_back({metadata::tableLabel(), metadata::origin(), metadata::description()});
+      // The columns the AOD reader has to read for this input, see WorkflowHelpers::computeAODColumnsToRead.
+      // An extended table is spawned from the columns of its base table its expressions depend on.
+      std::set<std::string> labels;
+      if constexpr (is_extension_metadata<metadata>::value) {
+        labels = getExpressionInputLabels(typename metadata::expression_pack_t{});
+      } else {
+        labels = getColumnLabels(typename std::decay_t<Arg>::columns{});
+      }
+      std::vector<ConfigParamSpec> columns{ConfigParamSpec{"columns", VariantType::String, joinLabels(labels), {"columns used by the task"}}};
+      inputs.push_back(InputSpec{metadata::tableLabel(), metadata::origin(), metadata::description(), Lifetime::Timeframe, columns});
     }
   }
 
@@ -261,23 +328,6 @@ struct AnalysisDataProcessorBuilder {
         }
       }
 
-      template <typename Z>
-      auto changeShifts()
-      {
-        constexpr auto index = framework::has_type_at_v<Z>(associated_pack_t{});
-        if (unassignedGroups[index] > 0) {
-          uint64_t pos;
-          if constexpr (soa::is_soa_filtered_t<std::decay_t<G>>::value) {
-            pos = (*groupSelection)[position];
-          } else {
-            pos = position;
-          }
-          if ((idValues[index])[pos] < 0) {
-            ++shifts[index];
-          }
-        }
-      }
-
       GroupSlicerIterator(G& gt, std::tuple<A...>& at)
         : mAt{&at},
           mGroupingElement{gt.begin()},
@@ -287,51 +337,25 @@ struct AnalysisDataProcessorBuilder {
           groupSelection = &gt.getSelectedRows();
         }
         auto indexColumnName = getLabelFromType();
-        /// prepare slices and offsets for all associated tables that have index
-        /// to grouping table
-        ///
+        /// get the slices of all associated tables that have index to grouping
+        /// table. They are computed once per time frame and shared with the
+        /// other users of the same table.
         auto splitter = [&](auto&& x) {
           using xt = std::decay_t<decltype(x)>;
           constexpr auto index = framework::has_type_at_v<std::decay_t<decltype(x)>>(associated_pack_t{});
           if (x.size() != 0 && hasIndexTo<std::decay_t<G>>(typename xt::persistent_columns_t{})) {
-            auto result = o2::framework::sliceByColumn(indexColumnName.c_str(),
-                                                       x.asArrowTable(),
-                                                       static_cast<int32_t>(gt.tableSize()),
-                                                       &groups[index],
-                                                       &idValues[index],
-                                                       &offsets[index]);
-            if (result.ok() == false) {
-              throw runtime_error("Cannot split collection");
-            }
-            unassignedGroups[index] = std::count_if(idValues[index].begin(), idValues[index].end(), [](auto&& x) { return x < 0; });
-            if ((groups[index].size() - unassignedGroups[index]) > gt.tableSize()) {
-              throw runtime_error_f("Splitting collection resulted in a larger group number (%d, %d of them unassigned) than there is rows in the grouping table (%d).", groups[index].size(), unassignedGroups[index], gt.tableSize());
-            };
+            sliceIndices[index] = GroupingIndexCache::getSliceIndex(x.asArrowTable(), indexColumnName, gt.tableSize());
           }
-        };
-
-        std::apply(
-          [&](auto&&... x) -> void {
-            (splitter(x), ...);
-          },
-          at);
-        /// extract selections from filtered associated tables
-        auto extractor = [&](auto&& x) {
-          using xt = std::decay_t<decltype(x)>;
           if constexpr (soa::is_soa_filtered_t<xt>::value) {
-            constexpr auto index = framework::has_type_at_v<std::decay_t<decltype(x)>>(associated_pack_t{});
             selections[index] = &x.getSelectedRows();
-            starts[index] = selections[index]->begin();
-            offsets[index].push_back(std::get<xt>(at).tableSize());
           }
         };
+
         std::apply(
           [&](auto&&... x) -> void {
-            (extractor(x), ...);
+            (splitter(x), ...);
           },
           at);
-
-        (changeShifts<A>(), ...);
       }
 
       template <typename B, typename... C>
@@ -409,30 +433,23 @@ struct AnalysisDataProcessorBuilder {
           } else {
             pos = position;
           }
-          if (unassignedGroups[index] > 0) {
-            if ((idValues[index])[pos + shifts[index]] < 0) {
-              ++shifts[index];
-            }
-            pos += shifts[index];
-          }
+          auto start = sliceIndices[index]->start(pos);
+          auto size = sliceIndices[index]->size(pos);
+          auto groupedElementsTable = std::get<A1>(*mAt).asArrowTable()->Slice(start, size);
           if constexpr (soa::is_soa_filtered_t<std::decay_t<A1>>::value) {
-            auto groupedElementsTable = arrow::util::get<std::shared_ptr<arrow::Table>>(((groups[index])[pos]).value);
-
             // for each grouping element we need to slice the selection vector
-            auto start_iterator = std::lower_bound(starts[index], selections[index]->end(), (offsets[index])[pos]);
-            auto stop_iterator = std::lower_bound(start_iterator, selections[index]->end(), (offsets[index])[pos + 1]);
-            starts[index] = stop_iterator;
+            auto start_iterator = std::lower_bound(selections[index]->begin(), selections[index]->end(), static_cast<int64_t>(start));
+            auto stop_iterator = std::lower_bound(start_iterator, selections[index]->end(), static_cast<int64_t>(start + size));
             soa::SelectionVector slicedSelection{start_iterator, stop_iterator};
             std::transform(slicedSelection.begin(), slicedSelection.end(), slicedSelection.begin(),
                            [&](int64_t idx) {
-                             return idx - static_cast<int64_t>((offsets[index])[pos]);
+                             return idx - static_cast<int64_t>(start);
                            });
 
-            std::decay_t<A1> typedTable{{groupedElementsTable}, std::move(slicedSelection), (offsets[index])[pos]};
+            std::decay_t<A1> typedTable{{groupedElementsTable}, std::move(slicedSelection), start};
             return typedTable;
           } else {
-            auto groupedElementsTable = arrow::util::get<std::shared_ptr<arrow::Table>>(((groups[index])[pos]).value);
-            std::decay_t<A1> typedTable{{groupedElementsTable}, (offsets[index])[pos]};
+            std::decay_t<A1> typedTable{{groupedElementsTable}, start};
             return typedTable;
           }
         } else {
@@ -446,13 +463,8 @@ struct AnalysisDataProcessorBuilder {
       uint64_t position = 0;
       soa::SelectionVector const* groupSelection = nullptr;
 
-      std::array<std::vector<arrow::Datum>, sizeof...(A)> groups;
-      std::array<std::vector<int32_t>, sizeof...(A)> idValues;
-      std::array<std::vector<uint64_t>, sizeof...(A)> offsets;
+      std::array<std::shared_ptr<SliceIndex const>, sizeof...(A)> sliceIndices;
       std::array<soa::SelectionVector const*, sizeof...(A)> selections;
-      std::array<soa::SelectionVector::const_iterator, sizeof...(A)> starts;
-      std::array<int, sizeof...(A)> unassignedGroups{0};
-      std::array<int, sizeof...(A)> shifts{0};
     };
 
     GroupSlicerIterator& begin()
@@ -689,6 +701,85 @@ auto getNameTaskProcesses()
   }
 }
 
+/// Instances of a task processing timeslices concurrently, when the
+/// processing-threads option is larger than 1. Each copy of the task
+/// fills its own outputs, which are merged into the original one at the
+/// end of stream.
+template <typename T>
+struct AnalysisTaskInstances {
+  std::mutex mutex;
+  std::condition_variable released;
+  std::vector<std::shared_ptr<T>> idle;
+  std::vector<std::shared_ptr<T>> copies;
+
+  std::shared_ptr<T> acquire()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    released.wait(lock, [this]() { return !idle.empty(); });
+    auto instance = idle.back();
+    idle.pop_back();
+    return instance;
+  }
+
+  void release(std::shared_ptr<T> instance)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      idle.push_back(std::move(instance));
+    }
+    released.notify_one();
+  }
+
+  /// invoke @a f on an idle instance, which is returned to the pool also when @a f throws
+  template <typename F>
+  void process(F&& f)
+  {
+    struct Lease {
+      AnalysisTaskInstances& instances;
+      std::shared_ptr<T> instance;
+      ~Lease() { instances.release(std::move(instance)); }
+    } lease{*this, acquire()};
+    f(*lease.instance.get());
+  }
+
+  /// create @a n copies of @a task, false if its outputs cannot be merged
+  bool createCopies(std::shared_ptr<T> const& task, int n)
+  {
+    if constexpr (std::is_copy_constructible_v<T>) {
+      for (int i = 0; i < n; ++i) {
+        auto copy = std::make_shared<T>(*task);
+        bool cloned = true;
+        homogeneous_apply_refs([&cloned](auto& x) { cloned = OutputManager<std::decay_t<decltype(x)>>::cloneOutput(x) && cloned; return true; }, *copy);
+        if (!cloned) {
+          copies.clear();
+          return false;
+        }
+        copies.push_back(copy);
+      }
+      idle.insert(idle.end(), copies.begin(), copies.end());
+      return true;
+    } else {
+      return false;
+    }
+  }
+
+  /// add the outputs of the copies to the ones of @a task
+  void merge(T& task)
+  {
+    for (auto& copy : copies) {
+      std::vector<void*> members;
+      homogeneous_apply_refs([&members](auto& x) { members.push_back(&x); return true; }, *copy);
+      size_t i = 0;
+      homogeneous_apply_refs([&members, &i](auto& x) {
+        using M = std::decay_t<decltype(x)>;
+        return OutputManager<M>::mergeOutput(x, *static_cast<M*>(members[i++]));
+      },
+                             task);
+    }
+    copies.clear();
+  }
+};
+
 /// Adaptor to make an AlgorithmSpec from a o2::framework::Task
 ///
 template <typename T, typename... Args>
@@ -741,12 +832,21 @@ DataProcessorSpec adaptAnalysisTask(ConfigContext const& ctx, Args&&... args)
 
   homogeneous_apply_refs([&outputs, &hash](auto& x) { return OutputManager<std::decay_t<decltype(x)>>::appendOutput(outputs, x, hash); }, *task.get());
 
+  // number of timeslices processed concurrently, each by its own copy of the task
+  if (std::none_of(options.begin(), options.end(), [](ConfigParamSpec const& option) { return option.name == "processing-threads"; })) {
+    options.push_back(ConfigParamSpec{"processing-threads", VariantType::Int, 1, {"number of time frames processed concurrently by copies of the task"}});
+  }
+
   auto algo = AlgorithmSpec::InitCallback{[task = task, processTuple = processTuple, expressionInfos](InitContext& ic) mutable {
     homogeneous_apply_refs([&ic](auto&& x) { return OptionManager<std::decay_t<decltype(x)>>::prepare(ic, x); }, *task.get());
     homogeneous_apply_refs([&ic](auto&& x) { return ServiceManager<std::decay_t<decltype(x)>>::prepare(ic, x); }, *task.get());
 
+    auto instances = std::make_shared<AnalysisTaskInstances<T>>();
+    instances->idle.push_back(task);
+
     auto& callbacks = ic.services().get<CallbackService>();
-    auto endofdatacb = [task](EndOfStreamContext& eosContext) {
+    auto endofdatacb = [task, instances](EndOfStreamContext& eosContext) {
+      instances->merge(*task.get());
       homogeneous_apply_refs([&eosContext](auto&& x) { return OutputManager<std::decay_t<decltype(x)>>::postRun(eosContext, x); }, *task.get());
       eosContext.services().get<ControlService>().readyToQuit(QuitRequest::Me);
     };
@@ -772,15 +872,23 @@ DataProcessorSpec adaptAnalysisTask(ConfigContext const& ctx, Args&&... args)
       task->init(ic);
     }
 
-    return [task, processTuple, expressionInfos](ProcessingContext& pc) {
-      homogeneous_apply_refs([&pc](auto&& x) { return OutputManager<std::decay_t<decltype(x)>>::prepare(pc, x); }, *task.get());
-      if constexpr (has_run_v<T>) {
-        task->run(pc);
-      }
-      if constexpr ((std::tuple_size_v<std::decay_t<decltype(processTuple)>>) > 0) {
-        AnalysisDataProcessorBuilder::invokeProcessTuple(*(task.get()), pc.inputs(), processTuple, expressionInfos);
-      }
-      homogeneous_apply_refs([&pc](auto&& x) { return OutputManager<std::decay_t<decltype(x)>>::finalize(pc, x); }, *task.get());
+    // the copies are made once the task is fully initialised
+    auto nThreads = ic.options().get<int>("processing-threads");
+    if (nThreads > 1 && !instances->createCopies(task, nThreads - 1)) {
+      LOGP(WARNING, "The outputs of {} cannot be merged, its time frames are processed one at a time", type_name<T>());
+    }
+
+    return [instances, processTuple, expressionInfos](ProcessingContext& pc) {
+      instances->process([&](T& instance) {
+        homogeneous_apply_refs([&pc](auto&& x) { return OutputManager<std::decay_t<decltype(x)>>::prepare(pc, x); }, instance);
+        if constexpr (has_run_v<T>) {
+          instance.run(pc);
+        }
+        if constexpr ((std::tuple_size_v<std::decay_t<decltype(processTuple)>>) > 0) {
+          AnalysisDataProcessorBuilder::invokeProcessTuple(instance, pc.inputs(), processTuple, expressionInfos);
+        }
+        homogeneous_apply_refs([&pc](auto&& x) { return OutputManager<std::decay_t<decltype(x)>>::finalize(pc, x); }, instance);
+      });
     };
   }};
 
@@ -0,0 +1,61 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_ARROWAODHELPERS_H_
+#define O2_FRAMEWORK_ARROWAODHELPERS_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace arrow
+{
+class Table;
+}
+
+class TFile;
+
+namespace o2::framework
+{
+
+/// Helpers for AODs stored in the Arrow IPC file format (aka Feather V2).
+///
+/// An Arrow AOD is a directory with the structure of an AO2D ROOT file,
+/// one uncompressed file per table and time frame:
+///
+///   <directory>/DF_<time frame number>/<tree name>.arrow
+///
+/// The files are memory mapped when read, therefore the columns of the
+/// resulting arrow::Table point to the page cache and no decoding is needed.
+struct ArrowAODHelpers {
+  static constexpr char const* Extension = ".arrow";
+
+  /// true if @a path is an Arrow AOD directory
+  static bool isArrowAOD(std::string const& path);
+
+  /// sorted list of the time frame numbers (DF_<number> folders) in the Arrow AOD @a path
+  static std::vector<uint64_t> getTimeFrameNumbers(std::string const& path);
+
+  /// name of the file holding the tree @a treeName of the folder @a folderName
+  static std::string getTableFileName(std::string const& path, std::string const& folderName, std::string const& treeName);
+
+  /// memory map the file @a fileName and return its content. The table keeps the mapping alive.
+  static std::shared_ptr<arrow::Table> readTable(std::string const& fileName);
+
+  /// write @a table to @a fileName in the Arrow IPC file format
+  static void writeTable(std::string const& fileName, arrow::Table const& table);
+
+  /// convert the AO2D ROOT file @a input to the Arrow AOD @a outputPath and return the number of tables written
+  static size_t convertFromROOT(TFile* input, std::string const& outputPath);
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_ARROWAODHELPERS_H_
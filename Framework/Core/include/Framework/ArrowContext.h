@@ -11,9 +11,13 @@
 #define O2_FRAMEWORK_ARROWCONTEXT_H_
 
 #include "Framework/FairMQDeviceProxy.h"
+#include "Framework/DataProcessingHeader.h"
+#include <fairmq/FairMQMessage.h>
+#include <algorithm>
 #include <cassert>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -52,6 +56,7 @@ class ArrowContext
                  std::function<void(std::shared_ptr<FairMQResizableBuffer>)> finalize,
                  const std::string& channel)
   {
+    std::lock_guard<std::mutex> lock(mMutex);
     mMessages.push_back(std::move(MessageRef{std::move(header),
                                              std::move(buffer),
                                              std::move(finalize),
@@ -85,6 +90,17 @@ class ArrowContext
     mMessages.clear();
   }
 
+  /// drop the buffers of @a timeslice which are not sent yet, e.g. because its processing failed
+  void discardTimeslice(size_t timeslice)
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mMessages.erase(std::remove_if(mMessages.begin(), mMessages.end(), [timeslice](MessageRef const& m) {
+                      auto const* dph = m.header ? o2::header::get<DataProcessingHeader*>(m.header->GetData()) : nullptr;
+                      return dph != nullptr && dph->startTime == timeslice;
+                    }),
+                    mMessages.end());
+  }
+
   FairMQDeviceProxy& proxy()
   {
     return mProxy;
@@ -133,6 +149,8 @@ class ArrowContext
  private:
   FairMQDeviceProxy mProxy;
   Messages mMessages;
+  /// Serialises the additions from the processing callbacks running concurrently
+  std::mutex mMutex;
   size_t mBytesSent = 0;
   size_t mBytesDestroyed = 0;
   size_t mMessagesCreated = 0;
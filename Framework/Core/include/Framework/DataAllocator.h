@@ -59,6 +59,8 @@ namespace o2
 namespace framework
 {
 class ServiceRegistry;
+struct DataRef;
+struct MessageSet;
 
 #define ERROR_STRING                                          \
   "data type T not supported by API, "                        \
@@ -373,6 +375,19 @@ class DataAllocator
   void snapshot(const Output& spec, const char* payload, size_t payloadSize,
                 o2::header::SerializationMethod serializationMethod = o2::header::gSerializationMethodNone);
 
+  /// Send the payload of one of the inputs being processed to the specified output, with the
+  /// serialization method of the input. When the input message and the output channel use the same
+  /// transport, e.g. the same shared memory segment, the new message refers to the buffer of the
+  /// input, which is kept alive by reference counting. Otherwise the payload is copied like with
+  /// snapshot.
+  void forwardPayload(const Output& spec, DataRef const& input);
+
+  /// The inputs being processed, which forwardPayload can refer to.
+  void setCurrentInputs(std::vector<MessageSet> const* inputs)
+  {
+    mCurrentInputs = inputs;
+  }
+
   /// make an object of type T and route to output specified by OutputRef
   /// The object is owned by the framework, returned reference can be used to fill the object.
   ///
@@ -448,18 +463,19 @@ class DataAllocator
 
   o2::header::DataHeader* findMessageHeader(const Output& spec)
   {
-    return mRegistry->get<MessageContext>().findMessageHeader(spec);
+    return mRegistry->get<MessageContext>().findMessageHeader(spec, mTimingInfo->timeslice);
   }
 
   o2::header::DataHeader* findMessageHeader(OutputRef&& ref)
   {
-    return mRegistry->get<MessageContext>().findMessageHeader(getOutputByBind(std::move(ref)));
+    return mRegistry->get<MessageContext>().findMessageHeader(getOutputByBind(std::move(ref)), mTimingInfo->timeslice);
   }
 
  private:
   AllowedOutputRoutes mAllowedOutputRoutes;
   TimingInfo* mTimingInfo;
   ServiceRegistry* mRegistry;
+  std::vector<MessageSet> const* mCurrentInputs = nullptr;
 
   std::string const& matchDataHeader(const Output& spec, size_t timeframeId);
   FairMQMessagePtr headerMessageFromOutput(Output const& spec,                                  //
@@ -15,9 +15,15 @@
 
 #include "Framework/DataDescriptorMatcher.h"
 
+#include <memory>
 #include <regex>
 #include "rapidjson/fwd.h"
 
+namespace arrow
+{
+class Table;
+}
+
 namespace o2::framework
 {
 
@@ -26,6 +32,7 @@ struct FileNameHolder {
   int numberOfTimeFrames = 0;
   std::vector<uint64_t> listOfTimeFrameNumbers;
   std::vector<std::string> listOfTimeFrameKeys;
+  bool isArrow = false; // Arrow AOD directory, see ArrowAODHelpers
 };
 FileNameHolder* makeFileNameHolder(std::string fileName);
 
@@ -70,6 +77,8 @@ struct DataInputDescriptor {
   uint64_t getTimeFrameNumber(int counter, int numTF);
   FileAndFolder getFileFolder(int counter, int numTF);
   int getTimeFramesInFile(int counter);
+  bool isArrowFile(int counter);
+  std::shared_ptr<arrow::Table> getArrowTable(int counter, int numTF, std::string const& treename);
 
   void closeInputFile();
   bool isAlienSupportOn() { return mAlienSupport; }
@@ -113,6 +122,9 @@ struct DataInputDirector {
 
   std::unique_ptr<TTreeReader> getTreeReader(header::DataHeader dh, int counter, int numTF, std::string treeName);
   TTree* getDataTree(header::DataHeader dh, int counter, int numTF);
+  /// table of an Arrow AOD input, nullptr if there is no time frame left
+  std::shared_ptr<arrow::Table> getArrowTable(header::DataHeader dh, int counter, int numTF);
+  bool isArrowFile(header::DataHeader dh, int counter);
   uint64_t getTimeFrameNumber(header::DataHeader dh, int counter, int numTF);
   FileAndFolder getFileFolder(header::DataHeader dh, int counter, int numTF);
   int getTimeFramesInFile(header::DataHeader dh, int counter);
@@ -39,6 +39,7 @@ namespace o2::framework
 struct InputChannelInfo;
 struct DeviceState;
 struct ComputingQuotaEvaluator;
+class ProcessingWorkerPool;
 
 /// Context associated to a given DataProcessor.
 /// For the time being everything points to
@@ -83,6 +84,9 @@ struct DataProcessorContext {
   AlgorithmSpec::ProcessCallback* statefulProcess = nullptr;
   AlgorithmSpec::ProcessCallback* statelessProcess = nullptr;
   AlgorithmSpec::ErrorCallback* error = nullptr;
+  /// Threads processing the ready timeslices concurrently, nullptr
+  /// if the DataProcessor is not declared as thread safe.
+  ProcessingWorkerPool* workerPool = nullptr;
 
   std::function<void(o2::framework::RuntimeErrorRef e, InputRecord& record)>* errorHandling = nullptr;
 };
@@ -147,6 +151,8 @@ class DataProcessingDevice : public FairMQDevice
   std::vector<ExpirationHandler> mExpirationHandlers;
   /// Completed actions
   std::vector<DataRelayer::RecordAction> mCompleted;
+  /// Worker threads, created when the processing-threads option is present
+  std::shared_ptr<ProcessingWorkerPool> mWorkerPool;
 
   uint64_t mLastSlowMetricSentTimestamp = 0;         /// The timestamp of the last time we sent slow metrics
   uint64_t mLastMetricFlushedTimestamp = 0;          /// The timestamp of the last time we actually flushed metrics
@@ -18,8 +18,11 @@
 #include "Framework/MessageSet.h"
 #include "Framework/TimesliceIndex.h"
 #include "Framework/Tracing.h"
+#include "Framework/InputRouteLookup.h"
 
+#include <atomic>
 #include <cstddef>
+#include <memory>
 #include <mutex>
 #include <vector>
 
@@ -35,10 +38,10 @@ namespace o2::framework
 
 /// Helper struct to hold statistics about the relaying process.
 struct DataRelayerStats {
-  uint64_t malformedInputs = 0;         /// Malformed inputs which the user attempted to process
-  uint64_t droppedComputations = 0;     /// How many computations have been dropped because one of the inputs was late
-  uint64_t droppedIncomingMessages = 0; /// How many messages have been dropped (not relayed) because they were late
-  uint64_t relayedMessages = 0;         /// How many messages have been successfully relayed
+  uint64_t malformedInputs = 0;             /// Malformed inputs which the user attempted to process
+  uint64_t droppedComputations = 0;         /// How many computations have been dropped because one of the inputs was late
+  uint64_t droppedIncomingMessages = 0;     /// How many messages have been dropped (not relayed) because they were late
+  std::atomic<uint64_t> relayedMessages{0}; /// How many messages have been successfully relayed
 };
 
 enum struct CacheEntryStatus : int {
@@ -116,6 +119,16 @@ class DataRelayer
   /// Tune the maximum number of in flight timeslices this can handle.
   void setPipelineLength(size_t s);
 
+  /// Allow relay to be invoked concurrently from several threads, while the
+  /// completed slots are consumed by another one. Messages for a concrete
+  /// route of a timeslice which already has a slot are then stored by
+  /// acquiring only that slot, without the relayer lock. Must be set before
+  /// relaying starts. The DataProcessingDevice relays from a single thread
+  /// and does not enable it: this is for users of the relayer which receive
+  /// from several threads.
+  void setConcurrentRelaying(bool v) { mConcurrentRelaying = v; }
+  bool getConcurrentRelaying() const { return mConcurrentRelaying; }
+
   /// @return the current stats about the data relaying process
   DataRelayerStats const& getStats() const;
 
@@ -139,6 +152,22 @@ class DataRelayer
   void clear();
 
  private:
+  /// The part of the state of a slot which is accessed without holding mMutex
+  /// when relaying concurrently.
+  struct SlotState {
+    std::atomic<uint64_t> timeslice{TimesliceId::INVALID}; /// timeslice accepted by the slot, INVALID if none
+    std::atomic<bool> dirty{false};                        /// data was relayed without updating the TimesliceIndex
+    std::atomic_flag busy = ATOMIC_FLAG_INIT;              /// spinlock owning the cache line of the slot
+  };
+
+  /// Store the message in the slot which already accepts its timeslice, holding
+  /// only the lock of the slot.
+  /// @return false if no such slot exists, in which case nothing was done.
+  bool relayToPublishedSlot(int input, uint64_t timeslice,
+                            std::unique_ptr<FairMQMessage>& firstPart,
+                            std::unique_ptr<FairMQMessage>* restOfParts,
+                            size_t restOfPartsSize);
+
   monitoring::Monitoring& mMetrics;
 
   /// This is the actual cache of all the parts in flight.
@@ -154,6 +183,11 @@ class DataRelayer
   CompletionPolicy mCompletionPolicy;
   std::vector<size_t> mDistinctRoutesIndex;
   std::vector<data_matcher::DataDescriptorMatcher> mInputMatchers;
+  /// Lookup of the routes by the DataHeader of the incoming message
+  InputRouteLookup mInputRouteLookup;
+  /// One per slot of the TimesliceIndex
+  std::unique_ptr<SlotState[]> mSlotStates;
+  bool mConcurrentRelaying = false;
   std::vector<data_matcher::VariableContext> mVariableContextes;
   std::vector<CacheEntryStatus> mCachedStateMetrics;
 
@@ -0,0 +1,58 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_EXPRESSIONCACHE_H_
+#define O2_FRAMEWORK_EXPRESSIONCACHE_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace arrow
+{
+class Schema;
+}
+
+namespace gandiva
+{
+class Condition;
+class Expression;
+class Filter;
+class Projector;
+} // namespace gandiva
+
+namespace o2::framework::expressions
+{
+
+/// Process wide cache of the filters and projectors compiled by gandiva,
+/// keyed by the schema of the table and by the expressions.
+///
+/// The same filter is applied to every time frame, and often by several
+/// tasks of the same workflow, so that it only needs to be compiled once.
+/// The cached objects are shared by all the threads of the process.
+struct ExpressionCache {
+  struct Stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    /// total time spent compiling the expressions
+    uint64_t compileTimeMs = 0;
+  };
+
+  static std::shared_ptr<gandiva::Filter> getFilter(std::shared_ptr<arrow::Schema> const& schema,
+                                                    std::shared_ptr<gandiva::Condition> const& condition);
+  static std::shared_ptr<gandiva::Projector> getProjector(std::shared_ptr<arrow::Schema> const& schema,
+                                                          std::vector<std::shared_ptr<gandiva::Expression>> const& expressions);
+  static Stats getStats();
+  /// drop all the cached objects
+  static void clear();
+};
+
+} // namespace o2::framework::expressions
+
+#endif // O2_FRAMEWORK_EXPRESSIONCACHE_H_
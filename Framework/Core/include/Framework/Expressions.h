@@ -20,6 +20,7 @@
 #include "Framework/ConfigParamRegistry.h"
 #include "Framework/RootConfigParamHelpers.h"
 #include "Framework/RuntimeError.h"
+#include "Framework/ExpressionCache.h"
 #include <arrow/type_fwd.h>
 #include <gandiva/gandiva_aliases.h>
 #include <arrow/type.h>
@@ -339,6 +340,8 @@ using Operations = std::vector<ColumnOperationSpec>;
 /// Function to create an internal operation sequence from a filter tree
 Operations createOperations(Filter const& expression);
 
+/// Function to get the labels of the columns an operation sequence depends on
+std::set<std::string> getBoundColumnNames(Operations const& opSpecs);
 /// Function to check compatibility of a given arrow schema with operation sequence
 bool isSchemaCompatible(gandiva::SchemaPtr const& Schema, Operations const& opSpecs);
 /// Function to create gandiva expression tree from operation sequence
@@ -370,20 +373,13 @@ void updatePlaceholders(Filter& filter, InitContext& context);
 template <typename... C>
 std::shared_ptr<gandiva::Projector> createProjectors(framework::pack<C...>, gandiva::SchemaPtr schema)
 {
-  std::shared_ptr<gandiva::Projector> projector;
-  auto s = gandiva::Projector::Make(
+  return ExpressionCache::getProjector(
     schema,
     {makeExpression(
       framework::expressions::createExpressionTree(
         framework::expressions::createOperations(C::Projector()),
         schema),
-      C::asArrowField())...},
-    &projector);
-  if (s.ok()) {
-    return projector;
-  } else {
-    throw o2::framework::runtime_error_f("Failed to create projector: %s", s.ToString().c_str());
-  }
+      C::asArrowField())...});
 }
 } // namespace o2::framework::expressions
 
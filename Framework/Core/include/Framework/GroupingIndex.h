@@ -0,0 +1,72 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_GROUPINGINDEX_H_
+#define O2_FRAMEWORK_GROUPINGINDEX_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace arrow
+{
+class ChunkedArray;
+class Table;
+} // namespace arrow
+
+namespace o2::framework
+{
+
+/// Position of the rows of each group in a table grouped by an index
+/// column, e.g. the tracks of each collision. The rows of a group are
+/// contiguous, rows with a negative index belong to no group.
+struct SliceIndex {
+  std::vector<uint64_t> starts;
+  std::vector<uint64_t> sizes;
+
+  uint64_t start(int64_t group) const { return starts[group]; }
+  uint64_t size(int64_t group) const { return sizes[group]; }
+  int64_t groups() const { return starts.size(); }
+};
+
+/// Indices built from a column of a table, which are computed once per
+/// column and shared by all their users in the process, e.g. the several
+/// process methods and copies of a task and the block combinations.
+/// Entries are dropped once the column they were built for is deleted.
+struct GroupingIndexCache {
+  /// get the index named @a key of @a column, or create it with @a build
+  template <typename I, typename F>
+  static std::shared_ptr<I const> get(std::shared_ptr<arrow::ChunkedArray> const& column, std::string const& key, F&& build)
+  {
+    if (auto found = find(column, key)) {
+      return std::static_pointer_cast<I const>(found);
+    }
+    std::shared_ptr<I const> index = std::make_shared<I>(build());
+    insert(column, key, index);
+    return index;
+  }
+
+  /// slices of @a table grouped by the index column @a columnName pointing to a table of @a nGroups rows
+  static std::shared_ptr<SliceIndex const> getSliceIndex(std::shared_ptr<arrow::Table> const& table, std::string const& columnName, int64_t nGroups);
+
+  /// build the slices from the values of an index column
+  static SliceIndex makeSliceIndex(arrow::ChunkedArray const& column, int64_t nGroups);
+
+  /// number of indices in the cache
+  static size_t size();
+
+ private:
+  static std::shared_ptr<void const> find(std::shared_ptr<arrow::ChunkedArray> const& column, std::string const& key);
+  static void insert(std::shared_ptr<arrow::ChunkedArray> const& column, std::string const& key, std::shared_ptr<void const> index);
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_GROUPINGINDEX_H_
@@ -25,6 +25,7 @@
 #include <TDataMember.h>
 #include <TDataType.h>
 
+#include <array>
 #include <deque>
 
 class TList;
@@ -47,6 +48,16 @@ struct HistFiller {
   template <typename... Cs, typename R, typename T>
   static void fillHistAny(std::shared_ptr<R>& hist, const T& table, const o2::framework::expressions::Filter& filter);
 
+  // fill any type of histogram with columns (Cs) of a table, TH1, TH2 and TH3 are filled in batches of BulkSize rows
+  template <typename... Cs, typename R, typename T>
+  static void fillHistAnyTable(std::shared_ptr<R>& hist, const T& table);
+
+  // fill nEntries at once into a TH1, TH2 or TH3, with one array of values per axis and optionally an array of weights;
+  // the bins of a batch are computed in one pass and the contents are accumulated directly into the histogram arrays
+  static void fillHistBulk(TH1* hist, size_t nEntries, double const* const* coordinates, double const* weights = nullptr);
+
+  static constexpr size_t BulkSize = 1024;
+
   // function that returns rough estimate for the size of a histogram in MB
   template <typename T>
   static double getSize(std::shared_ptr<T>& hist, double fillFraction = 1.);
@@ -122,6 +133,10 @@ class HistogramRegistry
   template <typename... Cs, typename T>
   void fill(const HistName& histName, const T& table, const o2::framework::expressions::Filter& filter);
 
+  // fill hist with content of table columns
+  template <typename... Cs, typename T>
+  void fill(const HistName& histName, const T& table);
+
   // get rough estimate for size of histogram stored in registry
   double getSize(const HistName& histName, double fillFraction = 1.);
 
@@ -131,6 +146,12 @@ class HistogramRegistry
   // print summary of the histograms stored in registry
   void print(bool showAxisDetails = false);
 
+  // replace the histograms by empty clones, so that a copy of this registry fills its own histograms
+  void cloneHistograms();
+
+  // add the content of the histograms of another registry with the same histograms, e.g. a copy of this one
+  void merge(HistogramRegistry const& other);
+
   // lookup distance counter for benchmarking
   mutable uint32_t lookup = 0;
 
@@ -223,13 +244,43 @@ void HistFiller::fillHistAny(std::shared_ptr<T>& hist, const Ts&... positionAndW
 template <typename... Cs, typename R, typename T>
 void HistFiller::fillHistAny(std::shared_ptr<R>& hist, const T& table, const o2::framework::expressions::Filter& filter)
 {
-  if constexpr (std::is_base_of_v<StepTHn, T>) {
-    LOGF(FATAL, "Table filling is not (yet?) supported for StepTHn.");
-    return;
-  }
   auto filtered = o2::soa::Filtered<T>{{table.asArrowTable()}, o2::framework::expressions::createSelection(table.asArrowTable(), filter)};
-  for (auto& t : filtered) {
-    fillHistAny(hist, (*(static_cast<Cs>(t).getIterator()))...);
+  fillHistAnyTable<Cs...>(hist, filtered);
+}
+
+template <typename... Cs, typename R, typename T>
+void HistFiller::fillHistAnyTable(std::shared_ptr<R>& hist, const T& table)
+{
+  constexpr size_t nColumns = sizeof...(Cs);
+  constexpr size_t nDim = std::is_same_v<TH3, R> ? 3 : (std::is_same_v<TH2, R> ? 2 : 1);
+  constexpr bool validBulkFill = (std::is_same_v<TH1, R> || std::is_same_v<TH2, R> || std::is_same_v<TH3, R>) && (nColumns == nDim || nColumns == nDim + 1);
+
+  if constexpr (std::is_base_of_v<StepTHn, R>) {
+    LOGF(FATAL, "Table filling is not (yet?) supported for StepTHn.");
+  } else if constexpr (validBulkFill) {
+    // the values of a batch of rows are collected column by column, the last one being the weight if there is one more column than axes
+    std::array<std::array<double, BulkSize>, nColumns> values;
+    std::array<double const*, nDim> coordinates;
+    for (size_t dim = 0; dim < nDim; ++dim) {
+      coordinates[dim] = values[dim].data();
+    }
+    double const* weights = nColumns > nDim ? values[nColumns - 1].data() : nullptr;
+    size_t nEntries = 0;
+    for (auto& t : table) {
+      size_t column = 0;
+      ((values[column++][nEntries] = static_cast<double>(*(static_cast<Cs>(t).getIterator()))), ...);
+      if (++nEntries == BulkSize) {
+        fillHistBulk(hist.get(), nEntries, coordinates.data(), weights);
+        nEntries = 0;
+      }
+    }
+    if (nEntries > 0) {
+      fillHistBulk(hist.get(), nEntries, coordinates.data(), weights);
+    }
+  } else {
+    for (auto& t : table) {
+      fillHistAny(hist, (*(static_cast<Cs>(t).getIterator()))...);
+    }
   }
 }
 
@@ -387,5 +438,11 @@ void HistogramRegistry::fill(const HistName& histName, const T& table, const o2:
   std::visit([&table, &filter](auto&& hist) { HistFiller::fillHistAny<Cs...>(hist, table, filter); }, mRegistryValue[getHistIndex(histName)]);
 }
 
+template <typename... Cs, typename T>
+void HistogramRegistry::fill(const HistName& histName, const T& table)
+{
+  std::visit([&table](auto&& hist) { HistFiller::fillHistAnyTable<Cs...>(hist, table); }, mRegistryValue[getHistIndex(histName)]);
+}
+
 } // namespace o2::framework
 #endif // FRAMEWORK_HISTOGRAMREGISTRY_H_
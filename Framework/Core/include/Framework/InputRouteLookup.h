@@ -0,0 +1,67 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_INPUTROUTELOOKUP_H_
+#define O2_FRAMEWORK_INPUTROUTELOOKUP_H_
+
+#include "Framework/ConcreteDataMatcher.h"
+#include "Headers/DataHeader.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace o2::framework
+{
+
+/// Precompiled dispatch of the incoming messages to the distinct input routes.
+/// Routes with a ConcreteDataMatcher are found by hashing the origin, description
+/// and subSpecification of the DataHeader, while the routes with wildcards still
+/// need to be tried with their DataDescriptorMatcher.
+struct InputRouteLookup {
+  struct ConcreteHash {
+    size_t operator()(ConcreteDataMatcher const& m) const
+    {
+      uint64_t h = (uint64_t(m.origin.itg[0]) << 32) ^ m.subSpec;
+      h ^= m.description.itg[0] * 0x9e3779b97f4a7c15ULL;
+      h ^= m.description.itg[1] * 0xc2b2ae3d27d4eb4fULL;
+      return h ^ (h >> 29);
+    }
+  };
+  /// position in the distinct routes index of the first route with a given concrete matcher
+  std::unordered_map<ConcreteDataMatcher, int, ConcreteHash> concrete;
+  /// positions in the distinct routes index of the routes which are not concrete, in increasing order
+  std::vector<int> wildcards;
+
+  /// Fill @a candidates with the positions of the distinct routes which may match the
+  /// message with header @a dh, in the same order of priority as the routes themselves.
+  void getCandidates(header::DataHeader const* dh, std::vector<int>& candidates) const
+  {
+    candidates.clear();
+    auto concreteRoute = concrete.end();
+    if (dh) {
+      concreteRoute = concrete.find(ConcreteDataMatcher{dh->dataOrigin, dh->dataDescription, dh->subSpecification});
+    }
+    if (concreteRoute == concrete.end()) {
+      candidates.insert(candidates.end(), wildcards.begin(), wildcards.end());
+      return;
+    }
+    // The concrete route must still be tried with its matcher, since the timeslice may not match
+    // the context, in which case a wildcard route with lower priority may be picked up.
+    auto pos = std::lower_bound(wildcards.begin(), wildcards.end(), concreteRoute->second);
+    candidates.insert(candidates.end(), wildcards.begin(), pos);
+    candidates.push_back(concreteRoute->second);
+    candidates.insert(candidates.end(), pos, wildcards.end());
+  }
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_INPUTROUTELOOKUP_H_
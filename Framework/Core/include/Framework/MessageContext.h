@@ -10,6 +10,7 @@
 #ifndef FRAMEWORK_MESSAGECONTEXT_H
 #define FRAMEWORK_MESSAGECONTEXT_H
 
+#include "Framework/DataProcessingHeader.h"
 #include "Framework/DispatchControl.h"
 #include "Framework/FairMQDeviceProxy.h"
 #include "Framework/RuntimeError.h"
@@ -24,6 +25,7 @@
 
 #include <cassert>
 #include <functional>
+#include <mutex>
 #include <string>
 #include <type_traits>
 #include <unordered_map>
@@ -114,6 +116,14 @@ class MessageContext
       return o2::header::get<o2::header::DataHeader*>(mParts.At(0)->GetData());
     }
 
+    DataProcessingHeader const* processingHeader()
+    {
+      if (empty() || mParts.At(0) == nullptr) {
+        return nullptr;
+      }
+      return o2::header::get<DataProcessingHeader*>(mParts.At(0)->GetData());
+    }
+
    protected:
     FairMQParts mParts;
     std::string const& mChannel;
@@ -429,9 +439,13 @@ class MessageContext
   template <typename T, typename... Args>
   auto& add(Args&&... args)
   {
-    mMessages.push_back(std::move(make<T>(std::forward<Args>(args)...)));
-    // return a reference to the element in the vector of unique pointers
-    return *dynamic_cast<T*>(mMessages.back().get());
+    // the object is created outside of the lock, its constructor accesses the context
+    auto message = make<T>(std::forward<Args>(args)...);
+    auto& ref = *dynamic_cast<T*>(message.get());
+    std::lock_guard<std::mutex> lock(mMutex);
+    mMessages.push_back(std::move(message));
+    // return a reference to the element owned by the vector of unique pointers
+    return ref;
   }
 
   /// Create the specified context object from the variadic arguments as a unique pointer of the context
@@ -465,6 +479,7 @@ class MessageContext
     if (header == nullptr) {
       throw std::logic_error("No valid header message found");
     }
+    std::lock_guard<std::mutex> lock(mMutex);
     mScheduledMessages.emplace_back(std::move(message));
     if (mDispatchControl.dispatch != nullptr) {
       // send all scheduled messages if there is no trigger callback or its result is true
@@ -488,6 +503,7 @@ class MessageContext
 
   Messages getMessagesForSending()
   {
+    std::lock_guard<std::mutex> lock(mMutex);
     // before starting iteration, message lists are merged
     for (auto& message : mScheduledMessages) {
       mMessages.emplace_back(std::move(message));
@@ -498,6 +514,7 @@ class MessageContext
 
   size_t size()
   {
+    std::lock_guard<std::mutex> lock(mMutex);
     return mMessages.size();
   }
 
@@ -506,6 +523,7 @@ class MessageContext
   /// discarded.
   void clear()
   {
+    std::lock_guard<std::mutex> lock(mMutex);
     // Verify that everything has been sent on clear.
     for (auto& m : mMessages) {
       assert(m->empty());
@@ -519,6 +537,7 @@ class MessageContext
   /// multimessage.
   std::string const& getChannelRef(std::string const& channel)
   {
+    std::lock_guard<std::mutex> lock(mChannelRefsMutex);
     auto ref = mChannelRefs.find(channel);
     if (ref != mChannelRefs.end()) {
       return *(ref->second);
@@ -539,16 +558,27 @@ class MessageContext
   FairMQMessagePtr createMessage(const std::string& channel, int index, size_t size);
   FairMQMessagePtr createMessage(const std::string& channel, int index, void* data, size_t size, fairmq_free_fn* ffn, void* hint);
 
-  /// return the header of the 1st (from the end) matching message checking first in
-  /// mMessages then in mScheduledMessages
-  o2::header::DataHeader* findMessageHeader(const Output& spec);
+  /// return the header of the 1st (from the end) message matching @a spec and created
+  /// for @a timeslice, checking first in mMessages then in mScheduledMessages
+  o2::header::DataHeader* findMessageHeader(const Output& spec, size_t timeslice);
+
+  /// drop the messages of @a timeslice which are not sent yet, e.g. because its processing failed.
+  /// They are only destroyed by releaseDiscarded, so that the headers returned by
+  /// findMessageHeader stay valid until the timeslice is finalised.
+  void discardTimeslice(size_t timeslice);
+  void releaseDiscarded(size_t timeslice);
 
  private:
   FairMQDeviceProxy mProxy;
   Messages mMessages;
   Messages mScheduledMessages;
+  std::unordered_map<size_t, Messages> mDiscardedMessages;
   DispatchControl mDispatchControl;
   std::unordered_map<std::string, std::unique_ptr<std::string>> mChannelRefs;
+  /// The messages can be created by the processing callbacks running concurrently
+  /// on the worker threads of the device, see DataProcessingDevice
+  std::mutex mMutex;
+  std::mutex mChannelRefsMutex;
 };
 } // namespace framework
 } // namespace o2
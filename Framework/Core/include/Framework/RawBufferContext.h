@@ -16,6 +16,7 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <mutex>
 
 class FairMQMessage;
 
@@ -66,6 +67,9 @@ class RawBufferContext
 
   void clear();
 
+  /// drop the buffers of @a timeslice which are not sent yet, e.g. because its processing failed
+  void discardTimeslice(size_t timeslice);
+
   FairMQDeviceProxy& proxy()
   {
     return mProxy;
@@ -74,6 +78,8 @@ class RawBufferContext
  private:
   FairMQDeviceProxy mProxy;
   Messages mMessages;
+  /// Serialises the additions from the processing callbacks running concurrently
+  std::mutex mMutex;
 };
 
 } // namespace o2::framework
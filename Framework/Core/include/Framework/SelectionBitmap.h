@@ -0,0 +1,139 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_SELECTIONBITMAP_H_
+#define O2_FRAMEWORK_SELECTIONBITMAP_H_
+
+#include "Framework/RuntimeError.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace gandiva
+{
+class SelectionVector;
+}
+
+namespace o2::soa
+{
+
+/// Selection of the rows of a table stored as one bit per row.
+///
+/// For loose filters this is up to 64 times smaller than the equivalent
+/// list of row indices, and combining selections is a loop over 64 bit
+/// words, which the compiler vectorises, rather than a merge of two sorted
+/// vectors.
+class SelectionBitmap
+{
+ public:
+  SelectionBitmap() = default;
+  /// empty selection of a table with @a size rows
+  explicit SelectionBitmap(int64_t size) : mSize{size}, mWords((size + 63) / 64, 0) {}
+  /// selection of the sorted row indices @a rows of a table with @a size rows
+  SelectionBitmap(std::vector<int64_t> const& rows, int64_t size) : SelectionBitmap(size)
+  {
+    for (auto row : rows) {
+      set(row);
+    }
+  }
+  /// selection produced by a gandiva filter on a table with @a size rows
+  SelectionBitmap(gandiva::SelectionVector const& selection, int64_t size);
+
+  /// number of rows of the table
+  int64_t size() const { return mSize; }
+
+  /// number of selected rows
+  int64_t count() const
+  {
+    int64_t n = 0;
+    for (auto word : mWords) {
+      n += __builtin_popcountll(word);
+    }
+    return n;
+  }
+
+  bool test(int64_t row) const { return (mWords[row >> 6] >> (row & 63)) & 1; }
+  void set(int64_t row) { mWords[row >> 6] |= uint64_t{1} << (row & 63); }
+  void reset(int64_t row) { mWords[row >> 6] &= ~(uint64_t{1} << (row & 63)); }
+
+  /// intersection with another selection of the same table
+  SelectionBitmap& operator&=(SelectionBitmap const& other)
+  {
+    checkSameSize(other);
+    auto* __restrict__ words = mWords.data();
+    auto const* __restrict__ otherWords = other.mWords.data();
+    for (size_t i = 0, n = mWords.size(); i < n; ++i) {
+      words[i] &= otherWords[i];
+    }
+    return *this;
+  }
+
+  /// union with another selection of the same table
+  SelectionBitmap& operator|=(SelectionBitmap const& other)
+  {
+    checkSameSize(other);
+    auto* __restrict__ words = mWords.data();
+    auto const* __restrict__ otherWords = other.mWords.data();
+    for (size_t i = 0, n = mWords.size(); i < n; ++i) {
+      words[i] |= otherWords[i];
+    }
+    return *this;
+  }
+
+  /// invoke @a f with the index of each selected row, in increasing order
+  template <typename F>
+  void forEachSelected(F&& f) const
+  {
+    for (size_t i = 0; i < mWords.size(); ++i) {
+      for (auto word = mWords[i]; word != 0; word &= word - 1) {
+        f(static_cast<int64_t>(i * 64 + __builtin_ctzll(word)));
+      }
+    }
+  }
+
+  /// sorted indices of the selected rows
+  std::vector<int64_t> toRows() const
+  {
+    std::vector<int64_t> rows;
+    rows.reserve(count());
+    forEachSelected([&rows](int64_t row) { rows.push_back(row); });
+    return rows;
+  }
+
+  /// selected rows as a gandiva selection vector
+  std::shared_ptr<gandiva::SelectionVector> toSelection() const;
+
+  uint64_t const* words() const { return mWords.data(); }
+
+ private:
+  void checkSameSize(SelectionBitmap const& other) const
+  {
+    if (other.mSize != mSize) {
+      throw o2::framework::runtime_error_f("Cannot combine selections of tables with %lld and %lld rows", (long long)mSize, (long long)other.mSize);
+    }
+  }
+
+  int64_t mSize = 0;
+  std::vector<uint64_t> mWords;
+};
+
+inline SelectionBitmap operator&(SelectionBitmap lhs, SelectionBitmap const& rhs)
+{
+  return lhs &= rhs;
+}
+
+inline SelectionBitmap operator|(SelectionBitmap lhs, SelectionBitmap const& rhs)
+{
+  return lhs |= rhs;
+}
+
+} // namespace o2::soa
+
+#endif // O2_FRAMEWORK_SELECTIONBITMAP_H_
@@ -14,6 +14,7 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <mutex>
 
 class FairMQMessage;
 
@@ -60,6 +61,9 @@ class StringContext
 
   void clear();
 
+  /// drop the strings of @a timeslice which are not sent yet, e.g. because its processing failed
+  void discardTimeslice(size_t timeslice);
+
   FairMQDeviceProxy& proxy()
   {
     return mProxy;
@@ -68,6 +72,8 @@ class StringContext
  private:
   FairMQDeviceProxy mProxy;
   Messages mMessages;
+  /// Serialises the additions from the processing callbacks running concurrently
+  std::mutex mMutex;
 };
 
 } // namespace o2::framework
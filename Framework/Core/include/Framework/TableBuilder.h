@@ -799,7 +799,8 @@ auto spawner(framework::pack<C...> columns, arrow::Table* atable, const char* na
     return makeEmptyTable<soa::Table<C...>>();
   }
   static auto new_schema = o2::soa::createSchemaFromColumns(columns);
-  static auto projectors = framework::expressions::createProjectors(columns, atable->schema());
+  // compiled once per schema, the projectors are cached
+  auto projectors = framework::expressions::createProjectors(columns, atable->schema());
 
   arrow::TableBatchReader reader(*atable);
   std::shared_ptr<arrow::RecordBatch> batch;
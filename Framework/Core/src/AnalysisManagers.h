@@ -16,6 +16,7 @@
 #include "Framework/ProcessingContext.h"
 #include "Framework/EndOfStreamContext.h"
 #include "Framework/HistogramRegistry.h"
+#include <TList.h>
 #include "Framework/ConfigParamSpec.h"
 #include "Framework/ConfigParamRegistry.h"
 #include "Framework/ConfigurableHelpers.h"
@@ -136,6 +137,20 @@ struct OutputManager {
   {
     return true;
   }
+
+  /// Give a copy of the task its own output objects, return false if this is not possible
+  template <typename ANY>
+  static bool cloneOutput(ANY&)
+  {
+    return true;
+  }
+
+  /// Add the content of the outputs of a copy of the task
+  template <typename ANY>
+  static bool mergeOutput(ANY&, ANY&)
+  {
+    return true;
+  }
 };
 
 /// Produces specialization
@@ -159,6 +174,14 @@ struct OutputManager<Produces<TABLE>> {
   {
     return true;
   }
+  static bool cloneOutput(Produces<TABLE>&)
+  {
+    return true;
+  }
+  static bool mergeOutput(Produces<TABLE>&, Produces<TABLE>&)
+  {
+    return true;
+  }
 };
 
 /// HistogramRegistry specialization
@@ -185,6 +208,18 @@ struct OutputManager<HistogramRegistry> {
     context.outputs().snapshot(what.ref(), *(*what));
     return true;
   }
+
+  static bool cloneOutput(HistogramRegistry& what)
+  {
+    what.cloneHistograms();
+    return true;
+  }
+
+  static bool mergeOutput(HistogramRegistry& what, HistogramRegistry& other)
+  {
+    what.merge(other);
+    return true;
+  }
 };
 
 /// OutputObj specialization
@@ -211,6 +246,28 @@ struct OutputManager<OutputObj<T>> {
     context.outputs().snapshot(what.ref(), *what);
     return true;
   }
+
+  /// only histograms can be merged
+  static bool cloneOutput(OutputObj<T>& what)
+  {
+    if constexpr (std::is_base_of_v<TH1, T> || std::is_base_of_v<THnBase, T>) {
+      what.object = std::shared_ptr<T>(static_cast<T*>(what.object->Clone()));
+      what.object->Reset();
+      return true;
+    } else {
+      return false;
+    }
+  }
+
+  static bool mergeOutput(OutputObj<T>& what, OutputObj<T>& other)
+  {
+    if constexpr (std::is_base_of_v<TH1, T> || std::is_base_of_v<THnBase, T>) {
+      TList list;
+      list.Add(other.object.get());
+      what.object->Merge(&list);
+    }
+    return true;
+  }
 };
 
 /// Spawns specializations
@@ -257,6 +314,16 @@ struct OutputManager<Spawns<T>> {
   {
     return true;
   }
+
+  static bool cloneOutput(Spawns<T>&)
+  {
+    return true;
+  }
+
+  static bool mergeOutput(Spawns<T>&, Spawns<T>&)
+  {
+    return true;
+  }
 };
 
 /// Builds specialization
@@ -307,6 +374,16 @@ struct OutputManager<Builds<T, P>> {
   {
     return true;
   }
+
+  static bool cloneOutput(Builds<T, P>&)
+  {
+    return true;
+  }
+
+  static bool mergeOutput(Builds<T, P>&, Builds<T, P>&)
+  {
+    return true;
+  }
 };
 
 template <typename T>
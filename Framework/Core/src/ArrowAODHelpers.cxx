@@ -0,0 +1,155 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/ArrowAODHelpers.h"
+#include "Framework/TableTreeHelpers.h"
+#include "Framework/Logger.h"
+
+#include <TFile.h>
+#include <TKey.h>
+#include <TTree.h>
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wshadow"
+#endif
+#include <arrow/io/file.h>
+#include <arrow/ipc/reader.h>
+#include <arrow/ipc/writer.h>
+#include <arrow/record_batch.h>
+#include <arrow/table.h>
+#include <arrow/util/config.h>
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+#include <algorithm>
+#include <filesystem>
+#include <regex>
+
+namespace fs = std::filesystem;
+
+namespace o2::framework
+{
+
+namespace
+{
+std::regex const& timeFrameFolderRegex()
+{
+  static std::regex const regex("DF_[0-9]+");
+  return regex;
+}
+} // namespace
+
+bool ArrowAODHelpers::isArrowAOD(std::string const& path)
+{
+  std::error_code ec;
+  return fs::is_directory(path, ec);
+}
+
+std::vector<uint64_t> ArrowAODHelpers::getTimeFrameNumbers(std::string const& path)
+{
+  std::vector<uint64_t> numbers;
+  for (auto const& entry : fs::directory_iterator(path)) {
+    auto name = entry.path().filename().string();
+    if (entry.is_directory() && std::regex_match(name, timeFrameFolderRegex())) {
+      numbers.emplace_back(std::stoul(name.substr(3)));
+    }
+  }
+  std::sort(numbers.begin(), numbers.end());
+  return numbers;
+}
+
+std::string ArrowAODHelpers::getTableFileName(std::string const& path, std::string const& folderName, std::string const& treeName)
+{
+  return path + "/" + folderName + "/" + treeName + Extension;
+}
+
+std::shared_ptr<arrow::Table> ArrowAODHelpers::readTable(std::string const& fileName)
+{
+  auto file = arrow::io::MemoryMappedFile::Open(fileName, arrow::io::FileMode::READ);
+  if (!file.ok()) {
+    throw std::runtime_error(fmt::format(R"(Couldn't open Arrow file "{}": {})", fileName, file.status().ToString()));
+  }
+  auto reader = arrow::ipc::RecordBatchFileReader::Open(file.ValueOrDie());
+  if (!reader.ok()) {
+    throw std::runtime_error(fmt::format(R"(Couldn't read Arrow file "{}": {})", fileName, reader.status().ToString()));
+  }
+  auto batchReader = reader.ValueOrDie();
+  // the buffers of the batches are slices of the mapping, which they keep alive
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+  for (int i = 0; i < batchReader->num_record_batches(); ++i) {
+    auto batch = batchReader->ReadRecordBatch(i);
+    if (!batch.ok()) {
+      throw std::runtime_error(fmt::format(R"(Couldn't read batch {} of Arrow file "{}": {})", i, fileName, batch.status().ToString()));
+    }
+    batches.emplace_back(batch.ValueOrDie());
+  }
+  auto table = arrow::Table::FromRecordBatches(batchReader->schema(), batches);
+  if (!table.ok()) {
+    throw std::runtime_error(fmt::format(R"(Couldn't create table from Arrow file "{}": {})", fileName, table.status().ToString()));
+  }
+  return table.ValueOrDie();
+}
+
+void ArrowAODHelpers::writeTable(std::string const& fileName, arrow::Table const& table)
+{
+  auto stream = arrow::io::FileOutputStream::Open(fileName);
+  if (!stream.ok()) {
+    throw std::runtime_error(fmt::format(R"(Couldn't create Arrow file "{}": {})", fileName, stream.status().ToString()));
+  }
+  auto sink = stream.ValueOrDie();
+#if ARROW_VERSION_MAJOR < 3
+  auto outBatch = arrow::ipc::NewFileWriter(sink.get(), table.schema());
+#else
+  auto outBatch = arrow::ipc::MakeFileWriter(sink.get(), table.schema());
+#endif
+  if (outBatch.ok() == false) {
+    throw std::runtime_error("Unable to create file writer");
+  }
+  auto writer = outBatch.ValueOrDie();
+  if (writer->WriteTable(table).ok() == false || writer->Close().ok() == false || sink->Close().ok() == false) {
+    throw std::runtime_error(fmt::format(R"(Unable to write table to "{}")", fileName));
+  }
+}
+
+size_t ArrowAODHelpers::convertFromROOT(TFile* input, std::string const& outputPath)
+{
+  size_t nTables = 0;
+  for (auto folderKey : *input->GetListOfKeys()) {
+    auto folderName = std::string(folderKey->GetName());
+    if (!std::regex_match(folderName, timeFrameFolderRegex())) {
+      continue;
+    }
+    auto folder = input->GetDirectory(folderName.c_str());
+    if (!folder) {
+      continue;
+    }
+    fs::create_directories(outputPath + "/" + folderName);
+    for (auto treeKey : *folder->GetListOfKeys()) {
+      auto tree = dynamic_cast<TTree*>(static_cast<TKey*>(treeKey)->ReadObj());
+      if (!tree) {
+        continue;
+      }
+      TreeToTable t2t;
+      if (t2t.addAllColumns(tree)) {
+        t2t.fill(tree);
+        writeTable(getTableFileName(outputPath, folderName, tree->GetName()), *t2t.finalize());
+        ++nTables;
+      } else {
+        LOGP(WARNING, "Skipping tree {}/{} without branches", folderName, tree->GetName());
+      }
+      delete tree;
+    }
+  }
+  return nTables;
+}
+
+} // namespace o2::framework
@@ -26,6 +26,7 @@
 #include "Framework/RawDeviceService.h"
 #include "Framework/Tracing.h"
 #include "Framework/Monitoring.h"
+#include "Framework/ExpressionCache.h"
 #include "TextDriverClient.h"
 #include "WSDriverClient.h"
 #include "HTTPParser.h"
@@ -610,6 +611,10 @@ auto sendRelayerMetrics(ServiceRegistry& registry, DataProcessingStats& stats) -
                     .addTag(Key::Subsystem, Value::DPL));
   monitoring.send(Metric{(stats.lastProcessedSize / (stats.lastLatency.maxLatency ? stats.lastLatency.maxLatency : 1) / 1000), "input_rate_mb_s"}
                     .addTag(Key::Subsystem, Value::DPL));
+  auto expressionStats = expressions::ExpressionCache::getStats();
+  monitoring.send(Metric{expressionStats.hits, "expressions/cache/hits"}.addTag(Key::Subsystem, Value::DPL));
+  monitoring.send(Metric{expressionStats.misses, "expressions/cache/misses"}.addTag(Key::Subsystem, Value::DPL));
+  monitoring.send(Metric{expressionStats.compileTimeMs, "expressions/compile_time_ms"}.addTag(Key::Subsystem, Value::DPL));
 
   stats.lastSlowMetricSentTimestamp.store(stats.beginIterationTimestamp.load());
   O2_SIGNPOST_END(MonitoringStatus::ID, MonitoringStatus::SEND, 0, 0, O2_SIGNPOST_BLUE);
@@ -15,6 +15,8 @@
 #include "Framework/ArrowContext.h"
 #include "Framework/DataSpecUtils.h"
 #include "Framework/DataProcessingHeader.h"
+#include "Framework/DataRef.h"
+#include "Framework/MessageSet.h"
 #include "Headers/Stack.h"
 #include "FairMQResizableBuffer.h"
 
@@ -255,6 +257,36 @@ void DataAllocator::snapshot(const Output& spec, const char* payload, size_t pay
   addPartToContext(std::move(payloadMessage), spec, serializationMethod);
 }
 
+void DataAllocator::forwardPayload(const Output& spec, DataRef const& input)
+{
+  auto const* inputHeader = o2::header::get<DataHeader*>(input.header);
+  if (inputHeader == nullptr) {
+    throw runtime_error("Cannot forward a payload without a DataHeader");
+  }
+  FairMQMessage const* inputPayload = nullptr;
+  if (mCurrentInputs != nullptr) {
+    for (auto const& inputSet : *mCurrentInputs) {
+      for (auto const& part : inputSet) {
+        if (part.payload && part.payload->GetData() == input.payload) {
+          inputPayload = part.payload.get();
+          break;
+        }
+      }
+    }
+  }
+
+  std::string const& channel = matchDataHeader(spec, mTimingInfo->timeslice);
+  auto* transport = mRegistry->get<MessageContext>().proxy().getTransport(channel);
+  if (inputPayload == nullptr || inputPayload->GetType() != transport->GetType() || inputPayload->GetSize() != inputHeader->payloadSize) {
+    snapshot(spec, input.payload, inputHeader->payloadSize, inputHeader->payloadSerializationMethod);
+    return;
+  }
+  // the transport shares the buffer of the input instead of copying it whenever possible
+  FairMQMessagePtr payloadMessage = transport->CreateMessage();
+  payloadMessage->Copy(*inputPayload);
+  addPartToContext(std::move(payloadMessage), spec, inputHeader->payloadSerializationMethod);
+}
+
 Output DataAllocator::getOutputByBind(OutputRef&& ref)
 {
   if (ref.label.empty()) {
@@ -8,6 +8,7 @@
 // granted to it by virtue of its status as an Intergovernmental Organization
 // or submit itself to any jurisdiction.
 #include "Framework/DataInputDirector.h"
+#include "Framework/ArrowAODHelpers.h"
 #include "Framework/DataDescriptorQueryBuilder.h"
 #include "Framework/Logger.h"
 #include "AnalysisDataModelHelpers.h"
@@ -77,6 +78,7 @@ void DataInputDescriptor::addFileNameHolder(FileNameHolder* fn)
     TGrid::Connect("alien://");
     mAlienSupport = true;
   }
+  fn->isArrow = ArrowAODHelpers::isArrowAOD(fn->fileName);
 
   mtotalNumberTimeFrames += fn->numberOfTimeFrames;
   mfilenames.emplace_back(fn);
@@ -89,8 +91,21 @@ bool DataInputDescriptor::setFile(int counter)
     return false;
   }
 
-  // open file
   auto filename = mfilenames[counter]->fileName;
+  if (mfilenames[counter]->isArrow) {
+    // nothing to open, the tables are memory mapped when read
+    closeInputFile();
+    if (mfilenames[counter]->numberOfTimeFrames <= 0) {
+      mfilenames[counter]->listOfTimeFrameNumbers = ArrowAODHelpers::getTimeFrameNumbers(filename);
+      for (auto folderNumber : mfilenames[counter]->listOfTimeFrameNumbers) {
+        mfilenames[counter]->listOfTimeFrameKeys.emplace_back("DF_" + std::to_string(folderNumber));
+      }
+      mfilenames[counter]->numberOfTimeFrames = mfilenames[counter]->listOfTimeFrameKeys.size();
+    }
+    return true;
+  }
+
+  // open file
   if (mcurrentFile) {
     if (mcurrentFile->GetName() != filename) {
       closeInputFile();
@@ -169,6 +184,21 @@ int DataInputDescriptor::getTimeFramesInFile(int counter)
   return mfilenames.at(counter)->numberOfTimeFrames;
 }
 
+bool DataInputDescriptor::isArrowFile(int counter)
+{
+  return counter < getNumberInputfiles() && mfilenames[counter]->isArrow;
+}
+
+std::shared_ptr<arrow::Table> DataInputDescriptor::getArrowTable(int counter, int numTF, std::string const& treename)
+{
+  // no TF left
+  if (!setFile(counter) || numTF >= mfilenames[counter]->numberOfTimeFrames) {
+    return nullptr;
+  }
+  auto fileName = ArrowAODHelpers::getTableFileName(mfilenames[counter]->fileName, mfilenames[counter]->listOfTimeFrameKeys[numTF], treename);
+  return ArrowAODHelpers::readTable(fileName);
+}
+
 void DataInputDescriptor::closeInputFile()
 {
   if (mcurrentFile) {
@@ -582,6 +612,31 @@ TTree* DataInputDirector::getDataTree(header::DataHeader dh, int counter, int nu
   return tree;
 }
 
+std::shared_ptr<arrow::Table> DataInputDirector::getArrowTable(header::DataHeader dh, int counter, int numTF)
+{
+  std::string treename;
+
+  auto didesc = getDataInputDescriptor(dh);
+  if (didesc) {
+    treename = didesc->treename;
+  } else {
+    didesc = mdefaultDataInputDescriptor;
+    treename = aod::datamodel::getTreeName(dh);
+  }
+
+  return didesc->getArrowTable(counter, numTF, treename);
+}
+
+bool DataInputDirector::isArrowFile(header::DataHeader dh, int counter)
+{
+  auto didesc = getDataInputDescriptor(dh);
+  // if NOT match then use defaultDataInputDescriptor
+  if (!didesc) {
+    didesc = mdefaultDataInputDescriptor;
+  }
+  return didesc->isArrowFile(counter);
+}
+
 void DataInputDirector::closeInputFiles()
 {
   mdefaultDataInputDescriptor->closeInputFile();
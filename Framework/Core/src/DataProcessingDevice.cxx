@@ -21,6 +21,10 @@
 #include "Framework/DeviceState.h"
 #include "Framework/DispatchPolicy.h"
 #include "Framework/DispatchControl.h"
+#include "Framework/MessageContext.h"
+#include "Framework/StringContext.h"
+#include "Framework/ArrowContext.h"
+#include "Framework/RawBufferContext.h"
 #include "Framework/DanglingContext.h"
 #include "Framework/DriverClient.h"
 #include "Framework/EndOfStreamContext.h"
@@ -40,6 +44,7 @@
 #include "DataProcessingStatus.h"
 #include "DataProcessingHelpers.h"
 #include "DataRelayerHelpers.h"
+#include "ProcessingWorkerPool.h"
 
 #include "ScopedExit.h"
 
@@ -54,6 +59,7 @@
 #include <TClonesArray.h>
 
 #include <algorithm>
+#include <exception>
 #include <vector>
 #include <memory>
 #include <unordered_map>
@@ -254,6 +260,18 @@ void DataProcessingDevice::Init()
 
   mConfigRegistry = std::make_unique<ConfigParamRegistry>(std::move(configStore));
 
+  // A DataProcessor declares that its processing callback can be invoked
+  // concurrently for different timeslices by having the processing-threads
+  // option. The value is the number of threads to use.
+  mWorkerPool.reset();
+  if (mConfigRegistry->isSet("processing-threads")) {
+    auto nThreads = mConfigRegistry->get<int>("processing-threads");
+    if (nThreads > 1) {
+      LOG(INFO) << "Processing up to " << nThreads << " timeslices concurrently";
+      mWorkerPool = std::make_shared<ProcessingWorkerPool>(nThreads);
+    }
+  }
+
   mExpirationHandlers.clear();
 
   auto distinct = DataRelayerHelpers::createDistinctRouteIndex(mSpec.inputs);
@@ -475,6 +493,7 @@ void DataProcessingDevice::fillContext(DataProcessorContext& context, DeviceCont
   context.statefulProcess = &mStatefulProcess;
   context.statelessProcess = &mStatelessProcess;
   context.error = &mError;
+  context.workerPool = mWorkerPool.get();
   context.deviceContext = &deviceContext;
   /// Callback for the error handling
   context.errorHandling = &mErrorHandling;
@@ -906,11 +925,24 @@ void update_maximum(std::atomic<T>& maximum_value, T const& value) noexcept
 bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context, std::vector<DataRelayer::RecordAction>& completed)
 {
   ZoneScopedN("DataProcessingDevice::tryDispatchComputation");
-  // This is the actual hidden state for the outer loop. In case we decide we
-  // want to support multithreaded dispatching of operations, I can simply
-  // move these to some thread local store and the rest of the lambdas
-  // should work just fine.
-  std::vector<MessageSet> currentSetOfInputs;
+  // This is the state associated to the processing of a given timeslice.
+  // When the processing callback is invoked concurrently for different
+  // timeslices, each of them gets its own allocator and TimingInfo, so that
+  // the created messages carry the correct timeslice. Otherwise the ones of
+  // the device are used.
+  struct TimesliceProcessing {
+    DataRelayer::RecordAction action;
+    std::vector<MessageSet> inputs;
+    TimingInfo timingInfo;
+    std::unique_ptr<DataAllocator> allocator;
+    std::unique_ptr<InputSpan> span;
+    std::unique_ptr<InputRecord> record;
+    std::unique_ptr<ProcessingContext> processContext;
+    uint64_t tStart = 0;
+    /// Exception thrown by the processing callback, handled once the
+    /// processing is finalised.
+    std::exception_ptr error;
+  };
 
   auto reportError = [&registry = *context.registry, &context](const char* message) {
     registry.get<DataProcessingStats>().errorCount++;
@@ -939,8 +971,7 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
   };
 
   //
-  auto getInputSpan = [&relayer = context.relayer,
-                       &currentSetOfInputs](TimesliceSlot slot) {
+  auto getInputSpan = [&relayer = context.relayer](TimesliceSlot slot, std::vector<MessageSet>& currentSetOfInputs) {
     currentSetOfInputs = std::move(relayer->getInputsForTimeslice(slot));
     auto getter = [&currentSetOfInputs](size_t i, size_t partindex) -> DataRef {
       if (currentSetOfInputs[i].size() > partindex) {
@@ -953,7 +984,7 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
     auto nofPartsGetter = [&currentSetOfInputs](size_t i) -> size_t {
       return currentSetOfInputs[i].size();
     };
-    return InputSpan{getter, nofPartsGetter, currentSetOfInputs.size()};
+    return std::make_unique<InputSpan>(getter, nofPartsGetter, currentSetOfInputs.size());
   };
 
   auto markInputsAsDone = [&relayer = context.relayer](TimesliceSlot slot) -> void {
@@ -964,20 +995,19 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
   // propagates it to the various contextes (i.e. the actual entities which
   // create messages) because the messages need to have the timeslice id into
   // it.
-  auto prepareAllocatorForCurrentTimeSlice = [&timingInfo = context.timingInfo,
-                                              &relayer = context.relayer](TimesliceSlot i) {
+  auto prepareAllocatorForCurrentTimeSlice = [&relayer = context.relayer](TimesliceSlot i, TimingInfo& timingInfo) {
     ZoneScopedN("DataProcessingDevice::prepareForCurrentTimeslice");
     auto timeslice = relayer->getTimesliceForSlot(i);
-    timingInfo->timeslice = timeslice.value;
-    timingInfo->tfCounter = relayer->getFirstTFCounterForSlot(i);
-    timingInfo->firstTFOrbit = relayer->getFirstTFOrbitForSlot(i);
+    timingInfo.timeslice = timeslice.value;
+    timingInfo.tfCounter = relayer->getFirstTFCounterForSlot(i);
+    timingInfo.firstTFOrbit = relayer->getFirstTFOrbitForSlot(i);
   };
 
   // When processing them, timers will have to be cleaned up
   // to avoid double counting them.
   // This was actually the easiest solution we could find for
   // O2-646.
-  auto cleanTimers = [&currentSetOfInputs](TimesliceSlot slot, InputRecord& record) {
+  auto cleanTimers = [](TimesliceSlot slot, InputRecord& record, std::vector<MessageSet>& currentSetOfInputs) {
     assert(record.size() == currentSetOfInputs.size());
     for (size_t ii = 0, ie = record.size(); ii < ie; ++ii) {
       DataRef input = record.getByPos(ii);
@@ -1020,7 +1050,7 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
   // FIXME: do it in a smarter way than O(N^2)
   auto forwardInputs = [&reportError,
                         &spec = context.deviceContext->spec,
-                        &device = context.deviceContext->device, &currentSetOfInputs](TimesliceSlot slot, InputRecord& record) {
+                        &device = context.deviceContext->device](TimesliceSlot slot, InputRecord& record, std::vector<MessageSet>& currentSetOfInputs) {
     ZoneScopedN("forward inputs");
     assert(record.size() == currentSetOfInputs.size());
     // we collect all messages per forward in a map and send them together
@@ -1129,46 +1159,71 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
     }
   };
 
-  for (auto action : getReadyActions()) {
-    if (action.op == CompletionPolicy::CompletionOp::Wait) {
-      continue;
+  // Prepare the processing of a timeslice. Returns false if there is
+  // nothing to process, because the inputs were discarded.
+  auto prepareProcessing = [&context, &prepareAllocatorForCurrentTimeSlice, &getInputSpan,
+                            &forwardInputs, &markInputsAsDone, &preUpdateStats](DataRelayer::RecordAction const& action, TimesliceProcessing& current, bool concurrent) -> bool {
+    current.action = action;
+    DataAllocator* allocator = context.allocator;
+    if (concurrent) {
+      prepareAllocatorForCurrentTimeSlice(TimesliceSlot{action.slot}, current.timingInfo);
+      current.allocator = std::make_unique<DataAllocator>(&current.timingInfo, context.registry, context.deviceContext->spec->outputs);
+      allocator = current.allocator.get();
+    } else {
+      prepareAllocatorForCurrentTimeSlice(TimesliceSlot{action.slot}, *context.timingInfo);
     }
-
-    prepareAllocatorForCurrentTimeSlice(TimesliceSlot{action.slot});
-    InputSpan span = getInputSpan(action.slot);
-    InputRecord record{context.deviceContext->spec->inputs, span};
-    ProcessingContext processContext{record, *context.registry, *context.allocator};
+    current.span = getInputSpan(action.slot, current.inputs);
+    current.record = std::make_unique<InputRecord>(context.deviceContext->spec->inputs, *current.span);
+    current.processContext = std::make_unique<ProcessingContext>(*current.record, *context.registry, *allocator);
     {
       ZoneScopedN("service pre processing");
-      context.registry->preProcessingCallbacks(processContext);
+      context.registry->preProcessingCallbacks(*current.processContext);
     }
     if (action.op == CompletionPolicy::CompletionOp::Discard) {
-      context.registry->postDispatchingCallbacks(processContext);
+      context.registry->postDispatchingCallbacks(*current.processContext);
       if (context.deviceContext->spec->forwards.empty() == false) {
-        forwardInputs(action.slot, record);
-        continue;
+        forwardInputs(action.slot, *current.record, current.inputs);
+        return false;
       }
     }
+    allocator->setCurrentInputs(&current.inputs);
     markInputsAsDone(action.slot);
 
-    uint64_t tStart = uv_hrtime();
-    preUpdateStats(action, record, tStart);
-    try {
-      if (context.deviceContext->state->quitRequested == false) {
+    current.tStart = uv_hrtime();
+    preUpdateStats(action, *current.record, current.tStart);
+    return true;
+  };
 
-        if (*context.statefulProcess) {
-          ZoneScopedN("statefull process");
-          (*context.statefulProcess)(processContext);
-        }
-        if (*context.statelessProcess) {
-          ZoneScopedN("stateless process");
-          (*context.statelessProcess)(processContext);
-        }
+  // Invoke the user callbacks. This is the only step which can run on
+  // the worker threads, so any error is kept for later.
+  auto process = [&context](TimesliceProcessing& current) {
+    if (context.deviceContext->state->quitRequested) {
+      return;
+    }
+    try {
+      if (*context.statefulProcess) {
+        ZoneScopedN("statefull process");
+        (*context.statefulProcess)(*current.processContext);
+      }
+      if (*context.statelessProcess) {
+        ZoneScopedN("stateless process");
+        (*context.statelessProcess)(*current.processContext);
+      }
+    } catch (...) {
+      current.error = std::current_exception();
+    }
+  };
 
-        {
-          ZoneScopedN("service post processing");
-          context.registry->postProcessingCallbacks(processContext);
-        }
+  auto finaliseProcessing = [&context, &postUpdateStats, &forwardInputs, &cleanupRecord, &cleanTimers](TimesliceProcessing& current) {
+    auto& action = current.action;
+    auto& record = *current.record;
+    try {
+      if (current.error) {
+        std::rethrow_exception(current.error);
+      }
+      if (context.deviceContext->state->quitRequested == false) {
+        ZoneScopedN("service post processing");
+        context.registry->postProcessingCallbacks(*current.processContext);
       }
     } catch (std::exception& ex) {
       ZoneScopedN("error handling");
@@ -1182,19 +1237,78 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
       (*context.errorHandling)(e, record);
     }
 
-    postUpdateStats(action, record, tStart);
+    postUpdateStats(action, record, current.tStart);
     // We forward inputs only when we consume them. If we simply Process them,
     // we keep them for next message arriving.
     if (action.op == CompletionPolicy::CompletionOp::Consume) {
-      context.registry->postDispatchingCallbacks(processContext);
+      context.registry->postDispatchingCallbacks(*current.processContext);
       if (context.deviceContext->spec->forwards.empty() == false) {
-        forwardInputs(action.slot, record);
+        forwardInputs(action.slot, record, current.inputs);
       }
 #ifdef TRACY_ENABLE
       cleanupRecord(record);
 #endif
     } else if (action.op == CompletionPolicy::CompletionOp::Process) {
-      cleanTimers(action.slot, record);
+      cleanTimers(action.slot, record, current.inputs);
+    }
+  };
+
+  auto readyActions = getReadyActions();
+  if (context.workerPool != nullptr) {
+    // The DataProcessor declared its callback as thread safe. All the ready
+    // timeslices are prepared serially, processed concurrently and then
+    // finalised serially, in the same order as they would be dispatched.
+    std::vector<TimesliceProcessing> batch(readyActions.size());
+    size_t batchSize = 0;
+    for (auto& action : readyActions) {
+      if (action.op == CompletionPolicy::CompletionOp::Wait) {
+        continue;
+      }
+      if (prepareProcessing(action, batch[batchSize], true)) {
+        batchSize++;
+      } else {
+        batch[batchSize] = TimesliceProcessing{};
+      }
+    }
+    {
+      ZoneScopedN("concurrent process");
+      context.workerPool->run(batchSize, [&batch, &process](size_t i) { process(batch[i]); });
+    }
+    // The outputs of all the timeslices are in the same contexts, the ones
+    // created by a failed callback must not go out with the others. The
+    // discarded messages are destroyed only once the batch is finalised.
+    auto releaseDiscarded = make_scope_guard([&batch, batchSize, &context]() noexcept {
+      for (size_t i = 0; i < batchSize; ++i) {
+        if (batch[i].error) {
+          context.registry->get<MessageContext>().releaseDiscarded(batch[i].timingInfo.timeslice);
+        }
+      }
+    });
+    for (size_t i = 0; i < batchSize; ++i) {
+      if (batch[i].error) {
+        auto timeslice = batch[i].timingInfo.timeslice;
+        context.registry->get<MessageContext>().discardTimeslice(timeslice);
+        context.registry->get<StringContext>().discardTimeslice(timeslice);
+        context.registry->get<ArrowContext>().discardTimeslice(timeslice);
+        context.registry->get<RawBufferContext>().discardTimeslice(timeslice);
+      }
+    }
+    for (size_t i = 0; i < batchSize; ++i) {
+      finaliseProcessing(batch[i]);
+    }
+  } else {
+    for (auto& action : readyActions) {
+      if (action.op == CompletionPolicy::CompletionOp::Wait) {
+        continue;
+      }
+      TimesliceProcessing current;
+      // The shared allocator must not keep pointing to the inputs of this
+      // timeslice once it is gone, also when the processing throws.
+      auto resetInputs = make_scope_guard([allocator = context.allocator]() noexcept { allocator->setCurrentInputs(nullptr); });
+      if (prepareProcessing(action, current, false)) {
+        process(current);
+        finaliseProcessing(current);
+      }
     }
   }
   // We now broadcast the end of stream if it was requested
@@ -31,6 +31,8 @@
 
 #include <fmt/format.h>
 #include <gsl/span>
+#include <algorithm>
+#include <atomic>
 #include <numeric>
 #include <string>
 
@@ -47,6 +49,45 @@ constexpr int INVALID_INPUT = -1;
 // The number should really be tuned at runtime for each processor.
 constexpr int DEFAULT_PIPELINE_LENGTH = 16;
 
+namespace
+{
+/// Owns the cache line of a slot. Uncontended unless relaying concurrently,
+/// and then only held for the time of moving a few pointers.
+class SlotLock
+{
+ public:
+  explicit SlotLock(std::atomic_flag& flag) : mFlag(flag)
+  {
+    while (mFlag.test_and_set(std::memory_order_acquire)) {
+    }
+  }
+  ~SlotLock() { mFlag.clear(std::memory_order_release); }
+  SlotLock(SlotLock const&) = delete;
+  SlotLock& operator=(SlotLock const&) = delete;
+
+ private:
+  std::atomic_flag& mFlag;
+};
+
+/// Move the header / payload pairs of a multipart message to a cache entry.
+void moveToCacheEntry(MessageSet& entry,
+                      std::unique_ptr<FairMQMessage>& firstPart,
+                      std::unique_ptr<FairMQMessage>* restOfParts,
+                      size_t restOfPartsSize)
+{
+  std::vector<PartRef>& parts = entry.parts;
+  // TODO: make sure that multiple parts can only be added within the same call of
+  // DataRelayer::relay
+  PartRef first{std::move(firstPart), std::move(restOfParts[0])};
+  parts.emplace_back(std::move(first));
+  auto rest = restOfParts + 1;
+  for (size_t pi = 0; pi < (restOfPartsSize - 1) / 2; ++pi) {
+    PartRef part{std::move(rest[pi * 2]), std::move(rest[pi * 2 + 1])};
+    parts.emplace_back(std::move(part));
+  }
+}
+} // namespace
+
 DataRelayer::DataRelayer(const CompletionPolicy& policy,
                          std::vector<InputRoute> const& routes,
                          monitoring::Monitoring& metrics,
@@ -55,7 +96,8 @@ DataRelayer::DataRelayer(const CompletionPolicy& policy,
     mMetrics{metrics},
     mCompletionPolicy{policy},
     mDistinctRoutesIndex{DataRelayerHelpers::createDistinctRouteIndex(routes)},
-    mInputMatchers{DataRelayerHelpers::createInputMatchers(routes)}
+    mInputMatchers{DataRelayerHelpers::createInputMatchers(routes)},
+    mInputRouteLookup{DataRelayerHelpers::createInputRouteLookup(routes, mDistinctRoutesIndex)}
 {
   std::scoped_lock<LockableBase(std::recursive_mutex)> lock(mMutex);
 
@@ -112,6 +154,10 @@ DataRelayer::ActivityStats DataRelayer::processDanglingInputs(std::vector<Expira
     assert(mDistinctRoutesIndex.empty() == false);
     auto timestamp = mTimesliceIndex.getTimesliceForSlot(slot);
     auto& variables = mTimesliceIndex.getVariablesForSlot(slot);
+    SlotLock slotLock(mSlotStates[ti].busy);
+    // The slot may have been created by the handlers, make it visible
+    // to the concurrent relaying.
+    mSlotStates[ti].timeslice.store(timestamp.value, std::memory_order_release);
     // We iterate on all the hanlders checking if they need to be expired.
     for (size_t ei = 0; ei < expirationHandlers.size(); ++ei) {
       auto& expirator = expirationHandlers[ei];
@@ -155,12 +201,15 @@ DataRelayer::ActivityStats DataRelayer::processDanglingInputs(std::vector<Expira
 /// This does the mapping between a route and a InputSpec. The
 /// reason why these might diffent is that when you have timepipelining
 /// you have one route per timeslice, even if the type is the same.
+/// Only the @a candidates routes, preselected via the InputRouteLookup,
+/// are tried.
 size_t matchToContext(void* data,
                       std::vector<DataDescriptorMatcher> const& matchers,
                       std::vector<size_t> const& index,
+                      std::vector<int> const& candidates,
                       VariableContext& context)
 {
-  for (size_t ri = 0, re = index.size(); ri < re; ++ri) {
+  for (auto ri : candidates) {
     auto& matcher = matchers[index[ri]];
 
     if (matcher.match(reinterpret_cast<char const*>(data), context)) {
@@ -205,17 +254,33 @@ DataRelayer::RelayChoice
                      std::unique_ptr<FairMQMessage>* restOfParts,
                      size_t restOfPartsSize)
 {
+  // The routes which can match the message do not depend on the slot, so
+  // we select them once via the DataHeader.
+  static thread_local std::vector<int> candidates;
+  mInputRouteLookup.getCandidates(o2::header::get<DataHeader*>(firstPart->GetData()), candidates);
+
+  // A concrete route only requires the timeslice of the slot to match, so if there
+  // is already a slot for it we do not need to touch the TimesliceIndex.
+  if (mConcurrentRelaying && candidates.size() == 1 &&
+      std::binary_search(mInputRouteLookup.wildcards.begin(), mInputRouteLookup.wildcards.end(), candidates[0]) == false) {
+    auto const* dph = o2::header::get<DataProcessingHeader*>(firstPart->GetData());
+    if (dph && relayToPublishedSlot(candidates[0], dph->startTime, firstPart, restOfParts, restOfPartsSize)) {
+      return WillRelay;
+    }
+  }
+
   std::scoped_lock<LockableBase(std::recursive_mutex)> lock(mMutex);
   // STATE HOLDING VARIABLES
-  // This is the class level state of the relaying. If we start supporting
-  // multithreading this will have to be made thread safe before we can invoke
-  // relay concurrently.
+  // This is the class level state of the relaying. Apart from the cache
+  // lines, which are owned via the slot locks, it is only accessed
+  // holding the relayer lock.
   auto& index = mTimesliceIndex;
 
   auto& cache = mCache;
   auto const& readonlyCache = mCache;
   auto& metrics = mMetrics;
   auto numInputTypes = mDistinctRoutesIndex.size();
+  auto& slotStates = mSlotStates;
 
   // IMPLEMENTATION DETAILS
   //
@@ -229,7 +294,7 @@ DataRelayer::RelayChoice
     -> std::tuple<int, TimesliceId> {
     /// FIXME: for the moment we only use the first context and reset
     /// between one invokation and the other.
-    auto input = matchToContext(firstPart->GetData(), matchers, distinctRoutes, context);
+    auto input = matchToContext(firstPart->GetData(), matchers, distinctRoutes, candidates, context);
 
     if (input == INVALID_INPUT) {
       return {
@@ -271,25 +336,18 @@ DataRelayer::RelayChoice
   };
 
   // Actually save the header / payload in the slot
+  // The slot is then published as the one accepting the timeslice.
   auto saveInSlot = [&firstPart,
                      &cachedStateMetrics = mCachedStateMetrics,
                      &restOfParts,
                      &restOfPartsSize,
                      &cache,
                      &numInputTypes,
-                     &metrics](TimesliceId timeslice, int input, TimesliceSlot slot) {
+                     &slotStates](TimesliceId timeslice, int input, TimesliceSlot slot) {
     auto cacheIdx = numInputTypes * slot.index + input;
-    std::vector<PartRef>& parts = cache[cacheIdx].parts;
     cachedStateMetrics[cacheIdx] = CacheEntryStatus::PENDING;
-    // TODO: make sure that multiple parts can only be added within the same call of
-    // DataRelayer::relay
-    PartRef entry{std::move(firstPart), std::move(restOfParts[0])};
-    parts.emplace_back(std::move(entry));
-    auto rest = restOfParts + 1;
-    for (size_t pi = 0; pi < (restOfPartsSize - 1) / 2; ++pi) {
-      PartRef entry{std::move(rest[pi * 2]), std::move(rest[pi * 2 + 1])};
-      parts.emplace_back(std::move(entry));
-    }
+    moveToCacheEntry(cache[cacheIdx], firstPart, restOfParts, restOfPartsSize);
+    slotStates[slot.index].timeslice.store(timeslice.value, std::memory_order_release);
   };
 
   auto updateStatistics = [& stats = mStats](TimesliceIndex::ActionTaken action) {
@@ -355,6 +413,7 @@ DataRelayer::RelayChoice
   /// If we get a valid result, we can store the message in cache.
   if (input != INVALID_INPUT && TimesliceId::isValid(timeslice) && TimesliceSlot::isValid(slot)) {
     O2_SIGNPOST(O2_PROBE_DATARELAYER, timeslice.value, 0, 0, 0);
+    SlotLock slotLock(mSlotStates[slot.index].busy);
     if (needsCleaning) {
       pruneCache(slot);
     }
@@ -419,6 +478,7 @@ DataRelayer::RelayChoice
 
   // At this point the variables match the new input but the
   // cache still holds the old data, so we prune it.
+  SlotLock slotLock(mSlotStates[slot.index].busy);
   pruneCache(slot);
   saveInSlot(timeslice, input, slot);
   index.publishSlot(slot);
@@ -427,6 +487,34 @@ DataRelayer::RelayChoice
   return WillRelay;
 }
 
+bool DataRelayer::relayToPublishedSlot(int input, uint64_t timeslice,
+                                       std::unique_ptr<FairMQMessage>& firstPart,
+                                       std::unique_ptr<FairMQMessage>* restOfParts,
+                                       size_t restOfPartsSize)
+{
+  // The cache and the slot states are only resized by setPipelineLength, which
+  // must not be invoked while relaying.
+  auto numInputTypes = mDistinctRoutesIndex.size();
+  for (size_t si = 0, se = mTimesliceIndex.size(); si < se; ++si) {
+    auto& state = mSlotStates[si];
+    if (state.timeslice.load(std::memory_order_acquire) != timeslice) {
+      continue;
+    }
+    SlotLock slotLock(state.busy);
+    // The slot might have been consumed or reused meanwhile.
+    if (state.timeslice.load(std::memory_order_relaxed) != timeslice) {
+      return false;
+    }
+    auto cacheIdx = numInputTypes * si + input;
+    mCachedStateMetrics[cacheIdx] = CacheEntryStatus::PENDING;
+    moveToCacheEntry(mCache[cacheIdx], firstPart, restOfParts, restOfPartsSize);
+    state.dirty.store(true, std::memory_order_relaxed);
+    mStats.relayedMessages++;
+    return true;
+  }
+  return false;
+}
+
 void DataRelayer::getReadyToProcess(std::vector<DataRelayer::RecordAction>& completed)
 {
   std::scoped_lock<LockableBase(std::recursive_mutex)> lock(mMutex);
@@ -475,9 +563,11 @@ void DataRelayer::getReadyToProcess(std::vector<DataRelayer::RecordAction>& comp
     TimesliceSlot slot{li};
     // We only check the cachelines which have been updated by an incoming
     // message.
-    if (mTimesliceIndex.isDirty(slot) == false) {
+    bool relayedConcurrently = mSlotStates[li].dirty.exchange(false, std::memory_order_relaxed);
+    if (mTimesliceIndex.isDirty(slot) == false && relayedConcurrently == false) {
       continue;
     }
+    SlotLock slotLock(mSlotStates[li].busy);
     auto partial = getPartialRecord(li);
     auto getter = [&partial](size_t idx, size_t part) {
       if (partial[idx].size() > 0 && partial[idx].at(part).header && partial[idx].at(part).payload) {
@@ -521,6 +611,7 @@ void DataRelayer::updateCacheStatus(TimesliceSlot slot, CacheEntryStatus oldStat
     }
   };
 
+  SlotLock slotLock(mSlotStates[slot.index].busy);
   for (size_t ai = 0, ae = numInputTypes; ai != ae; ++ai) {
     markInputDone(slot, ai, oldStatus, newStatus);
   }
@@ -573,6 +664,8 @@ std::vector<o2::framework::MessageSet> DataRelayer::getInputsForTimeslice(Timesl
 
   // Outer loop here.
   jumpToCacheEntryAssociatedWith(slot);
+  SlotLock slotLock(mSlotStates[slot.index].busy);
+  mSlotStates[slot.index].timeslice.store(TimesliceId::INVALID, std::memory_order_relaxed);
   for (size_t ai = 0, ae = numInputTypes; ai != ae; ++ai) {
     moveHeaderPayloadToOutput(slot, ai);
   }
@@ -585,10 +678,14 @@ void DataRelayer::clear()
 {
   std::scoped_lock<LockableBase(std::recursive_mutex)> lock(mMutex);
 
-  for (auto& cache : mCache) {
-    cache.clear();
-  }
+  auto numInputTypes = mDistinctRoutesIndex.size();
   for (size_t s = 0; s < mTimesliceIndex.size(); ++s) {
+    SlotLock slotLock(mSlotStates[s].busy);
+    mSlotStates[s].timeslice.store(TimesliceId::INVALID, std::memory_order_relaxed);
+    mSlotStates[s].dirty.store(false, std::memory_order_relaxed);
+    for (size_t ai = s * numInputTypes, ae = ai + numInputTypes; ai != ae; ++ai) {
+      mCache[ai].clear();
+    }
     mTimesliceIndex.markAsInvalid(TimesliceSlot{s});
   }
 }
@@ -609,6 +706,14 @@ void DataRelayer::setPipelineLength(size_t s)
 
   mTimesliceIndex.resize(s);
   mVariableContextes.resize(s);
+  // Only the slots which are valid in the index accept data.
+  mSlotStates = std::make_unique<SlotState[]>(s);
+  for (size_t si = 0; si < s; ++si) {
+    TimesliceSlot slot{si};
+    if (mTimesliceIndex.isValid(slot)) {
+      mSlotStates[si].timeslice.store(mTimesliceIndex.getTimesliceForSlot(slot).value);
+    }
+  }
   publishMetrics();
 }
 
@@ -671,12 +776,16 @@ void DataRelayer::sendContextState()
     sendVariableContextMetrics(mTimesliceIndex.getPublishedVariablesForSlot(slot), slot,
                                mMetrics, sVariablesMetricsNames);
   }
-  for (size_t si = 0; si < mCachedStateMetrics.size(); ++si) {
-    mMetrics.send({static_cast<int>(mCachedStateMetrics[si]), sMetricsNames[si]});
-    // Anything which is done is actually already empty,
-    // so after we report it we mark it as such.
-    if (mCachedStateMetrics[si] == CacheEntryStatus::DONE) {
-      mCachedStateMetrics[si] = CacheEntryStatus::EMPTY;
+  auto numInputTypes = mDistinctRoutesIndex.size();
+  for (size_t ci = 0; ci < mTimesliceIndex.size(); ++ci) {
+    SlotLock slotLock(mSlotStates[ci].busy);
+    for (size_t si = ci * numInputTypes, se = si + numInputTypes; si < se; ++si) {
+      mMetrics.send({static_cast<int>(mCachedStateMetrics[si]), sMetricsNames[si]});
+      // Anything which is done is actually already empty,
+      // so after we report it we mark it as such.
+      if (mCachedStateMetrics[si] == CacheEntryStatus::DONE) {
+        mCachedStateMetrics[si] = CacheEntryStatus::EMPTY;
+      }
     }
   }
 }
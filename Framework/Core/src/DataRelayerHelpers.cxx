@@ -68,4 +68,20 @@ std::vector<DataDescriptorMatcher>
   return result;
 }
 
+InputRouteLookup
+  DataRelayerHelpers::createInputRouteLookup(std::vector<InputRoute> const& routes, std::vector<size_t> const& distinctRoutes)
+{
+  InputRouteLookup result;
+  for (size_t ri = 0; ri < distinctRoutes.size(); ++ri) {
+    auto& route = routes[distinctRoutes[ri]];
+    if (auto pval = std::get_if<ConcreteDataMatcher>(&route.matcher.matcher)) {
+      // in case of duplicates the first route wins, like in the linear matching
+      result.concrete.emplace(*pval, ri);
+    } else {
+      result.wildcards.push_back(ri);
+    }
+  }
+  return result;
+}
+
 } // namespace o2::framework
@@ -11,6 +11,7 @@
 #define O2_FRAMEWORK_DATARELAYERHELPERS_H_
 
 #include "Framework/InputRoute.h"
+#include "Framework/InputRouteLookup.h"
 #include <vector>
 
 namespace o2::framework
@@ -22,6 +23,8 @@ struct DataRelayerHelpers {
   static std::vector<size_t> createDistinctRouteIndex(std::vector<InputRoute> const&);
   /// This converts from InputRoute to the associated DataDescriptorMatcher.
   static std::vector<data_matcher::DataDescriptorMatcher> createInputMatchers(std::vector<InputRoute> const&);
+  /// Create the lookup of the distinct routes given by @a distinctRoutes (see createDistinctRouteIndex)
+  static InputRouteLookup createInputRouteLookup(std::vector<InputRoute> const&, std::vector<size_t> const& distinctRoutes);
 };
 
 } // namespace o2::framework
@@ -0,0 +1,109 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/ExpressionCache.h"
+#include "Framework/RuntimeError.h"
+#include "Framework/Logger.h"
+#include <gandiva/filter.h>
+#include <gandiva/projector.h>
+#include <arrow/type.h>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace o2::framework::expressions
+{
+
+namespace
+{
+struct CacheState {
+  std::mutex mutex;
+  std::unordered_map<std::string, std::shared_ptr<gandiva::Filter>> filters;
+  std::unordered_map<std::string, std::shared_ptr<gandiva::Projector>> projectors;
+  ExpressionCache::Stats stats;
+};
+
+CacheState& cacheState()
+{
+  static CacheState state;
+  return state;
+}
+
+/// look up @a key in @a cache, or create the entry with @a make while holding the lock,
+/// so that concurrent users of the same expression compile it only once
+template <typename T, typename F>
+std::shared_ptr<T> getOrMake(std::unordered_map<std::string, std::shared_ptr<T>>& cache, std::string const& key, F&& make)
+{
+  auto& state = cacheState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  auto it = cache.find(key);
+  if (it != cache.end()) {
+    ++state.stats.hits;
+    return it->second;
+  }
+  auto start = std::chrono::steady_clock::now();
+  auto result = make();
+  auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+  ++state.stats.misses;
+  state.stats.compileTimeMs += elapsed;
+  LOGP(DEBUG, "Compiled gandiva expression in {} ms: {}", elapsed, key);
+  cache.emplace(key, result);
+  return result;
+}
+} // namespace
+
+std::shared_ptr<gandiva::Filter> ExpressionCache::getFilter(std::shared_ptr<arrow::Schema> const& schema,
+                                                            std::shared_ptr<gandiva::Condition> const& condition)
+{
+  auto key = schema->ToString() + "\n" + condition->ToString();
+  return getOrMake(cacheState().filters, key, [&]() {
+    std::shared_ptr<gandiva::Filter> filter;
+    auto s = gandiva::Filter::Make(schema, condition, &filter);
+    if (!s.ok()) {
+      throw runtime_error_f("Failed to create filter: %s", s.ToString().c_str());
+    }
+    return filter;
+  });
+}
+
+std::shared_ptr<gandiva::Projector> ExpressionCache::getProjector(std::shared_ptr<arrow::Schema> const& schema,
+                                                                  std::vector<std::shared_ptr<gandiva::Expression>> const& expressions)
+{
+  auto key = schema->ToString();
+  for (auto& expression : expressions) {
+    key += "\n" + expression->ToString();
+  }
+  return getOrMake(cacheState().projectors, key, [&]() {
+    std::shared_ptr<gandiva::Projector> projector;
+    auto s = gandiva::Projector::Make(schema, expressions, &projector);
+    if (!s.ok()) {
+      throw runtime_error_f("Failed to create projector: %s", s.ToString().c_str());
+    }
+    return projector;
+  });
+}
+
+ExpressionCache::Stats ExpressionCache::getStats()
+{
+  auto& state = cacheState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  return state.stats;
+}
+
+void ExpressionCache::clear()
+{
+  auto& state = cacheState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  state.filters.clear();
+  state.projectors.clear();
+}
+
+} // namespace o2::framework::expressions
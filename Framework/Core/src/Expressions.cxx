@@ -12,6 +12,7 @@
 #include "Framework/VariantHelpers.h"
 #include "Framework/Logger.h"
 #include "Framework/RuntimeError.h"
+#include "Framework/ExpressionCache.h"
 #include "gandiva/tree_expr_builder.h"
 #include "arrow/table.h"
 #include "fmt/format.h"
@@ -316,40 +317,19 @@ gandiva::ExpressionPtr makeExpression(gandiva::NodePtr node, gandiva::FieldPtr r
 std::shared_ptr<gandiva::Filter>
   createFilter(gandiva::SchemaPtr const& Schema, Operations const& opSpecs)
 {
-  std::shared_ptr<gandiva::Filter> filter;
-  auto s = gandiva::Filter::Make(Schema,
-                                 makeCondition(createExpressionTree(opSpecs, Schema)),
-                                 &filter);
-  if (!s.ok()) {
-    throw runtime_error_f("Failed to create filter: %s", s.ToString().c_str());
-  }
-  return filter;
+  return ExpressionCache::getFilter(Schema, makeCondition(createExpressionTree(opSpecs, Schema)));
 }
 
 std::shared_ptr<gandiva::Filter>
   createFilter(gandiva::SchemaPtr const& Schema, gandiva::ConditionPtr condition)
 {
-  std::shared_ptr<gandiva::Filter> filter;
-  auto s = gandiva::Filter::Make(Schema,
-                                 condition,
-                                 &filter);
-  if (!s.ok()) {
-    throw runtime_error_f("Failed to create filter: %s", s.ToString().c_str());
-  }
-  return filter;
+  return ExpressionCache::getFilter(Schema, condition);
 }
 
 std::shared_ptr<gandiva::Projector>
   createProjector(gandiva::SchemaPtr const& Schema, Operations const& opSpecs, gandiva::FieldPtr result)
 {
-  std::shared_ptr<gandiva::Projector> projector;
-  auto s = gandiva::Projector::Make(Schema,
-                                    {makeExpression(createExpressionTree(opSpecs, Schema), result)},
-                                    &projector);
-  if (!s.ok()) {
-    throw runtime_error_f("Failed to create projector: %s", s.ToString().c_str());
-  }
-  return projector;
+  return ExpressionCache::getProjector(Schema, {makeExpression(createExpressionTree(opSpecs, Schema), result)});
 }
 
 std::shared_ptr<gandiva::Projector>
@@ -546,7 +526,7 @@ bool isTableCompatible(std::set<size_t> const& hashes, Operations const& specs)
                        opHashes.begin(), opHashes.end());
 }
 
-bool isSchemaCompatible(gandiva::SchemaPtr const& Schema, Operations const& opSpecs)
+std::set<std::string> getBoundColumnNames(Operations const& opSpecs)
 {
   std::set<std::string> opFieldNames;
   for (auto& spec : opSpecs) {
@@ -557,6 +537,12 @@ bool isSchemaCompatible(gandiva::SchemaPtr const& Schema, Operations const& opSp
       opFieldNames.insert(std::get<std::string>(spec.right.datum));
     }
   }
+  return opFieldNames;
+}
+
+bool isSchemaCompatible(gandiva::SchemaPtr const& Schema, Operations const& opSpecs)
+{
+  auto opFieldNames = getBoundColumnNames(opSpecs);
 
   std::set<std::string> schemaFieldNames;
   for (auto& field : Schema->fields()) {
@@ -0,0 +1,125 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/GroupingIndex.h"
+#include "Framework/RuntimeError.h"
+#include <arrow/array.h>
+#include <arrow/chunked_array.h>
+#include <arrow/table.h>
+#include <map>
+#include <mutex>
+
+namespace o2::framework
+{
+
+namespace
+{
+struct CacheEntry {
+  std::weak_ptr<arrow::ChunkedArray> column;
+  std::shared_ptr<void const> index;
+};
+
+struct CacheState {
+  std::mutex mutex;
+  std::map<std::pair<arrow::ChunkedArray const*, std::string>, CacheEntry> entries;
+};
+
+CacheState& cacheState()
+{
+  static CacheState state;
+  return state;
+}
+} // namespace
+
+std::shared_ptr<void const> GroupingIndexCache::find(std::shared_ptr<arrow::ChunkedArray> const& column, std::string const& key)
+{
+  auto& state = cacheState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  auto it = state.entries.find({column.get(), key});
+  // a column allocated where a deleted one was is not a match
+  if (it == state.entries.end() || it->second.column.lock() != column) {
+    return nullptr;
+  }
+  return it->second.index;
+}
+
+void GroupingIndexCache::insert(std::shared_ptr<arrow::ChunkedArray> const& column, std::string const& key, std::shared_ptr<void const> index)
+{
+  auto& state = cacheState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  for (auto it = state.entries.begin(); it != state.entries.end();) {
+    it = it->second.column.expired() ? state.entries.erase(it) : std::next(it);
+  }
+  state.entries[{column.get(), key}] = CacheEntry{column, std::move(index)};
+}
+
+size_t GroupingIndexCache::size()
+{
+  auto& state = cacheState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  return state.entries.size();
+}
+
+SliceIndex GroupingIndexCache::makeSliceIndex(arrow::ChunkedArray const& column, int64_t nGroups)
+{
+  if (column.type()->id() != arrow::Type::INT32) {
+    throw runtime_error_f("Cannot group by column of type %s", column.type()->ToString().c_str());
+  }
+  SliceIndex index;
+  index.starts.assign(nGroups, 0);
+  index.sizes.assign(nGroups, 0);
+  uint64_t row = 0;
+  int32_t last = -1;
+  bool previousAssigned = false;
+  for (auto const& chunk : column.chunks()) {
+    auto values = std::static_pointer_cast<arrow::Int32Array>(chunk)->raw_values();
+    for (int64_t i = 0; i < chunk->length(); ++i, ++row) {
+      auto value = values[i];
+      if (value < 0) {
+        previousAssigned = false;
+        continue;
+      }
+      if (value >= nGroups) {
+        throw runtime_error_f("Index %d is out of the %d rows of the grouping table", value, nGroups);
+      }
+      if (value != last || !previousAssigned) {
+        // a new group starts, which must come after the previous ones
+        if (value < last || (value == last && index.sizes[value] != 0)) {
+          throw runtime_error_f("Table is not sorted by its index, row %d of group %d follows group %d", row, value, last);
+        }
+        index.starts[value] = row;
+        last = value;
+      }
+      ++index.sizes[value];
+      previousAssigned = true;
+    }
+  }
+  // empty groups start where the previous group ends
+  uint64_t end = 0;
+  for (int64_t group = 0; group < nGroups; ++group) {
+    if (index.sizes[group] == 0) {
+      index.starts[group] = end;
+    } else {
+      end = index.starts[group] + index.sizes[group];
+    }
+  }
+  return index;
+}
+
+std::shared_ptr<SliceIndex const> GroupingIndexCache::getSliceIndex(std::shared_ptr<arrow::Table> const& table, std::string const& columnName, int64_t nGroups)
+{
+  auto column = table->GetColumnByName(columnName);
+  if (!column) {
+    throw runtime_error_f("Cannot find column %s to group by", columnName.c_str());
+  }
+  return get<SliceIndex>(column, "slices/" + std::to_string(nGroups), [&]() { return makeSliceIndex(*column, nGroups); });
+}
+
+} // namespace o2::framework
@@ -9,7 +9,10 @@
 // or submit itself to any jurisdiction.
 
 #include "Framework/HistogramRegistry.h"
+#include <array>
 #include <regex>
+#include <TArrayD.h>
+#include <TArrayF.h>
 #include <TList.h>
 
 namespace o2::framework
@@ -172,6 +175,55 @@ double HistogramRegistry::getSize(double fillFraction)
   return size;
 }
 
+void HistogramRegistry::cloneHistograms()
+{
+  auto resetArray = [](TArray* array) {
+    if (auto arrayF = dynamic_cast<TArrayF*>(array)) {
+      arrayF->Reset();
+    } else if (auto arrayD = dynamic_cast<TArrayD*>(array)) {
+      arrayD->Reset();
+    }
+  };
+  for (auto& histVariant : mRegistryValue) {
+    std::visit([&](auto& sharedPtr) {
+      using T = typename std::decay_t<decltype(sharedPtr)>::element_type;
+      if (!sharedPtr) {
+        return;
+      }
+      sharedPtr = std::shared_ptr<T>(static_cast<T*>(sharedPtr->Clone()));
+      if constexpr (std::is_base_of_v<StepTHn, T>) {
+        for (int step = 0; step < sharedPtr->getNSteps(); ++step) {
+          resetArray(sharedPtr->getValues(step));
+          resetArray(sharedPtr->getSumw2(step));
+        }
+      } else {
+        sharedPtr->Reset();
+      }
+    },
+               histVariant);
+  }
+}
+
+void HistogramRegistry::merge(HistogramRegistry const& other)
+{
+  for (auto i = 0u; i < MAX_REGISTRY_SIZE; ++i) {
+    if (mRegistryKey[i] != other.mRegistryKey[i]) {
+      throw runtime_error_f(R"(Cannot merge HistogramRegistry "%s" with "%s", they do not hold the same histograms)", mName.data(), other.mName.data());
+    }
+    std::visit([&](auto& sharedPtr) {
+      using ptr_t = std::decay_t<decltype(sharedPtr)>;
+      auto otherPtr = std::get_if<ptr_t>(&other.mRegistryValue[i]);
+      if (!sharedPtr || !otherPtr || !*otherPtr || sharedPtr == *otherPtr) {
+        return;
+      }
+      TList list;
+      list.Add(otherPtr->get());
+      sharedPtr->Merge(&list);
+    },
+               mRegistryValue[i]);
+  }
+}
+
 // print some useful meta-info about the stored histograms
 void HistogramRegistry::print(bool showAxisDetails)
 {
@@ -384,4 +436,141 @@ void HistogramRegistry::registerName(const std::string& name)
   mRegisteredNames.push_back(name);
 }
 
+namespace
+{
+// bins of the values on an axis, computed like TAxis::FindFixBin
+void findBins(TAxis const* axis, size_t nEntries, double const* __restrict__ values, int* __restrict__ bins)
+{
+  const int nBins = axis->GetNbins();
+  if (axis->GetXbins()->fN != 0) {
+    for (size_t i = 0; i < nEntries; ++i) {
+      bins[i] = axis->FindFixBin(values[i]);
+    }
+    return;
+  }
+  const double xMin = axis->GetXmin();
+  const double xMax = axis->GetXmax();
+  // no branches so that the loop can be vectorised, NaN ends up in the overflow like in ROOT
+  for (size_t i = 0; i < nEntries; ++i) {
+    const double x = values[i];
+    const bool inRange = x >= xMin && x < xMax;
+    const int bin = 1 + int(nBins * ((inRange ? x : xMin) - xMin) / (xMax - xMin));
+    bins[i] = inRange ? bin : (x < xMin ? 0 : nBins + 1);
+  }
+}
+} // namespace
+
+void HistFiller::fillHistBulk(TH1* hist, size_t nEntries, double const* const* coordinates, double const* weights)
+{
+  const int nDim = hist->GetDimension();
+  std::array<TAxis const*, 3> axes{hist->GetXaxis(), hist->GetYaxis(), hist->GetZaxis()};
+
+  // profiles, buffered and extendable histograms are filled entry by entry
+  bool canFillBulk = !hist->InheritsFrom(TProfile::Class()) && !hist->InheritsFrom(TProfile2D::Class()) && !hist->InheritsFrom(TProfile3D::Class()) && hist->GetBuffer() == nullptr;
+  for (int dim = 0; dim < nDim; ++dim) {
+    canFillBulk = canFillBulk && !axes[dim]->CanExtend() && !axes[dim]->TestBit(TAxis::kAxisRange);
+  }
+  if (!canFillBulk) {
+    for (size_t i = 0; i < nEntries; ++i) {
+      if (nDim == 1) {
+        weights ? hist->Fill(coordinates[0][i], weights[i]) : hist->Fill(coordinates[0][i]);
+      } else if (nDim == 2) {
+        weights ? static_cast<TH2*>(hist)->Fill(coordinates[0][i], coordinates[1][i], weights[i]) : static_cast<TH2*>(hist)->Fill(coordinates[0][i], coordinates[1][i]);
+      } else {
+        weights ? static_cast<TH3*>(hist)->Fill(coordinates[0][i], coordinates[1][i], coordinates[2][i], weights[i]) : static_cast<TH3*>(hist)->Fill(coordinates[0][i], coordinates[1][i], coordinates[2][i]);
+      }
+    }
+    return;
+  }
+
+  // same as TH1::Fill, the errors are stored separately as soon as a weight is not one
+  if (weights && hist->GetSumw2N() == 0 && !hist->TestBit(TH1::kIsNotW)) {
+    for (size_t i = 0; i < nEntries; ++i) {
+      if (weights[i] != 1.) {
+        hist->Sumw2();
+        break;
+      }
+    }
+  }
+  auto contentD = dynamic_cast<TArrayD*>(hist);
+  auto contentF = dynamic_cast<TArrayF*>(hist);
+  double* sumw2 = hist->GetSumw2N() > 0 ? hist->GetSumw2()->GetArray() : nullptr;
+  const bool considerOverflows = hist->GetStatOverflowsBehaviour();
+  std::array<int, 3> nBins{1, 1, 1};
+  for (int dim = 0; dim < nDim; ++dim) {
+    nBins[dim] = axes[dim]->GetNbins();
+  }
+
+  double stats[TH1::kNstat] = {0.};
+  hist->GetStats(stats);
+
+  std::array<std::array<int, BulkSize>, 3> bins;
+  std::array<int, BulkSize> globalBins;
+  for (size_t begin = 0; begin < nEntries; begin += BulkSize) {
+    const size_t n = std::min(BulkSize, nEntries - begin);
+    for (int dim = 0; dim < nDim; ++dim) {
+      findBins(axes[dim], n, coordinates[dim] + begin, bins[dim].data());
+    }
+    for (int dim = nDim; dim < 3; ++dim) {
+      bins[dim].fill(0);
+    }
+    for (size_t i = 0; i < n; ++i) {
+      globalBins[i] = bins[0][i] + (nBins[0] + 2) * (bins[1][i] + (nBins[1] + 2) * bins[2][i]);
+    }
+
+    // accumulate directly into the bin contents
+    double const* w = weights ? weights + begin : nullptr;
+    if (contentD) {
+      for (size_t i = 0; i < n; ++i) {
+        contentD->fArray[globalBins[i]] += w ? w[i] : 1.;
+      }
+    } else if (contentF) {
+      for (size_t i = 0; i < n; ++i) {
+        contentF->fArray[globalBins[i]] += Float_t(w ? w[i] : 1.);
+      }
+    } else {
+      for (size_t i = 0; i < n; ++i) {
+        hist->AddBinContent(globalBins[i], w ? w[i] : 1.);
+      }
+    }
+    if (sumw2) {
+      for (size_t i = 0; i < n; ++i) {
+        sumw2[globalBins[i]] += w ? w[i] * w[i] : 1.;
+      }
+    }
+
+    // statistics in the same order as TH1::Fill, TH2::Fill and TH3::Fill
+    double const* x = coordinates[0] + begin;
+    double const* y = nDim > 1 ? coordinates[1] + begin : nullptr;
+    double const* z = nDim > 2 ? coordinates[2] + begin : nullptr;
+    for (size_t i = 0; i < n; ++i) {
+      bool inRange = true;
+      for (int dim = 0; dim < nDim; ++dim) {
+        inRange = inRange && bins[dim][i] != 0 && bins[dim][i] <= nBins[dim];
+      }
+      if (!inRange && !considerOverflows) {
+        continue;
+      }
+      const double weight = w ? w[i] : 1.;
+      stats[0] += weight;
+      stats[1] += weight * weight;
+      stats[2] += weight * x[i];
+      stats[3] += weight * x[i] * x[i];
+      if (y) {
+        stats[4] += weight * y[i];
+        stats[5] += weight * y[i] * y[i];
+        stats[6] += weight * x[i] * y[i];
+      }
+      if (z) {
+        stats[7] += weight * z[i];
+        stats[8] += weight * z[i] * z[i];
+        stats[9] += weight * x[i] * z[i];
+        stats[10] += weight * y[i] * z[i];
+      }
+    }
+  }
+  hist->PutStats(stats);
+  hist->SetEntries(hist->GetEntries() + nEntries);
+}
+
 } // namespace o2::framework
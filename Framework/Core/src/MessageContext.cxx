@@ -11,6 +11,8 @@
 #include "Framework/Output.h"
 #include "Framework/MessageContext.h"
 #include "fairmq/FairMQDevice.h"
+#include <algorithm>
+#include <iterator>
 
 namespace o2
 {
@@ -27,22 +29,49 @@ FairMQMessagePtr MessageContext::createMessage(const std::string& channel, int i
   return proxy().getDevice()->NewMessageFor(channel, 0, data, size, ffn, hint);
 }
 
-o2::header::DataHeader* MessageContext::findMessageHeader(const Output& spec)
+o2::header::DataHeader* MessageContext::findMessageHeader(const Output& spec, size_t timeslice)
 {
+  // the worker threads of the device create the messages of several timeslices at once
+  auto matches = [&spec, timeslice](Messages::value_type& message) {
+    const auto* hd = message->header();
+    const auto* dph = message->processingHeader();
+    return hd->dataOrigin == spec.origin && hd->dataDescription == spec.description && hd->subSpecification == spec.subSpec &&
+           dph != nullptr && dph->startTime == timeslice;
+  };
+  std::lock_guard<std::mutex> lock(mMutex);
   for (auto it = mMessages.rbegin(); it != mMessages.rend(); ++it) {
-    const auto* hd = (*it)->header();
-    if (hd->dataOrigin == spec.origin && hd->dataDescription == spec.description && hd->subSpecification == spec.subSpec) {
-      return const_cast<o2::header::DataHeader*>(hd); // o2::header::get returns const pointer, but the caller may need non-const
+    if (matches(*it)) {
+      return const_cast<o2::header::DataHeader*>((*it)->header()); // o2::header::get returns const pointer, but the caller may need non-const
     }
   }
   for (auto it = mScheduledMessages.rbegin(); it != mScheduledMessages.rend(); ++it) {
-    const auto* hd = (*it)->header();
-    if (hd->dataOrigin == spec.origin && hd->dataDescription == spec.description && hd->subSpecification == spec.subSpec) {
-      return const_cast<o2::header::DataHeader*>(hd); // o2::header::get returns const pointer, but the caller may need non-const
+    if (matches(*it)) {
+      return const_cast<o2::header::DataHeader*>((*it)->header()); // o2::header::get returns const pointer, but the caller may need non-const
     }
   }
   return nullptr;
 }
 
+void MessageContext::discardTimeslice(size_t timeslice)
+{
+  auto notFromTimeslice = [timeslice](Messages::value_type& message) {
+    auto const* dph = message->processingHeader();
+    return dph == nullptr || dph->startTime != timeslice;
+  };
+  std::lock_guard<std::mutex> lock(mMutex);
+  auto& discarded = mDiscardedMessages[timeslice];
+  for (auto* messages : {&mMessages, &mScheduledMessages}) {
+    auto first = std::stable_partition(messages->begin(), messages->end(), notFromTimeslice);
+    std::move(first, messages->end(), std::back_inserter(discarded));
+    messages->erase(first, messages->end());
+  }
+}
+
+void MessageContext::releaseDiscarded(size_t timeslice)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mDiscardedMessages.erase(timeslice);
+}
+
 } // namespace framework
 } // namespace o2
@@ -0,0 +1,117 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "ProcessingWorkerPool.h"
+
+namespace o2::framework
+{
+
+ProcessingWorkerPool::ProcessingWorkerPool(size_t size)
+{
+  for (size_t i = 1; i < size; ++i) {
+    mThreads.emplace_back([this]() { loop(); });
+  }
+}
+
+ProcessingWorkerPool::~ProcessingWorkerPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStop = true;
+  }
+  mWakeUp.notify_all();
+  for (auto& thread : mThreads) {
+    thread.join();
+  }
+}
+
+void ProcessingWorkerPool::run(size_t n, std::function<void(size_t)> const& task)
+{
+  if (n == 0) {
+    return;
+  }
+  // Nothing to share, avoid waking up the workers.
+  if (mThreads.empty() || n == 1) {
+    for (size_t i = 0; i < n; ++i) {
+      task(i);
+    }
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mTask = &task;
+    mNTasks = n;
+    mNext = 0;
+    mNDone = 0;
+    mError = nullptr;
+    mGeneration++;
+  }
+  mWakeUp.notify_all();
+  work(task, n);
+
+  std::unique_lock<std::mutex> lock(mMutex);
+  // A worker still inside work() might be about to pick up an index,
+  // so we must wait for all of them to leave before dropping the task.
+  mDone.wait(lock, [this]() { return mNDone == mNTasks && mBusy == 0; });
+  mTask = nullptr;
+  if (mError) {
+    auto error = mError;
+    mError = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+void ProcessingWorkerPool::work(std::function<void(size_t)> const& task, size_t n)
+{
+  for (size_t i = mNext++; i < n; i = mNext++) {
+    try {
+      task(i);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mMutex);
+      if (!mError) {
+        mError = std::current_exception();
+      }
+    }
+    if (++mNDone == n) {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mDone.notify_all();
+    }
+  }
+}
+
+void ProcessingWorkerPool::loop()
+{
+  uint64_t generation = 0;
+  std::unique_lock<std::mutex> lock(mMutex);
+  while (true) {
+    mWakeUp.wait(lock, [this, &generation]() { return mStop || mGeneration != generation; });
+    if (mStop) {
+      return;
+    }
+    generation = mGeneration;
+    // The run of this generation might already be over, in which case
+    // there is nothing left to do. Otherwise run() waits for us to
+    // leave work() before resetting the task, so the snapshot stays valid.
+    if (mTask == nullptr) {
+      continue;
+    }
+    auto const& task = *mTask;
+    auto n = mNTasks;
+    mBusy++;
+    lock.unlock();
+    work(task, n);
+    lock.lock();
+    if (--mBusy == 0) {
+      mDone.notify_all();
+    }
+  }
+}
+
+} // namespace o2::framework
@@ -0,0 +1,71 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_PROCESSINGWORKERPOOL_H_
+#define O2_FRAMEWORK_PROCESSINGWORKERPOOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace o2::framework
+{
+
+/// A fixed set of threads used by a DataProcessingDevice to invoke
+/// the processing callback on several timeslices at the same time.
+/// The thread calling run() takes part in the processing, so a pool
+/// of size N starts N - 1 additional threads.
+class ProcessingWorkerPool
+{
+ public:
+  explicit ProcessingWorkerPool(size_t size);
+  ~ProcessingWorkerPool();
+  ProcessingWorkerPool(ProcessingWorkerPool const&) = delete;
+  ProcessingWorkerPool& operator=(ProcessingWorkerPool const&) = delete;
+
+  /// Number of threads, including the calling one, processing the tasks
+  size_t size() const { return mThreads.size() + 1; }
+
+  /// Invoke @a task for all the indices in [0, @a n) and wait for all of them
+  /// to be done. The first exception thrown by a task is rethrown once all
+  /// the tasks are completed. Not reentrant.
+  void run(size_t n, std::function<void(size_t)> const& task);
+
+ private:
+  void loop();
+  /// Process the indices of the current run, @a task and @a n being its
+  /// snapshot taken with the mutex held.
+  void work(std::function<void(size_t)> const& task, size_t n);
+
+  std::vector<std::thread> mThreads;
+  std::mutex mMutex;
+  std::condition_variable mWakeUp;
+  std::condition_variable mDone;
+  /// Incremented for each run, so that the workers know there is a new one
+  uint64_t mGeneration = 0;
+  /// Number of workers inside work()
+  size_t mBusy = 0;
+  bool mStop = false;
+
+  std::function<void(size_t)> const* mTask = nullptr;
+  size_t mNTasks = 0;
+  std::atomic<size_t> mNext{0};
+  std::atomic<size_t> mNDone{0};
+  std::exception_ptr mError;
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_PROCESSINGWORKERPOOL_H_
@@ -9,7 +9,9 @@
 // or submit itself to any jurisdiction.
 
 #include "Framework/RawBufferContext.h"
+#include "Framework/DataProcessingHeader.h"
 #include <FairMQMessage.h>
+#include <algorithm>
 
 namespace o2::framework
 {
@@ -20,6 +22,7 @@ void RawBufferContext::addRawBuffer(std::unique_ptr<FairMQMessage> header,
                                     std::function<std::ostringstream()> serialize,
                                     std::function<void()> destructor)
 {
+  std::lock_guard<std::mutex> lock(mMutex);
   mMessages.push_back(std::move(MessageRef{std::move(header), std::move(payload), std::move(channel), std::move(serialize), std::move(destructor)}));
 }
 
@@ -40,6 +43,19 @@ void RawBufferContext::clear()
   mMessages.clear();
 }
 
+void RawBufferContext::discardTimeslice(size_t timeslice)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  auto discarded = std::stable_partition(mMessages.begin(), mMessages.end(), [timeslice](MessageRef const& m) {
+    auto const* dph = m.header ? o2::header::get<DataProcessingHeader*>(m.header->GetData()) : nullptr;
+    return dph == nullptr || dph->startTime != timeslice;
+  });
+  for (auto it = discarded; it != mMessages.end(); ++it) {
+    it->destroyPayload();
+  }
+  mMessages.erase(discarded, mMessages.end());
+}
+
 RawBufferContext::RawBufferContext(RawBufferContext&& other)
   : mProxy{other.mProxy}, mMessages{std::move(other.mMessages)}
 {
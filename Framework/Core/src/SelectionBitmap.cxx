@@ -0,0 +1,39 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/SelectionBitmap.h"
+#include "Framework/RuntimeError.h"
+#include "gandiva/selection_vector.h"
+#include "arrow/memory_pool.h"
+
+namespace o2::soa
+{
+
+SelectionBitmap::SelectionBitmap(gandiva::SelectionVector const& selection, int64_t size) : SelectionBitmap(size)
+{
+  for (int64_t i = 0, n = selection.GetNumSlots(); i < n; ++i) {
+    set(selection.GetIndex(i));
+  }
+}
+
+std::shared_ptr<gandiva::SelectionVector> SelectionBitmap::toSelection() const
+{
+  std::shared_ptr<gandiva::SelectionVector> selection;
+  auto s = gandiva::SelectionVector::MakeInt64(mSize, arrow::default_memory_pool(), &selection);
+  if (!s.ok()) {
+    throw o2::framework::runtime_error_f("Cannot allocate selection vector %s", s.ToString().c_str());
+  }
+  int64_t slot = 0;
+  forEachSelected([&](int64_t row) { selection->SetIndex(slot++, row); });
+  selection->SetNumSlots(slot);
+  return selection;
+}
+
+} // namespace o2::soa
@@ -9,7 +9,9 @@
 // or submit itself to any jurisdiction.
 
 #include "Framework/StringContext.h"
+#include "Framework/DataProcessingHeader.h"
 #include <FairMQMessage.h>
+#include <algorithm>
 #include <cassert>
 
 namespace o2::framework
@@ -19,6 +21,7 @@ void StringContext::addString(std::unique_ptr<FairMQMessage> header,
                               std::unique_ptr<std::string> s,
                               const std::string& channel)
 {
+  std::lock_guard<std::mutex> lock(mMutex);
   mMessages.push_back(std::move(MessageRef{std::move(header),
                                            std::move(s),
                                            channel}));
@@ -36,4 +39,14 @@ void StringContext::clear()
   mMessages.clear();
 }
 
+void StringContext::discardTimeslice(size_t timeslice)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mMessages.erase(std::remove_if(mMessages.begin(), mMessages.end(), [timeslice](MessageRef const& m) {
+                    auto const* dph = m.header ? o2::header::get<DataProcessingHeader*>(m.header->GetData()) : nullptr;
+                    return dph != nullptr && dph->startTime == timeslice;
+                  }),
+                  mMessages.end());
+}
+
 } // namespace o2::framework
@@ -28,7 +28,9 @@
 #include "Headers/DataHeader.h"
 #include <algorithm>
 #include <list>
+#include <map>
 #include <set>
+#include <sstream>
 #include <utility>
 #include <vector>
 #include <climits>
@@ -165,7 +167,8 @@ void addMissingOutputsToSpawner(std::vector<InputSpec>&& requestedDYNs,
 {
   for (auto& input : requestedDYNs) {
     publisher.inputs.emplace_back(InputSpec{input.binding, header::DataOrigin{"AOD"}, DataSpecUtils::asConcreteDataMatcher(input).description});
-    requestedAODs.emplace_back(InputSpec{input.binding, header::DataOrigin{"AOD"}, DataSpecUtils::asConcreteDataMatcher(input).description});
+    // the columns of the extended table request are the ones its expressions are computed from
+    requestedAODs.emplace_back(InputSpec{input.binding, header::DataOrigin{"AOD"}, DataSpecUtils::asConcreteDataMatcher(input).description, Lifetime::Timeframe, input.metadata});
     auto concrete = DataSpecUtils::asConcreteDataMatcher(input);
     publisher.outputs.emplace_back(OutputSpec{concrete.origin, concrete.description, concrete.subSpec});
   }
@@ -261,7 +264,7 @@ void WorkflowHelpers::injectServiceDevices(WorkflowSpec& workflow, ConfigContext
                aodLifetime}},
     {},
     AlgorithmSpec::dummyAlgorithm(),
-    {ConfigParamSpec{"aod-file", VariantType::String, {"Input AOD file"}},
+    {ConfigParamSpec{"aod-file", VariantType::String, {"Input AOD file (ROOT file or Arrow AOD directory)"}},
      ConfigParamSpec{"aod-reader-json", VariantType::String, {"json configuration file"}},
      ConfigParamSpec{"time-limit", VariantType::Int64, 0ll, {"Maximum run time limit in seconds"}},
      ConfigParamSpec{"orbit-offset-enumeration", VariantType::Int64, 0ll, {"initial value for the orbit"}},
@@ -399,6 +402,7 @@ void WorkflowHelpers::injectServiceDevices(WorkflowSpec& workflow, ConfigContext
   addMissingOutputsToBuilder(std::move(requestedIDXs), requestedAODs, indexBuilder);
 
   addMissingOutputsToReader(providedAODs, requestedAODs, aodReader);
+  aodReader.options.push_back(ConfigParamSpec{"aod-columns", VariantType::String, computeAODColumnsToRead(requestedAODs), {"Columns to read for each table, all columns of the tables not listed are read"}});
   addMissingOutputsToReader(providedCCDBs, requestedCCDBs, ccdbBackend);
 
   std::vector<DataProcessorSpec> extraSpecs;
@@ -794,6 +798,39 @@ void WorkflowHelpers::sortEdges(std::vector<size_t>& inEdgeIndex,
   std::sort(outEdgeIndex.begin(), outEdgeIndex.end(), outSorter);
 }
 
+std::string WorkflowHelpers::computeAODColumnsToRead(std::vector<InputSpec> const& requestedAODs)
+{
+  std::map<std::string, std::set<std::string>> columnsPerTable;
+  std::set<std::string> readEntirely;
+  for (auto& requested : requestedAODs) {
+    auto concrete = DataSpecUtils::asConcreteDataMatcher(requested);
+    auto table = concrete.origin.as<std::string>() + "/" + concrete.description.as<std::string>();
+    auto columns = std::find_if(requested.metadata.begin(), requested.metadata.end(), [](ConfigParamSpec const& spec) { return spec.name == "columns"; });
+    if (columns == requested.metadata.end()) {
+      readEntirely.insert(table);
+      continue;
+    }
+    auto& tableColumns = columnsPerTable[table];
+    std::stringstream labels(columns->defaultValue.get<std::string>());
+    std::string label;
+    while (std::getline(labels, label, ',')) {
+      tableColumns.insert(label);
+    }
+  }
+
+  std::string result;
+  for (auto& [table, columns] : columnsPerTable) {
+    if (readEntirely.count(table) || columns.empty()) {
+      continue;
+    }
+    result += (result.empty() ? "" : ";") + table + ":";
+    for (auto& column : columns) {
+      result += column + (column == *columns.rbegin() ? "" : ",");
+    }
+  }
+  return result;
+}
+
 WorkflowParsingState WorkflowHelpers::verifyWorkflow(const o2::framework::WorkflowSpec& workflow)
 {
   if (workflow.empty()) {
@@ -209,6 +209,12 @@ struct WorkflowHelpers {
 
   /// returns only dangling outputs
   static std::vector<InputSpec> computeDanglingOutputs(WorkflowSpec const& workflow);
+
+  /// Columns of the AOD tables which the reader needs to read, encoded as
+  /// "ORIGIN/DESCRIPTION:column,column,...;ORIGIN/DESCRIPTION:...". For each table
+  /// this is the union of the "columns" metadata of @a requestedAODs. Tables requested
+  /// at least once without this metadata are read entirely and therefore not listed.
+  static std::string computeAODColumnsToRead(std::vector<InputSpec> const& requestedAODs);
 };
 
 } // namespace o2::framework
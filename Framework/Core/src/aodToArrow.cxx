@@ -0,0 +1,38 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/ArrowAODHelpers.h"
+#include "Framework/Logger.h"
+#include <TFile.h>
+#include <memory>
+
+using namespace o2::framework;
+
+// Convert an AO2D ROOT file to an Arrow AOD directory which can be given to --aod-file
+int main(int argc, char** argv)
+{
+  if (argc != 3) {
+    LOG(ERROR) << "Usage: " << argv[0] << " <input AO2D ROOT file> <output directory>";
+    return 1;
+  }
+  std::unique_ptr<TFile> infile{TFile::Open(argv[1])};
+  if (infile.get() == nullptr || infile->IsOpen() == false) {
+    LOG(ERROR) << "File not found: " << argv[1];
+    return 1;
+  }
+  try {
+    auto nTables = ArrowAODHelpers::convertFromROOT(infile.get(), argv[2]);
+    LOG(INFO) << "Converted " << nTables << " tables from " << argv[1] << " to " << argv[2];
+  } catch (std::exception const& e) {
+    LOG(ERROR) << "Conversion failed: " << e.what();
+    return 1;
+  }
+  return 0;
+}
@@ -14,6 +14,7 @@
 #include "Framework/CompletionPolicyHelpers.h"
 #include "Framework/DataRelayer.h"
 #include "Framework/DataProcessingHeader.h"
+#include "Framework/WorkflowSpec.h"
 #include "../src/DataRelayerHelpers.h"
 #include <Monitoring/Monitoring.h>
 #include <fairmq/FairMQTransportFactory.h>
@@ -302,4 +303,74 @@ static void BM_RelaySplitParts(benchmark::State& state)
 
 BENCHMARK(BM_RelaySplitParts);
 
+/// Relay cost as a function of the number of routes: state.range(0) routes
+/// differing only by subSpecification, plus a wildcard route in front of them
+/// if state.range(1) is set. One message per route is relayed for every timeslice.
+static void BM_RelayManyRoutes(benchmark::State& state)
+{
+  Monitoring metrics;
+  size_t nRoutes = state.range(0);
+  bool withWildcard = state.range(1);
+
+  std::vector<InputRoute> inputs;
+  if (withWildcard) {
+    auto specs = o2::framework::select("tracks:TPC/TRACKS");
+    inputs.emplace_back(InputRoute{specs[0], 0, "FakeWildcard", 0});
+  }
+  for (size_t i = 0; i < nRoutes; ++i) {
+    InputSpec spec{"clusters" + std::to_string(i), "TPC", "CLUSTERS", static_cast<DataHeader::SubSpecificationType>(i)};
+    inputs.emplace_back(InputRoute{spec, inputs.size(), "Fake" + std::to_string(i), 0});
+  }
+
+  TimesliceIndex index;
+
+  auto policy = CompletionPolicyHelpers::consumeWhenAll();
+  DataRelayer relayer(policy, inputs, metrics, index);
+  relayer.setPipelineLength(4);
+
+  DataHeader dh;
+  dh.dataDescription = "CLUSTERS";
+  dh.dataOrigin = "TPC";
+
+  auto transport = FairMQTransportFactory::CreateTransportFactory("zeromq");
+  size_t timeslice = 0;
+  std::vector<FairMQMessagePtr> messages;
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    messages.clear();
+    DataProcessingHeader dph{timeslice++, 1};
+    for (size_t i = 0; i < nRoutes; ++i) {
+      dh.subSpecification = i;
+      Stack stack{dh, dph};
+      FairMQMessagePtr header = transport->CreateMessage(stack.size());
+      memcpy(header->GetData(), stack.data(), stack.size());
+      messages.emplace_back(std::move(header));
+      messages.emplace_back(transport->CreateMessage(100));
+    }
+    state.ResumeTiming();
+
+    // Deliver the routes in reverse order, the worst case for a linear lookup
+    for (size_t i = nRoutes; i--;) {
+      relayer.relay(std::move(messages[2 * i]), std::move(messages[2 * i + 1]));
+    }
+    std::vector<RecordAction> ready;
+    relayer.getReadyToProcess(ready);
+    assert(ready.size() == 1);
+    auto result = relayer.getInputsForTimeslice(ready[0].slot);
+    assert(result.size() == inputs.size());
+  }
+  state.SetItemsProcessed(state.iterations() * nRoutes);
+}
+
+static void ManyRoutesArguments(benchmark::internal::Benchmark* b)
+{
+  for (int nRoutes : {1, 4, 16, 64}) {
+    b->Args({nRoutes, 0});
+    b->Args({nRoutes, 1});
+  }
+}
+
+BENCHMARK(BM_RelayManyRoutes)->Apply(ManyRoutesArguments);
+
 BENCHMARK_MAIN();
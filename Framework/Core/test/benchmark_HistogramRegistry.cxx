@@ -20,6 +20,12 @@ using namespace o2::framework;
 using namespace arrow;
 using namespace o2::soa;
 
+namespace test
+{
+DECLARE_SOA_COLUMN_FULL(X, x, float, "x");
+DECLARE_SOA_COLUMN_FULL(Y, y, float, "y");
+} // namespace test
+
 /// Number of lookups to perform
 const int nLookups = 100000;
 
@@ -61,7 +67,45 @@ static void BM_StandardNameLookup(benchmark::State& state)
     }
   }
 }
+using TestTable = o2::soa::Table<o2::soa::Index<>, test::X, test::Y>;
+
+std::shared_ptr<arrow::Table> makeFillTable(int64_t nRows)
+{
+  TableBuilder builder;
+  auto rowWriter = builder.persist<float, float>({"x", "y"});
+  for (auto i = 0; i < nRows; ++i) {
+    rowWriter(0, (i % 1013) * 0.01f, (i % 97) * 0.1f - 5.f);
+  }
+  return builder.finalize();
+}
+
+/// Fill a 2D histogram with the columns of a table row by row
+static void BM_FillPerRow(benchmark::State& state)
+{
+  TestTable table{makeFillTable(state.range(0))};
+  HistogramRegistry registry{"registry", {{"xy", "xy", {HistType::kTH2F, {{100, 0, 10}, {100, -5, 5}}}}}};
+  for (auto _ : state) {
+    for (auto& row : table) {
+      registry.fill(HIST("xy"), row.x(), row.y());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Fill a 2D histogram with the columns of a table in batches
+static void BM_FillBulk(benchmark::State& state)
+{
+  TestTable table{makeFillTable(state.range(0))};
+  HistogramRegistry registry{"registry", {{"xy", "xy", {HistType::kTH2F, {{100, 0, 10}, {100, -5, 5}}}}}};
+  for (auto _ : state) {
+    registry.fill<test::X, test::Y>(HIST("xy"), table);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
 BENCHMARK(BM_HashedNameLookup)->Arg(4)->Arg(8)->Arg(16)->Arg(64)->Arg(128)->Arg(256)->Arg(512);
 BENCHMARK(BM_StandardNameLookup)->Arg(4)->Arg(8)->Arg(16)->Arg(64)->Arg(128)->Arg(256)->Arg(512);
+BENCHMARK(BM_FillPerRow)->Arg(1000)->Arg(100000)->Arg(1000000);
+BENCHMARK(BM_FillBulk)->Arg(1000)->Arg(100000)->Arg(1000000);
 
 BENCHMARK_MAIN();
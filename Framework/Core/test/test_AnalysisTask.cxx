@@ -15,8 +15,12 @@
 #include "TestClasses.h"
 #include "Framework/AnalysisTask.h"
 #include "Framework/AnalysisDataModel.h"
+#include "../src/WorkflowHelpers.h"
 
 #include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <future>
+#include <stdexcept>
 
 using namespace o2;
 using namespace o2::framework;
@@ -44,6 +48,9 @@ DECLARE_SOA_TABLE(XYZ, "AOD", "XYZ",
                   test::X, test::Y, test::Z);
 DECLARE_SOA_TABLE(Events, "AOD", "EVENTS",
                   test::EventProperty);
+// a subset of the columns of XYZ
+DECLARE_SOA_TABLE(XY, "AOD", "XYZ",
+                  test::X, test::Y);
 } // namespace o2::aod
 
 // FIXME: for the moment we do not derive from AnalysisTask as
@@ -136,6 +143,22 @@ struct ITask {
   }
 };
 
+struct KTask {
+  void process(o2::aod::XY const& xys)
+  {
+    for (auto xy : xys) {
+      xy.x();
+      xy.y();
+    }
+  }
+};
+
+struct LTask {
+  void process(o2::aod::XYZ const&)
+  {
+  }
+};
+
 struct JTask {
   Configurable<o2::test::SimplePODClass> cfg{"someConfigurable", {}, "Some Configurable Object"};
   void process(o2::aod::Collision const&)
@@ -262,3 +285,56 @@ BOOST_AUTO_TEST_CASE(TestPartitionIteration)
   }
   BOOST_CHECK_EQUAL(i, 1);
 }
+
+struct CountingTask {
+  int processed = 0;
+};
+
+// a time frame whose processing throws must give its instance back, otherwise the next one waits forever
+BOOST_AUTO_TEST_CASE(TestInstanceReleasedOnThrow)
+{
+  AnalysisTaskInstances<CountingTask> instances;
+  instances.idle.push_back(std::make_shared<CountingTask>());
+
+  BOOST_CHECK_THROW(instances.process([](CountingTask&) { throw std::runtime_error("failed time frame"); }), std::runtime_error);
+
+  auto next = std::async(std::launch::async, [&instances]() { instances.process([](CountingTask& task) { task.processed++; }); });
+  BOOST_REQUIRE(next.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+  next.get();
+  BOOST_CHECK_EQUAL(instances.idle.size(), 1);
+  BOOST_CHECK_EQUAL(instances.idle.back()->processed, 1);
+}
+
+BOOST_AUTO_TEST_CASE(TestColumnsToRead)
+{
+  auto cfgc = makeEmptyConfigContext();
+  auto columnsToRead = [](std::vector<DataProcessorSpec> const& workflow) {
+    std::vector<InputSpec> requested;
+    for (auto& processor : workflow) {
+      requested.insert(requested.end(), processor.inputs.begin(), processor.inputs.end());
+    }
+    return WorkflowHelpers::computeAODColumnsToRead(requested);
+  };
+
+  // subscribing to a subset of a table reads only that subset
+  auto xy = adaptAnalysisTask<KTask>(*cfgc, TaskName{"xy"});
+  auto xyz = adaptAnalysisTask<LTask>(*cfgc, TaskName{"xyz"});
+  BOOST_CHECK_EQUAL(columnsToRead({xy}), "AOD/XYZ:fX,fY");
+  BOOST_CHECK_EQUAL(columnsToRead({xyz}), "AOD/XYZ:fX,fY,fZ");
+  BOOST_CHECK_EQUAL(columnsToRead({xy, xyz}), "AOD/XYZ:fX,fY,fZ");
+
+  // the columns a dynamic column is bound to are persistent columns of the table
+  auto foobars = adaptAnalysisTask<ETask>(*cfgc, TaskName{"foobars"});
+  BOOST_CHECK_EQUAL(columnsToRead({foobars}), "AOD/FOOBAR:fBar,fFoo");
+
+  // the extended table is spawned from the columns its expressions use
+  auto tracks = adaptAnalysisTask<DTask>(*cfgc, TaskName{"tracks"});
+  auto extension = std::find_if(tracks.inputs.begin(), tracks.inputs.end(), [](InputSpec const& input) { return input.binding == "TracksExtension"; });
+  BOOST_REQUIRE(extension != tracks.inputs.end());
+  auto columns = std::find_if(extension->metadata.begin(), extension->metadata.end(), [](ConfigParamSpec const& spec) { return spec.name == "columns"; });
+  BOOST_REQUIRE(columns != extension->metadata.end());
+  auto labels = columns->defaultValue.get<std::string>();
+  BOOST_CHECK(labels.find("fSigned1Pt") != std::string::npos);
+  BOOST_CHECK(labels.find("fTgl") != std::string::npos);
+  BOOST_CHECK(labels.find("fX") == std::string::npos);
+}
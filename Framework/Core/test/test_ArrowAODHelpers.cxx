@@ -0,0 +1,99 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#define BOOST_TEST_MODULE Test Framework ArrowAODHelpers
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include "Headers/DataHeader.h"
+#include "Framework/ArrowAODHelpers.h"
+#include "Framework/DataInputDirector.h"
+#include "Framework/TableBuilder.h"
+#include "Framework/TableTreeHelpers.h"
+
+#include <TFile.h>
+#include <arrow/table.h>
+#include <filesystem>
+
+using namespace o2::framework;
+namespace fs = std::filesystem;
+
+namespace
+{
+std::shared_ptr<arrow::Table> makeTable(int offset, int nRows)
+{
+  TableBuilder builder;
+  auto rowWriter = builder.persist<int32_t, float>({"fIndex", "fX"});
+  for (int i = 0; i < nRows; ++i) {
+    rowWriter(0, offset + i, 0.5f * (offset + i));
+  }
+  return builder.finalize();
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(TestArrowAODInput)
+{
+  std::string dir = "testArrowAOD";
+  fs::remove_all(dir);
+  for (auto tf : {12, 3}) {
+    fs::create_directories(dir + "/DF_" + std::to_string(tf));
+    ArrowAODHelpers::writeTable(ArrowAODHelpers::getTableFileName(dir, "DF_" + std::to_string(tf), "O2uno"), *makeTable(tf, 100 + tf));
+  }
+  BOOST_CHECK(ArrowAODHelpers::isArrowAOD(dir));
+  BOOST_CHECK(!ArrowAODHelpers::isArrowAOD("AO2D.root"));
+  BOOST_CHECK((ArrowAODHelpers::getTimeFrameNumbers(dir) == std::vector<uint64_t>{3, 12}));
+
+  DataInputDirector didir(std::vector<std::string>{dir});
+  auto dh = o2::header::DataHeader(o2::header::DataDescription{"UNO"}, o2::header::DataOrigin{"AOD"}, 0);
+  BOOST_CHECK(didir.isArrowFile(dh, 0));
+  BOOST_CHECK(!didir.isArrowFile(dh, 1));
+  BOOST_CHECK_EQUAL(didir.getTimeFramesInFile(dh, 0), 2);
+  BOOST_CHECK(didir.getDataTree(dh, 0, 0) == nullptr);
+
+  // time frames are read in order
+  BOOST_CHECK_EQUAL(didir.getTimeFrameNumber(dh, 0, 0), 3);
+  auto table = didir.getArrowTable(dh, 0, 0);
+  BOOST_REQUIRE(table);
+  BOOST_CHECK(table->Equals(*makeTable(3, 103)));
+  table = didir.getArrowTable(dh, 0, 1);
+  BOOST_REQUIRE(table);
+  BOOST_CHECK_EQUAL(table->num_rows(), 112);
+  BOOST_CHECK(didir.getArrowTable(dh, 0, 2) == nullptr);
+
+  // a missing table is an error
+  auto dhMissing = o2::header::DataHeader(o2::header::DataDescription{"DUE"}, o2::header::DataOrigin{"AOD"}, 0);
+  BOOST_CHECK_THROW(didir.getArrowTable(dhMissing, 0, 0), std::runtime_error);
+  fs::remove_all(dir);
+}
+
+BOOST_AUTO_TEST_CASE(TestConvertFromROOT)
+{
+  std::string fileName = "testArrowAODConversion.root";
+  std::string dir = "testArrowAODConversion";
+  fs::remove_all(dir);
+  auto original = makeTable(0, 1000);
+  {
+    TFile file(fileName.c_str(), "RECREATE");
+    file.mkdir("DF_1");
+    TableToTree t2t(original, &file, "DF_1/O2uno");
+    t2t.addAllBranches();
+    t2t.process();
+    file.Close();
+  }
+
+  TFile file(fileName.c_str());
+  BOOST_CHECK_EQUAL(ArrowAODHelpers::convertFromROOT(&file, dir), 1);
+  auto table = ArrowAODHelpers::readTable(ArrowAODHelpers::getTableFileName(dir, "DF_1", "O2uno"));
+  BOOST_CHECK_EQUAL(table->num_rows(), 1000);
+  BOOST_CHECK(table->schema()->Equals(*original->schema()));
+  fs::remove_all(dir);
+  std::remove(fileName.c_str());
+}
@@ -302,6 +302,8 @@ DataProcessorSpec getSinkSpec()
     ASSERT_ERROR((object12[1] == o2::test::TriviallyCopyable{10, 20, 0xacdc}));
     // forward the read-only span on a different route
     pc.outputs().snapshot(Output{"TST", "MSGABLVECTORCPY", 0, Lifetime::Timeframe}, object12);
+    // and forward the input message itself, sharing its payload if the transport allows
+    pc.outputs().forwardPayload(Output{"TST", "MSGABLVECTORFWD", 0, Lifetime::Timeframe}, pc.inputs().get("input12"));
 
     LOG(INFO) << "extracting TNamed object from input13";
     auto object13 = pc.inputs().get<TNamed*>("input13");
@@ -354,7 +356,8 @@ DataProcessorSpec getSinkSpec()
                             InputSpec{"inputPMR", "TST", "PMRTESTVECTOR", 0, Lifetime::Timeframe},
                             InputSpec{"inputPODvector", "TST", "PODVECTOR", 0, Lifetime::Timeframe},
                             InputSpec{"inputMP", ConcreteDataTypeMatcher{"TST", "MULTIPARTS"}, Lifetime::Timeframe}},
-                           Outputs{OutputSpec{"TST", "MSGABLVECTORCPY", 0, Lifetime::Timeframe}},
+                           Outputs{OutputSpec{"TST", "MSGABLVECTORCPY", 0, Lifetime::Timeframe},
+                                   OutputSpec{"TST", "MSGABLVECTORFWD", 0, Lifetime::Timeframe}},
                            AlgorithmSpec(processingFct)};
 }
 
@@ -391,12 +394,19 @@ DataProcessorSpec getSpectatorSinkSpec()
     ASSERT_ERROR((object12[0] == o2::test::TriviallyCopyable{42, 23, 0xdead}));
     ASSERT_ERROR((object12[1] == o2::test::TriviallyCopyable{10, 20, 0xacdc}));
 
+    LOG(INFO) << "extracting the payload forwarded with forwardPayload from input16";
+    auto object16 = pc.inputs().get<gsl::span<o2::test::TriviallyCopyable>>("input16");
+    ASSERT_ERROR(object16.size() == 2);
+    ASSERT_ERROR((object16[0] == o2::test::TriviallyCopyable{42, 23, 0xdead}));
+    ASSERT_ERROR((object16[1] == o2::test::TriviallyCopyable{10, 20, 0xacdc}));
+
     pc.services().get<ControlService>().readyToQuit(QuitRequest::Me);
   };
 
   return DataProcessorSpec{"spectator-sink", // name of the processor
                            {InputSpec{"inputMP", ConcreteDataTypeMatcher{"TST", "MULTIPARTS"}, Lifetime::Timeframe},
-                            InputSpec{"input12", ConcreteDataTypeMatcher{"TST", "MSGABLVECTORCPY"}, Lifetime::Timeframe}},
+                            InputSpec{"input12", ConcreteDataTypeMatcher{"TST", "MSGABLVECTORCPY"}, Lifetime::Timeframe},
+                            InputSpec{"input16", ConcreteDataTypeMatcher{"TST", "MSGABLVECTORFWD"}, Lifetime::Timeframe}},
                            Outputs{},
                            AlgorithmSpec(processingFct)};
 }
@@ -23,6 +23,7 @@
 #include <Monitoring/Monitoring.h>
 #include <fairmq/FairMQTransportFactory.h>
 #include <cstring>
+#include <thread>
 
 using Monitoring = o2::monitoring::Monitoring;
 using namespace o2::framework;
@@ -519,3 +520,152 @@ BOOST_AUTO_TEST_CASE(SplitParts)
   assert(ready.size() == 1);
   assert(ready[0].op == CompletionPolicy::CompletionOp::Consume);
 }
+
+// Concrete routes are looked up by hash, but the first matching route must
+// still win when a wildcard route precedes them.
+BOOST_AUTO_TEST_CASE(RouteLookup)
+{
+  Monitoring metrics;
+  InputSpec spec0{"tracks", "TPC", "TRACKS", 1};
+  InputSpec spec1{"clusters", ConcreteDataTypeMatcher{"TPC", "CLUSTERS"}};
+  InputSpec spec2{"clusters0", "TPC", "CLUSTERS", 0};
+
+  std::vector<InputRoute> inputs = {
+    InputRoute{spec0, 0, "Fake0", 0},
+    InputRoute{spec1, 1, "Fake1", 0},
+    InputRoute{spec2, 2, "Fake2", 0},
+  };
+
+  auto lookup = DataRelayerHelpers::createInputRouteLookup(inputs, DataRelayerHelpers::createDistinctRouteIndex(inputs));
+  BOOST_CHECK_EQUAL(lookup.concrete.size(), 2);
+  BOOST_REQUIRE_EQUAL(lookup.wildcards.size(), 1);
+  BOOST_CHECK_EQUAL(lookup.wildcards[0], 1);
+
+  TimesliceIndex index;
+
+  auto policy = CompletionPolicyHelpers::consumeWhenAny();
+  DataRelayer relayer(policy, inputs, metrics, index);
+  relayer.setPipelineLength(4);
+
+  auto transport = FairMQTransportFactory::CreateTransportFactory("zeromq");
+  auto createMessage = [&transport](DataHeader const& dh, size_t timeslice) {
+    DataProcessingHeader dph{timeslice, 1};
+    Stack stack{dh, dph};
+    FairMQMessagePtr header = transport->CreateMessage(stack.size());
+    memcpy(header->GetData(), stack.data(), stack.size());
+    return header;
+  };
+
+  DataHeader dh;
+  dh.dataDescription = "CLUSTERS";
+  dh.dataOrigin = "TPC";
+  dh.subSpecification = 0;
+  // matches both the wildcard and the concrete route, the wildcard comes first
+  auto result = relayer.relay(createMessage(dh, 0), transport->CreateMessage(100));
+  BOOST_CHECK_EQUAL(result, DataRelayer::WillRelay);
+
+  dh.dataDescription = "TRACKS";
+  dh.subSpecification = 1;
+  result = relayer.relay(createMessage(dh, 0), transport->CreateMessage(100));
+  BOOST_CHECK_EQUAL(result, DataRelayer::WillRelay);
+
+  std::vector<RecordAction> ready;
+  relayer.getReadyToProcess(ready);
+  BOOST_REQUIRE_EQUAL(ready.size(), 1);
+  auto inputsForSlot = relayer.getInputsForTimeslice(ready[0].slot);
+  BOOST_REQUIRE_EQUAL(inputsForSlot.size(), 3);
+  BOOST_CHECK_EQUAL(inputsForSlot.at(0).size(), 1);
+  BOOST_CHECK_EQUAL(inputsForSlot.at(1).size(), 1);
+  BOOST_CHECK_EQUAL(inputsForSlot.at(2).size(), 0);
+
+  // no route for this one
+  dh.subSpecification = 2;
+  result = relayer.relay(createMessage(dh, 1), transport->CreateMessage(100));
+  BOOST_CHECK_EQUAL(result, DataRelayer::Invalid);
+}
+
+// Several threads relay the inputs of the slots already created, while
+// the slots are consumed in between.
+BOOST_AUTO_TEST_CASE(ConcurrentRelay)
+{
+  Monitoring metrics;
+  constexpr size_t nInputs = 4;
+  constexpr size_t nSlots = 4;
+  constexpr size_t nBatches = 50;
+
+  std::vector<InputRoute> inputs;
+  for (size_t i = 0; i < nInputs; ++i) {
+    InputSpec spec{"clusters" + std::to_string(i), "TPC", "CLUSTERS", static_cast<DataHeader::SubSpecificationType>(i)};
+    inputs.emplace_back(InputRoute{spec, i, "Fake" + std::to_string(i), 0});
+  }
+
+  TimesliceIndex index;
+
+  auto policy = CompletionPolicyHelpers::consumeWhenAll();
+  DataRelayer relayer(policy, inputs, metrics, index);
+  relayer.setPipelineLength(nSlots);
+  relayer.setConcurrentRelaying(true);
+
+  auto transport = FairMQTransportFactory::CreateTransportFactory("zeromq");
+  auto relayInput = [&relayer, &transport](size_t input, size_t timeslice) {
+    DataHeader dh;
+    dh.dataDescription = "CLUSTERS";
+    dh.dataOrigin = "TPC";
+    dh.subSpecification = input;
+    DataProcessingHeader dph{timeslice, 1};
+    Stack stack{dh, dph};
+    FairMQMessagePtr header = transport->CreateMessage(stack.size());
+    memcpy(header->GetData(), stack.data(), stack.size());
+    return relayer.relay(std::move(header), transport->CreateMessage(100));
+  };
+
+  size_t nConsumed = 0;
+  for (size_t batch = 0; batch < nBatches; ++batch) {
+    // The first input creates the slots
+    for (size_t ts = batch * nSlots; ts < (batch + 1) * nSlots; ++ts) {
+      BOOST_REQUIRE_EQUAL(relayInput(0, ts), DataRelayer::WillRelay);
+    }
+    std::vector<std::thread> threads;
+    std::atomic<size_t> nRelayed = 0;
+    std::atomic<size_t> nRelaysDone = 0;
+    for (size_t input = 1; input < nInputs; ++input) {
+      threads.emplace_back([&relayInput, &nRelayed, &nRelaysDone, input, batch]() {
+        for (size_t ts = batch * nSlots; ts < (batch + 1) * nSlots; ++ts) {
+          nRelayed += relayInput(input, ts) == DataRelayer::WillRelay;
+        }
+        nRelaysDone++;
+      });
+    }
+    // The completed slots are consumed while the other ones are still being
+    // relayed to.
+    size_t nConsumedInBatch = 0;
+    while (nConsumedInBatch < nSlots) {
+      bool relaying = nRelaysDone.load() < nInputs - 1;
+      std::vector<RecordAction> ready;
+      relayer.getReadyToProcess(ready);
+      if (ready.empty() && relaying == false) {
+        break;
+      }
+      for (auto& action : ready) {
+        BOOST_CHECK(action.op == CompletionPolicy::CompletionOp::Consume);
+        auto result = relayer.getInputsForTimeslice(action.slot);
+        BOOST_CHECK_EQUAL(result.size(), nInputs);
+        for (auto& messageSet : result) {
+          BOOST_CHECK_EQUAL(messageSet.size(), 1);
+        }
+        nConsumedInBatch++;
+      }
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    BOOST_CHECK_EQUAL(nRelayed.load(), (nInputs - 1) * nSlots);
+    BOOST_REQUIRE_EQUAL(nConsumedInBatch, nSlots);
+    std::vector<RecordAction> ready;
+    relayer.getReadyToProcess(ready);
+    BOOST_CHECK_EQUAL(ready.size(), 0);
+    nConsumed += nConsumedInBatch;
+  }
+  BOOST_CHECK_EQUAL(nConsumed, nSlots * nBatches);
+  BOOST_CHECK_EQUAL(relayer.getStats().relayedMessages.load(), nInputs * nSlots * nBatches);
+}
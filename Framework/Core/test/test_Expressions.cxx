@@ -202,3 +202,23 @@ BOOST_AUTO_TEST_CASE(TestGandivaTreeCreation)
   BOOST_REQUIRE(s.ok());
 #endif
 }
+
+BOOST_AUTO_TEST_CASE(TestExpressionCache)
+{
+  Filter f = o2::aod::track::tgl > 1.f;
+  auto schema = o2::soa::createSchemaFromColumns(o2::aod::Tracks::persistent_columns_t{});
+  auto before = ExpressionCache::getStats();
+  auto filter1 = createFilter(schema, createOperations(f));
+  auto filter2 = createFilter(schema, createOperations(f));
+  auto after = ExpressionCache::getStats();
+  // compiled once, then served from the cache
+  BOOST_CHECK_EQUAL(filter1.get(), filter2.get());
+  BOOST_CHECK_EQUAL(after.misses - before.misses, 1);
+  BOOST_CHECK_EQUAL(after.hits - before.hits, 1);
+
+  // a different cut is a different filter
+  Filter g = o2::aod::track::tgl > 2.f;
+  auto filter3 = createFilter(schema, createOperations(g));
+  BOOST_CHECK(filter3.get() != filter1.get());
+  BOOST_CHECK_EQUAL(ExpressionCache::getStats().misses - before.misses, 2);
+}
@@ -377,3 +377,36 @@ BOOST_AUTO_TEST_CASE(ArrowDirectSlicing)
     BOOST_CHECK(cb->Equals(slices_bool[i]));
   }
 }
+
+BOOST_AUTO_TEST_CASE(GroupingIndexSlices)
+{
+  TableBuilder builderT;
+  auto trksWriter = builderT.cursor<aod::TrksX>();
+  // unassigned tracks first, groups 1 and 3 empty, unassigned tracks between groups
+  std::vector<int> ids{-1, -1, 0, 0, 2, -1, 4, 4, 4};
+  for (auto id : ids) {
+    trksWriter(0, id, 0.f);
+  }
+  auto trkTable = builderT.finalize();
+
+  auto index = GroupingIndexCache::getSliceIndex(trkTable, "fIndexEvents", 6);
+  BOOST_REQUIRE_EQUAL(index->groups(), 6);
+  std::vector<uint64_t> starts{2, 4, 4, 5, 6, 9};
+  std::vector<uint64_t> sizes{2, 0, 1, 0, 3, 0};
+  for (auto i = 0; i < 6; ++i) {
+    BOOST_CHECK_EQUAL(index->start(i), starts[i]);
+    BOOST_CHECK_EQUAL(index->size(i), sizes[i]);
+  }
+  // shared with the other users of the same column
+  BOOST_CHECK_EQUAL(GroupingIndexCache::getSliceIndex(trkTable, "fIndexEvents", 6).get(), index.get());
+
+  // out of range and unsorted indices
+  BOOST_CHECK_THROW(GroupingIndexCache::makeSliceIndex(*trkTable->GetColumnByName("fIndexEvents"), 4), o2::framework::RuntimeErrorRef);
+  TableBuilder builderU;
+  auto unsortedWriter = builderU.cursor<aod::TrksX>();
+  for (auto id : {0, 2, 1}) {
+    unsortedWriter(0, id, 0.f);
+  }
+  auto unsortedTable = builderU.finalize();
+  BOOST_CHECK_THROW(GroupingIndexCache::makeSliceIndex(*unsortedTable->GetColumnByName("fIndexEvents"), 3), o2::framework::RuntimeErrorRef);
+}
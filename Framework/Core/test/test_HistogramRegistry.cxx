@@ -22,6 +22,7 @@ namespace test
 {
 DECLARE_SOA_COLUMN_FULL(X, x, float, "x");
 DECLARE_SOA_COLUMN_FULL(Y, y, float, "y");
+DECLARE_SOA_COLUMN_FULL(W, w, float, "w");
 } // namespace test
 
 HistogramRegistry foo()
@@ -108,6 +109,65 @@ BOOST_AUTO_TEST_CASE(HistogramRegistryExpressionFill)
   BOOST_CHECK_EQUAL(registry.get<TH2>(HIST("xy"))->GetEntries(), 2);
 }
 
+BOOST_AUTO_TEST_CASE(HistogramRegistryBulkFill)
+{
+  // more rows than fit in one batch, some of them outside of the axis ranges
+  TableBuilder builder;
+  auto rowWriter = builder.persist<float, float, float>({"x", "y", "w"});
+  for (int i = 0; i < 2500; ++i) {
+    rowWriter(0, (i % 101) * 0.11f - 1.0f, (i % 37) * 0.6f - 10.0f, 0.5f + (i % 3));
+  }
+  auto table = builder.finalize();
+  using TestA = o2::soa::Table<o2::soa::Index<>, test::X, test::Y, test::W>;
+  TestA tests{table};
+
+  HistogramRegistry registry{
+    "registry", {
+                  {"x", "test x", {HistType::kTH1F, {{100, 0.0, 10.0}}}},                                    //
+                  {"xw", "test x weighted", {HistType::kTH1D, {{100, 0.0, 10.0}}}},                          //
+                  {"xVar", "test x variable bins", {HistType::kTH1D, {{std::vector<double>{0., 1., 5., 8.}}}}}, //
+                  {"xy", "test xy", {HistType::kTH2F, {{50, 0.0, 10.0}, {40, -8.0, 8.0}}}}                   //
+                }                                                                                            //
+  };
+  registry.fill<test::X>(HIST("x"), tests);
+  registry.fill<test::X, test::W>(HIST("xw"), tests);
+  registry.fill<test::X>(HIST("xVar"), tests);
+  registry.fill<test::X, test::Y, test::W>(HIST("xy"), tests);
+
+  // the same histograms filled row by row
+  auto x = std::unique_ptr<TH1>(static_cast<TH1*>(registry.get<TH1>(HIST("x"))->Clone()));
+  auto xw = std::unique_ptr<TH1>(static_cast<TH1*>(registry.get<TH1>(HIST("xw"))->Clone()));
+  auto xVar = std::unique_ptr<TH1>(static_cast<TH1*>(registry.get<TH1>(HIST("xVar"))->Clone()));
+  auto xy = std::unique_ptr<TH2>(static_cast<TH2*>(registry.get<TH2>(HIST("xy"))->Clone()));
+  for (auto* hist : {x.get(), xw.get(), xVar.get(), static_cast<TH1*>(xy.get())}) {
+    hist->Reset();
+  }
+  for (auto& row : tests) {
+    x->Fill(row.x());
+    xw->Fill(row.x(), row.w());
+    xVar->Fill(row.x());
+    xy->Fill(row.x(), row.y(), row.w());
+  }
+
+  auto check = [](TH1* bulk, TH1* reference) {
+    BOOST_REQUIRE_EQUAL(bulk->GetNcells(), reference->GetNcells());
+    for (int bin = 0; bin < bulk->GetNcells(); ++bin) {
+      BOOST_CHECK_CLOSE(bulk->GetBinContent(bin), reference->GetBinContent(bin), 1e-4);
+      BOOST_CHECK_CLOSE(bulk->GetBinError(bin), reference->GetBinError(bin), 1e-4);
+    }
+    BOOST_CHECK_EQUAL(bulk->GetEntries(), reference->GetEntries());
+    for (int axis = 1; axis <= bulk->GetDimension(); ++axis) {
+      BOOST_CHECK_CLOSE(bulk->GetMean(axis), reference->GetMean(axis), 1e-6);
+      BOOST_CHECK_CLOSE(bulk->GetStdDev(axis), reference->GetStdDev(axis), 1e-6);
+    }
+  };
+  check(registry.get<TH1>(HIST("x")).get(), x.get());
+  check(registry.get<TH1>(HIST("xw")).get(), xw.get());
+  check(registry.get<TH1>(HIST("xVar")).get(), xVar.get());
+  check(registry.get<TH2>(HIST("xy")).get(), xy.get());
+  BOOST_CHECK_EQUAL(registry.get<TH1>(HIST("x"))->GetEntries(), 2500);
+}
+
 BOOST_AUTO_TEST_CASE(HistogramRegistryStepTHn)
 {
   HistogramRegistry registry{"registry"};
@@ -128,3 +188,31 @@ BOOST_AUTO_TEST_CASE(HistogramRegistryStepTHn)
 
   registry.print();
 }
+
+BOOST_AUTO_TEST_CASE(HistogramRegistryCloneAndMerge)
+{
+  HistogramRegistry registry{"registry"};
+  registry.add("pt", "p_{T}", {HistType::kTH1F, {{10, 0, 10}}});
+  registry.add("stepTHnF", "a", {kStepTHnF, {{10, 0.0f, 10.0f}}, 2});
+  registry.fill(HIST("pt"), 1.5);
+
+  // a copy fills its own histograms
+  HistogramRegistry copy = registry;
+  copy.cloneHistograms();
+  BOOST_CHECK(copy.get<TH1>(HIST("pt")) != registry.get<TH1>(HIST("pt")));
+  BOOST_CHECK_EQUAL(copy.get<TH1>(HIST("pt"))->GetEntries(), 0);
+  BOOST_CHECK_EQUAL(copy.get<TH1>(HIST("pt"))->GetNbinsX(), 10);
+  copy.fill(HIST("pt"), 1.5);
+  copy.fill(HIST("pt"), 5.5);
+  copy.fill(HIST("stepTHnF"), 1, 2.5);
+  BOOST_CHECK_EQUAL(registry.get<TH1>(HIST("pt"))->GetEntries(), 1);
+
+  registry.merge(copy);
+  auto& pt = registry.get<TH1>(HIST("pt"));
+  BOOST_CHECK_EQUAL(pt->GetEntries(), 3);
+  BOOST_CHECK_EQUAL(pt->GetBinContent(pt->FindBin(1.5)), 2);
+  BOOST_CHECK_EQUAL(pt->GetBinContent(pt->FindBin(5.5)), 1);
+
+  HistogramRegistry other{"other", {{"eta", "#eta", {HistType::kTH1F, {{10, -1, 1}}}}}};
+  BOOST_CHECK_THROW(registry.merge(other), o2::framework::RuntimeErrorRef);
+}
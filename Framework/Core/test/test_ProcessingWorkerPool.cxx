@@ -0,0 +1,95 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test Framework ProcessingWorkerPool
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include "../src/ProcessingWorkerPool.h"
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace o2::framework;
+
+BOOST_AUTO_TEST_CASE(TestAllTasksAreRun)
+{
+  ProcessingWorkerPool pool{4};
+  BOOST_CHECK_EQUAL(pool.size(), 4);
+  for (size_t n : {0, 1, 3, 4, 100}) {
+    std::vector<std::atomic<int>> calls(n);
+    pool.run(n, [&calls](size_t i) { calls[i]++; });
+    for (auto& c : calls) {
+      BOOST_CHECK_EQUAL(c.load(), 1);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TestConcurrency)
+{
+  // All the tasks wait for each other, this only completes if
+  // they really run on different threads.
+  ProcessingWorkerPool pool{3};
+  std::atomic<int> arrived{0};
+  std::mutex mutex;
+  std::set<std::thread::id> threads;
+  pool.run(3, [&](size_t) {
+    arrived++;
+    while (arrived.load() != 3) {
+      std::this_thread::yield();
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    threads.insert(std::this_thread::get_id());
+  });
+  BOOST_CHECK_EQUAL(threads.size(), 3);
+  BOOST_CHECK(threads.count(std::this_thread::get_id()) == 1);
+}
+
+BOOST_AUTO_TEST_CASE(TestException)
+{
+  ProcessingWorkerPool pool{2};
+  std::atomic<int> calls{0};
+  BOOST_CHECK_THROW(pool.run(10, [&calls](size_t i) {
+    calls++;
+    if (i == 5) {
+      throw std::runtime_error("failure");
+    }
+  }),
+                    std::runtime_error);
+  // the other tasks are still executed
+  BOOST_CHECK_EQUAL(calls.load(), 10);
+  // and the pool can be reused
+  calls = 0;
+  pool.run(10, [&calls](size_t) { calls++; });
+  BOOST_CHECK_EQUAL(calls.load(), 10);
+}
+
+BOOST_AUTO_TEST_CASE(TestBackToBackRuns)
+{
+  // Short runs following each other, so that workers often wake up
+  // after the run they were notified for is already over. Each index
+  // of each run must still be processed exactly once, by its own task.
+  ProcessingWorkerPool pool{4};
+  for (int run = 0; run < 10000; ++run) {
+    size_t n = 2 + run % 4;
+    std::vector<std::atomic<int>> calls(n);
+    pool.run(n, [&calls, n](size_t i) {
+      BOOST_REQUIRE(i < n);
+      calls[i]++;
+    });
+    for (auto& c : calls) {
+      BOOST_REQUIRE_EQUAL(c.load(), 1);
+    }
+  }
+}
@@ -0,0 +1,82 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test Framework SelectionBitmap
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include "Framework/SelectionBitmap.h"
+#include <boost/test/unit_test.hpp>
+#include <gandiva/selection_vector.h>
+#include <arrow/memory_pool.h>
+#include <algorithm>
+#include <iterator>
+
+using namespace o2::soa;
+
+BOOST_AUTO_TEST_CASE(TestSelectionBitmapOperations)
+{
+  // rows across word boundaries, and a size which is not a multiple of 64
+  std::vector<int64_t> evens, thirds;
+  for (int64_t i = 0; i < 1000; i += 2) {
+    evens.push_back(i);
+  }
+  for (int64_t i = 0; i < 1000; i += 3) {
+    thirds.push_back(i);
+  }
+  SelectionBitmap a{evens, 1000};
+  SelectionBitmap b{thirds, 1000};
+  BOOST_CHECK_EQUAL(a.size(), 1000);
+  BOOST_CHECK_EQUAL(a.count(), 500);
+  BOOST_CHECK(a.test(998));
+  BOOST_CHECK(!a.test(999));
+  BOOST_CHECK(a.toRows() == evens);
+
+  std::vector<int64_t> expected;
+  std::set_intersection(evens.begin(), evens.end(), thirds.begin(), thirds.end(), std::back_inserter(expected));
+  BOOST_CHECK((a & b).toRows() == expected);
+  expected.clear();
+  std::set_union(evens.begin(), evens.end(), thirds.begin(), thirds.end(), std::back_inserter(expected));
+  BOOST_CHECK((a | b).toRows() == expected);
+  BOOST_CHECK_EQUAL((a | b).count(), expected.size());
+
+  SelectionBitmap empty{1000};
+  BOOST_CHECK_EQUAL(empty.count(), 0);
+  BOOST_CHECK_EQUAL((a & empty).count(), 0);
+
+  // selections of tables with a different number of rows cannot be combined
+  SelectionBitmap shorter{999};
+  BOOST_CHECK_THROW(a &= shorter, o2::framework::RuntimeErrorRef);
+  BOOST_CHECK_THROW(a |= shorter, o2::framework::RuntimeErrorRef);
+  BOOST_CHECK_EQUAL(a.count(), 500);
+  a.reset(0);
+  BOOST_CHECK(!a.test(0));
+}
+
+BOOST_AUTO_TEST_CASE(TestSelectionBitmapGandiva)
+{
+  std::shared_ptr<gandiva::SelectionVector> selection;
+  BOOST_REQUIRE(gandiva::SelectionVector::MakeInt64(100, arrow::default_memory_pool(), &selection).ok());
+  std::vector<int64_t> rows{1, 7, 63, 64, 99};
+  for (size_t i = 0; i < rows.size(); ++i) {
+    selection->SetIndex(i, rows[i]);
+  }
+  selection->SetNumSlots(rows.size());
+
+  SelectionBitmap bitmap{*selection, 100};
+  BOOST_CHECK_EQUAL(bitmap.count(), 5);
+  BOOST_CHECK(bitmap.toRows() == rows);
+
+  auto back = bitmap.toSelection();
+  BOOST_REQUIRE_EQUAL(back->GetNumSlots(), 5);
+  for (size_t i = 0; i < rows.size(); ++i) {
+    BOOST_CHECK_EQUAL(back->GetIndex(i), rows[i]);
+  }
+}
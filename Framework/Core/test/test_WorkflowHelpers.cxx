@@ -590,3 +590,19 @@ BOOST_AUTO_TEST_CASE(TestOriginWildcard)
     BOOST_CHECK_EQUAL(inActions[ai].requiresNewChannel, expectedInActions[ai].requiresNewChannel);
   }
 }
+
+BOOST_AUTO_TEST_CASE(TestAODColumnsToRead)
+{
+  auto columns = [](std::string labels) {
+    return std::vector<ConfigParamSpec>{ConfigParamSpec{"columns", VariantType::String, labels, {""}}};
+  };
+  std::vector<InputSpec> requested{
+    InputSpec{"A", "AOD", "TRACK", 0, Lifetime::Timeframe, columns("fX,fY")},
+    InputSpec{"B", "AOD", "TRACK", 0, Lifetime::Timeframe, columns("fZ,fX")},
+    InputSpec{"C", "AOD", "COLLISION", 0, Lifetime::Timeframe, columns("fPosZ")},
+    InputSpec{"D", "AOD", "CALO", 0, Lifetime::Timeframe, columns("fAmplitude")},
+    // no columns declared, read everything
+    InputSpec{"E", "AOD", "CALO", 0, Lifetime::Timeframe}};
+  BOOST_CHECK_EQUAL(WorkflowHelpers::computeAODColumnsToRead(requested), "AOD/COLLISION:fPosZ;AOD/TRACK:fX,fY,fZ");
+  BOOST_CHECK_EQUAL(WorkflowHelpers::computeAODColumnsToRead({}), "");
+}
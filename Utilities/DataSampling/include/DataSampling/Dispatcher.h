@@ -71,6 +71,8 @@ class Dispatcher : public framework::Task
   std::string mReconfigurationSource;
   // policies should be shared between all pipeline threads
   std::vector<std::shared_ptr<DataSamplingPolicy>> mPolicies;
+  // share the payloads of the sampled messages instead of copying them
+  bool mZeroCopy = true;
 };
 
 } // namespace o2::utilities
@@ -57,6 +57,10 @@ void Dispatcher::init(InitContext& ctx)
     ; // we use policies declared during workflow init.
   }
 
+  if (ctx.options().isSet("zero-copy")) {
+    mZeroCopy = ctx.options().get<bool>("zero-copy");
+  }
+
   for (auto&& policyConfig : policiesTree) {
     // we don't want the Dispatcher to exit due to one faulty Policy
     try {
@@ -147,8 +151,13 @@ header::Stack Dispatcher::extractAdditionalHeaders(const char* inputHeaderStack)
 
 void Dispatcher::send(DataAllocator& dataAllocator, const DataRef& inputData, Output&& output) const
 {
-  const auto* inputHeader = header::get<header::DataHeader*>(inputData.header);
-  dataAllocator.snapshot(output, inputData.payload, inputHeader->payloadSize, inputHeader->payloadSerializationMethod);
+  if (mZeroCopy) {
+    // the payload is shared with the input when it is in the same shared memory segment, copied otherwise
+    dataAllocator.forwardPayload(output, inputData);
+  } else {
+    const auto* inputHeader = header::get<header::DataHeader*>(inputData.header);
+    dataAllocator.snapshot(output, inputData.payload, inputHeader->payloadSize, inputHeader->payloadSerializationMethod);
+  }
 }
 
 void Dispatcher::registerPolicy(std::unique_ptr<DataSamplingPolicy>&& policy)
@@ -209,7 +218,8 @@ Outputs Dispatcher::getOutputSpecs()
 }
 framework::Options Dispatcher::getOptions()
 {
-  return {{"period-timer-stats", framework::VariantType::Int, 10 * 1000000, {"Dispatcher's stats timer period"}}};
+  return {{"period-timer-stats", framework::VariantType::Int, 10 * 1000000, {"Dispatcher's stats timer period"}},
+          {"zero-copy", framework::VariantType::Bool, true, {"Send the sampled messages without copying them when possible"}}};
 }
 
 size_t Dispatcher::numberOfPolicies()
@@ -54,6 +54,7 @@ class FullHistoryMerger : public framework::Task
 
   MergerConfig mConfig;
   std::unique_ptr<monitoring::Monitoring> mCollector;
+  int mNThreads = 1;
 
   // stats
   int mTotalObjectsMerged = 0;
@@ -0,0 +1,84 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef ALICEO2_HISTOGRAMDELTA_H
+#define ALICEO2_HISTOGRAMDELTA_H
+
+/// \file HistogramDelta.h
+/// \brief Definition of HistogramDelta, a compact difference of histograms to be merged
+
+#include "Mergers/MergeInterface.h"
+
+#include <TObject.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class TH1;
+
+namespace o2::mergers
+{
+
+/// \brief A compact difference between two versions of a histogram, which can be merged.
+///
+/// Only the bins which changed are stored, as varint-encoded gaps between their indices and their
+/// differences of contents (and of Sumw2 if needed), together with the binning of the histogram and
+/// the differences of its statistics. It is meant to be sent to Mergers with
+/// InputObjectsTimespan::LastDifference instead of the full histogram, which are then able to
+/// reconstruct the full histogram from the sum of the deltas.
+///
+/// Supported are TH1, TH2 and TH3 histograms with an array of bins, profiles are not.
+class HistogramDelta : public TObject, public MergeInterface
+{
+ public:
+  HistogramDelta() = default;
+  /// \brief Encodes the bins of histogram which differ from previous, or all the non-empty ones if previous is nullptr.
+  HistogramDelta(TH1 const& histogram, TH1 const* previous = nullptr);
+  ~HistogramDelta() override;
+
+  /// \brief Adds the bins of the other HistogramDelta, which must have the same binning.
+  void merge(MergeInterface* const other) override;
+
+  /// \brief The histogram reconstructed from the delta and everything merged into it, owned by the delta.
+  TH1* getHistogram();
+
+  /// \brief Number of bins stored in the delta.
+  size_t getNChangedBins() const { return mNChangedBins; }
+  /// \brief Size of the encoded bins in bytes.
+  size_t getEncodedSize() const { return mEncoded.size(); }
+
+  const char* GetName() const override { return mName.c_str(); }
+
+ private:
+  void encode(TH1 const& histogram, TH1 const* previous);
+  void apply(TH1& histogram) const;
+  std::unique_ptr<TH1> makeHistogram() const;
+  bool hasSameBinning(HistogramDelta const& other) const;
+
+  std::string mName;
+  std::string mTitle;
+  std::string mClassName;
+  std::vector<int> mNBins;                // number of bins of each axis
+  std::vector<std::vector<double>> mEdges; // lower and upper limit of each axis, or all edges for variable bins
+  std::vector<double> mStats;              // differences of the statistics, as given by TH1::GetStats
+  double mEntries = 0;
+  size_t mNChangedBins = 0;
+  std::vector<unsigned char> mEncoded;
+
+  std::unique_ptr<TH1> mHistogram; //! reconstructed histogram
+  bool mEncodedIsCurrent = true;   //! false when other deltas were merged since the encoding
+
+  ClassDefOverride(HistogramDelta, 1);
+};
+
+} // namespace o2::mergers
+
+#endif //ALICEO2_HISTOGRAMDELTA_H
@@ -23,6 +23,7 @@
 #include "Framework/Task.h"
 
 #include <memory>
+#include <vector>
 
 class TObject;
 
@@ -51,6 +52,7 @@ class IntegratingMerger : public framework::Task
   void run(framework::ProcessingContext& ctx) override;
 
  private:
+  void mergeInParallel(std::vector<framework::DataRef> const& refs);
   void publish(framework::DataAllocator& allocator);
 
  private:
@@ -58,6 +60,7 @@ class IntegratingMerger : public framework::Task
   ObjectStore mMergedObject = std::monostate{};
   MergerConfig mConfig;
   std::unique_ptr<monitoring::Monitoring> mCollector;
+  int mNThreads = 1;
 
   // stats
   int mTotalDeltasMerged = 0;
@@ -18,6 +18,8 @@
 
 #include "Mergers/MergeInterface.h"
 
+#include <vector>
+
 class TObject;
 
 namespace o2::mergers::algorithm
@@ -25,6 +27,10 @@ namespace o2::mergers::algorithm
 
 /// \brief A function which merges TObjects
 void merge(TObject* const target, TObject* const other);
+/// \brief Merges all the other TObjects into the target, using up to nThreads threads.
+/// The other objects are not modified. Histograms of the same type and binning are added bin by bin.
+/// When more than one thread is used, ROOT thread safety is enabled with ROOT::EnableThreadSafety().
+void merge(TObject* const target, std::vector<TObject*> const& others, int nThreads);
 void deleteTCollections(TObject* obj);
 
 } // namespace o2::mergers::algorithm
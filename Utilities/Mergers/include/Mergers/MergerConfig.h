@@ -47,6 +47,11 @@ enum class TopologySize {
   ReductionFactor // User specifies how many sources should be handled by one merger (by maximum).
 };
 
+enum class MergingParallelism {
+  SingleThreaded, // Objects are merged one after another.
+  MultiThreaded   // Objects are merged in parallel by the number of threads given as the parameter.
+};
+
 template <typename V, typename P = double>
 struct ConfigEntry {
   V value;
@@ -59,6 +64,7 @@ struct MergerConfig {
   ConfigEntry<MergedObjectTimespan> mergedObjectTimespan = {MergedObjectTimespan::FullHistory};
   ConfigEntry<PublicationDecision> publicationDecision = {PublicationDecision::EachNSeconds, 10};
   ConfigEntry<TopologySize, int> topologySize = {TopologySize::NumberOfLayers, 1};
+  ConfigEntry<MergingParallelism, int> mergingParallelism = {MergingParallelism::SingleThreaded, 1};
   std::string monitoringUrl = "infologger:///debug?qc";
 };
 
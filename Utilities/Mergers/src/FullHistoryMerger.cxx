@@ -22,6 +22,11 @@
 #include "Framework/InputRecordWalker.h"
 #include "Framework/Logger.h"
 #include <Monitoring/MonitoringFactory.h>
+#include <TH1.h>
+#include <TROOT.h>
+
+#include <algorithm>
+#include <vector>
 
 using namespace o2::header;
 using namespace o2::framework;
@@ -47,6 +52,13 @@ void FullHistoryMerger::init(framework::InitContext& ictx)
 {
   mCollector = monitoring::MonitoringFactory::Get(mConfig.monitoringUrl);
   mCollector->addGlobalTag(monitoring::tags::Key::Subsystem, monitoring::tags::Value::Mergers);
+
+  if (mConfig.mergingParallelism.value == MergingParallelism::MultiThreaded) {
+    mNThreads = std::max(1, mConfig.mergingParallelism.param);
+    // objects are copied in parallel, they should not be registered in the shared current directory
+    ROOT::EnableThreadSafety();
+    TH1::AddDirectory(false);
+  }
 }
 
 void FullHistoryMerger::run(framework::ProcessingContext& ctx)
@@ -107,12 +119,14 @@ void FullHistoryMerger::mergeCache()
   if (std::holds_alternative<TObjectPtr>(mMergedObject)) {
 
     auto target = std::get<TObjectPtr>(mMergedObject);
+    std::vector<TObject*> others;
+    others.reserve(mCache.size());
     for (auto& [name, entry] : mCache) {
       (void)name;
-      auto other = std::get<TObjectPtr>(entry);
-      algorithm::merge(target.get(), other.get());
-      mObjectsMerged++;
+      others.push_back(std::get<TObjectPtr>(entry).get());
     }
+    algorithm::merge(target.get(), others, mNThreads);
+    mObjectsMerged += others.size();
 
   } else if (std::holds_alternative<MergeInterfacePtr>(mMergedObject)) {
     auto target = std::get<MergeInterfacePtr>(mMergedObject);
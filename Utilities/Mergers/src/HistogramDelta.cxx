@@ -0,0 +1,327 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file HistogramDelta.cxx
+/// \brief Implementation of HistogramDelta
+
+#include "Mergers/HistogramDelta.h"
+
+#include <TArray.h>
+#include <TBuffer.h>
+#include <TClass.h>
+#include <TH1.h>
+#include <TH2.h>
+#include <TH3.h>
+#include <TProfile.h>
+#include <TProfile2D.h>
+#include <TProfile3D.h>
+
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+ClassImp(o2::mergers::HistogramDelta);
+
+namespace o2::mergers
+{
+
+namespace
+{
+
+enum Flags : unsigned char {
+  ContentsAreIntegral = 1 << 0,
+  HasSumw2 = 1 << 1,
+  Sumw2EqualsContents = 1 << 2,
+  Sumw2IsIntegral = 1 << 3
+};
+
+void putVarint(std::vector<unsigned char>& buffer, uint64_t value)
+{
+  while (value >= 0x80) {
+    buffer.push_back(static_cast<unsigned char>(value | 0x80));
+    value >>= 7;
+  }
+  buffer.push_back(static_cast<unsigned char>(value));
+}
+
+uint64_t getVarint(unsigned char const*& position, unsigned char const* end)
+{
+  uint64_t value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    if (position == end) {
+      throw std::runtime_error("HistogramDelta: truncated encoded bins");
+    }
+    auto byte = *position++;
+    value |= uint64_t(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      return value;
+    }
+  }
+  throw std::runtime_error("HistogramDelta: malformed encoded bins");
+}
+
+bool isIntegral(double value)
+{
+  return std::abs(value) < 9007199254740992. && value == std::nearbyint(value);
+}
+
+/// integral values are stored as zigzag varints, which takes 1 or 2 bytes for most of the bins of
+/// unweighted histograms, other values as they are
+void putValues(std::vector<unsigned char>& buffer, std::vector<double> const& values, bool integral)
+{
+  for (auto value : values) {
+    if (integral) {
+      auto signedValue = static_cast<int64_t>(value);
+      putVarint(buffer, (static_cast<uint64_t>(signedValue) << 1) ^ static_cast<uint64_t>(signedValue >> 63));
+    } else {
+      auto size = buffer.size();
+      buffer.resize(size + sizeof(double));
+      std::memcpy(buffer.data() + size, &value, sizeof(double));
+    }
+  }
+}
+
+double getValue(unsigned char const*& position, unsigned char const* end, bool integral)
+{
+  if (integral) {
+    auto zigzag = getVarint(position, end);
+    return static_cast<double>(static_cast<int64_t>((zigzag >> 1) ^ (~(zigzag & 1) + 1)));
+  }
+  if (end - position < static_cast<std::ptrdiff_t>(sizeof(double))) {
+    throw std::runtime_error("HistogramDelta: truncated encoded bins");
+  }
+  double value;
+  std::memcpy(&value, position, sizeof(double));
+  position += sizeof(double);
+  return value;
+}
+
+double getSumw2(TH1 const& histogram, int bin)
+{
+  // errors of a histogram without Sumw2 are the square root of its contents
+  return histogram.GetSumw2N() ? histogram.GetSumw2()->At(bin) : std::abs(histogram.GetBinContent(bin));
+}
+
+} // namespace
+
+HistogramDelta::HistogramDelta(TH1 const& histogram, TH1 const* previous)
+  : TObject(), MergeInterface(), mName(histogram.GetName()), mTitle(histogram.GetTitle()), mClassName(histogram.ClassName())
+{
+  if (dynamic_cast<TArray const*>(&histogram) == nullptr || histogram.InheritsFrom(TProfile::Class()) || histogram.InheritsFrom(TProfile2D::Class()) || histogram.InheritsFrom(TProfile3D::Class())) {
+    throw std::runtime_error("HistogramDelta does not support histograms of type '" + mClassName + "'");
+  }
+  std::vector<TAxis const*> axes{histogram.GetXaxis(), histogram.GetYaxis(), histogram.GetZaxis()};
+  axes.resize(histogram.GetDimension());
+  for (auto axis : axes) {
+    mNBins.push_back(axis->GetNbins());
+    if (axis->GetXbins()->fN != 0) {
+      mEdges.emplace_back(axis->GetXbins()->GetArray(), axis->GetXbins()->GetArray() + axis->GetXbins()->fN);
+    } else {
+      mEdges.push_back({axis->GetXmin(), axis->GetXmax()});
+    }
+  }
+  if (previous != nullptr && (previous->GetNcells() != histogram.GetNcells() || previous->GetDimension() != histogram.GetDimension())) {
+    throw std::runtime_error("HistogramDelta: the previous version of '" + mName + "' has a different binning");
+  }
+  encode(histogram, previous);
+}
+
+HistogramDelta::~HistogramDelta() = default;
+
+void HistogramDelta::encode(TH1 const& histogram, TH1 const* previous)
+{
+  std::vector<int> bins;
+  std::vector<double> contents;
+  std::vector<double> sumw2;
+  const bool hasSumw2 = histogram.GetSumw2N() != 0 || (previous != nullptr && previous->GetSumw2N() != 0);
+  bool contentsAreIntegral = true;
+  bool sumw2IsIntegral = true;
+  bool sumw2EqualsContents = true;
+  for (int bin = 0; bin < histogram.GetNcells(); ++bin) {
+    double content = histogram.GetBinContent(bin) - (previous ? previous->GetBinContent(bin) : 0.);
+    double error = hasSumw2 ? getSumw2(histogram, bin) - (previous ? getSumw2(*previous, bin) : 0.) : 0.;
+    if (content == 0. && error == 0.) {
+      continue;
+    }
+    bins.push_back(bin);
+    contents.push_back(content);
+    sumw2.push_back(error);
+    contentsAreIntegral = contentsAreIntegral && isIntegral(content);
+    sumw2IsIntegral = sumw2IsIntegral && isIntegral(error);
+    sumw2EqualsContents = sumw2EqualsContents && error == content;
+  }
+
+  unsigned char flags = (contentsAreIntegral ? ContentsAreIntegral : 0) | (hasSumw2 ? HasSumw2 : 0) |
+                        (sumw2EqualsContents ? Sumw2EqualsContents : 0) | (sumw2IsIntegral ? Sumw2IsIntegral : 0);
+  mEncoded.clear();
+  mEncoded.reserve(2 * bins.size() + 16);
+  mEncoded.push_back(flags);
+  putVarint(mEncoded, bins.size());
+  int last = -1;
+  for (auto bin : bins) {
+    putVarint(mEncoded, bin - last - 1);
+    last = bin;
+  }
+  putValues(mEncoded, contents, contentsAreIntegral);
+  if (hasSumw2 && !sumw2EqualsContents) {
+    putValues(mEncoded, sumw2, sumw2IsIntegral);
+  }
+  mNChangedBins = bins.size();
+
+  mStats.assign(TH1::kNstat, 0.);
+  histogram.GetStats(mStats.data());
+  mEntries = histogram.GetEntries();
+  if (previous != nullptr) {
+    std::vector<double> previousStats(TH1::kNstat, 0.);
+    previous->GetStats(previousStats.data());
+    for (size_t i = 0; i < mStats.size(); ++i) {
+      mStats[i] -= previousStats[i];
+    }
+    mEntries -= previous->GetEntries();
+  }
+  mEncodedIsCurrent = true;
+}
+
+void HistogramDelta::apply(TH1& histogram) const
+{
+  if (mEncoded.empty()) {
+    throw std::runtime_error("HistogramDelta '" + mName + "' is empty");
+  }
+  auto position = mEncoded.data();
+  auto end = mEncoded.data() + mEncoded.size();
+  const unsigned char flags = *position++;
+  const size_t nBins = getVarint(position, end);
+  std::vector<int> bins(nBins);
+  int last = -1;
+  for (auto& bin : bins) {
+    bin = last + 1 + static_cast<int>(getVarint(position, end));
+    if (bin >= histogram.GetNcells()) {
+      throw std::runtime_error("HistogramDelta: bin out of the range of '" + mName + "'");
+    }
+    last = bin;
+  }
+
+  const bool hasSumw2 = flags & HasSumw2;
+  if (hasSumw2 && histogram.GetSumw2N() == 0) {
+    histogram.Sumw2();
+  }
+  double* sumw2 = histogram.GetSumw2N() ? histogram.GetSumw2()->GetArray() : nullptr;
+  std::vector<double> contents(nBins);
+  for (size_t i = 0; i < nBins; ++i) {
+    contents[i] = getValue(position, end, flags & ContentsAreIntegral);
+    histogram.AddBinContent(bins[i], contents[i]);
+  }
+  if (sumw2 != nullptr) {
+    // deltas without their own Sumw2 come from unweighted histograms, whose errors are their contents
+    const bool sumw2Stored = hasSumw2 && !(flags & Sumw2EqualsContents);
+    for (size_t i = 0; i < nBins; ++i) {
+      sumw2[bins[i]] += sumw2Stored ? getValue(position, end, flags & Sumw2IsIntegral) : contents[i];
+    }
+  }
+
+  std::vector<double> stats(TH1::kNstat, 0.);
+  auto entries = histogram.GetEntries();
+  histogram.GetStats(stats.data());
+  for (size_t i = 0; i < stats.size() && i < mStats.size(); ++i) {
+    stats[i] += mStats[i];
+  }
+  histogram.PutStats(stats.data());
+  histogram.SetEntries(entries + mEntries);
+}
+
+std::unique_ptr<TH1> HistogramDelta::makeHistogram() const
+{
+  auto histogramClass = TClass::GetClass(mClassName.c_str());
+  if (histogramClass == nullptr || !histogramClass->InheritsFrom(TH1::Class())) {
+    throw std::runtime_error("HistogramDelta: unknown histogram type '" + mClassName + "'");
+  }
+  std::unique_ptr<TH1> histogram(static_cast<TH1*>(histogramClass->New()));
+  histogram->SetDirectory(nullptr);
+  histogram->SetNameTitle(mName.c_str(), mTitle.c_str());
+
+  bool fixedBins = true;
+  for (size_t axis = 0; axis < mNBins.size(); ++axis) {
+    fixedBins = fixedBins && mEdges[axis].size() == 2;
+  }
+  // axes of fixed bins are given as edges if any of the axes has variable bins
+  std::vector<std::vector<double>> edges(mEdges);
+  for (size_t axis = 0; axis < mNBins.size(); ++axis) {
+    if (edges[axis].size() != static_cast<size_t>(mNBins[axis]) + 1) {
+      double min = mEdges[axis][0];
+      double width = (mEdges[axis][1] - min) / mNBins[axis];
+      edges[axis].resize(mNBins[axis] + 1);
+      for (int bin = 0; bin <= mNBins[axis]; ++bin) {
+        edges[axis][bin] = min + bin * width;
+      }
+    }
+  }
+  if (mNBins.size() == 1 && fixedBins) {
+    histogram->SetBins(mNBins[0], mEdges[0][0], mEdges[0][1]);
+  } else if (mNBins.size() == 1) {
+    histogram->SetBins(mNBins[0], edges[0].data());
+  } else if (mNBins.size() == 2 && fixedBins) {
+    histogram->SetBins(mNBins[0], mEdges[0][0], mEdges[0][1], mNBins[1], mEdges[1][0], mEdges[1][1]);
+  } else if (mNBins.size() == 2) {
+    histogram->SetBins(mNBins[0], edges[0].data(), mNBins[1], edges[1].data());
+  } else if (mNBins.size() == 3 && fixedBins) {
+    histogram->SetBins(mNBins[0], mEdges[0][0], mEdges[0][1], mNBins[1], mEdges[1][0], mEdges[1][1], mNBins[2], mEdges[2][0], mEdges[2][1]);
+  } else if (mNBins.size() == 3) {
+    histogram->SetBins(mNBins[0], edges[0].data(), mNBins[1], edges[1].data(), mNBins[2], edges[2].data());
+  } else {
+    throw std::runtime_error("HistogramDelta: unsupported number of dimensions of '" + mName + "'");
+  }
+  return histogram;
+}
+
+TH1* HistogramDelta::getHistogram()
+{
+  if (!mHistogram) {
+    mHistogram = makeHistogram();
+    apply(*mHistogram);
+  }
+  return mHistogram.get();
+}
+
+bool HistogramDelta::hasSameBinning(HistogramDelta const& other) const
+{
+  return mClassName == other.mClassName && mNBins == other.mNBins && mEdges == other.mEdges;
+}
+
+void HistogramDelta::merge(MergeInterface* const other)
+{
+  auto delta = dynamic_cast<HistogramDelta const*>(other);
+  if (delta == nullptr) {
+    throw std::runtime_error("HistogramDelta '" + mName + "' can be merged only with other HistogramDeltas");
+  }
+  if (!hasSameBinning(*delta)) {
+    throw std::runtime_error("HistogramDelta '" + mName + "' cannot be merged with '" + delta->mName + "', which has a different binning");
+  }
+  // the other delta is added to the bins directly, without reconstructing its histogram
+  delta->apply(*getHistogram());
+  mEncodedIsCurrent = false;
+}
+
+void HistogramDelta::Streamer(TBuffer& R__b)
+{
+  // the custom streamer for HistogramDelta
+  if (R__b.IsReading()) {
+    R__b.ReadClassBuffer(HistogramDelta::Class(), this);
+    mHistogram.reset();
+    mEncodedIsCurrent = true;
+  } else {
+    // a merged delta is sent as the difference to an empty histogram
+    if (mHistogram && !mEncodedIsCurrent) {
+      encode(*mHistogram, nullptr);
+    }
+    R__b.WriteClassBuffer(HistogramDelta::Class(), this);
+  }
+}
+
+} // namespace o2::mergers
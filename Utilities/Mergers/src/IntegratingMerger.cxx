@@ -19,6 +19,11 @@
 #include "Mergers/MergerBuilder.h"
 
 #include <Monitoring/MonitoringFactory.h>
+#include <TH1.h>
+#include <TROOT.h>
+
+#include <algorithm>
+#include <exception>
 
 #include "Framework/InputRecordWalker.h"
 #include "Framework/Logger.h"
@@ -38,6 +43,13 @@ void IntegratingMerger::init(framework::InitContext& ictx)
 {
   mCollector = monitoring::MonitoringFactory::Get(mConfig.monitoringUrl);
   mCollector->addGlobalTag(monitoring::tags::Key::Subsystem, monitoring::tags::Value::Mergers);
+
+  if (mConfig.mergingParallelism.value == MergingParallelism::MultiThreaded) {
+    mNThreads = std::max(1, mConfig.mergingParallelism.param);
+    // objects are created in parallel, they should not be registered in the shared current directory
+    ROOT::EnableThreadSafety();
+    TH1::AddDirectory(false);
+  }
 }
 
 void IntegratingMerger::run(framework::ProcessingContext& ctx)
@@ -45,25 +57,35 @@ void IntegratingMerger::run(framework::ProcessingContext& ctx)
   // we have to avoid mistaking the timer input with data inputs.
   auto* timerHeader = ctx.inputs().get("timer-publish").header;
 
-  for (const DataRef& ref : InputRecordWalker(ctx.inputs())) {
-    if (ref.header != timerHeader) {
-      if (std::holds_alternative<std::monostate>(mMergedObject)) {
-        mMergedObject = object_store_helpers::extractObjectFrom(ref);
-
-      } else if (std::holds_alternative<TObjectPtr>(mMergedObject)) {
-        // We expect that if the first object was TObject, then all should.
-        auto other = TObjectPtr(framework::DataRefUtils::as<TObject>(ref).release(), algorithm::deleteTCollections);
-        auto target = std::get<TObjectPtr>(mMergedObject);
-        algorithm::merge(target.get(), other.get());
-
-      } else if (std::holds_alternative<MergeInterfacePtr>(mMergedObject)) {
-        // We expect that if the first object inherited MergeInterface, then all should.
-        auto other = framework::DataRefUtils::as<MergeInterface>(ref);
-        std::get<MergeInterfacePtr>(mMergedObject)->merge(other.get());
-      } else {
-        throw std::runtime_error("mMergedObject' variant has no value.");
+  if (mNThreads > 1) {
+    std::vector<DataRef> refs;
+    for (const DataRef& ref : InputRecordWalker(ctx.inputs())) {
+      if (ref.header != timerHeader) {
+        refs.push_back(ref);
+      }
+    }
+    mergeInParallel(refs);
+  } else {
+    for (const DataRef& ref : InputRecordWalker(ctx.inputs())) {
+      if (ref.header != timerHeader) {
+        if (std::holds_alternative<std::monostate>(mMergedObject)) {
+          mMergedObject = object_store_helpers::extractObjectFrom(ref);
+
+        } else if (std::holds_alternative<TObjectPtr>(mMergedObject)) {
+          // We expect that if the first object was TObject, then all should.
+          auto other = TObjectPtr(framework::DataRefUtils::as<TObject>(ref).release(), algorithm::deleteTCollections);
+          auto target = std::get<TObjectPtr>(mMergedObject);
+          algorithm::merge(target.get(), other.get());
+
+        } else if (std::holds_alternative<MergeInterfacePtr>(mMergedObject)) {
+          // We expect that if the first object inherited MergeInterface, then all should.
+          auto other = framework::DataRefUtils::as<MergeInterface>(ref);
+          std::get<MergeInterfacePtr>(mMergedObject)->merge(other.get());
+        } else {
+          throw std::runtime_error("mMergedObject' variant has no value.");
+        }
+        mDeltasMerged++;
       }
-      mDeltasMerged++;
     }
   }
 
@@ -77,6 +99,48 @@ void IntegratingMerger::run(framework::ProcessingContext& ctx)
   }
 }
 
+void IntegratingMerger::mergeInParallel(std::vector<framework::DataRef> const& refs)
+{
+  // deserializing the deltas takes as long as merging them, so it is done in parallel as well
+  std::vector<ObjectStore> deltas(refs.size());
+  std::vector<std::exception_ptr> errors(refs.size());
+#ifdef WITH_OPENMP
+#pragma omp parallel for num_threads(mNThreads) schedule(dynamic)
+#endif
+  for (size_t i = 0; i < refs.size(); ++i) {
+    try {
+      deltas[i] = object_store_helpers::extractObjectFrom(refs[i]);
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+  }
+  for (auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  size_t first = 0;
+  if (std::holds_alternative<std::monostate>(mMergedObject) && !deltas.empty()) {
+    mMergedObject = deltas[0];
+    first = 1;
+  }
+  if (std::holds_alternative<TObjectPtr>(mMergedObject)) {
+    // We expect that if the first object was TObject, then all should.
+    std::vector<TObject*> others;
+    for (size_t i = first; i < deltas.size(); ++i) {
+      others.push_back(std::get<TObjectPtr>(deltas[i]).get());
+    }
+    algorithm::merge(std::get<TObjectPtr>(mMergedObject).get(), others, mNThreads);
+  } else if (std::holds_alternative<MergeInterfacePtr>(mMergedObject)) {
+    // We expect that if the first object inherited MergeInterface, then all should.
+    for (size_t i = first; i < deltas.size(); ++i) {
+      std::get<MergeInterfacePtr>(mMergedObject)->merge(std::get<MergeInterfacePtr>(deltas[i]).get());
+    }
+  }
+  mDeltasMerged += refs.size();
+}
+
 void IntegratingMerger::publish(framework::DataAllocator& allocator)
 {
   mTotalDeltasMerged += mDeltasMerged;
@@ -25,10 +25,104 @@
 #include <THnSparse.h>
 #include <TObjArray.h>
 #include <TGraph.h>
+#include <TProfile.h>
+#include <TProfile2D.h>
+#include <TProfile3D.h>
+#include <TROOT.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <vector>
 
 namespace o2::mergers::algorithm
 {
 
+namespace
+{
+
+template <typename T>
+void addArrays(T* __restrict__ target, T const* __restrict__ other, size_t size)
+{
+  for (size_t i = 0; i < size; ++i) {
+    target[i] += other[i];
+  }
+}
+
+bool sameBinning(TAxis const* a, TAxis const* b)
+{
+  if (a->GetNbins() != b->GetNbins() || a->GetXmin() != b->GetXmin() || a->GetXmax() != b->GetXmax()) {
+    return false;
+  }
+  if (a->GetLabels() != nullptr || b->GetLabels() != nullptr) {
+    return false;
+  }
+  // a restricted range changes how TH1::Merge treats the bins outside of it
+  if (a->TestBit(TAxis::kAxisRange) || b->TestBit(TAxis::kAxisRange)) {
+    return false;
+  }
+  auto edgesA = a->GetXbins();
+  auto edgesB = b->GetXbins();
+  return edgesA->fN == edgesB->fN && (edgesA->fN == 0 || std::memcmp(edgesA->fArray, edgesB->fArray, edgesA->fN * sizeof(Double_t)) == 0);
+}
+
+/// Adds the bins of the other histogram to the target, if both are TH1, TH2 or TH3 with float or double
+/// bins of the same type and binning. Returns false for any other case, which is left to TH1::Merge.
+bool mergeHistogramsFast(TH1* target, TH1* other)
+{
+  if (target->IsA() != other->IsA() || target->InheritsFrom(TProfile::Class()) || target->InheritsFrom(TProfile2D::Class()) || target->InheritsFrom(TProfile3D::Class())) {
+    return false;
+  }
+  auto targetF = dynamic_cast<TArrayF*>(target);
+  auto targetD = dynamic_cast<TArrayD*>(target);
+  if ((targetF == nullptr && targetD == nullptr) || target->GetNcells() != other->GetNcells()) {
+    return false;
+  }
+  if (target->GetBuffer() != nullptr || other->GetBuffer() != nullptr) {
+    return false;
+  }
+  if (!sameBinning(target->GetXaxis(), other->GetXaxis()) || !sameBinning(target->GetYaxis(), other->GetYaxis()) || !sameBinning(target->GetZaxis(), other->GetZaxis())) {
+    return false;
+  }
+
+  const size_t nCells = target->GetNcells();
+  // errors of a histogram without Sumw2 are the square root of its contents, like in TH1::Add
+  if (target->GetSumw2N() == 0 && other->GetSumw2N() != 0) {
+    target->Sumw2();
+  }
+  if (target->GetSumw2N() != 0) {
+    auto targetSumw2 = target->GetSumw2()->GetArray();
+    if (other->GetSumw2N() != 0) {
+      addArrays(targetSumw2, other->GetSumw2()->GetArray(), nCells);
+    } else {
+      for (size_t i = 0; i < nCells; ++i) {
+        targetSumw2[i] += std::abs(other->GetBinContent(i));
+      }
+    }
+  }
+  if (targetF) {
+    addArrays(targetF->GetArray(), dynamic_cast<TArrayF*>(other)->GetArray(), nCells);
+  } else {
+    addArrays(targetD->GetArray(), dynamic_cast<TArrayD*>(other)->GetArray(), nCells);
+  }
+
+  std::array<Double_t, TH1::kNstat> targetStats{0.};
+  std::array<Double_t, TH1::kNstat> otherStats{0.};
+  target->GetStats(targetStats.data());
+  other->GetStats(otherStats.data());
+  for (size_t i = 0; i < targetStats.size(); ++i) {
+    targetStats[i] += otherStats[i];
+  }
+  auto entries = target->GetEntries() + other->GetEntries();
+  target->PutStats(targetStats.data());
+  target->SetEntries(entries);
+  return true;
+}
+
+} // namespace
+
 void merge(TObject* const target, TObject* const other)
 {
   if (target == nullptr) {
@@ -76,7 +170,9 @@ void merge(TObject* const target, TObject* const other)
 
     if (target->InheritsFrom(TH1::Class())) {
       // this includes TH1, TH2, TH3
-      errorCode = reinterpret_cast<TH1*>(target)->Merge(&otherCollection);
+      if (!other->InheritsFrom(TH1::Class()) || !mergeHistogramsFast(reinterpret_cast<TH1*>(target), reinterpret_cast<TH1*>(other))) {
+        errorCode = reinterpret_cast<TH1*>(target)->Merge(&otherCollection);
+      }
     } else if (target->InheritsFrom(THnBase::Class())) {
       // this includes THn and THnSparse
       errorCode = reinterpret_cast<THnBase*>(target)->Merge(&otherCollection);
@@ -93,6 +189,61 @@ void merge(TObject* const target, TObject* const other)
   }
 }
 
+void merge(TObject* const target, std::vector<TObject*> const& others, int nThreads)
+{
+#ifndef WITH_OPENMP
+  nThreads = 1;
+#endif
+  // every thread needs at least two objects, so that merging in parallel is worth a copy
+  const int nGroups = std::max(1, std::min<int>(nThreads, others.size() / 2));
+  if (nGroups == 1) {
+    for (auto other : others) {
+      merge(target, other);
+    }
+    return;
+  }
+  // Clone() and Merge() touch the global state of ROOT, e.g. gDirectory and the list of cleanups
+  ROOT::EnableThreadSafety();
+
+  // each thread merges a contiguous group of objects into a copy of the first one of the group,
+  // the others are not modified so that they can be merged again later.
+  std::vector<TObject*> partials(nGroups, nullptr);
+  std::vector<std::exception_ptr> errors(nGroups);
+#ifdef WITH_OPENMP
+#pragma omp parallel for num_threads(nGroups) schedule(static, 1)
+#endif
+  for (int group = 0; group < nGroups; ++group) {
+    try {
+      size_t begin = group * others.size() / nGroups;
+      size_t end = (group + 1) * others.size() / nGroups;
+      partials[group] = others[begin]->Clone();
+      for (size_t i = begin + 1; i < end; ++i) {
+        merge(partials[group], others[i]);
+      }
+    } catch (...) {
+      errors[group] = std::current_exception();
+    }
+  }
+
+  std::exception_ptr error;
+  for (int group = 0; group < nGroups; ++group) {
+    if (error == nullptr) {
+      error = errors[group];
+    }
+    if (error == nullptr) {
+      try {
+        merge(target, partials[group]);
+      } catch (...) {
+        error = std::current_exception();
+      }
+    }
+    deleteTCollections(partials[group]);
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
 void deleteTCollections(TObject* obj)
 {
   if (auto c = dynamic_cast<TCollection*>(obj)) {
@@ -35,6 +35,9 @@
 #include <TGraph.h>
 #include <TProfile.h>
 
+#include <memory>
+#include <vector>
+
 //using namespace o2::framework;
 using namespace o2::mergers;
 
@@ -299,6 +302,98 @@ BOOST_AUTO_TEST_CASE(MergerCollection)
   delete target;
 }
 
+BOOST_AUTO_TEST_CASE(MergerHistogramsFastPath)
+{
+  // histograms of the same type and binning are added bin by bin, the result should match TH1::Add
+  const Double_t edges[] = {0, 1, 2, 4, 8, 10};
+  auto check = [](TH1* target, TH1* other) {
+    std::unique_ptr<TH1> reference(static_cast<TH1*>(target->Clone("reference")));
+    reference->Add(other);
+    BOOST_CHECK_NO_THROW(algorithm::merge(target, other));
+    for (int bin = 0; bin < target->GetNcells(); ++bin) {
+      BOOST_CHECK_CLOSE(target->GetBinContent(bin), reference->GetBinContent(bin), 1e-6);
+      BOOST_CHECK_CLOSE(target->GetBinError(bin), reference->GetBinError(bin), 1e-6);
+    }
+    BOOST_CHECK_EQUAL(target->GetEntries(), reference->GetEntries());
+    BOOST_CHECK_CLOSE(target->GetMean(), reference->GetMean(), 1e-6);
+    BOOST_CHECK_CLOSE(target->GetStdDev(), reference->GetStdDev(), 1e-6);
+  };
+  {
+    TH1F target("obj1", "obj1", bins, min, max);
+    TH1F other("obj2", "obj2", bins, min, max);
+    other.Sumw2();
+    for (int i = 0; i < 100; ++i) {
+      target.Fill(i % 12 - 1);
+      other.Fill(i % 7, 0.5);
+    }
+    check(&target, &other);
+  }
+  {
+    TH2D target("obj1", "obj1", 5, edges, bins, min, max);
+    TH2D other("obj2", "obj2", 5, edges, bins, min, max);
+    for (int i = 0; i < 100; ++i) {
+      target.Fill(i % 9, i % 4);
+      other.Fill(i % 11, i % 3, 2);
+    }
+    check(&target, &other);
+  }
+  {
+    // different binning is left to ROOT
+    TH1F target("obj1", "obj1", bins, min, max);
+    TH1F other("obj2", "obj2", 2 * bins, min, max);
+    target.Fill(5);
+    other.Fill(5);
+    BOOST_CHECK_NO_THROW(algorithm::merge(&target, &other));
+    BOOST_CHECK_EQUAL(target.GetBinContent(target.FindBin(5)), 2);
+  }
+  {
+    // a restricted axis range is left to ROOT, the result should match TH1::Merge
+    TH1F target("obj1", "obj1", bins, min, max);
+    TH1F other("obj2", "obj2", bins, min, max);
+    for (int i = 0; i < 100; ++i) {
+      target.Fill(i % 12 - 1);
+      other.Fill(i % 7);
+    }
+    target.GetXaxis()->SetRange(2, 5);
+    std::unique_ptr<TH1> reference(static_cast<TH1*>(target.Clone("reference")));
+    TObjArray list;
+    list.Add(&other);
+    reference->Merge(&list);
+    BOOST_CHECK_NO_THROW(algorithm::merge(&target, &other));
+    for (int bin = 0; bin < target.GetNcells(); ++bin) {
+      BOOST_CHECK_EQUAL(target.GetBinContent(bin), reference->GetBinContent(bin));
+    }
+    BOOST_CHECK_EQUAL(target.GetEntries(), reference->GetEntries());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(MergerMultipleObjects)
+{
+  TH1::AddDirectory(false);
+  std::vector<std::unique_ptr<TH1F>> histos;
+  std::vector<TObject*> others;
+  for (int i = 0; i < 10; ++i) {
+    histos.emplace_back(new TH1F("obj", "obj", bins, min, max));
+    histos.back()->Fill(i % bins);
+    others.push_back(histos.back().get());
+  }
+  for (int nThreads : {1, 4}) {
+    TH1F target("obj", "obj", bins, min, max);
+    BOOST_CHECK_NO_THROW(algorithm::merge(&target, others, nThreads));
+    BOOST_CHECK_EQUAL(target.GetEntries(), 10);
+    for (size_t bin = 1; bin <= bins; ++bin) {
+      BOOST_CHECK_EQUAL(target.GetBinContent(bin), 1);
+    }
+  }
+  // the merged objects are not modified
+  for (auto& histo : histos) {
+    BOOST_CHECK_EQUAL(histo->GetEntries(), 1);
+  }
+  others.push_back(nullptr);
+  TH1F target("obj", "obj", bins, min, max);
+  BOOST_CHECK_THROW(algorithm::merge(&target, others, 4), std::runtime_error);
+}
+
 BOOST_AUTO_TEST_CASE(Deleting)
 {
   TObjArray* main = new TObjArray();
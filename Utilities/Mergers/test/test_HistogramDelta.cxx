@@ -0,0 +1,107 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file test_HistogramDelta.cxx
+/// \brief A unit test of HistogramDelta
+
+#define BOOST_TEST_MODULE Test Utilities MergersHistogramDelta
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include "Mergers/HistogramDelta.h"
+#include "Mergers/MergerAlgorithm.h"
+
+#include <TH1.h>
+#include <TH2.h>
+#include <TProfile.h>
+
+#include <memory>
+
+using namespace o2::mergers;
+
+void checkSameHistograms(TH1* result, TH1* expected)
+{
+  BOOST_REQUIRE_EQUAL(result->GetNcells(), expected->GetNcells());
+  for (int bin = 0; bin < expected->GetNcells(); ++bin) {
+    BOOST_CHECK_CLOSE(result->GetBinContent(bin), expected->GetBinContent(bin), 1e-6);
+    BOOST_CHECK_CLOSE(result->GetBinError(bin), expected->GetBinError(bin), 1e-6);
+  }
+  BOOST_CHECK_CLOSE(result->GetEntries(), expected->GetEntries(), 1e-6);
+  for (int axis = 1; axis <= expected->GetDimension(); ++axis) {
+    BOOST_CHECK_CLOSE(result->GetMean(axis), expected->GetMean(axis), 1e-6);
+    BOOST_CHECK_CLOSE(result->GetStdDev(axis), expected->GetStdDev(axis), 1e-6);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(HistogramDeltaCycles)
+{
+  TH1::AddDirectory(false);
+  // a producer sends what has changed since the previous cycle, the merger sums up the deltas
+  TH1F histogram("histo", "histo", 10000, 0, 100);
+  std::unique_ptr<TH1> previous;
+  std::unique_ptr<HistogramDelta> merged;
+  for (int cycle = 0; cycle < 5; ++cycle) {
+    for (int i = 0; i < 50; ++i) {
+      histogram.Fill((cycle * 50 + i) % 97 + 0.5);
+    }
+    auto delta = std::make_unique<HistogramDelta>(histogram, previous.get());
+    BOOST_CHECK_LE(delta->getNChangedBins(), 50);
+    // a few bytes per changed bin, instead of 4 bytes per bin
+    BOOST_CHECK_LT(delta->getEncodedSize(), 4 * delta->getNChangedBins() + 16);
+    if (merged) {
+      BOOST_CHECK_NO_THROW(algorithm::merge(merged.get(), delta.get()));
+    } else {
+      merged = std::move(delta);
+    }
+    previous.reset(static_cast<TH1*>(histogram.Clone()));
+  }
+  checkSameHistograms(merged->getHistogram(), &histogram);
+
+  // a merged delta is sent further as a whole
+  std::unique_ptr<HistogramDelta> copy(static_cast<HistogramDelta*>(merged->Clone()));
+  BOOST_CHECK_EQUAL(copy->getNChangedBins(), 97);
+  checkSameHistograms(copy->getHistogram(), &histogram);
+}
+
+BOOST_AUTO_TEST_CASE(HistogramDeltaWeights)
+{
+  TH1::AddDirectory(false);
+  const Double_t edges[] = {0, 1, 2, 5, 10};
+  TH2D first("histo", "histo", 4, edges, 20, -10, 10);
+  TH2D second("histo", "histo", 4, edges, 20, -10, 10);
+  for (int i = 0; i < 100; ++i) {
+    first.Fill(i % 11, i % 23 - 11, 0.25 * (i % 3));
+    second.Fill(i % 7, i % 5, 1);
+  }
+  HistogramDelta merged(first);
+  HistogramDelta other(second);
+  BOOST_CHECK_NO_THROW(merged.merge(&other));
+
+  TH2D expected(first);
+  expected.Add(&second);
+  checkSameHistograms(merged.getHistogram(), &expected);
+}
+
+BOOST_AUTO_TEST_CASE(HistogramDeltaErrors)
+{
+  TH1::AddDirectory(false);
+  TH1F histogram("histo", "histo", 10, 0, 10);
+  TH1F differentBins("histo", "histo", 20, 0, 10);
+  histogram.Fill(1);
+  differentBins.Fill(1);
+  HistogramDelta delta(histogram);
+  HistogramDelta other(differentBins);
+  BOOST_CHECK_THROW(delta.merge(&other), std::runtime_error);
+
+  TProfile profile("profile", "profile", 10, 0, 10);
+  BOOST_CHECK_THROW(HistogramDelta{profile}, std::runtime_error);
+}
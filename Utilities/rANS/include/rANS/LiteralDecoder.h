@@ -18,6 +18,7 @@
 
 #include "Decoder.h"
 
+#include <array>
 #include <cstddef>
 #include <type_traits>
 #include <iostream>
@@ -31,6 +32,7 @@
 #include "rANS/internal/SymbolTable.h"
 #include "rANS/internal/Decoder.h"
 #include "rANS/internal/DecoderBase.h"
+#include "rANS/internal/InterleavedDecoder.h"
 
 namespace o2
 {
@@ -43,18 +45,18 @@ class LiteralDecoder : public internal::DecoderBase<coder_T, stream_T, source_T>
  public:
   using internal::DecoderBase<coder_T, stream_T, source_T>::DecoderBase;
 
-  template <typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<stream_T, stream_IT>, bool> = true>
+  // decode a message encoded with nStreams_V interleaved rANS states. For 64 Bit states decoded from a contiguous
+  // buffer and nStreams_V >= 8 the states are advanced with AVX2 gathers if the target supports them.
+  template <size_t nStreams_V = 2, typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<stream_T, stream_IT>, bool> = true>
   void process(stream_IT inputEnd, source_IT outputBegin, size_t messageLength, std::vector<source_T>& literals) const;
-
- private:
-  using ransDecoder_t = typename internal::DecoderBase<coder_T, stream_T, source_T>::ransDecoder_t;
 };
 
 template <typename coder_T, typename stream_T, typename source_T>
-template <typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<stream_T, stream_IT>, bool>>
+template <size_t nStreams_V, typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<stream_T, stream_IT>, bool>>
 void LiteralDecoder<coder_T, stream_T, source_T>::process(stream_IT inputEnd, source_IT outputBegin, size_t messageLength, std::vector<source_T>& literals) const
 {
   using namespace internal;
+  using ransDecoder_t = InterleavedDecoder<coder_T, stream_T, nStreams_V>;
   LOG(trace) << "start decoding";
   RANSTimer t;
   t.start();
@@ -67,34 +69,39 @@ void LiteralDecoder<coder_T, stream_T, source_T>::process(stream_IT inputEnd, so
   stream_IT inputIter = inputEnd;
   source_IT it = outputBegin;
 
-  auto decode = [&, this](ransDecoder_t& decoder) {
-    const auto cumul = decoder.get();
-    const auto streamSymbol = (this->mReverseLUT)[cumul];
-    source_T symbol = streamSymbol;
-    if (this->mSymbolTable.isEscapeSymbol(streamSymbol)) {
-      symbol = literals.back();
-      literals.pop_back();
+  const int32_t* reverseLUT = this->mReverseLUT.begin();
+  const DecoderSymbol* symbols = this->mDenseSymbolTable.data();
+  const int32_t minSymbol = this->mSymbolTable.getMinSymbol();
+  const int32_t escapeSymbol = this->mSymbolTable.getMaxSymbol();
+
+  auto writeSymbols = [&](const int32_t* decodedSymbols, size_t nSymbols) {
+    for (size_t i = 0; i < nSymbols; ++i) {
+      if (decodedSymbols[i] == escapeSymbol) {
+        *it++ = literals.back();
+        literals.pop_back();
+      } else {
+        *it++ = static_cast<source_T>(decodedSymbols[i]);
+      }
     }
-
-    return std::make_tuple(symbol, decoder.advanceSymbol(inputIter, (this->mSymbolTable)[streamSymbol]));
   };
 
   // make Iter point to the last last element
   --inputIter;
 
-  ransDecoder_t rans0{this->mSymbolTablePrecission};
-  ransDecoder_t rans1{this->mSymbolTablePrecission};
-  inputIter = rans0.init(inputIter);
-  inputIter = rans1.init(inputIter);
+  ransDecoder_t decoder{this->mSymbolTablePrecission};
+  inputIter = decoder.init(inputIter);
 
-  for (size_t i = 0; i < (messageLength & ~1); i += 2) {
-    std::tie(*it++, inputIter) = decode(rans0);
-    std::tie(*it++, inputIter) = decode(rans1);
+  std::array<int32_t, nStreams_V> decodedSymbols{};
+  const size_t nInterleavedSymbols = messageLength & ~(nStreams_V - 1);
+  for (size_t i = 0; i < nInterleavedSymbols; i += nStreams_V) {
+    inputIter = decoder.decode(inputIter, reverseLUT, symbols, minSymbol, decodedSymbols.data());
+    writeSymbols(decodedSymbols.data(), nStreams_V);
   }
 
-  // last byte, if message length was odd
-  if (messageLength & 1) {
-    std::tie(*it++, inputIter) = decode(rans0);
+  // last symbols, if message length is not a multiple of nStreams_V
+  if (const size_t nTail = messageLength - nInterleavedSymbols; nTail > 0) {
+    inputIter = decoder.decodeTail(inputIter, reverseLUT, symbols, minSymbol, nTail, decodedSymbols.data());
+    writeSymbols(decodedSymbols.data(), nTail);
   }
   t.stop();
   LOG(debug1) << "Decoder::" << __func__ << " { DecodedSymbols: " << messageLength << ","
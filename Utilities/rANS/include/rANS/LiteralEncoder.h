@@ -16,9 +16,11 @@
 #ifndef RANS_LITERAL_ENCODER_H
 #define RANS_LITERAL_ENCODER_H
 
+#include <array>
 #include <memory>
 #include <algorithm>
 #include <iomanip>
+#include <utility>
 
 #include <fairlogger/Logger.h>
 #include <stdexcept>
@@ -41,15 +43,22 @@ class LiteralEncoder : public internal::EncoderBase<coder_T, stream_T, source_T>
   //inherit constructors;
   using internal::EncoderBase<coder_T, stream_T, source_T>::EncoderBase;
 
-  template <typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<source_T, source_IT>, bool> = true>
+  // encode using nStreams_V interleaved rANS states, symbol i is coded by state i % nStreams_V.
+  template <size_t nStreams_V = 2, typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<source_T, source_IT>, bool> = true>
   stream_IT process(source_IT inputBegin, source_IT inputEnd, stream_IT outputBegin, std::vector<source_T>& literals) const;
 
  private:
   using ransCoder_t = typename internal::EncoderBase<coder_T, stream_T, source_T>::ransCoder_t;
+
+  template <size_t... Is>
+  static std::array<ransCoder_t, sizeof...(Is)> makeCoders(size_t symbolTablePrecission, std::index_sequence<Is...>)
+  {
+    return {((void)Is, ransCoder_t{symbolTablePrecission})...};
+  };
 };
 
 template <typename coder_T, typename stream_T, typename source_T>
-template <typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<source_T, source_IT>, bool>>
+template <size_t nStreams_V, typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<source_T, source_IT>, bool>>
 stream_IT LiteralEncoder<coder_T, stream_T, source_T>::process(source_IT inputBegin, source_IT inputEnd, stream_IT outputBegin, std::vector<source_T>& literals) const
 {
   using namespace internal;
@@ -62,8 +71,8 @@ stream_IT LiteralEncoder<coder_T, stream_T, source_T>::process(source_IT inputBe
     return outputBegin;
   }
 
-  ransCoder_t rans0{this->mSymbolTablePrecission};
-  ransCoder_t rans1{this->mSymbolTablePrecission};
+  static_assert(nStreams_V > 0 && (nStreams_V & (nStreams_V - 1)) == 0, "number of interleaved streams must be a power of 2");
+  auto coders = makeCoders(this->mSymbolTablePrecission, std::make_index_sequence<nStreams_V>{});
 
   stream_IT outputIter = outputBegin;
   source_IT inputIT = inputEnd;
@@ -79,17 +88,15 @@ stream_IT LiteralEncoder<coder_T, stream_T, source_T>::process(source_IT inputBe
     return coder.putSymbol(outputIter, encoderSymbol);
   };
 
-  // odd number of bytes?
-  if (inputBufferSize & 1) {
-    outputIter = encode(--inputIT, outputIter, rans0);
-  }
-
+  size_t index = inputBufferSize;
   while (inputIT != inputBegin) { // NB: working in reverse!
-    outputIter = encode(--inputIT, outputIter, rans1);
-    outputIter = encode(--inputIT, outputIter, rans0);
+    --index;
+    outputIter = encode(--inputIT, outputIter, coders[index & (nStreams_V - 1)]);
+  }
+  // flush in reverse order, the decoder reads the first state first
+  for (auto coder = coders.rbegin(); coder != coders.rend(); ++coder) {
+    outputIter = coder->flush(outputIter);
   }
-  outputIter = rans1.flush(outputIter);
-  outputIter = rans0.flush(outputIter);
   // first iterator past the range so that sizes, distances and iterators work correctly.
   ++outputIter;
 
@@ -108,6 +115,7 @@ stream_IT LiteralEncoder<coder_T, stream_T, source_T>::process(source_IT inputBe
               << "streamTypeB: " << sizeof(stream_T) << ", "
               << "coderTypeB: " << sizeof(coder_T) << ", "
               << "probabilityBits: " << this->mSymbolTablePrecission << ", "
+              << "nStreams: " << nStreams_V << ", "
               << "inputBufferSizeB: " << inputBufferSizeB << "}";
 #endif
 
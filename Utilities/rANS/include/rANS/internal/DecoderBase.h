@@ -20,6 +20,7 @@
 #include <type_traits>
 #include <iostream>
 #include <memory>
+#include <vector>
 
 #include <fairlogger/Logger.h>
 
@@ -65,6 +66,7 @@ class DecoderBase
   size_t mSymbolTablePrecission{};
   decoderSymbolTable_t mSymbolTable{};
   reverseSymbolLookupTable_t mReverseLUT{};
+  std::vector<DecoderSymbol> mDenseSymbolTable{}; // decoder symbols indexed by symbol - minSymbol, for the interleaved kernels
 };
 
 template <typename coder_T, typename stream_T, typename source_T>
@@ -84,6 +86,10 @@ DecoderBase<coder_T, stream_T, source_T>::DecoderBase(const FrequencyTable& freq
   mReverseLUT = reverseSymbolLookupTable_t{stats};
   t.stop();
   LOG(debug1) << "ReverseSymbolLookupTable inclusive time (ms): " << t.getDurationMS();
+  mDenseSymbolTable.reserve(mSymbolTable.size());
+  for (size_t index = 0; index < mSymbolTable.size(); ++index) {
+    mDenseSymbolTable.push_back(mSymbolTable.at(index));
+  }
 };
 } // namespace internal
 } // namespace rans
@@ -0,0 +1,93 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   DecoderKernel.h
+/// @author Michael Lettrich
+/// @since  2021-03-18
+/// @brief  SIMD kernels advancing several interleaved 64 Bit rANS decoder states at once
+
+#ifndef RANS_INTERNAL_DECODERKERNEL_H
+#define RANS_INTERNAL_DECODERKERNEL_H
+
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+#include "rANS/internal/DecoderSymbol.h"
+
+namespace o2
+{
+namespace rans
+{
+namespace internal
+{
+namespace simd
+{
+
+// number of 64 Bit lanes processed by one AVX2 instruction
+inline constexpr size_t AVXLaneWidth = 4;
+
+// the vectorized kernels load cumulative and frequency of a decoder symbol as one 64 Bit word
+static_assert(sizeof(DecoderSymbol) == sizeof(uint64_t), "DecoderSymbol must be packable into a 64 Bit word");
+static_assert(std::is_standard_layout_v<DecoderSymbol>);
+
+inline constexpr uint64_t LOWER_BOUND = static_cast<uint64_t>(1) << 31; // lower bound of the normalization interval of 64 Bit states
+inline constexpr uint64_t STREAM_BITS = 32;
+
+// x = D(x) for a single state followed by renormalization, returns the decoded symbol
+inline int32_t decodeLane(uint64_t& state, const uint32_t*& streamPos, const int32_t* reverseLUT, const DecoderSymbol* symbols, int32_t minSymbol, size_t symbolTablePrecision) noexcept
+{
+  const uint64_t mask = (static_cast<uint64_t>(1) << symbolTablePrecision) - 1;
+  const uint64_t cumulative = state & mask;
+  const int32_t symbol = reverseLUT[cumulative];
+  const DecoderSymbol& decoderSymbol = symbols[symbol - minSymbol];
+  state = decoderSymbol.getFrequency() * (state >> symbolTablePrecision) + cumulative - decoderSymbol.getCumulative();
+  if (state < LOWER_BOUND) {
+    state = (state << STREAM_BITS) | *streamPos;
+    --streamPos;
+  }
+  return symbol;
+}
+
+// true if the CPU running the process supports AVX2, checked once
+bool hasAVX2() noexcept;
+
+// 4 lanes: gather symbols from the reverse LUT, gather their packed {cumulative, frequency}, update the states
+// and renormalize them with a masked gather from the stream. The states must be aligned to 32 Bytes.
+// Compiled with AVX2 in its own translation unit, only to be called if hasAVX2().
+void decodeLanesAVX(uint64_t* states, const uint32_t*& streamPos, const int32_t* reverseLUT, const DecoderSymbol* symbols, int32_t minSymbol, size_t symbolTablePrecision, int32_t* decodedSymbols) noexcept;
+
+// Advance all nStreams_V states by one symbol each and renormalize them. The stream is consumed strictly
+// in the order of the lanes, streamPos points to the next word to read and is moved towards the stream begin.
+// The gather based kernel only pays off if at least two independent groups of lanes hide the gather latency,
+// below that the scalar interleaved loop is faster.
+template <size_t nStreams_V>
+inline void decodeLanes(uint64_t* states, const uint32_t*& streamPos, const int32_t* reverseLUT, const DecoderSymbol* symbols, int32_t minSymbol, size_t symbolTablePrecision, int32_t* decodedSymbols) noexcept
+{
+  if constexpr (nStreams_V >= 2 * AVXLaneWidth && nStreams_V % AVXLaneWidth == 0) {
+    static const bool useAVX = hasAVX2();
+    if (useAVX) {
+      for (size_t lane = 0; lane < nStreams_V; lane += AVXLaneWidth) {
+        decodeLanesAVX(states + lane, streamPos, reverseLUT, symbols, minSymbol, symbolTablePrecision, decodedSymbols + lane);
+      }
+      return;
+    }
+  }
+  for (size_t lane = 0; lane < nStreams_V; ++lane) {
+    decodedSymbols[lane] = decodeLane(states[lane], streamPos, reverseLUT, symbols, minSymbol, symbolTablePrecision);
+  }
+}
+
+} // namespace simd
+} // namespace internal
+} // namespace rans
+} // namespace o2
+
+#endif /* RANS_INTERNAL_DECODERKERNEL_H */
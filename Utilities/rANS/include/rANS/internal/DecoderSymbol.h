@@ -20,6 +20,8 @@
 #include <cstring>
 #include <cassert>
 
+#include "rANS/internal/helper.h"
+
 namespace o2
 {
 namespace rans
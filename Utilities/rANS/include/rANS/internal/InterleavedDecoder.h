@@ -0,0 +1,154 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   InterleavedDecoder.h
+/// @author Michael Lettrich
+/// @since  2021-03-18
+/// @brief  set of nStreams rANS decoder states sharing one input stream
+
+#ifndef RANS_INTERNAL_INTERLEAVEDDECODER_H
+#define RANS_INTERNAL_INTERLEAVEDDECODER_H
+
+#include <array>
+#include <cstdint>
+#include <cassert>
+#include <type_traits>
+
+#include "rANS/internal/DecoderKernel.h"
+#include "rANS/internal/DecoderSymbol.h"
+#include "rANS/internal/helper.h"
+
+namespace o2
+{
+namespace rans
+{
+namespace internal
+{
+
+// Symbol i of a message is coded by state i % nStreams_V. The states are initialized in ascending order,
+// i.e. the encoder has to flush them in descending order. For nStreams_V == 2 the layout of the stream is
+// identical to the one produced by the classic two-way interleaved coders.
+template <typename state_T, typename stream_T, size_t nStreams_V>
+class InterleavedDecoder
+{
+  static_assert((sizeof(state_T) == sizeof(uint32_t) && sizeof(stream_T) == sizeof(uint8_t)) ||
+                  (sizeof(state_T) == sizeof(uint64_t) && sizeof(stream_T) == sizeof(uint32_t)),
+                "Coder can either be 32Bit with 8 Bit stream type or 64 Bit Type with 32 Bit stream type");
+  static_assert(nStreams_V > 0 && (nStreams_V & (nStreams_V - 1)) == 0, "number of interleaved streams must be a power of 2");
+
+ public:
+  explicit InterleavedDecoder(size_t symbolTablePrecission) noexcept : mSymbolTablePrecission{symbolTablePrecission} {};
+
+  static constexpr size_t getNStreams() noexcept { return nStreams_V; };
+
+  // read the initial states, first state first. stream_IT points to the last element of the encoded stream.
+  template <typename stream_IT>
+  stream_IT init(stream_IT inputIter);
+
+  // decode one symbol for each of the nStreams_V states
+  template <typename stream_IT>
+  stream_IT decode(stream_IT inputIter, const int32_t* reverseLUT, const DecoderSymbol* symbols, int32_t minSymbol, int32_t* decodedSymbols);
+
+  // decode one symbol for each of the first nLanes states, used for the tail of a message
+  template <typename stream_IT>
+  stream_IT decodeTail(stream_IT inputIter, const int32_t* reverseLUT, const DecoderSymbol* symbols, int32_t minSymbol, size_t nLanes, int32_t* decodedSymbols);
+
+ private:
+  alignas(32) std::array<state_T, nStreams_V> mStates{};
+  size_t mSymbolTablePrecission{};
+
+  template <typename stream_IT>
+  stream_IT renorm(state_T& state, stream_IT inputIter);
+
+  inline static constexpr state_T LOWER_BOUND = needs64Bit<state_T>() ? (1u << 31) : (1u << 23); // lower bound of our normalization interval
+
+  inline static constexpr state_T STREAM_BITS = sizeof(stream_T) * 8;
+};
+
+template <typename state_T, typename stream_T, size_t nStreams_V>
+template <typename stream_IT>
+stream_IT InterleavedDecoder<state_T, stream_T, nStreams_V>::init(stream_IT inputIter)
+{
+  stream_IT streamPosition = inputIter;
+  for (auto& state : mStates) {
+    state = 0;
+    for (size_t i = 0; i < sizeof(state_T) / sizeof(stream_T); ++i) {
+      state |= static_cast<state_T>(*streamPosition) << (i * STREAM_BITS);
+      --streamPosition;
+    }
+  }
+  return streamPosition;
+};
+
+template <typename state_T, typename stream_T, size_t nStreams_V>
+template <typename stream_IT>
+stream_IT InterleavedDecoder<state_T, stream_T, nStreams_V>::decode(stream_IT inputIter, const int32_t* reverseLUT, const DecoderSymbol* symbols, int32_t minSymbol, int32_t* decodedSymbols)
+{
+  if constexpr (needs64Bit<state_T>() && std::is_pointer_v<stream_IT>) {
+    // contiguous stream: let the (vectorized) kernel advance and renormalize all states
+    const uint32_t* streamPos = inputIter;
+    simd::decodeLanes<nStreams_V>(mStates.data(), streamPos, reverseLUT, symbols, minSymbol, mSymbolTablePrecission, decodedSymbols);
+    inputIter = const_cast<stream_IT>(streamPos);
+  } else {
+    const state_T mask = pow2(mSymbolTablePrecission) - 1;
+    for (size_t lane = 0; lane < nStreams_V; ++lane) {
+      state_T& state = mStates[lane];
+      const int32_t symbol = reverseLUT[state & mask];
+      const DecoderSymbol& decoderSymbol = symbols[symbol - minSymbol];
+      state = decoderSymbol.getFrequency() * (state >> mSymbolTablePrecission) + (state & mask) - decoderSymbol.getCumulative();
+      decodedSymbols[lane] = symbol;
+      // the stream has to be consumed in the order of the lanes
+      inputIter = renorm(state, inputIter);
+    }
+  }
+  return inputIter;
+};
+
+template <typename state_T, typename stream_T, size_t nStreams_V>
+template <typename stream_IT>
+stream_IT InterleavedDecoder<state_T, stream_T, nStreams_V>::decodeTail(stream_IT inputIter, const int32_t* reverseLUT, const DecoderSymbol* symbols, int32_t minSymbol, size_t nLanes, int32_t* decodedSymbols)
+{
+  assert(nLanes <= nStreams_V);
+  const state_T mask = pow2(mSymbolTablePrecission) - 1;
+  for (size_t lane = 0; lane < nLanes; ++lane) {
+    state_T& state = mStates[lane];
+    const int32_t symbol = reverseLUT[state & mask];
+    const DecoderSymbol& decoderSymbol = symbols[symbol - minSymbol];
+    state = decoderSymbol.getFrequency() * (state >> mSymbolTablePrecission) + (state & mask) - decoderSymbol.getCumulative();
+    decodedSymbols[lane] = symbol;
+    inputIter = renorm(state, inputIter);
+  }
+  return inputIter;
+};
+
+template <typename state_T, typename stream_T, size_t nStreams_V>
+template <typename stream_IT>
+inline stream_IT InterleavedDecoder<state_T, stream_T, nStreams_V>::renorm(state_T& state, stream_IT inputIter)
+{
+  if (state < LOWER_BOUND) {
+    if constexpr (needs64Bit<state_T>()) {
+      state = (state << STREAM_BITS) | *inputIter;
+      --inputIter;
+      assert(state >= LOWER_BOUND);
+    } else {
+      do {
+        state = (state << STREAM_BITS) | *inputIter;
+        --inputIter;
+      } while (state < LOWER_BOUND);
+    }
+  }
+  return inputIter;
+};
+
+} // namespace internal
+} // namespace rans
+} // namespace o2
+
+#endif /* RANS_INTERNAL_INTERLEAVEDDECODER_H */
@@ -0,0 +1,117 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   DecoderKernel.cxx
+/// @author Michael Lettrich
+/// @since  2021-03-18
+/// @brief  AVX2 kernel of the interleaved rANS decoder, this translation unit is compiled with AVX2 enabled
+
+#include "rANS/internal/DecoderKernel.h"
+
+#include <array>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace o2
+{
+namespace rans
+{
+namespace internal
+{
+namespace simd
+{
+
+bool hasAVX2() noexcept
+{
+#if defined(__AVX2__) && (defined(__x86_64__) || defined(__i386__))
+  return __builtin_cpu_supports("avx2");
+#else
+  return false;
+#endif
+}
+
+#if defined(__AVX2__)
+namespace
+{
+// Offsets (in stream words) from the current stream position for each lane that needs renormalization:
+// lanes consume the stream in ascending order, i.e. the k-th lane to renormalize reads streamPos[-k].
+struct alignas(32) RenormOffsets {
+  int64_t offsets[4];
+};
+
+constexpr std::array<RenormOffsets, 16> makeRenormOffsetsLUT() noexcept
+{
+  std::array<RenormOffsets, 16> lut{};
+  for (size_t mask = 0; mask < lut.size(); ++mask) {
+    int64_t rank = 0;
+    for (size_t lane = 0; lane < 4; ++lane) {
+      lut[mask].offsets[lane] = (mask & (1u << lane)) ? -(rank++) : 0;
+    }
+  }
+  return lut;
+}
+
+constexpr std::array<RenormOffsets, 16> RenormOffsetsLUT = makeRenormOffsetsLUT();
+} // namespace
+
+// States stay in 256 Bit registers between the steps, mixing scalar and vector accesses to the same states
+// would stall on store forwarding.
+void decodeLanesAVX(uint64_t* states, const uint32_t*& streamPos, const int32_t* reverseLUT, const DecoderSymbol* symbols, int32_t minSymbol, size_t symbolTablePrecision, int32_t* decodedSymbols) noexcept
+{
+  const __m256i mask = _mm256_set1_epi64x((static_cast<int64_t>(1) << symbolTablePrecision) - 1);
+  const __m256i lower32Mask = _mm256_set1_epi64x(0xffffffff);
+  const __m128i precision = _mm_cvtsi64_si128(symbolTablePrecision);
+
+  const __m256i state = _mm256_load_si256(reinterpret_cast<const __m256i*>(states));
+  const __m256i cumulative = _mm256_and_si256(state, mask);
+  const __m128i symbol = _mm256_i64gather_epi32(reverseLUT, cumulative, sizeof(int32_t));
+  const __m128i index = _mm_sub_epi32(symbol, _mm_set1_epi32(minSymbol));
+  const __m256i packedSymbol = _mm256_i32gather_epi64(reinterpret_cast<const long long*>(symbols), index, sizeof(DecoderSymbol));
+  const __m256i symbolCumulative = _mm256_and_si256(packedSymbol, lower32Mask);
+  const __m256i symbolFrequency = _mm256_srli_epi64(packedSymbol, 32);
+
+  // frequency * (state >> precision): the shifted state can exceed 32 Bits, multiply both halves separately
+  const __m256i quotient = _mm256_srl_epi64(state, precision);
+  const __m256i productLow = _mm256_mul_epu32(quotient, symbolFrequency);
+  const __m256i productHigh = _mm256_slli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(quotient, 32), symbolFrequency), 32);
+  const __m256i product = _mm256_add_epi64(productLow, productHigh);
+  __m256i newState = _mm256_add_epi64(product, _mm256_sub_epi64(cumulative, symbolCumulative));
+
+  // renormalize: state < 2^31 <=> (state >> 31) == 0
+  const __m256i needsRenorm = _mm256_cmpeq_epi64(_mm256_srli_epi64(newState, 31), _mm256_setzero_si256());
+  const int renormMask = _mm256_movemask_pd(_mm256_castsi256_pd(needsRenorm));
+  if (renormMask) {
+    const __m256i offsets = _mm256_load_si256(reinterpret_cast<const __m256i*>(RenormOffsetsLUT[renormMask].offsets));
+    // 64 Bit gather of 32 Bit words, the upper half (the next stream word) is masked away. During decoding the
+    // stream position is always followed by the initial states, so the over-read stays inside the stream.
+    const __m256i streamWords = _mm256_and_si256(_mm256_mask_i64gather_epi64(_mm256_setzero_si256(), reinterpret_cast<const long long*>(streamPos), offsets, needsRenorm, sizeof(uint32_t)), lower32Mask);
+    newState = _mm256_blendv_epi8(newState, _mm256_or_si256(_mm256_slli_epi64(newState, STREAM_BITS), streamWords), needsRenorm);
+    streamPos -= __builtin_popcount(renormMask);
+  }
+
+  _mm256_store_si256(reinterpret_cast<__m256i*>(states), newState);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(decodedSymbols), symbol);
+}
+#else
+// not reached, hasAVX2() is false when the kernel cannot be compiled for AVX2
+void decodeLanesAVX(uint64_t* states, const uint32_t*& streamPos, const int32_t* reverseLUT, const DecoderSymbol* symbols, int32_t minSymbol, size_t symbolTablePrecision, int32_t* decodedSymbols) noexcept
+{
+  for (size_t lane = 0; lane < AVXLaneWidth; ++lane) {
+    decodedSymbols[lane] = decodeLane(states[lane], streamPos, reverseLUT, symbols, minSymbol, symbolTablePrecision);
+  }
+}
+#endif
+
+} // namespace simd
+} // namespace internal
+} // namespace rans
+} // namespace o2
@@ -17,6 +17,7 @@
 #define BOOST_TEST_MAIN
 #define BOOST_TEST_DYN_LINK
 
+#include <array>
 #include <vector>
 #include <cstring>
 
@@ -24,6 +25,7 @@
 #include <boost/mpl/vector.hpp>
 
 #include "rANS/rans.h"
+#include "rANS/internal/DecoderKernel.h"
 
 struct EmptyTestString {
   std::string data{};
@@ -147,6 +149,22 @@ struct EncodeDecodeLiteral : public EncodeDecodeBase<o2::rans::LiteralEncoder, o
   std::vector<typename Params<coder_T>::source_t> literals;
 };
 
+template <typename coder_T, size_t nStreams_V, class dictString_T, class testString_T>
+struct EncodeDecodeInterleaved : public EncodeDecodeBase<o2::rans::LiteralEncoder, o2::rans::LiteralDecoder, coder_T, dictString_T, testString_T> {
+  void encode() override
+  {
+    BOOST_CHECK_NO_THROW(this->encoder.template process<nStreams_V>(std::begin(this->source.data), std::end(this->source.data), std::back_inserter(this->encodeBuffer), literals));
+  };
+  void decode() override
+  {
+    // decode from a raw pointer, which enables the vectorized kernels
+    BOOST_CHECK_NO_THROW(this->decoder.template process<nStreams_V>(this->encodeBuffer.data() + this->encodeBuffer.size(), std::back_inserter(this->decodeBuffer), this->source.data.size(), literals));
+    BOOST_CHECK(literals.empty());
+  };
+
+  std::vector<typename Params<coder_T>::source_t> literals;
+};
+
 template <typename coder_T, class dictString_T, class testString_T>
 struct EncodeDecodeDedup : public EncodeDecodeBase<o2::rans::DedupEncoder, o2::rans::DedupDecoder, coder_T, dictString_T, testString_T> {
   void encode() override
@@ -174,6 +192,12 @@ using testCase_t = boost::mpl::vector<EncodeDecode<uint32_t, EmptyTestString, Em
                                       EncodeDecodeLiteral<uint64_t, FullTestString, FullTestString>,
                                       EncodeDecodeLiteral<uint32_t, EmptyTestString, FullTestString>,
                                       EncodeDecodeLiteral<uint64_t, EmptyTestString, FullTestString>,
+                                      EncodeDecodeInterleaved<uint32_t, 4, FullTestString, FullTestString>,
+                                      EncodeDecodeInterleaved<uint64_t, 4, FullTestString, FullTestString>,
+                                      EncodeDecodeInterleaved<uint64_t, 8, FullTestString, FullTestString>,
+                                      EncodeDecodeInterleaved<uint64_t, 16, FullTestString, FullTestString>,
+                                      EncodeDecodeInterleaved<uint64_t, 16, EmptyTestString, EmptyTestString>,
+                                      EncodeDecodeInterleaved<uint64_t, 8, EmptyTestString, FullTestString>,
                                       EncodeDecodeDedup<uint32_t, EmptyTestString, EmptyTestString>,
                                       EncodeDecodeDedup<uint64_t, EmptyTestString, EmptyTestString>,
                                       EncodeDecodeDedup<uint32_t, FullTestString, FullTestString>,
@@ -185,4 +209,60 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_encodeDecode, testCase_T, testCase_t)
   testCase.encode();
   testCase.decode();
   testCase.check();
-};
\ No newline at end of file
+};
+BOOST_AUTO_TEST_CASE(test_interleavedStreamLayout)
+{
+  // two interleaved streams must reproduce the stream layout of the classic Encoder
+  FullTestString source;
+  o2::rans::FrequencyTable frequencies;
+  frequencies.addSamples(std::begin(source.data), std::end(source.data));
+  const o2::rans::Encoder64<char> encoder{frequencies, 16};
+  const o2::rans::LiteralEncoder64<char> literalEncoder{frequencies, 16};
+
+  std::vector<uint32_t> encodeBuffer;
+  std::vector<uint32_t> interleavedBuffer;
+  std::vector<char> literals;
+  encoder.process(std::begin(source.data), std::end(source.data), std::back_inserter(encodeBuffer));
+  literalEncoder.process<2>(std::begin(source.data), std::end(source.data), std::back_inserter(interleavedBuffer), literals);
+  BOOST_CHECK_EQUAL_COLLECTIONS(encodeBuffer.begin(), encodeBuffer.end(), interleavedBuffer.begin(), interleavedBuffer.end());
+}
+
+BOOST_AUTO_TEST_CASE(test_avx2DecoderKernel)
+{
+  // the AVX2 kernel must advance the states and the stream position exactly like the scalar decoding of each lane
+  using namespace o2::rans::internal;
+  if (!simd::hasAVX2()) {
+    BOOST_TEST_MESSAGE("AVX2 is not supported by this CPU, skipping the test of the AVX2 kernel");
+    return;
+  }
+  constexpr size_t nLanes = 2 * simd::AVXLaneWidth;
+  constexpr size_t precision = 4;
+  const std::vector<DecoderSymbol> symbols{{8, 0, precision}, {4, 8, precision}, {2, 12, precision}, {2, 14, precision}};
+  std::vector<int32_t> reverseLUT;
+  for (int32_t symbol = 0; symbol < static_cast<int32_t>(symbols.size()); ++symbol) {
+    reverseLUT.insert(reverseLUT.end(), symbols[symbol].getFrequency(), symbol);
+  }
+  std::vector<uint32_t> stream(1024);
+  for (size_t i = 0; i < stream.size(); ++i) {
+    stream[i] = static_cast<uint32_t>(i * 2654435761u);
+  }
+
+  alignas(32) std::array<uint64_t, nLanes> states;
+  std::array<uint64_t, nLanes> referenceStates;
+  for (size_t lane = 0; lane < nLanes; ++lane) {
+    states[lane] = referenceStates[lane] = simd::LOWER_BOUND + lane * 0x12345679ull;
+  }
+  const uint32_t* streamPos = stream.data() + stream.size() - 2;
+  const uint32_t* referenceStreamPos = streamPos;
+  std::array<int32_t, nLanes> decoded{};
+  for (size_t step = 0; step < 100; ++step) {
+    for (size_t lane = 0; lane < nLanes; lane += simd::AVXLaneWidth) {
+      simd::decodeLanesAVX(states.data() + lane, streamPos, reverseLUT.data(), symbols.data(), 0, precision, decoded.data() + lane);
+    }
+    for (size_t lane = 0; lane < nLanes; ++lane) {
+      BOOST_CHECK_EQUAL(decoded[lane], simd::decodeLane(referenceStates[lane], referenceStreamPos, reverseLUT.data(), symbols.data(), 0, precision));
+    }
+    BOOST_REQUIRE(states == referenceStates);
+    BOOST_REQUIRE(streamPos == referenceStreamPos);
+  }
+}